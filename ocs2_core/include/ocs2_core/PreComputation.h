@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+
 #include <ocs2_core/ComputationRequest.h>
 #include <ocs2_core/Types.h>
 
@@ -65,9 +67,39 @@ class PreComputation {
   /** Request callback at final time */
   virtual void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {}
 
+  /**
+   * Sets the index of the node of the solver's time discretization at which the next requests and evaluations are made. The pre-jump
+   * node and the post-jump node of an event have different indices. Terms which keep data per node, e.g. QuasiNewtonStateCost, use
+   * it to identify the node.
+   */
+  void setNodeIndex(size_t nodeIndex) { nodeIndex_ = nodeIndex; }
+
+  /** Whether the solver has set the node index. */
+  bool hasNodeIndex() const { return nodeIndex_ != std::numeric_limits<size_t>::max(); }
+
+  /** Gets the node index, see setNodeIndex(). */
+  size_t getNodeIndex() const { return nodeIndex_; }
+
+  /**
+   * Sets the index of the active mode in ModeSchedule::modeSequence at the node which is evaluated next. Solvers which precompute it,
+   * e.g. from ModelData::eventIndex_, set it together with the node index, so that switched systems can skip the lookup of the mode.
+   * It agrees with ModeSchedule::modeAtTime() at the node time.
+   */
+  void setModeIndex(size_t modeIndex) { modeIndex_ = modeIndex; }
+
+  /** Whether the solver has set the mode index. */
+  bool hasModeIndex() const { return modeIndex_ != std::numeric_limits<size_t>::max(); }
+
+  /** Gets the mode index, see setModeIndex(). */
+  size_t getModeIndex() const { return modeIndex_; }
+
  protected:
   /** Copy constructor */
   PreComputation(const PreComputation& other) = default;
+
+ private:
+  size_t nodeIndex_ = std::numeric_limits<size_t>::max();
+  size_t modeIndex_ = std::numeric_limits<size_t>::max();
 };
 
 /** Helper to cast to const reference of derived class. */
@@ -178,6 +178,14 @@ struct VectorFunctionLinearApproximation {
 
 std::ostream& operator<<(std::ostream& out, const VectorFunctionLinearApproximation& f);
 
+/**
+ * Extracts a subset of the elements of a vector-valued function approximation.
+ * @param[in] f: The full approximation.
+ * @param[in] rows: The indices of the selected elements.
+ * @return The approximation of the selected elements, in the order of rows.
+ */
+VectorFunctionLinearApproximation extractRows(const VectorFunctionLinearApproximation& f, const size_array_t& rows);
+
 /**
  * Defines quadratic approximation of a vector-valued function
  * f[i](x,u) = 1/2 dx' dfdxx[i] dx + du' dfdux[i] dx + 1/2 du' dfduu[i] du + dfdx[i,:] dx + dfdu[i,:] du + f[i]
@@ -230,4 +238,12 @@ struct VectorFunctionQuadraticApproximation {
 
 std::ostream& operator<<(std::ostream& out, const VectorFunctionQuadraticApproximation& f);
 
+/**
+ * Extracts a subset of the elements of a vector-valued function approximation.
+ * @param[in] f: The full approximation.
+ * @param[in] rows: The indices of the selected elements.
+ * @return The approximation of the selected elements, in the order of rows.
+ */
+VectorFunctionQuadraticApproximation extractRows(const VectorFunctionQuadraticApproximation& f, const size_array_t& rows);
+
 }  // namespace ocs2
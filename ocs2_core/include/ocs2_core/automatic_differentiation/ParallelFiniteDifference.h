@@ -0,0 +1,107 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/dynamics/ControlledSystemBase.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Computes the finite-difference linearization of a ControlledSystemBase with the columns of the Jacobians distributed over a
+ * ThreadPool. Each worker evaluates the flow map of its own clone of the system on its own preallocated perturbation buffers. The
+ * last linearization is cached, such that repeated queries at the same time, state, and input do not evaluate the system again.
+ */
+class ParallelFiniteDifference {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] system: The system to linearize. It is cloned for each thread.
+   * @param [in] nThreads: The number of threads, including the calling thread.
+   * @param [in] eps: The relative perturbation size.
+   * @param [in] doubleSidedDerivative: If true, the central difference is used, else the forward difference.
+   * @param [in] isSecondOrderSystem: If true, the state is assumed to be [q, dq/dt] and the rows of dq/dt are not perturbed.
+   * @param [in] threadPriority: The priority of the worker threads.
+   */
+  ParallelFiniteDifference(const ControlledSystemBase& system, size_t nThreads, scalar_t eps = Eigen::NumTraits<scalar_t>::epsilon(),
+                           bool doubleSidedDerivative = true, bool isSecondOrderSystem = false, int threadPriority = 0);
+
+  /**
+   * Computes the flow map and its Jacobians with respect to the state and the input.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in] u: The current input.
+   * @return The linear approximation. The reference is valid until the next call.
+   */
+  const VectorFunctionLinearApproximation& linearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
+
+  /** Invalidates the cached linearization, e.g. after the parameters of the system have changed. */
+  void clearCache() { isCacheValid_ = false; }
+
+  /** Gets the number of threads, including the calling thread. */
+  size_t getNumThreads() const { return systemPtrStock_.size(); }
+
+ private:
+  struct WorkerBuffer {
+    vector_t state;
+    vector_t input;
+  };
+
+  /** Computes the Jacobian columns which are assigned to this worker */
+  void computeColumns(size_t workerIndex, scalar_t t, const vector_t& x, const vector_t& u);
+
+  /** Computes the difference quotient of the flow map in var(index), where var is either the state or the input of the buffer */
+  void computeColumn(ControlledSystemBase& system, scalar_t t, WorkerBuffer& buffer, vector_t& var, size_t index,
+                     Eigen::Ref<vector_t> column) const;
+
+  scalar_t eps_;
+  bool doubleSidedDerivative_;
+  bool isSecondOrderSystem_;
+
+  ThreadPool threadPool_;
+  std::vector<std::unique_ptr<ControlledSystemBase>> systemPtrStock_;
+  std::vector<WorkerBuffer> workerBufferStock_;
+  std::atomic_size_t nextColumnId_{0};
+
+  bool isCacheValid_ = false;
+  scalar_t cachedTime_ = 0.0;
+  vector_t cachedState_;
+  vector_t cachedInput_;
+  VectorFunctionLinearApproximation linearApproximation_;
+};
+
+}  // namespace ocs2
@@ -57,6 +57,12 @@ class LinearStateConstraint : public StateConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x,
                                                            const PreComputation& /* preComputation */) const final;
 
+  size_t insertLinearApproximation(scalar_t t, const vector_t& x, const PreComputation& /* preComputation */, size_t startRow,
+                                   VectorFunctionLinearApproximation& approximation) const final;
+
+  VectorFunctionLinearApproximation getPartialLinearApproximation(scalar_t t, const vector_t& x, const size_array_t& rows,
+                                                                  const PreComputation& /* preComputation */) const final;
+
  public:
   vector_t h_; /**< State only constraint */
   matrix_t F_; /**< State only constraint derivative wrt. state */
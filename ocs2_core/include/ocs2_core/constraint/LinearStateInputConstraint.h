@@ -58,6 +58,13 @@ class LinearStateInputConstraint : public StateInputConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                            const PreComputation& /* preComputation */) const final;
 
+  size_t insertLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& /* preComputation */,
+                                   size_t startRow, VectorFunctionLinearApproximation& approximation) const final;
+
+  VectorFunctionLinearApproximation getPartialLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                  const size_array_t& rows,
+                                                                  const PreComputation& /* preComputation */) const final;
+
  public:
   vector_t e_; /**< State input constraint */
   matrix_t C_; /**< State input constraint derivative wrt. state */
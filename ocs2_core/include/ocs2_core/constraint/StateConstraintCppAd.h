@@ -64,6 +64,12 @@ class StateConstraintCppAd : public StateConstraint {
                                                            const PreComputation& /* preComputation */) const override;
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                  const PreComputation& /* preComputation */) const override;
+  /** Also used for a quadratic constraint, since it does not require the Hessians. */
+  VectorFunctionLinearApproximation getPartialLinearApproximation(scalar_t time, const vector_t& state, const size_array_t& rows,
+                                                                  const PreComputation& /* preComputation */) const override;
+  /** Only the Hessians of the requested constraints are evaluated. */
+  VectorFunctionQuadraticApproximation getPartialQuadraticApproximation(scalar_t time, const vector_t& state, const size_array_t& rows,
+                                                                        const PreComputation& /* preComputation */) const override;
 
  protected:
   StateConstraintCppAd(const StateConstraintCppAd& rhs);
@@ -76,6 +76,55 @@ class StateInputConstraint {
     }
   }
 
+  /**
+   * Writes the constraint linear approximation into the rows of the given approximation, starting from startRow. The default
+   * implementation copies the result of getLinearApproximation(). Constraints with constant Jacobians can override it to write their
+   * Jacobians directly, without creating a temporary approximation.
+   * @return The number of written rows.
+   */
+  virtual size_t insertLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                                           size_t startRow, VectorFunctionLinearApproximation& approximation) const {
+    const auto linearApproximation = getLinearApproximation(time, state, input, preComp);
+    const size_t nc = linearApproximation.f.rows();
+    approximation.f.segment(startRow, nc) = linearApproximation.f;
+    approximation.dfdx.middleRows(startRow, nc) = linearApproximation.dfdx;
+    approximation.dfdu.middleRows(startRow, nc) = linearApproximation.dfdu;
+    return nc;
+  }
+
+  /**
+   * Get the linear approximation of a subset of the constraints. The default implementation extracts the rows from the full linear
+   * approximation, or from the full quadratic approximation for a quadratic constraint. Derived classes can override it to skip the
+   * evaluation of the other rows.
+   * @param [in] rows: The indices of the requested constraints.
+   * @return The linear approximation of the requested constraints, in the order of rows.
+   */
+  virtual VectorFunctionLinearApproximation getPartialLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                          const size_array_t& rows, const PreComputation& preComp) const {
+    if (order_ == ConstraintOrder::Linear) {
+      return extractRows(getLinearApproximation(time, state, input, preComp), rows);
+    } else {
+      auto quadraticApproximation = extractRows(getQuadraticApproximation(time, state, input, preComp), rows);
+      VectorFunctionLinearApproximation linearApproximation;
+      linearApproximation.f = std::move(quadraticApproximation.f);
+      linearApproximation.dfdx = std::move(quadraticApproximation.dfdx);
+      linearApproximation.dfdu = std::move(quadraticApproximation.dfdu);
+      return linearApproximation;
+    }
+  }
+
+  /**
+   * Get the quadratic approximation of a subset of the constraints. The default implementation extracts the rows from the full
+   * quadratic approximation. Derived classes can override it to skip the evaluation of the other rows.
+   * @param [in] rows: The indices of the requested constraints.
+   * @return The quadratic approximation of the requested constraints, in the order of rows.
+   */
+  virtual VectorFunctionQuadraticApproximation getPartialQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                                const size_array_t& rows,
+                                                                                const PreComputation& preComp) const {
+    return extractRows(getQuadraticApproximation(time, state, input, preComp), rows);
+  }
+
  protected:
   StateInputConstraint(const StateInputConstraint& rhs) = default;
 
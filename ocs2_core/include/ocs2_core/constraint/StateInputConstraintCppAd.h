@@ -65,6 +65,14 @@ class StateInputConstraintCppAd : public StateInputConstraint {
                                                            const PreComputation& /* preComputation */) const override;
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const PreComputation& /* preComputation */) const override;
+  /** Also used for a quadratic constraint, since it does not require the Hessians. */
+  VectorFunctionLinearApproximation getPartialLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                  const size_array_t& rows,
+                                                                  const PreComputation& /* preComputation */) const override;
+  /** Only the Hessians of the requested constraints are evaluated. */
+  VectorFunctionQuadraticApproximation getPartialQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                        const size_array_t& rows,
+                                                                        const PreComputation& /* preComputation */) const override;
 
  protected:
   StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs);
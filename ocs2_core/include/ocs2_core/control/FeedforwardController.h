@@ -103,6 +103,10 @@ class FeedforwardController final : public ControllerBase {
 
   static FeedforwardController unFlatten(const scalar_array_t& timeArray, const std::vector<std::vector<float> const*>& flatArray2);
 
+  /** Same as unFlatten(timeArray, flatArray2), but overwrites the given controller and reuses its memory. */
+  static void unFlatten(const scalar_array_t& timeArray, const std::vector<std::vector<float> const*>& flatArray2,
+                        FeedforwardController& controller);
+
  private:
   void flattenSingle(scalar_t time, std::vector<float>& flatArray) const;
 
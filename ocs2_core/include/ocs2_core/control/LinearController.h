@@ -95,6 +95,43 @@ class LinearController final : public ControllerBase {
 
   void getBias(scalar_t time, vector_t& bias) const;
 
+  /** Feedback gains, one per time stamp. If the gains are compressed, they are decompressed first. */
+  matrix_array_t& gainArray() {
+    decompressGains();
+    return gainArray_;
+  }
+
+  /** Feedback gains, one per time stamp. Throws std::runtime_error if the gains are compressed, see gainsCompressed(). */
+  const matrix_array_t& gainArray() const;
+
+  /**
+   * Compresses the feedback gains: consecutive gains that are identical up to the tolerance are stored once, together with the number
+   * of time stamps they cover. With the default zero tolerance the compression is lossless. An empty controller is not compressed.
+   *
+   * @param [in] tolerance: Maximum element-wise difference of a gain to the first gain of its run.
+   * @return The maximum element-wise error of the feedback gain over the time horizon, which is bounded by the tolerance.
+   */
+  scalar_t compressGainsRunLength(scalar_t tolerance = 0.0);
+
+  /**
+   * Compresses the feedback gains: the gains are only stored at every stride-th time stamp and at both sides of an event, and are
+   * linearly interpolated in time in between. Since the original gains are linearly interpolated between the time stamps as well, the
+   * error is largest at a time stamp. An empty controller is not compressed.
+   *
+   * @param [in] stride: Number of time stamps from one stored gain to the next one.
+   * @return The maximum element-wise error of the feedback gain over the time horizon.
+   */
+  scalar_t compressGainsStride(size_t stride);
+
+  /** Restores one feedback gain per time stamp. */
+  void decompressGains();
+
+  /** Whether the feedback gains are compressed. The const gainArray() is then not accessible. */
+  bool gainsCompressed() const { return gainCompression_ != GainCompression::None; }
+
+  /** Number of stored feedback gains, which is smaller than size() if the gains are compressed. */
+  size_t numStoredGains() const { return gainArray_.size(); }
+
   scalar_array_t controllerEventTimes() const override;
 
   void flatten(const scalar_array_t& timeArray, const std::vector<std::vector<float>*>& flatArray2) const override;
@@ -102,14 +139,31 @@ class LinearController final : public ControllerBase {
   static LinearController unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
                                     const std::vector<std::vector<float> const*>& flatArray2);
 
+  /** Same as unFlatten(stateDim, inputDim, timeArray, flatArray2), but overwrites the given controller and reuses its memory. */
+  static void unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
+                        const std::vector<std::vector<float> const*>& flatArray2, LinearController& controller);
+
  private:
   void flattenSingle(scalar_t time, std::vector<float>& flatArray) const;
 
+  /** Feedback gain at a time stamp from the compressed gains */
+  void getCompressedGain(size_t index, matrix_t& gain) const;
+
+  /** Interpolates the compressed gains, corresponds to LinearInterpolation::interpolate(indexAlpha, gainArray_) */
+  matrix_t interpolateCompressedGain(const LinearInterpolation::index_alpha_t& indexAlpha) const;
+
+  /** Storage of the feedback gains, see compressGainsRunLength() and compressGainsStride() */
+  enum class GainCompression { None, RunLength, Stride };
+
  public:
   scalar_array_t timeStamp_;
   vector_array_t biasArray_;
   vector_array_t deltaBiasArray_;
+
+ private:
   matrix_array_t gainArray_;
+  GainCompression gainCompression_ = GainCompression::None;
+  size_array_t gainIndices_;  // index of the time stamp of each gain in gainArray_, only used if the gains are compressed
 
   friend void swap(LinearController& a, LinearController& b) noexcept;
 };
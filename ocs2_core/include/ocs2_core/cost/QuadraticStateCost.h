@@ -53,6 +53,10 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Adds the cost term quadratic approximation. The constant Hessian is added in place. */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                 ScalarFunctionQuadraticApproximation& approximation) const final;
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
@@ -58,6 +58,10 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Adds the cost term quadratic approximation. The constant Hessian blocks are added in place. */
+  void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation&, ScalarFunctionQuadraticApproximation& approximation) const final;
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
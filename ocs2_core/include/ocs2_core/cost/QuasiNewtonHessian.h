@@ -0,0 +1,145 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace quasi_newton {
+
+/** The update formula of the Hessian estimate */
+enum class HessianUpdate {
+  /** Damped BFGS update (Powell's damping). The estimate stays positive definite. */
+  BFGS,
+  /** Symmetric rank-one update. The estimate can become indefinite, but it is exact after n independent steps on a quadratic. */
+  SR1
+};
+
+/** Settings of the quasi-Newton Hessian estimate */
+struct Settings {
+  /** The update formula */
+  HessianUpdate update = HessianUpdate::BFGS;
+
+  /**
+   * The initial Hessian estimate is initialHessianScaling * identity. For BFGS, it is rescaled with the curvature along the first
+   * step (y' * y / s' * y) before the first update.
+   */
+  scalar_t initialHessianScaling = 1.0;
+
+  /** Powell's damping threshold of the BFGS update. The update is damped if s' * y < dampingThreshold * s' * B * s. */
+  scalar_t dampingThreshold = 0.2;
+
+  /** The SR1 update is skipped if |r' * s| < skipTolerance * |r| * |s| where r = y - B * s. */
+  scalar_t skipTolerance = 1e-8;
+};
+
+/** Converts the HessianUpdate to string */
+std::string toString(HessianUpdate update);
+
+/** Converts a string to HessianUpdate */
+HessianUpdate fromString(std::string name);
+
+/**
+ * Loads the quasi-Newton settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "quasi_newton", bool verbose = true);
+
+/**
+ * Maintains a quasi-Newton Hessian estimate of a scalar function for each node of a time discretization. The nodes are identified by
+ * their index in the solver's discretization, see PreComputation::setNodeIndex(). Hence, the pre-jump and the post-jump nodes of an
+ * event are kept apart, and the secant pairs are also formed when the node times change between the iterations, e.g. with an adaptive
+ * step size rollout. At every call of update(), the estimate of the node is updated with the change of the gradient between the
+ * previous and the current evaluation point of this node, i.e. between two iterations of the solver. Repeated evaluations at the same
+ * point do not change the estimate. A node that is seen for the first time starts from the estimate of its closest node.
+ *
+ * The class is thread-safe. It is shared between the copies of the cost term which uses it, such that each node keeps its estimate
+ * regardless of the worker thread that evaluates it.
+ */
+class QuasiNewtonHessian {
+ public:
+  /**
+   * Constructor.
+   * @param [in] settings: The quasi-Newton settings.
+   */
+  explicit QuasiNewtonHessian(Settings settings = Settings());
+
+  /**
+   * Updates the Hessian estimate of the given node and returns it.
+   *
+   * @param [in] nodeIndex: The index of the node.
+   * @param [in] point: The evaluation point, e.g. the stacked state and input.
+   * @param [in] gradient: The gradient of the function at the evaluation point.
+   * @param [out] hessian: The updated Hessian estimate.
+   */
+  void update(size_t nodeIndex, const vector_t& point, const vector_t& gradient, matrix_t& hessian);
+
+  /** Removes all the nodes. */
+  void clear();
+
+  /** Gets the number of the stored nodes. */
+  size_t getNumNodes() const;
+
+  /** Gets the number of the secant updates of all the nodes since the construction or the last clear(). */
+  size_t getNumUpdates() const;
+
+  /** Gets the settings. */
+  const Settings& settings() const { return settings_; }
+
+ private:
+  struct Node {
+    vector_t point;
+    vector_t gradient;
+    matrix_t hessian;
+    bool hasCurvaturePair = false;
+  };
+
+  /** Finds the node with the given index, or creates it from its closest node. */
+  Node& getNode(size_t nodeIndex, size_t dim);
+
+  /** Applies the update formula with the step s and the gradient change y. */
+  void updateHessian(const vector_t& s, const vector_t& y, matrix_t& hessian) const;
+
+  const Settings settings_;
+  std::map<size_t, Node> nodes_;
+  size_t numUpdates_ = 0;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace quasi_newton
+}  // namespace ocs2
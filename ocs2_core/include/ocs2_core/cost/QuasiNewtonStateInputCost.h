@@ -0,0 +1,88 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/cost/QuasiNewtonHessian.h>
+#include <ocs2_core/cost/StateInputCost.h>
+
+namespace ocs2 {
+
+/**
+ * Wraps a state-input cost term which only provides gradients, e.g. a StateInputSoftConstraint or a StateInputCostCppAd which is
+ * initialized with the first approximation order. The Hessian with respect to the stacked state and input is estimated with a
+ * quasi-Newton update per node, see QuasiNewtonStateCost.
+ */
+class QuasiNewtonStateInputCost final : public StateInputCost {
+ public:
+  /**
+   * Constructor.
+   * @param [in] costPtr: The cost term which only provides gradients.
+   * @param [in] settings: The quasi-Newton settings.
+   */
+  QuasiNewtonStateInputCost(std::unique_ptr<StateInputCost> costPtr, quasi_newton::Settings settings = quasi_newton::Settings());
+
+  ~QuasiNewtonStateInputCost() override = default;
+
+  /** Gets the wrapped cost term. */
+  template <typename Derived = StateInputCost>
+  Derived& get() {
+    static_assert(std::is_base_of<StateInputCost, Derived>::value, "Template argument must derive from StateInputCost");
+    return dynamic_cast<Derived&>(*costPtr_);
+  }
+
+  /** Gets the Hessian estimates, which are shared with the clones of this class. */
+  quasi_newton::QuasiNewtonHessian& getHessianEstimate() { return *hessianPtr_; }
+
+  QuasiNewtonStateInputCost* clone() const override;
+
+  bool isActive(scalar_t time) const override;
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override;
+
+  /** The gradient of the wrapped term, and the updated quasi-Newton Hessian estimate of the node preComp.getNodeIndex(). */
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override;
+
+  ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                  const TargetTrajectories& targetTrajectories,
+                                                                  const PreComputation& preComp) const override;
+
+ private:
+  QuasiNewtonStateInputCost(const QuasiNewtonStateInputCost& other);
+
+  std::unique_ptr<StateInputCost> costPtr_;
+  std::shared_ptr<quasi_newton::QuasiNewtonHessian> hessianPtr_;
+};
+
+}  // namespace ocs2
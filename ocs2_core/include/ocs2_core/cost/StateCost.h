@@ -56,6 +56,33 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Get cost term value and first derivatives. The second-order derivatives of the returned approximation are zero. Cost terms that
+   * only provide gradients, e.g. terms wrapped in a QuasiNewtonStateCost, use this instead of getQuadraticApproximation(). The default
+   * implementation drops the second-order derivatives of getQuadraticApproximation(). Cost terms with expensive Hessians should
+   * override it.
+   */
+  virtual ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                          const TargetTrajectories& targetTrajectories,
+                                                                          const PreComputation& preComp) const {
+    auto approximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    approximation.dfdxx.setZero();
+    return approximation;
+  }
+
+  /**
+   * Adds the cost term quadratic approximation to the state derivatives of the given approximation. The default implementation adds
+   * the result of getQuadraticApproximation(). Cost terms with constant second-order derivatives can override it to add their constant
+   * blocks directly, without creating a temporary approximation.
+   */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                         const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const {
+    const auto costTermApproximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    approximation.f += costTermApproximation.f;
+    approximation.dfdx += costTermApproximation.dfdx;
+    approximation.dfdxx += costTermApproximation.dfdxx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
@@ -51,9 +51,12 @@ class StateCostCppAd : public StateCost {
    * @param modelFolder : Folder where the model library files are saved.
    * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
    * @param verbose : Print information.
+   * @param approximationOrder : The order of the generated derivatives. With the first order, only the value and the gradient are
+   *                             available, see getFirstOrderApproximation().
    */
   void initialize(size_t stateDim, size_t parameterDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
-                  bool recompileLibraries = true, bool verbose = true);
+                  bool recompileLibraries = true, bool verbose = true,
+                  CppAdInterface::ApproximationOrder approximationOrder = CppAdInterface::ApproximationOrder::Second);
 
   /* Get the parameter vector */
   virtual vector_t getParameters(scalar_t time, const TargetTrajectories& targetTrajectories) const { return vector_t(0); };
@@ -64,6 +67,9 @@ class StateCostCppAd : public StateCost {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
+  ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                  const TargetTrajectories& targetTrajectories,
+                                                                  const PreComputation& preComp) const override;
 
  protected:
   StateCostCppAd(const StateCostCppAd& rhs);
@@ -73,6 +79,7 @@ class StateCostCppAd : public StateCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  CppAdInterface::ApproximationOrder approximationOrder_ = CppAdInterface::ApproximationOrder::Second;
 };
 
 }  // namespace ocs2
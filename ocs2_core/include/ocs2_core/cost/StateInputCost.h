@@ -56,6 +56,33 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Get cost term value and first derivatives. The second-order derivatives of the returned approximation are zero. Cost terms that
+   * only provide gradients, e.g. terms wrapped in a QuasiNewtonStateInputCost, use this instead of getQuadraticApproximation(). The
+   * default implementation drops the second-order derivatives of getQuadraticApproximation(). Cost terms with expensive Hessians
+   * should override it.
+   */
+  virtual ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                          const TargetTrajectories& targetTrajectories,
+                                                                          const PreComputation& preComp) const {
+    auto approximation = getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+    approximation.dfdxx.setZero();
+    approximation.dfdux.setZero();
+    approximation.dfduu.setZero();
+    return approximation;
+  }
+
+  /**
+   * Adds the cost term quadratic approximation to the given approximation. The default implementation adds the result of
+   * getQuadraticApproximation(). Cost terms with constant second-order derivatives can override it to add their constant blocks
+   * directly, without creating a temporary approximation.
+   */
+  virtual void addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                         ScalarFunctionQuadraticApproximation& approximation) const {
+    approximation += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
@@ -71,21 +71,11 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
   return vec[ind];
 }
 
+namespace detail {
 /**
- * Get the interval index and interpolation coefficient alpha.
- * Alpha = 1 at the start of the interval and alpha = 0 at the end.
- *
- * @param [in] enquiryTime: The enquiry time for interpolation.
- * @param [in] timeArray: interpolation time array.
- * @return {index, alpha}
+ * Computes the interpolation coefficient alpha for a given interval index as returned by lookup::findIntervalInTimeArray.
  */
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+inline index_alpha_t timeSegmentFromInterval(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int index) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -116,6 +106,44 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
     return {0, scalar_t(1.0)};
   }
 }
+}  // namespace detail
+
+/**
+ * Get the interval index and interpolation coefficient alpha.
+ * Alpha = 1 at the start of the interval and alpha = 0 at the end.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @return {index, alpha}
+ */
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return detail::timeSegmentFromInterval(enquiryTime, timeArray, index);
+}
+
+/**
+ * Same as timeSegment(enquiryTime, timeArray), but the interval lookup starts from the given hint. The hint is updated with the found
+ * interval, such that a monotone sequence of enquiries is resolved in amortized constant time.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] hint: The interval from where the lookup starts. It is set to the found interval on return.
+ * @return {index, alpha}
+ */
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& hint) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  hint = lookup::findIntervalInTimeArray(timeArray, enquiryTime, hint);
+  return detail::timeSegmentFromInterval(enquiryTime, timeArray, hint);
+}
 
 /**
  * Directly uses the index and interpolation coefficient provided by the user
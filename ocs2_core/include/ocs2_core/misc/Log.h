@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <string>
 
+#include <boost/log/core/record.hpp>
+#include <boost/optional.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/sources/severity_logger.hpp>
 
@@ -77,8 +79,17 @@ struct Settings {
   SeverityLevel logFileSeverity = SeverityLevel::INFO;
   /** File name, supports boost log file name pattern including date and time. */
   std::string logFileName = "ocs2_%Y%m%d_%H%M%S.log";
+  /**
+   * Enable the asynchronous backend. The logging thread only formats the message into a fixed-size record of a per-thread lock-free
+   * ring buffer. A background thread passes the records to the sinks. Messages longer than maxAsyncMessageLength are truncated and the
+   * records are dropped if the ring buffer of the thread is full.
+   */
+  bool asynchronous = false;
 };
 
+/** Maximum length of a message in the asynchronous backend. */
+constexpr size_t maxAsyncMessageLength = 239;
+
 /**
  * Load log settings from file
  * @param [in] fileName: settings file name
@@ -96,12 +107,49 @@ void init(const Settings& settings, std::ostream* console_stream = &std::clog);
 /** Reset OCS2 logger sinks */
 void reset();
 
+/** Waits until the records of the asynchronous backend are passed to the sinks. It has no effect in the synchronous mode. */
+void flush();
+
 /**
  * Get global OCS2 logger
  * @return global logger reference
  */
 logger_t& getLogger();
 
+namespace detail {
+
+struct AsyncRecord;
+
+/**
+ * Collects the message of one OCS2_LOG statement. In the synchronous mode, the message is written to a boost-log record of getLogger().
+ * In the asynchronous mode, it is written directly into a slot of the ring buffer of the calling thread.
+ */
+class RecordPump {
+ public:
+  explicit RecordPump(SeverityLevel severity);
+  ~RecordPump() = default;
+  RecordPump(const RecordPump&) = delete;
+  RecordPump& operator=(const RecordPump&) = delete;
+
+  /** Whether the record passes the severity filter and the message should be streamed. */
+  explicit operator bool() const { return active_; }
+
+  /** The stream of the message. */
+  std::ostream& stream() { return *streamPtr_; }
+
+  /** Pushes the record to the sinks or to the asynchronous backend. */
+  void commit();
+
+ private:
+  bool active_ = false;
+  std::ostream* streamPtr_ = nullptr;
+  AsyncRecord* asyncRecordPtr_ = nullptr;
+  boost::log::record record_;
+  boost::optional<boost::log::record_ostream> recordStream_;
+};
+
+}  // namespace detail
+
 /**
  * Logging helper macro
  *
@@ -109,8 +157,10 @@ logger_t& getLogger();
  * OCS2_LOG(INFO) << "Hello, world!";
  * \endcode
  */
-#define OCS2_LOG(LVL) \
-  BOOST_LOG_STREAM_WITH_PARAMS(::ocs2::log::getLogger(), (::boost::log::keywords::severity = ::ocs2::log::SeverityLevel::LVL))
+#define OCS2_LOG(LVL)                                                                                                  \
+  for (::ocs2::log::detail::RecordPump ocs2_log_record_pump(::ocs2::log::SeverityLevel::LVL); ocs2_log_record_pump; \
+       ocs2_log_record_pump.commit())                                                                                  \
+  ocs2_log_record_pump.stream()
 
 /* Compact helper macros */
 #define OCS2_DEBUG OCS2_LOG(DEBUG)
@@ -91,6 +91,46 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ *  Same as findIndexInTimeArray, but the search starts from a hint index and gallops (exponential search) from there towards the
+ *  result. For a sequence of monotone enquiries where the hint is the result of the previous lookup, the cost is O(log(d)) with d the
+ *  distance between two consecutive results, instead of O(log(size(timeArray))).
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param hint : index from where the search starts. It is clamped to [0, size(timeArray)], therefore any value is safe.
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int hint) {
+  const auto size = static_cast<int>(timeArray.size());
+  hint = std::min(std::max(hint, 0), size);
+
+  int lower, upper;  // the result is in [lower, upper]
+  int step = 1;
+  if (hint < size && timeArray[hint] < time) {
+    // search forward: all indices before lower are smaller than time
+    lower = hint + 1;
+    while (lower + step - 1 < size && timeArray[lower + step - 1] < time) {
+      lower += step;
+      step *= 2;
+    }
+    upper = std::min(lower + step - 1, size);
+  } else {
+    // search backward: all indices from upper on are not smaller than time
+    upper = hint;
+    while (upper - step >= 0 && !(timeArray[upper - step] < time)) {
+      upper -= step;
+      step *= 2;
+    }
+    lower = std::max(upper - step + 1, 0);
+  }
+
+  auto firstLargerValueIterator = std::lower_bound(timeArray.begin() + lower, timeArray.begin() + upper, time);
+  return static_cast<int>(firstLargerValueIterator - timeArray.begin());
+}
+
 /**
  *  Find interval into a sorted time Array
  *
@@ -115,6 +155,24 @@ int findIntervalInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   }
 }
 
+/**
+ *  Same as findIntervalInTimeArray, but the search starts from a hint interval. See findIndexInTimeArray(timeArray, time, hint).
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param hint : interval from where the search starts, e.g. the result of the previous lookup.
+ * @return interval between [-1, size(timeArray)-1]
+ */
+template <typename SCALAR = double>
+int findIntervalInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int hint) {
+  if (!timeArray.empty()) {
+    return findIndexInTimeArray(timeArray, time, hint + 1) - 1;
+  } else {
+    return 0;
+  }
+}
+
 /**
  * Same as findIntervalInTimeArray except for 1 rule:
  * if t = t0, a 0 is returned instead of -1
@@ -79,6 +79,10 @@ struct ModelData {
   int stateDim_ = 0;
   int inputDim_ = 0;
 
+  // Index of the active mode in ModeSchedule::modeSequence at time_, i.e. the index which ModeSchedule::modeAtTime() looks up. It is
+  // precomputed once per rollout and passed to the evaluated terms through PreComputation::setModeIndex().
+  size_t eventIndex_ = 0;
+
   // dynamics
   VectorFunctionLinearApproximation dynamics_;
   vector_t dynamicsBias_;
@@ -66,6 +66,17 @@ struct ModeSchedule {
    */
   size_t modeAtTime(scalar_t time) const;
 
+  /**
+   *  Same as modeAtTime(time), but the lookup starts from a cursor, see lookup::findIndexInTimeArray(timeArray, time, hint). For
+   *  monotone inquiries, e.g. along a time trajectory, the cost is amortized constant instead of logarithmic in the number of events.
+   *  Each thread should keep its own cursor, which can be initialized to any value, e.g. zero.
+   *
+   *  @param [in] time: The inquiry time.
+   *  @param [in, out] cursor: The index of the mode in modeSequence from where the lookup starts. It is set to the found index.
+   *  @return the associated mode for the input time.
+   */
+  size_t modeAtTime(scalar_t time, int& cursor) const;
+
   std::vector<scalar_t> eventTimes;  // event times of size N - 1
   std::vector<size_t> modeSequence;  // mode sequence of size N
 };
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <ostream>
 
 #include "ocs2_core/Types.h"
@@ -49,12 +50,66 @@ struct TargetTrajectories {
   bool operator==(const TargetTrajectories& other);
   bool operator!=(const TargetTrajectories& other) { return !(*this == other); }
 
+  /**
+   * Returns the interpolated desired state at the given time. The lookup starts from the interval of the previous enquiry, therefore
+   * evaluating the reference along a monotone time grid is amortized constant time.
+   * @note: The method is thread-safe w.r.t. other const methods.
+   */
   vector_t getDesiredState(scalar_t time) const;
+
+  /**
+   * Returns the interpolated desired input at the given time. See getDesiredState().
+   */
   vector_t getDesiredInput(scalar_t time) const;
 
+  /**
+   * Appends the given points to the end of the trajectories in place. The existing points at or after the first appended time are
+   * replaced by the new ones, hence the appended segment can overlap with the tail of the current trajectories.
+   *
+   * @param [in] timePoints: The appended time points. They should be sorted in ascending order.
+   * @param [in] statePoints: The appended state points.
+   * @param [in] inputPoints: The appended input points. It can only be empty if the current inputTrajectory is empty as well.
+   */
+  void append(const scalar_array_t& timePoints, const vector_array_t& statePoints, const vector_array_t& inputPoints = vector_array_t());
+
+  /** Appends the points of other TargetTrajectories. See append(timePoints, statePoints, inputPoints). */
+  void append(const TargetTrajectories& other) { append(other.timeTrajectory, other.stateTrajectory, other.inputTrajectory); }
+
+  /**
+   * Removes the leading points which do not influence the interpolation at or after the given time, i.e. all points before the last
+   * point at or before the given time. The removal is lazy: the obsolete points are only erased once they are at least as many as the
+   * retained points, hence a receding reference which is trimmed every cycle is trimmed in amortized constant time per point and never
+   * holds more than twice the required points. The capacity of the trajectories is retained so that a subsequent append does not
+   * reallocate.
+   *
+   * @param [in] time: The earliest time that will be queried after the trim.
+   * @return The number of removed points.
+   */
+  size_t trimBefore(scalar_t time);
+
+  /**
+   * Shifts all the time points by the given offset.
+   * @param [in] timeShift: The time offset.
+   */
+  void shiftTime(scalar_t timeShift);
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
+
+ private:
+  /** The interval of the last lookup. It is shared among the concurrent readers, hence atomic. */
+  struct LookupHint {
+    LookupHint() = default;
+    LookupHint(const LookupHint& rhs) : interval(rhs.interval.load(std::memory_order_relaxed)) {}
+    LookupHint& operator=(const LookupHint& rhs) {
+      interval.store(rhs.interval.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      return *this;
+    }
+    std::atomic_int interval{0};
+  };
+
+  mutable LookupHint lookupHint_;
 };
 
 void swap(TargetTrajectories& lh, TargetTrajectories& rh);
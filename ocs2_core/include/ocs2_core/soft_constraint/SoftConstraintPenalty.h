@@ -97,9 +97,69 @@ class SoftConstraintPenalty {
    */
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h) const;
 
+  /**
+   * Get the value and the first derivatives of the penalty cost. The second-order derivatives are set to zero.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint linear approximation.
+   * @return The penalty cost approximation with zero second-order derivatives.
+   */
+  ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t t, const VectorFunctionLinearApproximation& h) const;
+
+  /**
+   * Selects the constraints for the active-set-aware lazy linearization. A constraint is considered active if its value is smaller
+   * than the margin. The remaining constraints are only required if their penalty derivative is nonzero, since they only contribute
+   * to the gradient of the penalty cost.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: Vector of inequality constraint values.
+   * @param [in] margin: The activity margin.
+   * @return The indices of the active constraints and the indices of the inactive constraints with a nonzero penalty derivative.
+   */
+  std::pair<size_array_t, size_array_t> getLazyLinearizationRows(scalar_t t, const vector_t& h, scalar_t margin) const;
+
+  /**
+   * Get the derivative of the penalty cost for the lazy linearization.
+   * The penalty cost is evaluated on all the constraints. The chain rule is only applied to the selected constraints where the
+   * curvature terms of the inactive constraints are dropped.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: Vector of all inequality constraint values.
+   * @param [in] rows: The indices of the selected constraints. The first numActiveRows of them are the active constraints.
+   * @param [in] numActiveRows: The number of active constraints.
+   * @param [in] hRows: The linear approximation of the selected constraints.
+   * @return The penalty cost quadratic approximation.
+   */
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& h, const size_array_t& rows,
+                                                                 size_t numActiveRows,
+                                                                 const VectorFunctionLinearApproximation& hRows) const;
+
+  /**
+   * Get the derivative of the penalty cost for the lazy linearization.
+   * The penalty cost is evaluated on all the constraints. The chain rule is only applied to the selected constraints where the
+   * curvature terms of the inactive constraints are dropped.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: Vector of all inequality constraint values.
+   * @param [in] activeRows: The indices of the active constraints.
+   * @param [in] hActive: The quadratic approximation of the active constraints.
+   * @param [in] inactiveRows: The indices of the inactive constraints that contribute to the gradient.
+   * @param [in] hInactive: The linear approximation of the inactive constraints. Not used if inactiveRows is empty.
+   * @return The penalty cost quadratic approximation.
+   */
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& h, const size_array_t& activeRows,
+                                                                 const VectorFunctionQuadraticApproximation& hActive,
+                                                                 const size_array_t& inactiveRows,
+                                                                 const VectorFunctionLinearApproximation& hInactive) const;
+
  private:
   std::tuple<scalar_t, vector_t, vector_t> getPenaltyValue1stDev2ndDev(scalar_t t, const vector_t& h) const;
 
+  /** Gets the penalty function of the i-th constraint. */
+  const PenaltyBase& getPenalty(size_t i) const {
+    return (penaltyPtrArray_.size() == 1) ? *penaltyPtrArray_.front() : *penaltyPtrArray_[i];
+  }
+
   std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray_;
 };
 
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
 #include <memory>
 
 #include <ocs2_core/Types.h>
@@ -51,6 +52,11 @@ namespace ocs2 {
  *
  *   A few commonly-used penalty functions have been provided by the toolbox such as Relaxed-Barrier and Squared-Hinge
  *   penalty functions.
+ *
+ *   For a finite activity margin, the approximation is computed lazily: the constraint values are evaluated first and only the
+ *   constraints with \f$ h_i < margin \f$ are fully approximated. The remaining constraints contribute their value and gradient
+ *   while their curvature terms are dropped, and they are not linearized at all if their penalty derivative is zero. For the
+ *   Squared-Hinge penalty with margin >= delta this is exact.
  */
 class StateInputSoftConstraint final : public StateInputCost {
  public:
@@ -58,16 +64,20 @@ class StateInputSoftConstraint final : public StateInputCost {
    * Constructor.
    * @param [in] constraintPtr: A pointer to the constraint which will be enforced as soft constraints.
    * @param [in] penaltyPtrArray: An array of pointers to the penalty function on the constraint.
+   * @param [in] activityMargin: The margin of the lazy linearization. It is disabled for an infinite margin.
    */
-  StateInputSoftConstraint(std::unique_ptr<StateInputConstraint> constraintPtr, std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray);
+  StateInputSoftConstraint(std::unique_ptr<StateInputConstraint> constraintPtr, std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray,
+                           scalar_t activityMargin = std::numeric_limits<scalar_t>::infinity());
 
   /**
    * Constructor.
    * @note This allows a varying number of constraints and uses the same penalty function for each constraint.
    * @param [in] constraintPtr: A pointer to the constraint which will be enforced as soft constraints.
    * @param [in] penaltyFunction: A pointer to the penalty function on the constraint.
+   * @param [in] activityMargin: The margin of the lazy linearization. It is disabled for an infinite margin.
    */
-  StateInputSoftConstraint(std::unique_ptr<StateInputConstraint> constraintPtr, std::unique_ptr<PenaltyBase> penaltyFunction);
+  StateInputSoftConstraint(std::unique_ptr<StateInputConstraint> constraintPtr, std::unique_ptr<PenaltyBase> penaltyFunction,
+                           scalar_t activityMargin = std::numeric_limits<scalar_t>::infinity());
 
   ~StateInputSoftConstraint() override = default;
 
@@ -89,11 +99,20 @@ class StateInputSoftConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /** Only the linear approximation of the constraint is evaluated, regardless of its order. */
+  ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                  const TargetTrajectories& /* targetTrajectories */,
+                                                                  const PreComputation& preComp) const override;
+
  private:
   StateInputSoftConstraint(const StateInputSoftConstraint& other);
 
+  ScalarFunctionQuadraticApproximation getLazyQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                     const PreComputation& preComp) const;
+
   std::unique_ptr<StateInputConstraint> constraintPtr_;
   SoftConstraintPenalty penalty_;
+  scalar_t activityMargin_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * A thread-safe free list of heap-allocated objects. Instead of being destroyed, a retired object is returned to the pool and it is
+ * handed out again by the next acquire() call with its memory intact, e.g. the capacity of its std::vector and the storage of its Eigen
+ * members. If the user overwrites such an object in place with data of the same size, the steady-state reuse does not allocate or
+ * deallocate memory on the heap.
+ *
+ * The pool holds at most maxNumObjects objects, such that the memory does not grow if more objects are released than acquired. The
+ * storage of the free list is reserved at construction, therefore acquire() and release() do not allocate unless the pool is empty.
+ *
+ * @tparam T : pooled type, which should be default constructible.
+ */
+template <typename T>
+class ObjectPool {
+ public:
+  /**
+   * Constructor
+   * @param [in] maxNumObjects: Maximum number of the retired objects which are kept in the pool.
+   */
+  explicit ObjectPool(size_t maxNumObjects = 2) : maxNumObjects_(maxNumObjects) { freeList_.reserve(maxNumObjects_); }
+
+  /** Returns a retired object if there is any, otherwise a new default-constructed object. The content of a retired object is stale. */
+  std::unique_ptr<T> acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!freeList_.empty()) {
+        std::unique_ptr<T> objectPtr = std::move(freeList_.back());
+        freeList_.pop_back();
+        return objectPtr;
+      }
+    }
+    return std::unique_ptr<T>(new T());
+  }
+
+  /** Returns a retired object to the pool. If the pool is full the object is destroyed, outside the lock. */
+  void release(std::unique_ptr<T> objectPtr) {
+    if (objectPtr == nullptr) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (freeList_.size() < maxNumObjects_) {
+      freeList_.push_back(std::move(objectPtr));
+    }
+  }
+
+  /** Destroys all the objects in the pool. */
+  void clear() {
+    std::vector<std::unique_ptr<T>> freeList;
+    freeList.reserve(maxNumObjects_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      freeList_.swap(freeList);
+    }
+  }
+
+  /** Number of the objects which are available in the pool. */
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return freeList_.size();
+  }
+
+ private:
+  const size_t maxNumObjects_;
+  std::vector<std::unique_ptr<T>> freeList_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace ocs2
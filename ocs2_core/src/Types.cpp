@@ -144,6 +144,21 @@ std::ostream& operator<<(std::ostream& out, const VectorFunctionLinearApproximat
   return out;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation extractRows(const VectorFunctionLinearApproximation& f, const size_array_t& rows) {
+  VectorFunctionLinearApproximation g(rows.size(), f.dfdx.cols(), f.dfdu.cols());
+  for (size_t k = 0; k < rows.size(); k++) {
+    g.f(k) = f.f(rows[k]);
+    g.dfdx.row(k) = f.dfdx.row(rows[k]);
+    if (f.dfdu.cols() > 0) {
+      g.dfdu.row(k) = f.dfdu.row(rows[k]);
+    }
+  }
+  return g;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -215,4 +230,30 @@ std::ostream& operator<<(std::ostream& out, const VectorFunctionQuadraticApproxi
   return out;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionQuadraticApproximation extractRows(const VectorFunctionQuadraticApproximation& f, const size_array_t& rows) {
+  // state-only approximations may leave the input derivatives empty
+  const bool hasInput = f.dfdu.cols() > 0;
+  VectorFunctionQuadraticApproximation g;
+  g.f.resize(rows.size());
+  g.dfdx.resize(rows.size(), f.dfdx.cols());
+  g.dfdu.resize(rows.size(), f.dfdu.cols());
+  g.dfdxx.reserve(rows.size());
+  g.dfdux.reserve(rows.size());
+  g.dfduu.reserve(rows.size());
+  for (size_t k = 0; k < rows.size(); k++) {
+    g.f(k) = f.f(rows[k]);
+    g.dfdx.row(k) = f.dfdx.row(rows[k]);
+    g.dfdxx.push_back(f.dfdxx[rows[k]]);
+    if (hasInput) {
+      g.dfdu.row(k) = f.dfdu.row(rows[k]);
+      g.dfdux.push_back(f.dfdux[rows[k]]);
+      g.dfduu.push_back(f.dfduu[rows[k]]);
+    }
+  }
+  return g;
+}
+
 }  // namespace ocs2
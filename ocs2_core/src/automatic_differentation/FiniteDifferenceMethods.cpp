@@ -43,20 +43,24 @@ matrix_t finiteDifferenceDerivative(std::function<vector_t(const vector_t&)> f,
   const size_t stateDim = f0.rows();
   matrix_t jacobian(stateDim, varDim);
 
+  // the variable is perturbed in place and restored after each column
+  vector_t x = x0;
   for (size_t i = 0; i < varDim; i++) {
     // inspired from: http://en.wikipedia.org/wiki/Numerical_differentiation#Practical_considerations_using_floating_point_arithmetic
     scalar_t h = eps * std::max(fabs(x0(i)), 1.0);
 
-    vector_t xPlus = x0;
-    xPlus(i) += h;
+    x(i) = x0(i) + h;
+    jacobian.col(i) = f(x);
 
     if (doubleSidedDerivative) {
-      vector_t xMinus = x0;
-      xMinus(i) -= h;
-      jacobian.col(i) = (f(xPlus) - f(xMinus)) / (2.0 * h);
+      x(i) = x0(i) - h;
+      jacobian.col(i) -= f(x);
+      jacobian.col(i) /= 2.0 * h;
     } else {
-      jacobian.col(i) = (f(xPlus) - f0) / h;
+      jacobian.col(i) -= f0;
+      jacobian.col(i) /= h;
     }
+    x(i) = x0(i);
   }
 
   return jacobian;
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/ParallelFiniteDifference.h>
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ParallelFiniteDifference::ParallelFiniteDifference(const ControlledSystemBase& system, size_t nThreads, scalar_t eps,
+                                                   bool doubleSidedDerivative, bool isSecondOrderSystem, int threadPriority)
+    : eps_(eps),
+      doubleSidedDerivative_(doubleSidedDerivative),
+      isSecondOrderSystem_(isSecondOrderSystem),
+      threadPool_(std::max(nThreads, size_t(1)) - 1, threadPriority),
+      workerBufferStock_(std::max(nThreads, size_t(1))) {
+  systemPtrStock_.reserve(workerBufferStock_.size());
+  for (size_t i = 0; i < workerBufferStock_.size(); i++) {
+    systemPtrStock_.emplace_back(system.clone());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const VectorFunctionLinearApproximation& ParallelFiniteDifference::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
+  if (isCacheValid_ && t == cachedTime_ && x == cachedState_ && u == cachedInput_) {
+    return linearApproximation_;
+  }
+
+  // the caller runs as the last worker
+  linearApproximation_.f = systemPtrStock_.back()->computeFlowMap(t, x, u);
+  linearApproximation_.dfdx.resize(linearApproximation_.f.rows(), x.rows());
+  linearApproximation_.dfdu.resize(linearApproximation_.f.rows(), u.rows());
+
+  nextColumnId_ = 0;
+  auto task = [&](int workerIndex) { computeColumns(workerIndex, t, x, u); };
+  threadPool_.runParallel(task, getNumThreads());
+
+  if (isSecondOrderSystem_) {
+    // Assumes state vector = [x, x_dot]
+    const auto halfDim = x.rows() / 2;
+    linearApproximation_.dfdx.topLeftCorner(halfDim, halfDim).setZero();
+    linearApproximation_.dfdx.topRightCorner(halfDim, halfDim).setIdentity();
+    linearApproximation_.dfdu.topRows(halfDim).setZero();
+  }
+
+  isCacheValid_ = true;
+  cachedTime_ = t;
+  cachedState_ = x;
+  cachedInput_ = u;
+  return linearApproximation_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelFiniteDifference::computeColumns(size_t workerIndex, scalar_t t, const vector_t& x, const vector_t& u) {
+  auto& system = *systemPtrStock_[workerIndex];
+  auto& buffer = workerBufferStock_[workerIndex];
+  buffer.state = x;
+  buffer.input = u;
+
+  const size_t stateDim = x.rows();
+  const size_t numColumns = stateDim + u.rows();
+  size_t columnId;
+  while ((columnId = nextColumnId_++) < numColumns) {
+    if (columnId < stateDim) {
+      computeColumn(system, t, buffer, buffer.state, columnId, linearApproximation_.dfdx.col(columnId));
+    } else {
+      computeColumn(system, t, buffer, buffer.input, columnId - stateDim, linearApproximation_.dfdu.col(columnId - stateDim));
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelFiniteDifference::computeColumn(ControlledSystemBase& system, scalar_t t, WorkerBuffer& buffer, vector_t& var, size_t index,
+                                             Eigen::Ref<vector_t> column) const {
+  // inspired from: http://en.wikipedia.org/wiki/Numerical_differentiation#Practical_considerations_using_floating_point_arithmetic
+  const scalar_t value = var(index);
+  const scalar_t h = eps_ * std::max(std::abs(value), 1.0);
+
+  var(index) = value + h;
+  column = system.computeFlowMap(t, buffer.state, buffer.input);
+  if (doubleSidedDerivative_) {
+    var(index) = value - h;
+    column -= system.computeFlowMap(t, buffer.state, buffer.input);
+    column /= 2.0 * h;
+  } else {
+    column -= linearApproximation_.f;
+    column /= h;
+  }
+  var(index) = value;
+}
+
+}  // namespace ocs2
@@ -72,4 +72,33 @@ VectorFunctionLinearApproximation LinearStateConstraint::getLinearApproximation(
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t LinearStateConstraint::insertLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&, size_t startRow,
+                                                        VectorFunctionLinearApproximation& approximation) const {
+  const size_t nc = h_.rows();
+  auto f = approximation.f.segment(startRow, nc);
+  f = h_;
+  f.noalias() += F_ * x;
+  approximation.dfdx.middleRows(startRow, nc) = F_;
+  return nc;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation LinearStateConstraint::getPartialLinearApproximation(scalar_t t, const vector_t& x,
+                                                                                       const size_array_t& rows,
+                                                                                       const PreComputation&) const {
+  VectorFunctionLinearApproximation g;
+  g.f.resize(rows.size());
+  g.dfdx.resize(rows.size(), F_.cols());
+  for (size_t k = 0; k < rows.size(); k++) {
+    g.dfdx.row(k) = F_.row(rows[k]);
+    g.f(k) = h_(rows[k]) + F_.row(rows[k]).dot(x);
+  }
+  return g;
+}
+
 }  // namespace ocs2
@@ -75,4 +75,34 @@ VectorFunctionLinearApproximation LinearStateInputConstraint::getLinearApproxima
   return g;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t LinearStateInputConstraint::insertLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                                             size_t startRow, VectorFunctionLinearApproximation& approximation) const {
+  const size_t nc = e_.rows();
+  auto f = approximation.f.segment(startRow, nc);
+  f = e_;
+  f.noalias() += C_ * x;
+  f.noalias() += D_ * u;
+  approximation.dfdx.middleRows(startRow, nc) = C_;
+  approximation.dfdu.middleRows(startRow, nc) = D_;
+  return nc;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation LinearStateInputConstraint::getPartialLinearApproximation(scalar_t t, const vector_t& x,
+                                                                                            const vector_t& u, const size_array_t& rows,
+                                                                                            const PreComputation&) const {
+  VectorFunctionLinearApproximation g(rows.size(), C_.cols(), D_.cols());
+  for (size_t k = 0; k < rows.size(); k++) {
+    g.dfdx.row(k) = C_.row(rows[k]);
+    g.dfdu.row(k) = D_.row(rows[k]);
+    g.f(k) = e_(rows[k]) + C_.row(rows[k]).dot(x) + D_.row(rows[k]).dot(u);
+  }
+  return g;
+}
+
 }  // namespace ocs2
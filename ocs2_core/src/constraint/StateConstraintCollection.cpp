@@ -90,11 +90,7 @@ VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximat
   size_t i = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      i += nc;
+      i += constraintTerm->insertLinearApproximation(time, state, preComp, i, linearApproximation);
     }
   }
 
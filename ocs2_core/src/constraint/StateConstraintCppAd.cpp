@@ -124,4 +124,50 @@ VectorFunctionQuadraticApproximation StateConstraintCppAd::getQuadraticApproxima
   return constraint;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation StateConstraintCppAd::getPartialLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                      const size_array_t& rows,
+                                                                                      const PreComputation& preComp) const {
+  return extractRows(getLinearApproximation(time, state, preComp), rows);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionQuadraticApproximation StateConstraintCppAd::getPartialQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                            const size_array_t& rows,
+                                                                                            const PreComputation&) const {
+  if (getOrder() != ConstraintOrder::Quadratic) {
+    throw std::runtime_error("[StateConstraintCppAd] Quadratic approximation not supported!");
+  }
+
+  VectorFunctionQuadraticApproximation constraint;
+
+  const size_t stateDim = state.rows();
+  const vector_t params = getParameters(time);
+  vector_t tapedTimeState(1 + stateDim);
+  tapedTimeState << time, state;
+
+  const vector_t f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
+
+  const size_t numRows = rows.size();
+  constraint.f.resize(numRows);
+  constraint.dfdx.resize(numRows, stateDim);
+  constraint.dfdxx.resize(numRows);
+  constraint.dfdux.resize(numRows);
+  constraint.dfduu.resize(numRows);
+  for (size_t k = 0; k < numRows; k++) {
+    const auto i = rows[k];
+    constraint.f(k) = f(i);
+    constraint.dfdx.row(k) = J.block(i, 1, 1, stateDim);
+    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeState, params);
+    constraint.dfdxx[k] = H.bottomRightCorner(stateDim, stateDim);
+  }
+
+  return constraint;
+}
+
 }  // namespace ocs2
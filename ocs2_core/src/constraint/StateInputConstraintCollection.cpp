@@ -93,12 +93,7 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
   size_t i = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
-      i += nc;
+      i += constraintTerm->insertLinearApproximation(time, state, input, preComp, i, linearApproximation);
     }
   }
 
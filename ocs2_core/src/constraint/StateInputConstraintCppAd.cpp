@@ -132,4 +132,56 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   return constraint;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation StateInputConstraintCppAd::getPartialLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                           const vector_t& input, const size_array_t& rows,
+                                                                                           const PreComputation& preComp) const {
+  return extractRows(getLinearApproximation(time, state, input, preComp), rows);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getPartialQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                                 const vector_t& input,
+                                                                                                 const size_array_t& rows,
+                                                                                                 const PreComputation&) const {
+  if (getOrder() != ConstraintOrder::Quadratic) {
+    throw std::runtime_error("[StateInputConstraintCppAd] Quadratic approximation not supported!");
+  }
+
+  VectorFunctionQuadraticApproximation constraint;
+
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const vector_t params = getParameters(time);
+  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+  tapedTimeStateInput << time, state, input;
+
+  const vector_t f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+
+  const size_t numRows = rows.size();
+  constraint.f.resize(numRows);
+  constraint.dfdx.resize(numRows, stateDim);
+  constraint.dfdu.resize(numRows, inputDim);
+  constraint.dfdxx.resize(numRows);
+  constraint.dfdux.resize(numRows);
+  constraint.dfduu.resize(numRows);
+  for (size_t k = 0; k < numRows; k++) {
+    const auto i = rows[k];
+    constraint.f(k) = f(i);
+    constraint.dfdx.row(k) = J.block(i, 1, 1, stateDim);
+    constraint.dfdu.row(k) = J.block(i, 1 + stateDim, 1, inputDim);
+    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
+    constraint.dfdxx[k] = H.block(1, 1, stateDim, stateDim);
+    constraint.dfdux[k] = H.block(1 + stateDim, 1, inputDim, stateDim);
+    constraint.dfduu[k] = H.bottomRightCorner(inputDim, inputDim);
+  }
+
+  return constraint;
+}
+
 }  // namespace ocs2
@@ -129,13 +129,22 @@ void FeedforwardController::flattenSingle(scalar_t time, std::vector<float>& fla
 /******************************************************************************************************/
 FeedforwardController FeedforwardController::unFlatten(const scalar_array_t& timeArray,
                                                        const std::vector<std::vector<float> const*>& flatArray2) {
-  vector_array_t uffArray;
-  uffArray.reserve(flatArray2.size());
+  FeedforwardController controller;
+  unFlatten(timeArray, flatArray2, controller);
+  return controller;
+}
 
-  for (const auto& arr : flatArray2) {  // loop through time
-    uffArray.emplace_back(Eigen::Map<const Eigen::VectorXf>(arr->data(), arr->size()).cast<scalar_t>());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedforwardController::unFlatten(const scalar_array_t& timeArray, const std::vector<std::vector<float> const*>& flatArray2,
+                                      FeedforwardController& controller) {
+  controller.timeStamp_ = timeArray;
+  controller.uffArray_.resize(flatArray2.size());
+  for (size_t k = 0; k < flatArray2.size(); k++) {  // loop through time
+    const auto& arr = *flatArray2[k];
+    controller.uffArray_[k] = Eigen::Map<const Eigen::VectorXf>(arr.data(), arr.size()).cast<scalar_t>();
   }
-  return FeedforwardController(timeArray, std::move(uffArray));
 }
 
 /******************************************************************************************************/
@@ -27,7 +27,9 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <utility>
 
 #include <ocs2_core/control/LinearController.h>
@@ -39,6 +41,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 LinearController::LinearController(const LinearController& other) : LinearController(other.timeStamp_, other.biasArray_, other.gainArray_) {
   deltaBiasArray_ = other.deltaBiasArray_;
+  gainCompression_ = other.gainCompression_;
+  gainIndices_ = other.gainIndices_;
 }
 
 /******************************************************************************************************/
@@ -71,6 +75,8 @@ void LinearController::setController(const scalar_array_t& controllerTime, const
   timeStamp_ = controllerTime;
   biasArray_ = controllerBias;
   gainArray_ = controllerGain;
+  gainCompression_ = GainCompression::None;
+  gainIndices_.clear();
 }
 
 /******************************************************************************************************/
@@ -80,7 +86,7 @@ vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
   const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
 
   vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+  const matrix_t k = gainsCompressed() ? interpolateCompressedGain(indexAlpha) : LinearInterpolation::interpolate(indexAlpha, gainArray_);
 
   uff.noalias() += k * x;
   return uff;
@@ -130,7 +136,7 @@ void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArra
 
   const auto indexAlpha = LinearInterpolation::timeSegment(time, timeStamp_);
   const vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+  const matrix_t k = gainsCompressed() ? interpolateCompressedGain(indexAlpha) : LinearInterpolation::interpolate(indexAlpha, gainArray_);
 
   const size_t stateDim = k.cols();
   const size_t inputDim = k.rows();
@@ -151,27 +157,43 @@ void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArra
 /******************************************************************************************************/
 LinearController LinearController::unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
                                              const std::vector<std::vector<float> const*>& flatArray2) {
-  vector_array_t bias;
-  matrix_array_t gain;
-
-  bias.reserve(flatArray2.size());
-  gain.reserve(flatArray2.size());
+  LinearController controller;
+  unFlatten(stateDim, inputDim, timeArray, flatArray2, controller);
+  return controller;
+}
 
-  for (int k = 0; k < timeArray.size(); k++) {  // loop through time
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
+                                 const std::vector<std::vector<float> const*>& flatArray2, LinearController& controller) {
+  for (int k = 0; k < timeArray.size(); k++) {
     if (flatArray2[k]->size() != inputDim[k] + inputDim[k] * stateDim[k]) {
       throw std::runtime_error("LinearController::unFlatten received array of wrong length.");
     }
+  }
+
+  // a compressed controller is overwritten, no need to decompress it
+  if (controller.gainsCompressed()) {
+    controller.clear();
+  }
+  controller.timeStamp_ = timeArray;
+  controller.biasArray_.resize(timeArray.size());
+  controller.gainArray_.resize(timeArray.size());
+  controller.deltaBiasArray_.clear();
 
-    bias.emplace_back(vector_t(inputDim[k]));
-    gain.emplace_back(matrix_t(inputDim[k], stateDim[k]));
+  for (int k = 0; k < timeArray.size(); k++) {  // loop through time
+    auto& bias = controller.biasArray_[k];
+    auto& gain = controller.gainArray_[k];
+    bias.resize(inputDim[k]);
+    gain.resize(inputDim[k], stateDim[k]);
 
     const auto& arr = *flatArray2[k];
     for (int i = 0; i < inputDim[k]; i++) {  // loop through input dim
-      bias.back()(i) = static_cast<scalar_t>(arr[i * (stateDim[k] + 1) + 0]);
-      gain.back().row(i) = Eigen::Map<const Eigen::VectorXf>(&(arr[i * (stateDim[k] + 1) + 1]), stateDim[k]).cast<scalar_t>();
+      bias(i) = static_cast<scalar_t>(arr[i * (stateDim[k] + 1) + 0]);
+      gain.row(i) = Eigen::Map<const Eigen::VectorXf>(&(arr[i * (stateDim[k] + 1) + 1]), stateDim[k]).cast<scalar_t>();
     }
   }
-  return LinearController(timeArray, std::move(bias), std::move(gain));
 }
 
 /******************************************************************************************************/
@@ -182,10 +204,18 @@ void LinearController::concatenate(const ControllerBase* nextController, int ind
     if (!timeStamp_.empty() && timeStamp_.back() > nextLinCtrl->timeStamp_.front()) {
       throw std::runtime_error("Concatenate requires that the nextController comes later in time.");
     }
+    decompressGains();
     int last = index + length;
     timeStamp_.insert(timeStamp_.end(), nextLinCtrl->timeStamp_.begin() + index, nextLinCtrl->timeStamp_.begin() + last);
     biasArray_.insert(biasArray_.end(), nextLinCtrl->biasArray_.begin() + index, nextLinCtrl->biasArray_.begin() + last);
-    gainArray_.insert(gainArray_.end(), nextLinCtrl->gainArray_.begin() + index, nextLinCtrl->gainArray_.begin() + last);
+    if (nextLinCtrl->gainsCompressed()) {
+      for (int k = index; k < last; k++) {
+        gainArray_.emplace_back();
+        nextLinCtrl->getCompressedGain(k, gainArray_.back());
+      }
+    } else {
+      gainArray_.insert(gainArray_.end(), nextLinCtrl->gainArray_.begin() + index, nextLinCtrl->gainArray_.begin() + last);
+    }
 
     // deltaBiasArray can be of different, incompatible size.
     if (last < nextLinCtrl->deltaBiasArray_.size()) {
@@ -220,6 +250,8 @@ void LinearController::clear() {
   timeStamp_.clear();
   biasArray_.clear();
   gainArray_.clear();
+  gainCompression_ = GainCompression::None;
+  gainIndices_.clear();
 }
 
 /******************************************************************************************************/
@@ -240,7 +272,11 @@ void LinearController::display() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LinearController::getFeedbackGain(scalar_t time, matrix_t& gain) const {
-  gain = LinearInterpolation::interpolate(time, timeStamp_, gainArray_);
+  if (gainsCompressed()) {
+    gain = interpolateCompressedGain(LinearInterpolation::timeSegment(time, timeStamp_));
+  } else {
+    gain = LinearInterpolation::interpolate(time, timeStamp_, gainArray_);
+  }
 }
 
 /******************************************************************************************************/
@@ -250,6 +286,153 @@ void LinearController::getBias(scalar_t time, vector_t& bias) const {
   bias = LinearInterpolation::interpolate(time, timeStamp_, biasArray_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const matrix_array_t& LinearController::gainArray() const {
+  if (gainsCompressed()) {
+    throw std::runtime_error("[LinearController::gainArray] The gains are compressed, call decompressGains() first.");
+  }
+  return gainArray_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LinearController::compressGainsRunLength(scalar_t tolerance) {
+  decompressGains();
+  if (gainArray_.empty()) {
+    return 0.0;
+  }
+
+  // element-wise maximum difference, infinite for different sizes
+  auto maxDifference = [](const matrix_t& a, const matrix_t& b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) {
+      return std::numeric_limits<scalar_t>::infinity();
+    }
+    return (a.size() > 0) ? (a - b).cwiseAbs().maxCoeff() : scalar_t(0.0);
+  };
+
+  scalar_t maxError = 0.0;
+  size_t numStored = 0;
+  for (size_t k = 0; k < gainArray_.size(); k++) {
+    const scalar_t error = (numStored > 0) ? maxDifference(gainArray_[numStored - 1], gainArray_[k]) : 0.0;
+    if (numStored == 0 || error > tolerance) {  // start a new run
+      if (numStored != k) {
+        gainArray_[numStored] = std::move(gainArray_[k]);
+      }
+      gainIndices_.push_back(k);
+      numStored++;
+    } else {
+      maxError = std::max(maxError, error);
+    }
+  }
+  gainArray_.resize(numStored);
+  gainArray_.shrink_to_fit();
+  gainCompression_ = GainCompression::RunLength;
+
+  return maxError;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LinearController::compressGainsStride(size_t stride) {
+  decompressGains();
+  if (gainArray_.empty()) {
+    return 0.0;
+  }
+
+  const size_t numGains = gainArray_.size();
+  // The gains jump between time stamps k and k+1 at events and when the gain size changes
+  auto isDiscontinuous = [&](size_t k) {
+    const bool isEvent = timeStamp_[k + 1] - timeStamp_[k] < 2.0 * numeric_traits::weakEpsilon<scalar_t>();
+    return isEvent || gainArray_[k].rows() != gainArray_[k + 1].rows() || gainArray_[k].cols() != gainArray_[k + 1].cols();
+  };
+
+  // Time stamps of the stored gains
+  for (size_t k = 0; k < numGains; k++) {
+    const bool isFirstOrLast = (k == 0) || (k + 1 == numGains);
+    if (isFirstOrLast || k - gainIndices_.back() >= stride || isDiscontinuous(k - 1) || isDiscontinuous(k)) {
+      gainIndices_.push_back(k);
+    }
+  }
+
+  matrix_array_t originalGains;
+  originalGains.swap(gainArray_);
+  gainArray_.reserve(gainIndices_.size());
+  for (const auto k : gainIndices_) {
+    gainArray_.push_back(originalGains[k]);
+  }
+  gainCompression_ = GainCompression::Stride;
+
+  // Error at the time stamps in between the stored gains
+  scalar_t maxError = 0.0;
+  matrix_t gain;
+  for (size_t k = 0; k < numGains; k++) {
+    getCompressedGain(k, gain);
+    if (gain.size() > 0) {
+      maxError = std::max(maxError, (gain - originalGains[k]).cwiseAbs().maxCoeff());
+    }
+  }
+
+  return maxError;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::decompressGains() {
+  if (!gainsCompressed()) {
+    return;
+  }
+
+  matrix_array_t gainArray(timeStamp_.size());
+  for (size_t k = 0; k < timeStamp_.size(); k++) {
+    getCompressedGain(k, gainArray[k]);
+  }
+  gainArray_.swap(gainArray);
+  gainCompression_ = GainCompression::None;
+  gainIndices_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::getCompressedGain(size_t index, matrix_t& gain) const {
+  // stored gain at or before the index
+  const auto storedIndex = std::distance(gainIndices_.begin(), std::upper_bound(gainIndices_.begin(), gainIndices_.end(), index)) - 1;
+  const auto k0 = gainIndices_[storedIndex];
+  if (gainCompression_ == GainCompression::RunLength || k0 == index) {
+    gain = gainArray_[storedIndex];
+  } else {  // linear interpolation in time between the stored gains
+    const auto k1 = gainIndices_[storedIndex + 1];
+    const scalar_t alpha = (timeStamp_[k1] - timeStamp_[index]) / (timeStamp_[k1] - timeStamp_[k0]);
+    gain = alpha * gainArray_[storedIndex] + (1.0 - alpha) * gainArray_[storedIndex + 1];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t LinearController::interpolateCompressedGain(const LinearInterpolation::index_alpha_t& indexAlpha) const {
+  const auto index = static_cast<size_t>(indexAlpha.first);
+  const scalar_t alpha = indexAlpha.second;
+
+  matrix_t gain;
+  getCompressedGain(index, gain);
+  if (index + 1 < timeStamp_.size() && alpha < 1.0) {
+    matrix_t nextGain;
+    getCompressedGain(index + 1, nextGain);
+    if (gain.rows() == nextGain.rows() && gain.cols() == nextGain.cols()) {
+      gain = alpha * gain + (1.0 - alpha) * nextGain;
+    } else if (alpha < 0.5) {  // snap to the closest gain, as LinearInterpolation::interpolate
+      gain = std::move(nextGain);
+    }
+  }
+  return gain;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -287,6 +470,8 @@ void swap(LinearController& a, LinearController& b) noexcept {
   std::swap(a.biasArray_, b.biasArray_);
   std::swap(a.deltaBiasArray_, b.deltaBiasArray_);
   std::swap(a.gainArray_, b.gainArray_);
+  std::swap(a.gainCompression_, b.gainCompression_);
+  std::swap(a.gainIndices_, b.gainIndices_);
 }
 
 /******************************************************************************************************/
@@ -297,7 +482,13 @@ std::ostream& operator<<(std::ostream& out, const LinearController& controller)
     out << "k: " << k << '\n';
     out << "time: " << controller.timeStamp_[k] << '\n';
     out << "bias: " << controller.biasArray_[k].transpose() << '\n';
-    out << "gain: " << controller.gainArray_[k] << '\n';
+    if (controller.gainsCompressed()) {
+      matrix_t gain;
+      controller.getFeedbackGain(controller.timeStamp_[k], gain);
+      out << "gain: " << gain << '\n';
+    } else {
+      out << "gain: " << controller.gainArray()[k] << '\n';
+    }
   }
   return out;
 }
@@ -181,8 +181,8 @@ void TrajectorySpreadingControllerAdjustment::spreadController(scalar_t eventTim
                  alpha * controllersStock[eventTimeIndex.first].biasArray_[eventTimeIndex.second];
   // feedback part
   matrix_t kCorrected;
-  kCorrected = (1 - alpha) * controllersStock[eventTimePrevIndex.first].gainArray_[eventTimePrevIndex.second] +
-               alpha * controllersStock[eventTimeIndex.first].gainArray_[eventTimeIndex.second];
+  kCorrected = (1 - alpha) * controllersStock[eventTimePrevIndex.first].gainArray()[eventTimePrevIndex.second] +
+               alpha * controllersStock[eventTimeIndex.first].gainArray()[eventTimeIndex.second];
 
   index_t startIndex;
   index_t finalIndex;
@@ -194,7 +194,7 @@ void TrajectorySpreadingControllerAdjustment::spreadController(scalar_t eventTim
 
     // it is definitely at the same partition since it is the controller event times
     uffSpread = controllersStock[controlerEventTimeIndex.first].biasArray_[controlerEventTimeIndex.second + 1];  // it should be +1
-    kSpread = controllersStock[controlerEventTimeIndex.first].gainArray_[controlerEventTimeIndex.second + 1];    // it should be +1
+    kSpread = controllersStock[controlerEventTimeIndex.first].gainArray()[controlerEventTimeIndex.second + 1];    // it should be +1
 
     controllersStock[eventTimeIndex.first].timeStamp_[eventTimeIndex.second] = eventTime;
 
@@ -204,7 +204,7 @@ void TrajectorySpreadingControllerAdjustment::spreadController(scalar_t eventTim
 
     // it is definitely at the same partition since it is the controller event times
     uffSpread = controllersStock[controlerEventTimeIndex.first].biasArray_[controlerEventTimeIndex.second];
-    kSpread = controllersStock[controlerEventTimeIndex.first].gainArray_[controlerEventTimeIndex.second];
+    kSpread = controllersStock[controlerEventTimeIndex.first].gainArray()[controlerEventTimeIndex.second];
 
     controllersStock[eventTimePrevIndex.first].timeStamp_[eventTimePrevIndex.second] = eventTime;
   }
@@ -216,7 +216,7 @@ void TrajectorySpreadingControllerAdjustment::spreadController(scalar_t eventTim
 
     for (size_t k = startItr; k <= finalItr; k++) {
       controllersStock[i].biasArray_[k] = uffSpread;
-      controllersStock[i].gainArray_[k] = kSpread;
+      controllersStock[i].gainArray()[k] = kSpread;
     }  // end of k loop
   }    // end of i loop
 }
@@ -67,6 +67,18 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::addQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                   const PreComputation&, ScalarFunctionQuadraticApproximation& approximation) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+  const vector_t qDeviation = Q_ * xDeviation;
+  approximation.f += 0.5 * xDeviation.dot(qDeviation);
+  approximation.dfdx += qDeviation;
+  approximation.dfdxx += Q_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -96,6 +96,33 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::addQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                        ScalarFunctionQuadraticApproximation& approximation) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  vector_t qDeviation = Q_ * stateDeviation;
+  vector_t rDeviation = R_ * inputDeviation;
+  approximation.f += 0.5 * stateDeviation.dot(qDeviation) + 0.5 * inputDeviation.dot(rDeviation);
+
+  if (P_.size() > 0) {
+    const vector_t pDeviation = P_ * stateDeviation;
+    approximation.f += inputDeviation.dot(pDeviation);
+    rDeviation += pDeviation;
+    qDeviation.noalias() += P_.transpose() * inputDeviation;
+    approximation.dfdux += P_;
+  }
+
+  approximation.dfdx += qDeviation;
+  approximation.dfdu += rDeviation;
+  approximation.dfdxx += Q_;
+  approximation.dfduu += R_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
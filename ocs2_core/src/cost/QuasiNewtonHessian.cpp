@@ -0,0 +1,223 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/cost/QuasiNewtonHessian.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
+
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/LoadData.h>
+
+namespace ocs2 {
+namespace quasi_newton {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(HessianUpdate update) {
+  static const std::unordered_map<HessianUpdate, std::string> updateMap{{HessianUpdate::BFGS, "BFGS"}, {HessianUpdate::SR1, "SR1"}};
+  return updateMap.at(update);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+HessianUpdate fromString(std::string name) {
+  static const std::unordered_map<std::string, HessianUpdate> updateMap{{"BFGS", HessianUpdate::BFGS}, {"SR1", HessianUpdate::SR1}};
+  std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+  return updateMap.at(name);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+  if (verbose) {
+    std::cerr << " #### Quasi-Newton Settings: {\n";
+  }
+
+  Settings settings;
+
+  std::string updateName = toString(settings.update);
+  loadData::loadPtreeValue(pt, updateName, fieldName + ".update", verbose);
+  settings.update = fromString(updateName);
+
+  loadData::loadPtreeValue(pt, settings.initialHessianScaling, fieldName + ".initialHessianScaling", verbose);
+  loadData::loadPtreeValue(pt, settings.dampingThreshold, fieldName + ".dampingThreshold", verbose);
+  loadData::loadPtreeValue(pt, settings.skipTolerance, fieldName + ".skipTolerance", verbose);
+
+  if (verbose) {
+    std::cerr << " #### }" << std::endl;
+  }
+
+  return settings;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonHessian::QuasiNewtonHessian(Settings settings) : settings_(std::move(settings)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuasiNewtonHessian::update(size_t nodeIndex, const vector_t& point, const vector_t& gradient, matrix_t& hessian) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& node = getNode(nodeIndex, point.size());
+
+  // the step of this node since its previous evaluation
+  if (node.point.size() == point.size()) {
+    const vector_t s = point - node.point;
+    if (s.norm() > numeric_traits::limitEpsilon<scalar_t>() * (1.0 + point.norm())) {
+      const vector_t y = gradient - node.gradient;
+
+      // scale the initial estimate by the curvature along the first step (Shanno and Phua). For SR1, this scaling overestimates
+      // the curvature in all the other directions, such that the first update is a negative curvature correction.
+      const scalar_t sy = s.dot(y);
+      if (settings_.update == HessianUpdate::BFGS && !node.hasCurvaturePair && sy > 0.0) {
+        node.hessian.setIdentity();
+        node.hessian *= y.squaredNorm() / sy;
+      }
+
+      updateHessian(s, y, node.hessian);
+      node.hasCurvaturePair = true;
+      numUpdates_++;
+    }
+  }
+
+  node.point = point;
+  node.gradient = gradient;
+  hessian = node.hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuasiNewtonHessian::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  nodes_.clear();
+  numUpdates_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t QuasiNewtonHessian::getNumNodes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return nodes_.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t QuasiNewtonHessian::getNumUpdates() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numUpdates_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto QuasiNewtonHessian::getNode(size_t nodeIndex, size_t dim) -> Node& {
+  auto it = nodes_.lower_bound(nodeIndex);
+  if (it != nodes_.end() && it->first == nodeIndex) {
+    auto& node = it->second;
+    if (node.hessian.rows() != dim) {
+      node = Node();
+      node.hessian = settings_.initialHessianScaling * matrix_t::Identity(dim, dim);
+    }
+    return node;
+  }
+
+  // a new node starts from the estimate of its closest node, preferably the preceding one
+  const Node* closestNodePtr = nullptr;
+  if (it != nodes_.begin() && std::prev(it)->second.hessian.rows() == dim) {
+    closestNodePtr = &std::prev(it)->second;
+  }
+  if (it != nodes_.end() && it->second.hessian.rows() == dim &&
+      (closestNodePtr == nullptr || it->first - nodeIndex < nodeIndex - std::prev(it)->first)) {
+    closestNodePtr = &it->second;
+  }
+
+  Node node;
+  if (closestNodePtr != nullptr) {
+    node.hessian = closestNodePtr->hessian;
+    node.hasCurvaturePair = closestNodePtr->hasCurvaturePair;
+  } else {
+    node.hessian = settings_.initialHessianScaling * matrix_t::Identity(dim, dim);
+  }
+
+  return nodes_.emplace_hint(it, nodeIndex, std::move(node))->second;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuasiNewtonHessian::updateHessian(const vector_t& s, const vector_t& y, matrix_t& hessian) const {
+  switch (settings_.update) {
+    case HessianUpdate::BFGS: {
+      const vector_t Bs = hessian * s;
+      const scalar_t sBs = s.dot(Bs);
+      const scalar_t sy = s.dot(y);
+      if (sBs < numeric_traits::limitEpsilon<scalar_t>()) {
+        // no curvature along s, e.g. a zero initial estimate
+        if (sy > numeric_traits::limitEpsilon<scalar_t>()) {
+          hessian.noalias() += (y / sy) * y.transpose();
+        }
+        return;
+      }
+
+      // Powell's damping keeps the estimate positive definite
+      const scalar_t theta = (sy >= settings_.dampingThreshold * sBs) ? 1.0 : (1.0 - settings_.dampingThreshold) * sBs / (sBs - sy);
+      const vector_t r = theta * y + (1.0 - theta) * Bs;
+      hessian.noalias() += (r / s.dot(r)) * r.transpose();
+      hessian.noalias() -= (Bs / sBs) * Bs.transpose();
+      break;
+    }
+    case HessianUpdate::SR1: {
+      const vector_t r = y - hessian * s;
+      const scalar_t rs = r.dot(s);
+      if (std::abs(rs) > settings_.skipTolerance * r.norm() * s.norm()) {
+        hessian.noalias() += (r / rs) * r.transpose();
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("[QuasiNewtonHessian] Unknown Hessian update!");
+  }
+}
+
+}  // namespace quasi_newton
+}  // namespace ocs2
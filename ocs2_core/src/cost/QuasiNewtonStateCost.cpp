@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/cost/QuasiNewtonStateCost.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonStateCost::QuasiNewtonStateCost(std::unique_ptr<StateCost> costPtr, quasi_newton::Settings settings)
+    : costPtr_(std::move(costPtr)), hessianPtr_(std::make_shared<quasi_newton::QuasiNewtonHessian>(std::move(settings))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonStateCost::QuasiNewtonStateCost(const QuasiNewtonStateCost& other)
+    : StateCost(other), costPtr_(other.costPtr_->clone()), hessianPtr_(other.hessianPtr_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonStateCost* QuasiNewtonStateCost::clone() const {
+  return new QuasiNewtonStateCost(*this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool QuasiNewtonStateCost::isActive(scalar_t time) const {
+  return costPtr_->isActive(time);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t QuasiNewtonStateCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation& preComp) const {
+  return costPtr_->getValue(time, state, targetTrajectories, preComp);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation QuasiNewtonStateCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                     const TargetTrajectories& targetTrajectories,
+                                                                                     const PreComputation& preComp) const {
+  if (!preComp.hasNodeIndex()) {
+    throw std::runtime_error("[QuasiNewtonStateCost] The solver does not provide the node index, see PreComputation::setNodeIndex().");
+  }
+  auto cost = costPtr_->getFirstOrderApproximation(time, state, targetTrajectories, preComp);
+  hessianPtr_->update(preComp.getNodeIndex(), state, cost.dfdx, cost.dfdxx);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation QuasiNewtonStateCost::getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                                      const TargetTrajectories& targetTrajectories,
+                                                                                      const PreComputation& preComp) const {
+  return costPtr_->getFirstOrderApproximation(time, state, targetTrajectories, preComp);
+}
+
+}  // namespace ocs2
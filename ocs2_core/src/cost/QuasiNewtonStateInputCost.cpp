@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/cost/QuasiNewtonStateInputCost.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonStateInputCost::QuasiNewtonStateInputCost(std::unique_ptr<StateInputCost> costPtr, quasi_newton::Settings settings)
+    : costPtr_(std::move(costPtr)), hessianPtr_(std::make_shared<quasi_newton::QuasiNewtonHessian>(std::move(settings))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonStateInputCost::QuasiNewtonStateInputCost(const QuasiNewtonStateInputCost& other)
+    : StateInputCost(other), costPtr_(other.costPtr_->clone()), hessianPtr_(other.hessianPtr_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+QuasiNewtonStateInputCost* QuasiNewtonStateInputCost::clone() const {
+  return new QuasiNewtonStateInputCost(*this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool QuasiNewtonStateInputCost::isActive(scalar_t time) const {
+  return costPtr_->isActive(time);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t QuasiNewtonStateInputCost::getValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                             const TargetTrajectories& targetTrajectories, const PreComputation& preComp) const {
+  return costPtr_->getValue(time, state, input, targetTrajectories, preComp);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation QuasiNewtonStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                          const vector_t& input,
+                                                                                          const TargetTrajectories& targetTrajectories,
+                                                                                          const PreComputation& preComp) const {
+  if (!preComp.hasNodeIndex()) {
+    throw std::runtime_error("[QuasiNewtonStateInputCost] The solver does not provide the node index, see PreComputation::setNodeIndex().");
+  }
+  const auto stateDim = state.size();
+  const auto inputDim = input.size();
+  auto cost = costPtr_->getFirstOrderApproximation(time, state, input, targetTrajectories, preComp);
+
+  vector_t stateInput(stateDim + inputDim);
+  stateInput << state, input;
+  vector_t gradient(stateDim + inputDim);
+  gradient << cost.dfdx, cost.dfdu;
+  matrix_t hessian;
+  hessianPtr_->update(preComp.getNodeIndex(), stateInput, gradient, hessian);
+
+  cost.dfdxx = hessian.topLeftCorner(stateDim, stateDim);
+  cost.dfdux = hessian.bottomLeftCorner(inputDim, stateDim);
+  cost.dfduu = hessian.bottomRightCorner(inputDim, inputDim);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation QuasiNewtonStateInputCost::getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                                           const vector_t& input,
+                                                                                           const TargetTrajectories& targetTrajectories,
+                                                                                           const PreComputation& preComp) const {
+  return costPtr_->getFirstOrderApproximation(time, state, input, targetTrajectories, preComp);
+}
+
+}  // namespace ocs2
@@ -66,29 +66,13 @@ scalar_t StateCostCollection::getValue(scalar_t time, const vector_t& state, con
 ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation& preComp) const {
-  const auto firstActive =
-      std::find_if(terms_.begin(), terms_.end(), [time](const std::unique_ptr<StateCost>& costTerm) { return costTerm->isActive(time); });
-
-  // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.rows(), 0);
-  }
-
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
+  // accumulate the active terms in place, such that constant Hessians are not copied to temporaries. The input derivatives have zero size.
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), 0);
+  for (const auto& costTerm : this->terms_) {
     if (costTerm->isActive(time)) {
-      const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-      cost.f += costTermApproximation.f;
-      cost.dfdx += costTermApproximation.dfdx;
-      cost.dfdxx += costTermApproximation.dfdxx;
+      costTerm->addQuadraticApproximation(time, state, targetTrajectories, preComp, cost);
     }
-  });
-
-  // Make sure that input derivatives have zero size
-  cost.dfdu.resize(0);
-  cost.dfduu.resize(0, 0);
-  cost.dfdux.resize(0, state.size());
+  }
 
   return cost;
 }
@@ -35,7 +35,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void StateCostCppAd::initialize(size_t stateDim, size_t parameterDim, const std::string& modelName, const std::string& modelFolder,
-                                bool recompileLibraries, bool verbose) {
+                                bool recompileLibraries, bool verbose, CppAdInterface::ApproximationOrder approximationOrder) {
+  approximationOrder_ = approximationOrder;
   auto costAd = [=](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
     assert(x.rows() == 1 + stateDim);
     const ad_scalar_t time = x(0);
@@ -46,9 +47,9 @@ void StateCostCppAd::initialize(size_t stateDim, size_t parameterDim, const std:
   adInterfacePtr_.reset(new ocs2::CppAdInterface(costAd, 1 + stateDim, parameterDim, modelName, modelFolder));
 
   if (recompileLibraries) {
-    adInterfacePtr_->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+    adInterfacePtr_->createModels(approximationOrder_, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+    adInterfacePtr_->loadModelsIfAvailable(approximationOrder_, verbose);
   }
 }
 
@@ -56,7 +57,7 @@ void StateCostCppAd::initialize(size_t stateDim, size_t parameterDim, const std:
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateCostCppAd::StateCostCppAd(const StateCostCppAd& rhs)
-    : StateCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), approximationOrder_(rhs.approximationOrder_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -74,6 +75,10 @@ scalar_t StateCostCppAd::getValue(scalar_t time, const vector_t& state, const Ta
 ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                const TargetTrajectories& targetTrajectories,
                                                                                const PreComputation&) const {
+  if (approximationOrder_ != CppAdInterface::ApproximationOrder::Second) {
+    throw std::runtime_error("[StateCostCppAd] The second-order derivatives are not generated! Call getFirstOrderApproximation().");
+  }
+
   ScalarFunctionQuadraticApproximation cost;
 
   const size_t stateDim = state.rows();
@@ -92,4 +97,23 @@ ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(s
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateCostCppAd::getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                                const TargetTrajectories& targetTrajectories,
+                                                                                const PreComputation&) const {
+  const size_t stateDim = state.rows();
+  const vector_t params = getParameters(time, targetTrajectories);
+  vector_t tapedTimeState(1 + stateDim);
+  tapedTimeState << time, state;
+
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(stateDim, 0);
+  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
+  cost.dfdx = J.rightCols(stateDim).transpose();
+
+  return cost;
+}
+
 }  // namespace ocs2
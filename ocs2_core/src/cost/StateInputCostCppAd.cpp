@@ -35,7 +35,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t parameterDim, const std::string& modelName,
-                                     const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+                                     const std::string& modelFolder, bool recompileLibraries, bool verbose,
+                                     CppAdInterface::ApproximationOrder approximationOrder) {
+  approximationOrder_ = approximationOrder;
   auto costAd = [=](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
     assert(x.rows() == 1 + stateDim + inputDim);
     const ad_scalar_t time = x(0);
@@ -47,9 +49,9 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
   adInterfacePtr_.reset(new ocs2::CppAdInterface(costAd, 1 + stateDim + inputDim, parameterDim, modelName, modelFolder));
 
   if (recompileLibraries) {
-    adInterfacePtr_->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+    adInterfacePtr_->createModels(approximationOrder_, verbose);
   } else {
-    adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+    adInterfacePtr_->loadModelsIfAvailable(approximationOrder_, verbose);
   }
 }
 
@@ -57,7 +59,7 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
-    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), approximationOrder_(rhs.approximationOrder_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -76,6 +78,10 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
                                                                                     const vector_t& input,
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation&) const {
+  if (approximationOrder_ != CppAdInterface::ApproximationOrder::Second) {
+    throw std::runtime_error("[StateInputCostCppAd] The second-order derivatives are not generated! Call getFirstOrderApproximation().");
+  }
+
   ScalarFunctionQuadraticApproximation cost;
 
   const size_t stateDim = state.rows();
@@ -98,4 +104,26 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateInputCostCppAd::getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                                     const vector_t& input,
+                                                                                     const TargetTrajectories& targetTrajectories,
+                                                                                     const PreComputation&) const {
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const vector_t params = getParameters(time, targetTrajectories);
+  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+  tapedTimeStateInput << time, state, input;
+
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  cost.dfdx = J.middleCols(1, stateDim).transpose();
+  cost.dfdu = J.rightCols(inputDim).transpose();
+
+  return cost;
+}
+
 }  // namespace ocs2
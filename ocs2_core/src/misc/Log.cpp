@@ -27,10 +27,19 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
+#include <boost/date_time/c_local_time_adjustor.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
 #include <boost/log/core.hpp>
 
 #include <boost/core/null_deleter.hpp>
@@ -60,6 +69,200 @@ static std::shared_ptr<file_sink_t> fileSink_;
 
 BOOST_LOG_ATTRIBUTE_KEYWORD(severity, "Severity", SeverityLevel);
 
+namespace detail {
+
+/** Fixed-size record of the asynchronous backend. */
+struct AsyncRecord {
+  SeverityLevel severity;
+  std::chrono::system_clock::time_point time;
+  size_t length;
+  char message[maxAsyncMessageLength + 1];
+};
+
+}  // namespace detail
+
+namespace {
+
+/** Single-producer single-consumer ring buffer of the asynchronous records of one thread. */
+class AsyncRingBuffer {
+ public:
+  static constexpr size_t capacity = 1024;  // must be a power of 2
+
+  AsyncRingBuffer() : records_(capacity) {}
+
+  /** Producer: returns the next free slot or nullptr if the buffer is full. */
+  detail::AsyncRecord* acquire() {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == capacity) {
+      numDropped_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    return &records_[tail & (capacity - 1)];
+  }
+
+  /** Producer: publishes the slot returned by the last acquire(). */
+  void publish() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /** Consumer: appends the published records to the given array and returns the new head. */
+  size_t peek(std::vector<const detail::AsyncRecord*>& records) const {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    for (auto i = head_.load(std::memory_order_relaxed); i != tail; i++) {
+      records.push_back(&records_[i & (capacity - 1)]);
+    }
+    return tail;
+  }
+
+  /** Consumer: releases the records up to the given head. */
+  void release(size_t head) { head_.store(head, std::memory_order_release); }
+
+  bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+  size_t takeNumDropped() { return numDropped_.exchange(0, std::memory_order_relaxed); }
+
+  std::atomic_bool ownerAlive{true};
+
+ private:
+  std::vector<detail::AsyncRecord> records_;
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<size_t> numDropped_{0};
+};
+
+constexpr size_t AsyncRingBuffer::capacity;
+
+/** Stream buffer over the message of an asynchronous record. Characters beyond its capacity are discarded. */
+class FixedStreamBuffer : public std::streambuf {
+ public:
+  void setRecord(detail::AsyncRecord& record) { setp(record.message, record.message + maxAsyncMessageLength); }
+  size_t length() const { return static_cast<size_t>(pptr() - pbase()); }
+
+ protected:
+  int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+};
+
+/** The backend which passes the asynchronous records of all threads to the boost-log sinks. */
+class AsyncBackend {
+ public:
+  AsyncBackend() : timeStamp_(boost::posix_time::ptime()) { logger_.add_attribute("TimeStamp", timeStamp_); }
+
+  ~AsyncBackend() {
+    // the remaining records are dropped if the logger is not reset before exit
+    if (running_.exchange(false)) {
+      worker_.join();
+    }
+  }
+
+  std::shared_ptr<AsyncRingBuffer> registerThread() {
+    auto ringBufferPtr = std::make_shared<AsyncRingBuffer>();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    ringBuffers_.push_back(ringBufferPtr);
+    return ringBufferPtr;
+  }
+
+  void start() {
+    if (!running_.exchange(true)) {
+      worker_ = std::thread([this]() {
+        while (running_) {
+          if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+        }
+      });
+    }
+  }
+
+  void stop() {
+    if (running_.exchange(false)) {
+      worker_.join();
+    }
+    drain();
+  }
+
+  /** Passes all published records to the sinks in the order of their time stamps. Returns the number of records. */
+  size_t drain() {
+    std::lock_guard<std::mutex> drainLock(drainMutex_);
+    {
+      std::lock_guard<std::mutex> lock(registryMutex_);
+      // remove the buffers of the exited threads which are already drained
+      ringBuffers_.erase(std::remove_if(ringBuffers_.begin(), ringBuffers_.end(),
+                                        [](const std::shared_ptr<AsyncRingBuffer>& r) { return !r->ownerAlive && r->empty(); }),
+                         ringBuffers_.end());
+      drainedRingBuffers_ = ringBuffers_;
+    }
+
+    records_.clear();
+    heads_.clear();
+    size_t numDropped = 0;
+    for (const auto& ringBufferPtr : drainedRingBuffers_) {
+      heads_.push_back(ringBufferPtr->peek(records_));
+      numDropped += ringBufferPtr->takeNumDropped();
+    }
+    std::stable_sort(records_.begin(), records_.end(),
+                     [](const detail::AsyncRecord* lhs, const detail::AsyncRecord* rhs) { return lhs->time < rhs->time; });
+
+    for (const auto* recordPtr : records_) {
+      timeStamp_.set(toLocalTime(recordPtr->time));
+      BOOST_LOG_SEV(logger_, recordPtr->severity).write(recordPtr->message, recordPtr->length);
+    }
+    if (numDropped > 0) {
+      timeStamp_.set(toLocalTime(std::chrono::system_clock::now()));
+      BOOST_LOG_SEV(logger_, SeverityLevel::WARNING) << numDropped << " log records are dropped since the ring buffer is full.";
+    }
+
+    for (size_t i = 0; i < drainedRingBuffers_.size(); i++) {
+      drainedRingBuffers_[i]->release(heads_[i]);
+    }
+    drainedRingBuffers_.clear();
+    return records_.size();
+  }
+
+ private:
+  static boost::posix_time::ptime toLocalTime(std::chrono::system_clock::time_point time) {
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    const auto utcTime = boost::posix_time::from_time_t(sinceEpoch / 1000000) + boost::posix_time::microseconds(sinceEpoch % 1000000);
+    return boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(utcTime);
+  }
+
+  std::mutex registryMutex_;
+  std::vector<std::shared_ptr<AsyncRingBuffer>> ringBuffers_;
+
+  std::mutex drainMutex_;
+  std::vector<std::shared_ptr<AsyncRingBuffer>> drainedRingBuffers_;
+  std::vector<const detail::AsyncRecord*> records_;
+  std::vector<size_t> heads_;
+  boost::log::sources::severity_logger<SeverityLevel> logger_;
+  boost::log::attributes::mutable_constant<boost::posix_time::ptime> timeStamp_;
+
+  std::atomic_bool running_{false};
+  std::thread worker_;
+};
+
+AsyncBackend& getAsyncBackend() {
+  static AsyncBackend asyncBackend;
+  return asyncBackend;
+}
+
+/** Per-thread state of the asynchronous backend. */
+struct AsyncThreadState {
+  AsyncThreadState() : ringBufferPtr(getAsyncBackend().registerThread()), stream(&streamBuffer) {}
+  ~AsyncThreadState() { ringBufferPtr->ownerAlive = false; }
+
+  std::shared_ptr<AsyncRingBuffer> ringBufferPtr;
+  FixedStreamBuffer streamBuffer;
+  std::ostream stream;
+};
+
+AsyncThreadState& getAsyncThreadState() {
+  thread_local AsyncThreadState asyncThreadState;
+  return asyncThreadState;
+}
+
+std::atomic_bool asynchronous_{false};
+// the lowest severity which is accepted by a sink in the asynchronous mode
+std::atomic<size_t> asyncMinSeverity_{static_cast<size_t>(SeverityLevel::ERROR) + 1};
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -99,6 +302,7 @@ Settings loadSettings(const std::string& fileName, const std::string& fieldName)
   settings.logFileSeverity = fromString(logFileSeverity);
 
   loadData::loadPtreeValue(pt, settings.logFileName, fieldName + ".logFileName", false);
+  loadData::loadPtreeValue(pt, settings.asynchronous, fieldName + ".asynchronous", false);
 
   return settings;
 }
@@ -115,6 +319,7 @@ std::ostream& operator<<(std::ostream& stream, const Settings& settings) {
   loadData::printValue(stream, settings.useLogFile, "useLogFile");
   loadData::printValue(stream, settings.logFileSeverity, "logFileSeverity");
   loadData::printValue(stream, settings.logFileName, "logFileName");
+  loadData::printValue(stream, settings.asynchronous, "asynchronous");
 
   stream << " #### =============================================================================\n";
   return stream;
@@ -156,12 +361,30 @@ void init(const Settings& settings, std::ostream* console_stream) {
   }
 
   boost::log::add_common_attributes();
+
+  if (settings.asynchronous) {
+    auto minSeverity = asyncMinSeverity_.load();
+    if (settings.useConsole) {
+      minSeverity = std::min(minSeverity, static_cast<size_t>(settings.consoleSeverity));
+    }
+    if (settings.useLogFile) {
+      minSeverity = std::min(minSeverity, static_cast<size_t>(settings.logFileSeverity));
+    }
+    asyncMinSeverity_ = minSeverity;
+    getAsyncBackend().start();
+    asynchronous_ = true;
+  }
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void reset() {
+  if (asynchronous_.exchange(false)) {
+    getAsyncBackend().stop();
+    asyncMinSeverity_ = static_cast<size_t>(SeverityLevel::ERROR) + 1;
+  }
+
   auto core = boost::log::core::get();
 
   if (consoleSink_ != nullptr) {
@@ -175,6 +398,15 @@ void reset() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void flush() {
+  if (asynchronous_) {
+    getAsyncBackend().drain();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -183,5 +415,56 @@ logger_t& getLogger() {
   return logger;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+detail::RecordPump::RecordPump(SeverityLevel severity) {
+  if (asynchronous_.load(std::memory_order_relaxed)) {
+    if (static_cast<size_t>(severity) >= asyncMinSeverity_.load(std::memory_order_relaxed)) {
+      auto& threadState = getAsyncThreadState();
+      asyncRecordPtr_ = threadState.ringBufferPtr->acquire();
+      if (asyncRecordPtr_ != nullptr) {
+        asyncRecordPtr_->severity = severity;
+        asyncRecordPtr_->time = std::chrono::system_clock::now();
+        threadState.streamBuffer.setRecord(*asyncRecordPtr_);
+        // each message starts with the default stream state as in the synchronous mode
+        threadState.stream.clear();
+        threadState.stream.flags(std::ios_base::dec | std::ios_base::skipws);
+        threadState.stream.precision(6);
+        threadState.stream.width(0);
+        threadState.stream.fill(' ');
+        streamPtr_ = &threadState.stream;
+        active_ = true;
+      }
+    }
+
+  } else {
+    record_ = getLogger().open_record(boost::log::keywords::severity = severity);
+    if (record_) {
+      recordStream_.emplace(record_);
+      streamPtr_ = &recordStream_->stream();
+      active_ = true;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void detail::RecordPump::commit() {
+  if (asyncRecordPtr_ != nullptr) {
+    auto& threadState = getAsyncThreadState();
+    asyncRecordPtr_->length = threadState.streamBuffer.length();
+    threadState.ringBufferPtr->publish();
+    asyncRecordPtr_ = nullptr;
+
+  } else {
+    recordStream_->flush();
+    getLogger().push_record(std::move(record_));
+    recordStream_.reset();
+  }
+  active_ = false;
+}
+
 }  // namespace log
 }  // namespace ocs2
@@ -247,6 +247,7 @@ std::string ModelData::checkConstraintProperties() const {
 std::ostream& operator<<(std::ostream& out, const ModelData& data) {
   out << '\n';
   out << "time: " << data.time_ << '\n';
+  out << "event index: " << data.eventIndex_ << '\n';
   out << "Dynamics: " << data.dynamics_.f.transpose() << '\n';
   out << "dynamicsBias: " << data.dynamicsBias_.transpose() << '\n';
   out << "Dynamics State Derivative:\n" << data.dynamics_.dfdx << '\n';
@@ -51,6 +51,14 @@ size_t ModeSchedule::modeAtTime(scalar_t time) const {
   return modeSequence[ind];
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t ModeSchedule::modeAtTime(scalar_t time, int& cursor) const {
+  cursor = lookup::findIndexInTimeArray(eventTimes, time, cursor);
+  return modeSequence[cursor];
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
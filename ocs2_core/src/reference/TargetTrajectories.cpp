@@ -29,8 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/reference/TargetTrajectories.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
 
@@ -77,7 +80,10 @@ vector_t TargetTrajectories::getDesiredState(scalar_t time) const {
   if (this->empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
+    int hint = lookupHint_.interval.load(std::memory_order_relaxed);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory, hint);
+    lookupHint_.interval.store(hint, std::memory_order_relaxed);
+    return LinearInterpolation::interpolate(indexAlpha, stateTrajectory);
   }
 }
 
@@ -90,7 +96,80 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   } else if (inputTrajectory.empty()) {
     throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
   } else {
-    return LinearInterpolation::interpolate(time, timeTrajectory, inputTrajectory);
+    int hint = lookupHint_.interval.load(std::memory_order_relaxed);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory, hint);
+    lookupHint_.interval.store(hint, std::memory_order_relaxed);
+    return LinearInterpolation::interpolate(indexAlpha, inputTrajectory);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::append(const scalar_array_t& timePoints, const vector_array_t& statePoints, const vector_array_t& inputPoints) {
+  if (timePoints.size() != statePoints.size()) {
+    throw std::runtime_error("[TargetTrajectories::append] The appended time and state points have different sizes!");
+  }
+  if (!std::is_sorted(timePoints.cbegin(), timePoints.cend())) {
+    throw std::runtime_error("[TargetTrajectories::append] The appended time points are not sorted!");
+  }
+  if (timePoints.empty()) {
+    return;
+  }
+
+  if (!inputPoints.empty() && inputPoints.size() != timePoints.size()) {
+    throw std::runtime_error("[TargetTrajectories::append] The appended time and input points have different sizes!");
+  }
+  if (!timeTrajectory.empty() && inputTrajectory.empty() != inputPoints.empty()) {
+    throw std::runtime_error("[TargetTrajectories::append] The appended input points are inconsistent with the inputTrajectory!");
+  }
+
+  // remove the overlapping tail
+  const size_t firstReplaced = lookup::findIndexInTimeArray(timeTrajectory, timePoints.front(), static_cast<int>(timeTrajectory.size()));
+  timeTrajectory.resize(firstReplaced);
+  stateTrajectory.resize(firstReplaced);
+  if (!inputTrajectory.empty()) {
+    inputTrajectory.resize(firstReplaced);
+  }
+
+  timeTrajectory.insert(timeTrajectory.end(), timePoints.cbegin(), timePoints.cend());
+  stateTrajectory.insert(stateTrajectory.end(), statePoints.cbegin(), statePoints.cend());
+  inputTrajectory.insert(inputTrajectory.end(), inputPoints.cbegin(), inputPoints.cend());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+size_t TargetTrajectories::trimBefore(scalar_t time) {
+  // the last point at or before time is kept since it is required for the interpolation
+  const auto firstPointAfter = std::upper_bound(timeTrajectory.cbegin(), timeTrajectory.cend(), time);
+  const int numObsolete = static_cast<int>(firstPointAfter - timeTrajectory.cbegin()) - 1;
+
+  // Erasing from the front moves all the retained points. Therefore, the obsolete points are only removed once they are at least as
+  // many as the retained ones, which makes the cost of trimming amortized constant per point.
+  const int numRetained = static_cast<int>(timeTrajectory.size()) - numObsolete;
+  if (numObsolete <= 0 || numObsolete < numRetained) {
+    return 0;
+  }
+
+  timeTrajectory.erase(timeTrajectory.begin(), timeTrajectory.begin() + numObsolete);
+  stateTrajectory.erase(stateTrajectory.begin(), stateTrajectory.begin() + numObsolete);
+  if (!inputTrajectory.empty()) {
+    inputTrajectory.erase(inputTrajectory.begin(), inputTrajectory.begin() + numObsolete);
+  }
+
+  const int hint = lookupHint_.interval.load(std::memory_order_relaxed);
+  lookupHint_.interval.store(std::max(hint - numObsolete, 0), std::memory_order_relaxed);
+
+  return static_cast<size_t>(numObsolete);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::shiftTime(scalar_t timeShift) {
+  for (auto& t : timeTrajectory) {
+    t += timeShift;
   }
 }
 
@@ -104,6 +104,29 @@ ScalarFunctionQuadraticApproximation SoftConstraintPenalty::getQuadraticApproxim
   return penaltyApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SoftConstraintPenalty::getFirstOrderApproximation(scalar_t t,
+                                                                                       const VectorFunctionLinearApproximation& h) const {
+  const auto stateDim = h.dfdx.cols();
+  const auto inputDim = h.dfdu.cols();
+
+  vector_t penaltyDerivative(h.f.rows());
+  for (size_t i = 0; i < h.f.rows(); i++) {
+    penaltyDerivative(i) = getPenalty(i).getDerivative(t, h.f(i));
+  }
+
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  penaltyApproximation.f = getValue(t, h.f);
+  penaltyApproximation.dfdx.noalias() = h.dfdx.transpose() * penaltyDerivative;
+  if (inputDim > 0) {
+    penaltyApproximation.dfdu.noalias() = h.dfdu.transpose() * penaltyDerivative;
+  }
+
+  return penaltyApproximation;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -141,6 +164,116 @@ ScalarFunctionQuadraticApproximation SoftConstraintPenalty::getQuadraticApproxim
   return penaltyApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<size_array_t, size_array_t> SoftConstraintPenalty::getLazyLinearizationRows(scalar_t t, const vector_t& h,
+                                                                                      scalar_t margin) const {
+  assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == h.rows());
+  size_array_t activeRows, inactiveRows;
+  for (size_t i = 0; i < h.rows(); i++) {
+    if (h(i) < margin) {
+      activeRows.push_back(i);
+    } else if (getPenalty(i).getDerivative(t, h(i)) != 0.0) {
+      inactiveRows.push_back(i);
+    }
+  }
+  return {std::move(activeRows), std::move(inactiveRows)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SoftConstraintPenalty::getQuadraticApproximation(
+    scalar_t t, const vector_t& h, const size_array_t& rows, size_t numActiveRows, const VectorFunctionLinearApproximation& hRows) const {
+  const auto stateDim = hRows.dfdx.cols();
+  const auto inputDim = hRows.dfdu.cols();
+  const auto numRows = rows.size();
+
+  // the second derivative of the inactive rows is set to zero
+  vector_t penaltyDerivative(numRows);
+  vector_t penaltySecondDerivative = vector_t::Zero(numRows);
+  for (size_t k = 0; k < numRows; k++) {
+    const auto& penaltyTerm = getPenalty(rows[k]);
+    penaltyDerivative(k) = penaltyTerm.getDerivative(t, h(rows[k]));
+    if (k < numActiveRows) {
+      penaltySecondDerivative(k) = penaltyTerm.getSecondDerivative(t, h(rows[k]));
+    }
+  }
+
+  const auto dhdxActive = hRows.dfdx.topRows(numActiveRows);
+  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.head(numActiveRows).asDiagonal() * dhdxActive;
+
+  // to make sure that dfdux in the state-only case has a right size
+  ScalarFunctionQuadraticApproximation penaltyApproximation(stateDim, inputDim);
+
+  penaltyApproximation.f = getValue(t, h);
+  penaltyApproximation.dfdx.noalias() = hRows.dfdx.transpose() * penaltyDerivative;
+  penaltyApproximation.dfdxx.noalias() = dhdxActive.transpose() * penaltySecondDev_dhdx;
+  if (inputDim > 0) {
+    const auto dhduActive = hRows.dfdu.topRows(numActiveRows);
+    penaltyApproximation.dfdu.noalias() = hRows.dfdu.transpose() * penaltyDerivative;
+    penaltyApproximation.dfdux.noalias() = dhduActive.transpose() * penaltySecondDev_dhdx;
+    penaltyApproximation.dfduu.noalias() = dhduActive.transpose() * penaltySecondDerivative.head(numActiveRows).asDiagonal() * dhduActive;
+  }
+
+  return penaltyApproximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SoftConstraintPenalty::getQuadraticApproximation(
+    scalar_t t, const vector_t& h, const size_array_t& activeRows, const VectorFunctionQuadraticApproximation& hActive,
+    const size_array_t& inactiveRows, const VectorFunctionLinearApproximation& hInactive) const {
+  const auto stateDim = hActive.dfdx.cols();
+  const auto inputDim = hActive.dfdu.cols();
+  const auto numActiveRows = activeRows.size();
+
+  vector_t penaltyDerivative(numActiveRows);
+  vector_t penaltySecondDerivative(numActiveRows);
+  for (size_t k = 0; k < numActiveRows; k++) {
+    const auto& penaltyTerm = getPenalty(activeRows[k]);
+    penaltyDerivative(k) = penaltyTerm.getDerivative(t, h(activeRows[k]));
+    penaltySecondDerivative(k) = penaltyTerm.getSecondDerivative(t, h(activeRows[k]));
+  }
+  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.asDiagonal() * hActive.dfdx;
+
+  // to make sure that dfdux in the state-only case has a right size
+  ScalarFunctionQuadraticApproximation penaltyApproximation(stateDim, inputDim);
+
+  penaltyApproximation.f = getValue(t, h);
+  penaltyApproximation.dfdx.noalias() = hActive.dfdx.transpose() * penaltyDerivative;
+  penaltyApproximation.dfdxx.noalias() = hActive.dfdx.transpose() * penaltySecondDev_dhdx;
+  for (size_t k = 0; k < numActiveRows; k++) {
+    penaltyApproximation.dfdxx.noalias() += penaltyDerivative(k) * hActive.dfdxx[k];
+  }
+
+  if (inputDim > 0) {
+    penaltyApproximation.dfdu.noalias() = hActive.dfdu.transpose() * penaltyDerivative;
+    penaltyApproximation.dfdux.noalias() = hActive.dfdu.transpose() * penaltySecondDev_dhdx;
+    penaltyApproximation.dfduu.noalias() = hActive.dfdu.transpose() * penaltySecondDerivative.asDiagonal() * hActive.dfdu;
+    for (size_t k = 0; k < numActiveRows; k++) {
+      penaltyApproximation.dfduu.noalias() += penaltyDerivative(k) * hActive.dfduu[k];
+      penaltyApproximation.dfdux.noalias() += penaltyDerivative(k) * hActive.dfdux[k];
+    }
+  }
+
+  // the inactive constraints only contribute to the gradient
+  if (!inactiveRows.empty()) {
+    vector_t inactivePenaltyDerivative(inactiveRows.size());
+    for (size_t k = 0; k < inactiveRows.size(); k++) {
+      inactivePenaltyDerivative(k) = getPenalty(inactiveRows[k]).getDerivative(t, h(inactiveRows[k]));
+    }
+    penaltyApproximation.dfdx.noalias() += hInactive.dfdx.transpose() * inactivePenaltyDerivative;
+    if (inputDim > 0) {
+      penaltyApproximation.dfdu.noalias() += hInactive.dfdu.transpose() * inactivePenaltyDerivative;
+    }
+  }
+
+  return penaltyApproximation;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -35,21 +35,24 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputSoftConstraint::StateInputSoftConstraint(std::unique_ptr<StateInputConstraint> constraintPtr,
-                                                   std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray)
-    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyPtrArray)) {}
+                                                   std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray, scalar_t activityMargin)
+    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyPtrArray)), activityMargin_(activityMargin) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputSoftConstraint::StateInputSoftConstraint(std::unique_ptr<StateInputConstraint> constraintPtr,
-                                                   std::unique_ptr<PenaltyBase> penaltyFunction)
-    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyFunction)) {}
+                                                   std::unique_ptr<PenaltyBase> penaltyFunction, scalar_t activityMargin)
+    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyFunction)), activityMargin_(activityMargin) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputSoftConstraint::StateInputSoftConstraint(const StateInputSoftConstraint& other)
-    : StateInputCost(other), constraintPtr_(other.constraintPtr_->clone()), penalty_(other.penalty_) {}
+    : StateInputCost(other),
+      constraintPtr_(other.constraintPtr_->clone()),
+      penalty_(other.penalty_),
+      activityMargin_(other.activityMargin_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -79,6 +82,10 @@ scalar_t StateInputSoftConstraint::getValue(scalar_t time, const vector_t& state
 ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                          const vector_t& input, const TargetTrajectories&,
                                                                                          const PreComputation& preComp) const {
+  if (activityMargin_ < std::numeric_limits<scalar_t>::infinity()) {
+    return getLazyQuadraticApproximation(time, state, input, preComp);
+  }
+
   switch (constraintPtr_->getOrder()) {
     case ConstraintOrder::Linear:
       return penalty_.getQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, input, preComp));
@@ -89,4 +96,51 @@ ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                                          const vector_t& input,
+                                                                                          const TargetTrajectories&,
+                                                                                          const PreComputation& preComp) const {
+  return penalty_.getFirstOrderApproximation(time, constraintPtr_->getLinearApproximation(time, state, input, preComp));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateInputSoftConstraint::getLazyQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                             const vector_t& input,
+                                                                                             const PreComputation& preComp) const {
+  const vector_t h = constraintPtr_->getValue(time, state, input, preComp);
+
+  size_array_t activeRows, inactiveRows;
+  std::tie(activeRows, inactiveRows) = penalty_.getLazyLinearizationRows(time, h, activityMargin_);
+
+  // all the constraints are far from the boundary with a flat penalty
+  if (activeRows.empty() && inactiveRows.empty()) {
+    auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+    penaltyApproximation.f = penalty_.getValue(time, h);
+    return penaltyApproximation;
+  }
+
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear: {
+      const auto numActiveRows = activeRows.size();
+      activeRows.insert(activeRows.end(), inactiveRows.begin(), inactiveRows.end());
+      return penalty_.getQuadraticApproximation(
+          time, h, activeRows, numActiveRows, constraintPtr_->getPartialLinearApproximation(time, state, input, activeRows, preComp));
+    }
+    case ConstraintOrder::Quadratic: {
+      const auto hActive = constraintPtr_->getPartialQuadraticApproximation(time, state, input, activeRows, preComp);
+      const auto hInactive = inactiveRows.empty()
+                                 ? VectorFunctionLinearApproximation()
+                                 : constraintPtr_->getPartialLinearApproximation(time, state, input, inactiveRows, preComp);
+      return penalty_.getQuadraticApproximation(time, h, activeRows, hActive, inactiveRows, hInactive);
+    }
+    default:
+      throw std::runtime_error("[StateInputSoftConstraint] Unknown constraint Order");
+  }
+}
+
 }  // namespace ocs2
@@ -35,20 +35,24 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateSoftConstraint::StateSoftConstraint(std::unique_ptr<StateConstraint> constraintPtr,
-                                         std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray)
-    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyPtrArray)) {}
+                                         std::vector<std::unique_ptr<PenaltyBase>> penaltyPtrArray, scalar_t activityMargin)
+    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyPtrArray)), activityMargin_(activityMargin) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-StateSoftConstraint::StateSoftConstraint(std::unique_ptr<StateConstraint> constraintPtr, std::unique_ptr<PenaltyBase> penaltyFunction)
-    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyFunction)) {}
+StateSoftConstraint::StateSoftConstraint(std::unique_ptr<StateConstraint> constraintPtr, std::unique_ptr<PenaltyBase> penaltyFunction,
+                                         scalar_t activityMargin)
+    : constraintPtr_(std::move(constraintPtr)), penalty_(std::move(penaltyFunction)), activityMargin_(activityMargin) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateSoftConstraint::StateSoftConstraint(const StateSoftConstraint& other)
-    : StateCost(other), constraintPtr_(other.constraintPtr_->clone()), penalty_(other.penalty_) {}
+    : StateCost(other),
+      constraintPtr_(other.constraintPtr_->clone()),
+      penalty_(other.penalty_),
+      activityMargin_(other.activityMargin_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -78,6 +82,10 @@ scalar_t StateSoftConstraint::getValue(scalar_t time, const vector_t& state, con
 ScalarFunctionQuadraticApproximation StateSoftConstraint::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                     const TargetTrajectories&,
                                                                                     const PreComputation& preComp) const {
+  if (activityMargin_ < std::numeric_limits<scalar_t>::infinity()) {
+    return getLazyQuadraticApproximation(time, state, preComp);
+  }
+
   switch (constraintPtr_->getOrder()) {
     case ConstraintOrder::Linear:
       return penalty_.getQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp));
@@ -88,4 +96,48 @@ ScalarFunctionQuadraticApproximation StateSoftConstraint::getQuadraticApproximat
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateSoftConstraint::getFirstOrderApproximation(scalar_t time, const vector_t& state,
+                                                                                     const TargetTrajectories&,
+                                                                                     const PreComputation& preComp) const {
+  return penalty_.getFirstOrderApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateSoftConstraint::getLazyQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                        const PreComputation& preComp) const {
+  const vector_t h = constraintPtr_->getValue(time, state, preComp);
+
+  size_array_t activeRows, inactiveRows;
+  std::tie(activeRows, inactiveRows) = penalty_.getLazyLinearizationRows(time, h, activityMargin_);
+
+  // all the constraints are far from the boundary with a flat penalty
+  if (activeRows.empty() && inactiveRows.empty()) {
+    auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(state.size(), 0);
+    penaltyApproximation.f = penalty_.getValue(time, h);
+    return penaltyApproximation;
+  }
+
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear: {
+      const auto numActiveRows = activeRows.size();
+      activeRows.insert(activeRows.end(), inactiveRows.begin(), inactiveRows.end());
+      return penalty_.getQuadraticApproximation(time, h, activeRows, numActiveRows,
+                                                constraintPtr_->getPartialLinearApproximation(time, state, activeRows, preComp));
+    }
+    case ConstraintOrder::Quadratic: {
+      const auto hActive = constraintPtr_->getPartialQuadraticApproximation(time, state, activeRows, preComp);
+      const auto hInactive = inactiveRows.empty() ? VectorFunctionLinearApproximation()
+                                                  : constraintPtr_->getPartialLinearApproximation(time, state, inactiveRows, preComp);
+      return penalty_.getQuadraticApproximation(time, h, activeRows, hActive, inactiveRows, hInactive);
+    }
+    default:
+      throw std::runtime_error("[StateSoftConstraint] Unknown constraint Order");
+  }
+}
+
 }  // namespace ocs2
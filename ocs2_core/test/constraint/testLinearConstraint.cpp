@@ -49,6 +49,15 @@ TEST(TestLinearConstraint, testLinearStateInputConstraint) {
   EXPECT_TRUE(approx.f.isApprox(value));
   EXPECT_TRUE(approx.dfdx.isApprox(C));
   EXPECT_TRUE(approx.dfdu.isApprox(D));
+
+  // write into the rows of a larger approximation
+  ocs2::VectorFunctionLinearApproximation inserted = ocs2::VectorFunctionLinearApproximation::Zero(5, 2, 1);
+  EXPECT_EQ(constraint.insertLinearApproximation(t, x, u, ocs2::PreComputation(), 1, inserted), 3);
+  EXPECT_TRUE(inserted.f.segment(1, 3).isApprox(value));
+  EXPECT_TRUE(inserted.dfdx.middleRows(1, 3).isApprox(C));
+  EXPECT_TRUE(inserted.dfdu.middleRows(1, 3).isApprox(D));
+  EXPECT_EQ(inserted.f(0), 0.0);
+  EXPECT_EQ(inserted.f(4), 0.0);
 }
 
 TEST(TestLinearConstraint, testLinearStateConstraint) {
@@ -65,4 +74,10 @@ TEST(TestLinearConstraint, testLinearStateConstraint) {
   EXPECT_TRUE(value.isApprox(C * x + e));
   EXPECT_TRUE(approx.f.isApprox(value));
   EXPECT_TRUE(approx.dfdx.isApprox(C));
+
+  // write into the rows of a larger approximation
+  ocs2::VectorFunctionLinearApproximation inserted = ocs2::VectorFunctionLinearApproximation::Zero(5, 2, 0);
+  EXPECT_EQ(constraint.insertLinearApproximation(t, x, ocs2::PreComputation(), 2, inserted), 3);
+  EXPECT_TRUE(inserted.f.tail(3).isApprox(value));
+  EXPECT_TRUE(inserted.dfdx.bottomRows(3).isApprox(C));
 }
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <iostream>
+
 #include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/Benchmark.h>
 
 using namespace ocs2;
 
@@ -20,7 +23,190 @@ TEST(testLinearController, testSerialization) {
 
   for (int k = 0; k < time.size(); k++) {
     EXPECT_NEAR(controller.timeStamp_[k], controllerOut.timeStamp_[k], 1e-6);
-    EXPECT_TRUE(controller.gainArray_[k].isApprox(controllerOut.gainArray_[k], 1e-6));
+    EXPECT_TRUE(controller.gainArray()[k].isApprox(controllerOut.gainArray()[k], 1e-6));
+    EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
+  }
+}
+
+TEST(testLinearController, unFlattenInPlace) {
+  scalar_array_t time = {0.0, 1.0};
+  vector_array_t bias = {vector_t::Random(2), vector_t::Random(2)};
+  matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+
+  std::vector<std::vector<float>> data(2);
+  std::vector<std::vector<float>*> dataPtr{&data[0], &data[1]};
+  std::vector<std::vector<float> const*> dataPtrConst{&data[0], &data[1]};
+  controller.flatten(time, dataPtr);
+
+  // a recycled controller of the same size keeps its memory
+  LinearController controllerOut({5.0, 6.0}, {vector_t::Zero(2), vector_t::Zero(2)}, {matrix_t::Zero(2, 3), matrix_t::Zero(2, 3)});
+  controllerOut.deltaBiasArray_ = {vector_t::Zero(2), vector_t::Zero(2)};
+  const auto* biasData = controllerOut.biasArray_[1].data();
+  const auto* gainData = controllerOut.gainArray()[1].data();
+  LinearController::unFlatten({3, 3}, {2, 2}, time, dataPtrConst, controllerOut);
+
+  EXPECT_EQ(controllerOut.biasArray_[1].data(), biasData);
+  EXPECT_EQ(controllerOut.gainArray()[1].data(), gainData);
+  EXPECT_TRUE(controllerOut.deltaBiasArray_.empty());
+  ASSERT_EQ(controllerOut.size(), time.size());
+  for (int k = 0; k < time.size(); k++) {
+    EXPECT_NEAR(controller.timeStamp_[k], controllerOut.timeStamp_[k], 1e-6);
+    EXPECT_TRUE(controller.gainArray()[k].isApprox(controllerOut.gainArray()[k], 1e-6));
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
+
+  // a compressed controller is overwritten as well
+  controllerOut.compressGainsStride(2);
+  LinearController::unFlatten({3, 3}, {2, 2}, time, dataPtrConst, controllerOut);
+  EXPECT_FALSE(controllerOut.gainsCompressed());
+  EXPECT_TRUE(controller.gainArray()[1].isApprox(controllerOut.gainArray()[1], 1e-6));
+}
+
+namespace {
+/** Gains that are stationary on the first part of the horizon and smooth afterwards, with an event at the middle time stamp */
+LinearController getLongHorizonController(size_t numTimeStamps, int stateDim, int inputDim) {
+  const matrix_t stationaryGain = matrix_t::Random(inputDim, stateDim);
+  const matrix_t transientGain = matrix_t::Random(inputDim, stateDim);
+  const matrix_t jump = matrix_t::Random(inputDim, stateDim);
+  const scalar_t finalTime = 1.0;
+
+  scalar_array_t time;
+  vector_array_t bias;
+  matrix_array_t gain;
+  for (size_t k = 0; k < numTimeStamps; k++) {
+    const scalar_t t = finalTime * k / (numTimeStamps - 1);
+    time.push_back(t);
+    bias.push_back(vector_t::Random(inputDim));
+    const scalar_t transient = std::max(t - 0.7 * finalTime, 0.0);
+    gain.push_back(stationaryGain + 10.0 * transient * transient * transientGain);
+    if (k >= numTimeStamps / 2) {
+      gain.back() += jump;
+    }
+    if (k == numTimeStamps / 2) {  // event: repeat the time stamp with the gain before the jump
+      time.push_back(t);
+      bias.push_back(bias.back());
+      gain.push_back(gain.back());
+      gain[gain.size() - 2] -= jump;
+    }
+  }
+  return LinearController(time, bias, gain);
+}
+
+/** Maximum element-wise difference of the feedback gains of two controllers, evaluated at random times */
+scalar_t maxGainDifference(const LinearController& a, const LinearController& b, int numSamples = 1000) {
+  scalar_t maxDifference = 0.0;
+  matrix_t gainA, gainB;
+  for (int i = 0; i < numSamples; i++) {
+    const scalar_t t = a.timeStamp_.front() + (a.timeStamp_.back() - a.timeStamp_.front()) * std::rand() / scalar_t(RAND_MAX);
+    a.getFeedbackGain(t, gainA);
+    b.getFeedbackGain(t, gainB);
+    maxDifference = std::max(maxDifference, (gainA - gainB).cwiseAbs().maxCoeff());
+  }
+  return maxDifference;
+}
+}  // namespace
+
+TEST(testLinearController, testRunLengthCompression) {
+  const auto controller = getLongHorizonController(200, 4, 2);
+
+  // lossless: only identical gains are merged
+  auto compressed = controller;
+  EXPECT_DOUBLE_EQ(compressed.compressGainsRunLength(), 0.0);
+  EXPECT_TRUE(compressed.gainsCompressed());
+  EXPECT_LT(compressed.numStoredGains(), controller.size());
+  EXPECT_DOUBLE_EQ(maxGainDifference(controller, compressed), 0.0);
+
+  const vector_t x = vector_t::Random(4);
+  for (int i = 0; i < 100; i++) {
+    const scalar_t t = std::rand() / scalar_t(RAND_MAX);
+    EXPECT_TRUE(controller.clone()->computeInput(t, x).isApprox(compressed.computeInput(t, x)));
+  }
+
+  // lossy: error bounded by the tolerance
+  const scalar_t tolerance = 1e-3;
+  auto lossyCompressed = controller;
+  const scalar_t maxError = lossyCompressed.compressGainsRunLength(tolerance);
+  EXPECT_LE(maxError, tolerance);
+  EXPECT_LT(lossyCompressed.numStoredGains(), compressed.numStoredGains());
+  EXPECT_LE(maxGainDifference(controller, lossyCompressed), maxError + 1e-12);
+
+  // decompression restores one gain per time stamp
+  compressed.decompressGains();
+  EXPECT_FALSE(compressed.gainsCompressed());
+  ASSERT_EQ(compressed.gainArray().size(), controller.gainArray().size());
+  for (size_t k = 0; k < controller.gainArray().size(); k++) {
+    EXPECT_TRUE(compressed.gainArray()[k] == controller.gainArray()[k]);
+  }
+}
+
+TEST(testLinearController, testStrideCompression) {
+  const auto controller = getLongHorizonController(200, 4, 2);
+
+  for (size_t stride : {2, 5, 20}) {
+    auto compressed = controller;
+    const scalar_t maxError = compressed.compressGainsStride(stride);
+    EXPECT_TRUE(compressed.gainsCompressed());
+    EXPECT_LE(compressed.numStoredGains(), controller.size() / stride + 4);
+    // the error bound holds at any time, also around the event
+    EXPECT_LE(maxGainDifference(controller, compressed), maxError + 1e-12) << "stride: " << stride;
+    EXPECT_LT(maxError, 0.1) << "stride: " << stride;
+  }
+
+  // concatenation with a compressed controller
+  auto compressed = controller;
+  compressed.compressGainsStride(5);
+  LinearController concatenated;
+  concatenated.concatenate(&compressed, 0, compressed.size());
+  EXPECT_FALSE(concatenated.gainsCompressed());
+  ASSERT_EQ(concatenated.gainArray().size(), controller.gainArray().size());
+  EXPECT_DOUBLE_EQ(maxGainDifference(concatenated, compressed), 0.0);
+}
+
+TEST(testLinearController, testCompressedGainAccess) {
+  const auto controller = getLongHorizonController(50, 4, 2);
+
+  // the const access to the gains of a compressed controller throws, the non-const one decompresses
+  auto compressed = controller;
+  compressed.compressGainsStride(5);
+  const auto& constCompressed = compressed;
+  EXPECT_THROW(constCompressed.gainArray(), std::runtime_error);
+  ASSERT_EQ(compressed.gainArray().size(), controller.size());
+  EXPECT_FALSE(compressed.gainsCompressed());
+  EXPECT_EQ(constCompressed.gainArray().size(), controller.size());
+
+  // an empty controller is not compressed
+  LinearController empty;
+  EXPECT_DOUBLE_EQ(empty.compressGainsRunLength(), 0.0);
+  EXPECT_DOUBLE_EQ(empty.compressGainsStride(5), 0.0);
+  EXPECT_FALSE(empty.gainsCompressed());
+  EXPECT_TRUE(empty.gainArray().empty());
+}
+
+TEST(testLinearController, benchmarkCompression) {
+  constexpr size_t numTimeStamps = 1000;
+  constexpr int stateDim = 48;
+  constexpr int inputDim = 12;
+  constexpr int numRepeats = 100;
+  const auto controller = getLongHorizonController(numTimeStamps, stateDim, inputDim);
+
+  auto runLength = controller;
+  const scalar_t runLengthError = runLength.compressGainsRunLength(1e-6);
+  auto stride = controller;
+  const scalar_t strideError = stride.compressGainsStride(10);
+
+  auto benchmark = [&](const std::string& name, const LinearController& c, scalar_t maxError) {
+    const size_t memory = c.numStoredGains() * inputDim * stateDim * sizeof(scalar_t);
+    benchmark::RepeatedTimer copyTimer;
+    for (int i = 0; i < numRepeats; i++) {
+      copyTimer.startTimer();
+      std::unique_ptr<ControllerBase> copy(c.clone());
+      copyTimer.endTimer();
+    }
+    std::cerr << "[benchmarkCompression] " << name << ": gains " << memory / 1024 << " [kB], copy " << copyTimer.getAverageInMilliseconds()
+              << " [ms], max gain error " << maxError << "\n";
+  };
+  benchmark("uncompressed", controller, 0.0);
+  benchmark("run length (tolerance 1e-6)", runLength, runLengthError);
+  benchmark("stride 10", stride, strideError);
 }
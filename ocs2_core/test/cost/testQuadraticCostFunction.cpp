@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <iostream>
+
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/cost/StateCostCollection.h>
+#include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/misc/Benchmark.h>
 
 using namespace ocs2;
 
@@ -67,6 +72,29 @@ TEST_F(testQuadraticCost, StateInputCostApproximation) {
   EXPECT_TRUE(L.dfduu.isApprox(R_, PRECISION));
 }
 
+TEST_F(testQuadraticCost, StateInputCostAddApproximation) {
+  QuadraticStateInputCost costFunction(Q_, R_, P_);
+
+  // add to a non-zero approximation
+  ScalarFunctionQuadraticApproximation L;
+  L.f = 1.0;
+  L.dfdx.setRandom(2);
+  L.dfdu.setRandom(1);
+  L.dfdxx.setRandom(2, 2);
+  L.dfdux.setRandom(1, 2);
+  L.dfduu.setRandom(1, 1);
+  auto expected = L;
+  expected += costFunction.getQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_);
+  costFunction.addQuadraticApproximation(t_, x_, u_, targetTrajectories_, preComputation_, L);
+
+  EXPECT_NEAR(L.f, expected.f, PRECISION);
+  EXPECT_TRUE(L.dfdx.isApprox(expected.dfdx, PRECISION));
+  EXPECT_TRUE(L.dfdu.isApprox(expected.dfdu, PRECISION));
+  EXPECT_TRUE(L.dfdxx.isApprox(expected.dfdxx, PRECISION));
+  EXPECT_TRUE(L.dfdux.isApprox(expected.dfdux, PRECISION));
+  EXPECT_TRUE(L.dfduu.isApprox(expected.dfduu, PRECISION));
+}
+
 TEST_F(testQuadraticCost, StateInputCostClone) {
   QuadraticStateInputCost costFunction(Q_, R_, P_);
   auto costFunctionClone = std::unique_ptr<StateInputCost>(costFunction.clone());
@@ -94,6 +122,23 @@ TEST_F(testQuadraticCost, StateCostApproximation) {
   EXPECT_TRUE(Phi.dfdxx.isApprox(Qf_, PRECISION));
 }
 
+TEST_F(testQuadraticCost, StateCostAddApproximation) {
+  QuadraticStateCost costFunction(Qf_);
+
+  auto Phi = ScalarFunctionQuadraticApproximation::Zero(2, 0);
+  Phi.f = 1.0;
+  Phi.dfdx.setRandom(2);
+  Phi.dfdxx.setRandom(2, 2);
+  const auto expected = costFunction.getQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_);
+  const auto initial = Phi;
+  costFunction.addQuadraticApproximation(t_, x_, targetTrajectories_, preComputation_, Phi);
+
+  EXPECT_NEAR(Phi.f, initial.f + expected.f, PRECISION);
+  EXPECT_TRUE(Phi.dfdx.isApprox(initial.dfdx + expected.dfdx, PRECISION));
+  EXPECT_TRUE(Phi.dfdxx.isApprox(initial.dfdxx + expected.dfdxx, PRECISION));
+  EXPECT_EQ(Phi.dfdu.size(), 0);
+}
+
 TEST_F(testQuadraticCost, StateCostClone) {
   QuadraticStateCost costFunction(Qf_);
   auto costFunctionClone = std::unique_ptr<StateCost>(costFunction.clone());
@@ -102,3 +147,57 @@ TEST_F(testQuadraticCost, StateCostClone) {
   auto Lclone = costFunctionClone->getValue(t_, x_, targetTrajectories_, preComputation_);
   EXPECT_NEAR(L, Lclone, PRECISION);
 }
+
+/** Per-node cost approximation with the state and input dimensions of the ballbot and quadrotor examples */
+TEST(testQuadraticCostBenchmark, perNodeApproximation) {
+  constexpr size_t numNodes = 20000;
+  constexpr size_t numTerms = 3;  // e.g. tracking, regularization and task-space terms
+  const std::vector<std::pair<std::string, std::pair<size_t, size_t>>> examples{{"ballbot", {10, 3}}, {"quadrotor", {12, 4}}};
+
+  for (const auto& example : examples) {
+    const size_t stateDim = example.second.first;
+    const size_t inputDim = example.second.second;
+    const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(stateDim)}, {vector_t::Random(inputDim)});
+    const vector_t x = vector_t::Random(stateDim);
+    const vector_t u = vector_t::Random(inputDim);
+
+    StateInputCostCollection costCollection;
+    std::vector<const StateInputCost*> costTerms;
+    for (size_t i = 0; i < numTerms; i++) {
+      const matrix_t Q = (i + 1.0) * matrix_t::Identity(stateDim, stateDim);
+      const matrix_t R = (i + 1.0) * matrix_t::Identity(inputDim, inputDim);
+      const std::string name = "cost" + std::to_string(i);
+      costCollection.add(name, std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(Q, R)));
+      costTerms.push_back(&costCollection.get(name));
+    }
+
+    // summing copies of the term approximations, as done before the in-place accumulation
+    benchmark::RepeatedTimer copyTimer;
+    scalar_t copySum = 0.0;
+    copyTimer.startTimer();
+    for (size_t k = 0; k < numNodes; k++) {
+      auto L = costTerms.front()->getQuadraticApproximation(0.0, x, u, targetTrajectories, PreComputation());
+      for (size_t i = 1; i < numTerms; i++) {
+        L += costTerms[i]->getQuadraticApproximation(0.0, x, u, targetTrajectories, PreComputation());
+      }
+      copySum += L.f + L.dfdxx(0, 0);
+    }
+    copyTimer.endTimer();
+
+    // in-place accumulation of the collection
+    benchmark::RepeatedTimer collectionTimer;
+    scalar_t collectionSum = 0.0;
+    collectionTimer.startTimer();
+    for (size_t k = 0; k < numNodes; k++) {
+      const auto L = costCollection.getQuadraticApproximation(0.0, x, u, targetTrajectories, PreComputation());
+      collectionSum += L.f + L.dfdxx(0, 0);
+    }
+    collectionTimer.endTimer();
+
+    EXPECT_NEAR(copySum, collectionSum, 1e-9 * std::abs(copySum));
+    std::cerr << "[perNodeApproximation] " << example.first << " (" << stateDim << ", " << inputDim << "), " << numTerms << " terms, "
+              << numNodes << " nodes\n"
+              << "  copied approximations [ms]: " << copyTimer.getTotalInMilliseconds() << "\n"
+              << "  in-place accumulation [ms]: " << collectionTimer.getTotalInMilliseconds() << "\n";
+  }
+}
@@ -0,0 +1,273 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/cost/QuasiNewtonStateCost.h>
+#include <ocs2_core/cost/QuasiNewtonStateInputCost.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_core/soft_constraint/StateSoftConstraint.h>
+#include <ocs2_core/soft_constraint/penalties/QuadraticPenalty.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Quadratic state-input cost with a coupled Hessian which only provides gradients */
+class GradientOnlyQuadraticCost final : public StateInputCost {
+ public:
+  explicit GradientOnlyQuadraticCost(matrix_t H) : H_(std::move(H)) {}
+  GradientOnlyQuadraticCost* clone() const override { return new GradientOnlyQuadraticCost(*this); }
+
+  scalar_t getValue(scalar_t t, const vector_t& x, const vector_t& u, const TargetTrajectories&, const PreComputation&) const override {
+    const vector_t z = stack(x, u);
+    return 0.5 * z.dot(H_ * z);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                 const TargetTrajectories&, const PreComputation&) const override {
+    throw std::runtime_error("[GradientOnlyQuadraticCost] The Hessian is not available!");
+  }
+
+  ScalarFunctionQuadraticApproximation getFirstOrderApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                  const TargetTrajectories&, const PreComputation&) const override {
+    const vector_t z = stack(x, u);
+    const vector_t gradient = H_ * z;
+    auto cost = ScalarFunctionQuadraticApproximation::Zero(x.size(), u.size());
+    cost.f = 0.5 * z.dot(gradient);
+    cost.dfdx = gradient.head(x.size());
+    cost.dfdu = gradient.tail(u.size());
+    return cost;
+  }
+
+  const matrix_t& getHessian() const { return H_; }
+
+ private:
+  static vector_t stack(const vector_t& x, const vector_t& u) {
+    vector_t z(x.size() + u.size());
+    z << x, u;
+    return z;
+  }
+
+  matrix_t H_;
+};
+
+/** Smooth convex state cost: sum_i exp(a_i' x) + 0.5 |x|^2 */
+class ExponentialStateCost final : public StateCost {
+ public:
+  explicit ExponentialStateCost(matrix_t A) : A_(std::move(A)) {}
+  ExponentialStateCost* clone() const override { return new ExponentialStateCost(*this); }
+
+  scalar_t getValue(scalar_t t, const vector_t& x, const TargetTrajectories&, const PreComputation&) const override {
+    return (A_ * x).array().exp().sum() + 0.5 * x.squaredNorm();
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories&,
+                                                                 const PreComputation&) const override {
+    const vector_t e = (A_ * x).array().exp();
+    ScalarFunctionQuadraticApproximation cost;
+    cost.f = e.sum() + 0.5 * x.squaredNorm();
+    cost.dfdx = A_.transpose() * e + x;
+    cost.dfdxx = A_.transpose() * e.asDiagonal() * A_ + matrix_t::Identity(x.size(), x.size());
+    return cost;
+  }
+
+ private:
+  matrix_t A_;
+};
+
+}  // unnamed namespace
+
+TEST(testQuasiNewtonCost, sr1RecoversQuadraticHessian) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+  constexpr scalar_t time = 0.5;
+  const matrix_t H = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim + inputDim);
+
+  quasi_newton::Settings settings;
+  settings.update = quasi_newton::HessianUpdate::SR1;
+  QuasiNewtonStateInputCost cost(std::unique_ptr<StateInputCost>(new GradientOnlyQuadraticCost(H)), settings);
+  PreComputation preComp;
+  preComp.setNodeIndex(0);
+
+  // n + 1 random points at the same node give n independent steps
+  ScalarFunctionQuadraticApproximation approximation;
+  for (size_t i = 0; i < stateDim + inputDim + 1; i++) {
+    approximation = cost.getQuadraticApproximation(time, vector_t::Random(stateDim), vector_t::Random(inputDim), {}, preComp);
+  }
+
+  EXPECT_TRUE(approximation.dfdxx.isApprox(H.topLeftCorner(stateDim, stateDim), 1e-6));
+  EXPECT_TRUE(approximation.dfdux.isApprox(H.bottomLeftCorner(inputDim, stateDim), 1e-6));
+  EXPECT_TRUE(approximation.dfduu.isApprox(H.bottomRightCorner(inputDim, inputDim), 1e-6));
+}
+
+TEST(testQuasiNewtonCost, bfgsSecantCondition) {
+  constexpr size_t stateDim = 5;
+  constexpr size_t inputDim = 3;
+  constexpr scalar_t time = 0.0;
+  const matrix_t H = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim + inputDim);
+
+  quasi_newton::Settings settings;
+  settings.update = quasi_newton::HessianUpdate::BFGS;
+  settings.dampingThreshold = 0.0;  // on a convex quadratic, the update is then never damped
+  QuasiNewtonStateInputCost cost(std::unique_ptr<StateInputCost>(new GradientOnlyQuadraticCost(H)), settings);
+  PreComputation preComp;
+  preComp.setNodeIndex(0);
+
+  vector_t previousPoint = vector_t::Random(stateDim + inputDim);
+  cost.getQuadraticApproximation(time, previousPoint.head(stateDim), previousPoint.tail(inputDim), {}, preComp);
+  for (size_t i = 0; i < 10; i++) {
+    const vector_t point = vector_t::Random(stateDim + inputDim);
+    const auto approximation = cost.getQuadraticApproximation(time, point.head(stateDim), point.tail(inputDim), {}, preComp);
+
+    matrix_t B(stateDim + inputDim, stateDim + inputDim);
+    B << approximation.dfdxx, approximation.dfdux.transpose(), approximation.dfdux, approximation.dfduu;
+    const vector_t s = point - previousPoint;
+    EXPECT_TRUE((B * s).isApprox(H * s, 1e-8));
+    EXPECT_GT(LinearAlgebra::symmetricEigenvalues(B).minCoeff(), 0.0);
+    previousPoint = point;
+  }
+}
+
+TEST(testQuasiNewtonCost, nodes) {
+  constexpr size_t stateDim = 3;
+  constexpr size_t inputDim = 1;
+  const matrix_t H = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim + inputDim);
+
+  quasi_newton::Settings settings;
+  settings.update = quasi_newton::HessianUpdate::SR1;
+  settings.initialHessianScaling = 2.0;
+  QuasiNewtonStateInputCost cost(std::unique_ptr<StateInputCost>(new GradientOnlyQuadraticCost(H)), settings);
+  std::unique_ptr<QuasiNewtonStateInputCost> clonedCost(cost.clone());
+  PreComputation preComp;
+
+  // the solver has to provide the node index
+  EXPECT_THROW(cost.getQuadraticApproximation(0.0, vector_t::Random(stateDim), vector_t::Random(inputDim), {}, preComp),
+               std::runtime_error);
+
+  // the first evaluation of a node returns the initial estimate
+  preComp.setNodeIndex(0);
+  auto approximation = cost.getQuadraticApproximation(0.0, vector_t::Random(stateDim), vector_t::Random(inputDim), {}, preComp);
+  EXPECT_TRUE(approximation.dfduu.isApprox(2.0 * matrix_t::Identity(inputDim, inputDim)));
+
+  // the clone updates the same node, even if the time of the node changes between the iterations, e.g. with an adaptive rollout
+  for (size_t i = 0; i < stateDim + inputDim; i++) {
+    approximation = clonedCost->getQuadraticApproximation(0.01 * i + 0.003, vector_t::Random(stateDim), vector_t::Random(inputDim), {},
+                                                          preComp);
+  }
+  EXPECT_TRUE(approximation.dfdxx.isApprox(H.topLeftCorner(stateDim, stateDim), 1e-6));
+  EXPECT_EQ(cost.getHessianEstimate().getNumNodes(), 1);
+  EXPECT_EQ(cost.getHessianEstimate().getNumUpdates(), stateDim + inputDim);
+
+  // a new node starts from its closest node
+  preComp.setNodeIndex(5);
+  approximation = cost.getQuadraticApproximation(0.5, vector_t::Random(stateDim), vector_t::Random(inputDim), {}, preComp);
+  EXPECT_TRUE(approximation.dfdxx.isApprox(H.topLeftCorner(stateDim, stateDim), 1e-6));
+  EXPECT_EQ(cost.getHessianEstimate().getNumNodes(), 2);
+
+  // the pre-event and the post-event nodes share their time, but are kept apart: evaluating each of them at its own point does not
+  // form a secant pair between them
+  const vector_t preEventState = vector_t::Random(stateDim);
+  const vector_t postEventState = vector_t::Random(stateDim);
+  const vector_t input = vector_t::Random(inputDim);
+  const size_t numUpdates = cost.getHessianEstimate().getNumUpdates();
+  for (size_t i = 0; i < 3; i++) {
+    preComp.setNodeIndex(5);
+    cost.getQuadraticApproximation(0.5, preEventState, input, {}, preComp);
+    preComp.setNodeIndex(6);
+    cost.getQuadraticApproximation(0.5, postEventState, input, {}, preComp);
+  }
+  EXPECT_EQ(cost.getHessianEstimate().getNumNodes(), 3);
+  EXPECT_EQ(cost.getHessianEstimate().getNumUpdates(), numUpdates + 1);  // node 5 moved once to preEventState
+
+  cost.getHessianEstimate().clear();
+  EXPECT_EQ(clonedCost->getHessianEstimate().getNumNodes(), 0);
+  EXPECT_EQ(clonedCost->getHessianEstimate().getNumUpdates(), 0);
+}
+
+TEST(testQuasiNewtonCost, softConstraintGradient) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t numConstraints = 2;
+  std::unique_ptr<StateConstraint> constraintPtr(
+      new LinearStateConstraint(vector_t::Random(numConstraints), matrix_t::Random(numConstraints, stateDim)));
+  StateSoftConstraint softConstraint(std::move(constraintPtr), std::unique_ptr<PenaltyBase>(new QuadraticPenalty(10.0)));
+
+  const vector_t x = vector_t::Random(stateDim);
+  const auto quadraticApproximation = softConstraint.getQuadraticApproximation(0.0, x, {}, {});
+  const auto firstOrderApproximation = softConstraint.getFirstOrderApproximation(0.0, x, {}, {});
+  EXPECT_DOUBLE_EQ(firstOrderApproximation.f, quadraticApproximation.f);
+  EXPECT_TRUE(firstOrderApproximation.dfdx.isApprox(quadraticApproximation.dfdx));
+  EXPECT_TRUE(firstOrderApproximation.dfdxx.isZero());
+}
+
+TEST(testQuasiNewtonCost, convergence) {
+  constexpr size_t stateDim = 6;
+  constexpr size_t maxNumIterations = 50;
+  constexpr scalar_t tolerance = 1e-9;
+  const matrix_t A = 0.5 * matrix_t::Random(2 * stateDim, stateDim);
+
+  // Newton iterations with the exact Hessian, and with the quasi-Newton estimates. As in DDP, the Hessian is corrected to be
+  // positive definite, and the step is found by a backtracking line search.
+  auto solve = [&](const StateCost& cost) {
+    PreComputation preComp;
+    preComp.setNodeIndex(0);
+    vector_t x = vector_t::Ones(stateDim);
+    for (size_t i = 0; i < maxNumIterations; i++) {
+      auto approximation = cost.getQuadraticApproximation(0.0, x, {}, preComp);
+      if (approximation.dfdx.norm() < tolerance) {
+        return i;
+      }
+      LinearAlgebra::makePsdEigenvalue(approximation.dfdxx, 1e-3);
+      const vector_t dx = -approximation.dfdxx.ldlt().solve(approximation.dfdx);
+      scalar_t stepLength = 1.0;
+      while (cost.getValue(0.0, x + stepLength * dx, {}, {}) > approximation.f + 1e-4 * stepLength * approximation.dfdx.dot(dx) &&
+             stepLength > 1e-3) {
+        stepLength *= 0.5;
+      }
+      x += stepLength * dx;
+    }
+    return maxNumIterations;
+  };
+
+  const ExponentialStateCost exactCost(A);
+  QuasiNewtonStateCost bfgsCost(std::unique_ptr<StateCost>(exactCost.clone()));
+  quasi_newton::Settings sr1Settings;
+  sr1Settings.update = quasi_newton::HessianUpdate::SR1;
+  QuasiNewtonStateCost sr1Cost(std::unique_ptr<StateCost>(exactCost.clone()), sr1Settings);
+
+  const auto newtonIterations = solve(exactCost);
+  const auto bfgsIterations = solve(bfgsCost);
+  const auto sr1Iterations = solve(sr1Cost);
+  std::cerr << "[testQuasiNewtonCost] iterations to convergence, Newton: " << newtonIterations << ", BFGS: " << bfgsIterations
+            << ", SR1: " << sr1Iterations << "\n";
+  EXPECT_LT(bfgsIterations, maxNumIterations);
+  EXPECT_LT(sr1Iterations, maxNumIterations);
+}
@@ -0,0 +1,199 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
+#include <ocs2_core/automatic_differentiation/ParallelFiniteDifference.h>
+
+using namespace ocs2;
+
+namespace {
+
+/**
+ * Nonlinear system with analytic Jacobians: dx_i/dt = sin(x_i) * x_{i+1} + cos(u_{i mod m}) * x_i. The flow map is evaluated
+ * numRepetitions times to emulate an expensive model.
+ */
+class CoupledSystem final : public ControlledSystemBase {
+ public:
+  CoupledSystem(size_t stateDim, size_t inputDim, size_t numRepetitions = 1)
+      : stateDim_(stateDim), inputDim_(inputDim), numRepetitions_(numRepetitions), numEvaluationsPtr_(new std::atomic_size_t(0)) {}
+  ~CoupledSystem() override = default;
+  CoupledSystem* clone() const override { return new CoupledSystem(*this); }
+
+  using ControlledSystemBase::computeFlowMap;
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override {
+    ++(*numEvaluationsPtr_);
+    vector_t dxdt = vector_t::Zero(stateDim_);
+    for (size_t r = 0; r < numRepetitions_; r++) {
+      for (size_t i = 0; i < stateDim_; i++) {
+        dxdt(i) += std::sin(x(i)) * x((i + 1) % stateDim_) + std::cos(u(i % inputDim_)) * x(i);
+      }
+    }
+    return dxdt / static_cast<scalar_t>(numRepetitions_);
+  }
+
+  VectorFunctionLinearApproximation getLinearApproximation(const vector_t& x, const vector_t& u) const {
+    VectorFunctionLinearApproximation linearApproximation;
+    linearApproximation.dfdx.setZero(stateDim_, stateDim_);
+    linearApproximation.dfdu.setZero(stateDim_, inputDim_);
+    for (size_t i = 0; i < stateDim_; i++) {
+      const size_t next = (i + 1) % stateDim_;
+      linearApproximation.dfdx(i, i) += std::cos(x(i)) * x(next) + std::cos(u(i % inputDim_));
+      linearApproximation.dfdx(i, next) += std::sin(x(i));
+      linearApproximation.dfdu(i, i % inputDim_) = -std::sin(u(i % inputDim_)) * x(i);
+    }
+    return linearApproximation;
+  }
+
+  /** Number of flow map evaluations of this system and all its clones */
+  size_t getNumEvaluations() const { return *numEvaluationsPtr_; }
+
+ private:
+  size_t stateDim_;
+  size_t inputDim_;
+  size_t numRepetitions_;
+  std::shared_ptr<std::atomic_size_t> numEvaluationsPtr_;
+};
+
+}  // unnamed namespace
+
+TEST(testParallelFiniteDifference, accuracy) {
+  constexpr size_t stateDim = 8;
+  constexpr size_t inputDim = 3;
+  CoupledSystem system(stateDim, inputDim);
+
+  for (const bool doubleSidedDerivative : {true, false}) {
+    const scalar_t eps = doubleSidedDerivative ? 1e-6 : 1e-8;
+    const scalar_t tolerance = doubleSidedDerivative ? 1e-8 : 1e-6;
+    for (const size_t nThreads : {1, 3}) {
+      ParallelFiniteDifference finiteDifference(system, nThreads, eps, doubleSidedDerivative);
+      for (size_t i = 0; i < 10; i++) {
+        const vector_t x = vector_t::Random(stateDim);
+        const vector_t u = vector_t::Random(inputDim);
+        const auto expected = system.getLinearApproximation(x, u);
+        const auto& approximation = finiteDifference.linearApproximation(0.0, x, u);
+        EXPECT_TRUE(approximation.f.isApprox(system.computeFlowMap(0.0, x, u)));
+        EXPECT_LT((approximation.dfdx - expected.dfdx).lpNorm<Eigen::Infinity>(), tolerance) << "nThreads: " << nThreads;
+        EXPECT_LT((approximation.dfdu - expected.dfdu).lpNorm<Eigen::Infinity>(), tolerance) << "nThreads: " << nThreads;
+
+        // the same perturbations as the sequential implementation
+        const matrix_t A = finiteDifferenceDerivativeState(system, 0.0, x, u, eps, doubleSidedDerivative);
+        const matrix_t B = finiteDifferenceDerivativeInput(system, 0.0, x, u, eps, doubleSidedDerivative);
+        EXPECT_TRUE(approximation.dfdx.isApprox(A, 1e-12));
+        EXPECT_TRUE(approximation.dfdu.isApprox(B, 1e-12));
+      }
+    }
+  }
+}
+
+TEST(testParallelFiniteDifference, secondOrderSystem) {
+  constexpr size_t stateDim = 6;
+  constexpr size_t inputDim = 2;
+  constexpr size_t halfDim = stateDim / 2;
+  constexpr scalar_t eps = 1e-6;
+  CoupledSystem system(stateDim, inputDim);
+  ParallelFiniteDifference finiteDifference(system, 2, eps, /*doubleSidedDerivative=*/true, /*isSecondOrderSystem=*/true);
+
+  const vector_t x = vector_t::Random(stateDim);
+  const vector_t u = vector_t::Random(inputDim);
+  const auto& approximation = finiteDifference.linearApproximation(0.0, x, u);
+  const matrix_t A = finiteDifferenceDerivativeState(system, 0.0, x, u, eps);
+  EXPECT_TRUE(approximation.dfdx.topLeftCorner(halfDim, halfDim).isZero());
+  EXPECT_TRUE(approximation.dfdx.topRightCorner(halfDim, halfDim).isIdentity());
+  EXPECT_TRUE(approximation.dfdx.bottomRows(halfDim).isApprox(A.bottomRows(halfDim)));
+  EXPECT_TRUE(approximation.dfdu.topRows(halfDim).isZero());
+}
+
+TEST(testParallelFiniteDifference, cache) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+  CoupledSystem system(stateDim, inputDim);
+  ParallelFiniteDifference finiteDifference(system, 2, 1e-6);
+
+  const vector_t x = vector_t::Random(stateDim);
+  const vector_t u = vector_t::Random(inputDim);
+  finiteDifference.linearApproximation(0.0, x, u);
+  const size_t numEvaluations = system.getNumEvaluations();
+  EXPECT_EQ(numEvaluations, 1 + 2 * (stateDim + inputDim));
+
+  // the same query
+  finiteDifference.linearApproximation(0.0, x, u);
+  EXPECT_EQ(system.getNumEvaluations(), numEvaluations);
+
+  // a different time, or a cleared cache
+  finiteDifference.linearApproximation(0.1, x, u);
+  EXPECT_EQ(system.getNumEvaluations(), 2 * numEvaluations);
+  finiteDifference.clearCache();
+  finiteDifference.linearApproximation(0.1, x, u);
+  EXPECT_EQ(system.getNumEvaluations(), 3 * numEvaluations);
+}
+
+TEST(testParallelFiniteDifference, scalingBenchmark) {
+  constexpr size_t stateDim = 36;
+  constexpr size_t inputDim = 12;
+  constexpr size_t numRepetitions = 100;
+  constexpr size_t numLinearizations = 20;
+  constexpr scalar_t eps = 1e-6;
+  CoupledSystem system(stateDim, inputDim, numRepetitions);
+
+  std::vector<vector_t> stateTrajectory, inputTrajectory;
+  for (size_t i = 0; i < numLinearizations; i++) {
+    stateTrajectory.push_back(vector_t::Random(stateDim));
+    inputTrajectory.push_back(vector_t::Random(inputDim));
+  }
+
+  // average time per linearization [ms]
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numLinearizations; i++) {
+    finiteDifferenceDerivativeState(system, 0.0, stateTrajectory[i], inputTrajectory[i], eps);
+    finiteDifferenceDerivativeInput(system, 0.0, stateTrajectory[i], inputTrajectory[i], eps);
+  }
+  const scalar_t sequentialTime =
+      std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - start).count() / numLinearizations;
+
+  std::cerr << "[scalingBenchmark] state dim: " << stateDim << ", input dim: " << inputDim << ", central differences\n"
+            << "  sequential: " << sequentialTime << " [ms]\n";
+  for (const size_t nThreads : {1, 2, 4}) {
+    ParallelFiniteDifference finiteDifference(system, nThreads, eps);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numLinearizations; i++) {
+      finiteDifference.linearApproximation(0.0, stateTrajectory[i], inputTrajectory[i]);
+    }
+    const scalar_t parallelTime =
+        std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - start).count() / numLinearizations;
+    std::cerr << "  " << nThreads << " thread(s): " << parallelTime << " [ms], speedup: " << sequentialTime / parallelTime << "\n";
+  }
+}
@@ -29,14 +29,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <ocs2_core/misc/Log.h>
+#include <ocs2_core/misc/Benchmark.h>
 
 TEST(testLogging, canPrintMessage) {
   ocs2::log::Settings settings;
@@ -155,3 +160,122 @@ log
   EXPECT_EQ(settings.logFileSeverity, ocs2::log::SeverityLevel::WARNING);
   EXPECT_EQ(settings.logFileName, "ocs2.log");
 }
+
+TEST(testLogging, asynchronousWritesCorrectMessageToConsole) {
+  ocs2::log::Settings settings;
+
+  settings.useLogFile = false;
+  settings.useConsole = true;
+  settings.consoleSeverity = ocs2::log::SeverityLevel::INFO;
+  settings.asynchronous = true;
+
+  std::ostringstream console_stream;
+  ocs2::log::init(settings, &console_stream);
+
+  OCS2_LOG(DEBUG) << "NOT logged";
+  OCS2_LOG(INFO) << "An informational severity message";
+  OCS2_LOG(WARNING) << "A warning severity message " << 1.5;
+  OCS2_LOG(ERROR) << "An error severity message " << std::string(2 * ocs2::log::maxAsyncMessageLength, 'x');
+
+  ocs2::log::flush();
+
+  const std::string message = "An error severity message " + std::string(2 * ocs2::log::maxAsyncMessageLength, 'x');
+  const std::string expect =
+      "[    INFO ] An informational severity message\n"
+      "[ WARNING ] A warning severity message 1.5\n"
+      "[   ERROR ] " +
+      message.substr(0, ocs2::log::maxAsyncMessageLength) + "\n";
+
+  EXPECT_EQ(console_stream.str(), expect);
+
+  ocs2::log::reset();
+}
+
+TEST(testLogging, asynchronousKeepsOrderOfThreads) {
+  constexpr size_t numThreads = 4;
+  constexpr size_t numMessages = 500;
+
+  ocs2::log::Settings settings;
+  settings.useLogFile = false;
+  settings.useConsole = true;
+  settings.consoleSeverity = ocs2::log::SeverityLevel::DEBUG;
+  settings.asynchronous = true;
+
+  std::ostringstream console_stream;
+  ocs2::log::init(settings, &console_stream);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; t++) {
+    threads.emplace_back([t]() {
+      for (size_t i = 0; i < numMessages; i++) {
+        OCS2_LOG(INFO) << t << ' ' << i;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ocs2::log::reset();
+
+  std::vector<size_t> nextMessage(numThreads, 0);
+  std::istringstream lines(console_stream.str());
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream message(line.substr(std::string("[    INFO ] ").size()));
+    size_t t, i;
+    message >> t >> i;
+    ASSERT_LT(t, numThreads);
+    EXPECT_EQ(i, nextMessage[t]++);
+  }
+  for (const auto n : nextMessage) {
+    EXPECT_EQ(n, numMessages);
+  }
+}
+
+TEST(testLogging, benchmarkHotPathLatency) {
+  constexpr size_t numThreads = 4;
+  constexpr size_t numMessages = 1000;
+
+  std::cerr << "\n[testLogging] latency of a log call with " << numThreads << " contending threads\n";
+  for (const bool asynchronous : {false, true}) {
+    ocs2::log::Settings settings;
+    settings.useLogFile = false;
+    settings.useConsole = true;
+    settings.consoleSeverity = ocs2::log::SeverityLevel::DEBUG;
+    settings.asynchronous = asynchronous;
+
+    std::ostringstream console_stream;
+    ocs2::log::init(settings, &console_stream);
+
+    std::vector<ocs2::benchmark::RepeatedTimer> timers(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; t++) {
+      threads.emplace_back([t, &timers]() {
+        // the first call of a thread registers its ring buffer in the asynchronous mode
+        OCS2_LOG(DEBUG) << "thread " << t << " started";
+        for (size_t i = 0; i < numMessages; i++) {
+          timers[t].startTimer();
+          OCS2_LOG(INFO) << "thread " << t << " message " << i << " value " << 0.1 * i;
+          timers[t].endTimer();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ocs2::log::reset();
+
+    const auto log = console_stream.str();
+    const auto numLines = std::count(log.begin(), log.end(), '\n');
+    EXPECT_EQ(numLines, numThreads * (numMessages + 1));
+
+    ocs2::scalar_t average = 0.0;
+    ocs2::scalar_t maximum = 0.0;
+    for (const auto& timer : timers) {
+      average += timer.getAverageInMilliseconds() / numThreads;
+      maximum = std::max(maximum, timer.getMaxIntervalInMilliseconds());
+    }
+    std::cerr << (asynchronous ? "asynchronous" : "synchronous ") << " average: " << 1e3 * average << " [us], maximum: " << 1e3 * maximum
+              << " [us]\n";
+  }
+}
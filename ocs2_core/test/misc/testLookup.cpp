@@ -169,3 +169,23 @@ TEST(testLookup, findBoundedActiveIntervalInTimeArray)
   ASSERT_ANY_THROW(findBoundedActiveIntervalInTimeArray(timeArrayEmpty,  0.0));
   ASSERT_ANY_THROW(findBoundedActiveIntervalInTimeArray(timeArrayEmpty,  1.0));
 }
+
+TEST(testLookup, findIndexInTimeArray_withHint)
+{
+  std::vector<double> timeArrayRepeated{-1.0, 2.0, 2.0, 2.0, 3.0, 4.0, 4.5, 5.0, 6.0, 7.0};
+  const std::vector<double> queries{-2.0, -1.0, 0.0, 1.9, 2.0, 2.1, 3.0, 4.2, 5.0, 6.5, 7.0, 8.0};
+  const int size = static_cast<int>(timeArrayRepeated.size());
+
+  // Any hint gives the same result as the plain lookup
+  for (const auto t : queries) {
+    for (int hint = -2; hint <= size + 2; hint++) {
+      ASSERT_EQ(findIndexInTimeArray(timeArrayRepeated, t, hint), findIndexInTimeArray(timeArrayRepeated, t));
+      ASSERT_EQ(findIntervalInTimeArray(timeArrayRepeated, t, hint), findIntervalInTimeArray(timeArrayRepeated, t));
+    }
+  }
+
+  // empty time
+  std::vector<double> timeArrayEmpty;
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 0.0, 3), 0);
+  ASSERT_EQ(findIntervalInTimeArray(timeArrayEmpty, 0.0, 3), 0);
+}
@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+
+#include <ocs2_core/reference/ModeSchedule.h>
+
+using namespace ocs2;
+
+namespace {
+/** A gait-like mode schedule with the given number of events, which are evenly spaced in [0, 1]. */
+ModeSchedule getPeriodicModeSchedule(size_t numEvents) {
+  std::vector<scalar_t> eventTimes(numEvents);
+  std::vector<size_t> modeSequence(numEvents + 1);
+  for (size_t i = 0; i < numEvents; i++) {
+    eventTimes[i] = static_cast<scalar_t>(i + 1) / (numEvents + 1);
+    modeSequence[i] = i % 4;
+  }
+  modeSequence.back() = numEvents % 4;
+  return {eventTimes, modeSequence};
+}
+}  // unnamed namespace
+
+TEST(testModeSchedule, cursorLookup) {
+  const auto modeSchedule = getPeriodicModeSchedule(20);
+
+  // monotone times, including the event times and the times outside of the schedule
+  std::vector<scalar_t> times{-1.0};
+  for (size_t k = 0; k <= 1000; k++) {
+    times.push_back(k / 1000.0);
+  }
+  times.insert(times.end(), modeSchedule.eventTimes.begin(), modeSchedule.eventTimes.end());
+  times.push_back(2.0);
+  std::sort(times.begin(), times.end());
+
+  int cursor = 0;
+  for (const auto t : times) {
+    ASSERT_EQ(modeSchedule.modeAtTime(t, cursor), modeSchedule.modeAtTime(t)) << "time: " << t;
+  }
+
+  // random times, and a stale cursor
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<scalar_t> distribution(-0.5, 1.5);
+  cursor = 1000;
+  for (size_t k = 0; k < 1000; k++) {
+    const scalar_t t = distribution(generator);
+    ASSERT_EQ(modeSchedule.modeAtTime(t, cursor), modeSchedule.modeAtTime(t)) << "time: " << t;
+  }
+
+  // a schedule without events
+  const ModeSchedule singleMode;
+  cursor = 5;
+  EXPECT_EQ(singleMode.modeAtTime(0.5, cursor), 0);
+  EXPECT_EQ(cursor, 0);
+}
+
+/**
+ * The mode lookup at each node of a time trajectory, e.g. in the per-node dynamics or cost evaluation of a contact-rich problem: a
+ * fresh binary search, the cursor lookup, and the event indices which are precomputed once per rollout.
+ */
+TEST(testModeSchedule, lookupBenchmark) {
+  constexpr size_t numNodes = 10000;
+  constexpr size_t numRepetitions = 20;
+
+  for (const size_t numEvents : {10, 100, 1000}) {
+    const auto modeSchedule = getPeriodicModeSchedule(numEvents);
+    std::vector<scalar_t> timeTrajectory(numNodes);
+    for (size_t k = 0; k < numNodes; k++) {
+      timeTrajectory[k] = static_cast<scalar_t>(k) / (numNodes - 1);
+    }
+
+    size_t checksum[3] = {0, 0, 0};
+    scalar_t lookupTime[3] = {0.0, 0.0, 0.0};  // [ns] per node
+    auto measure = [&](size_t method, const std::function<size_t(size_t)>& modeAtNode) {
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t r = 0; r < numRepetitions; r++) {
+        for (size_t k = 0; k < numNodes; k++) {
+          checksum[method] += modeAtNode(k);
+        }
+      }
+      lookupTime[method] =
+          std::chrono::duration<scalar_t, std::nano>(std::chrono::steady_clock::now() - start).count() / (numRepetitions * numNodes);
+    };
+
+    measure(0, [&](size_t k) { return modeSchedule.modeAtTime(timeTrajectory[k]); });
+
+    int cursor = 0;
+    measure(1, [&](size_t k) { return modeSchedule.modeAtTime(timeTrajectory[k], cursor); });
+
+    // precomputed in a single merge pass over the time trajectory and the event times
+    std::vector<size_t> eventIndices(numNodes);
+    for (size_t k = 0, e = 0; k < numNodes; k++) {
+      while (e < modeSchedule.eventTimes.size() && modeSchedule.eventTimes[e] < timeTrajectory[k]) {
+        e++;
+      }
+      eventIndices[k] = e;
+    }
+    measure(2, [&](size_t k) { return modeSchedule.modeSequence[eventIndices[k]]; });
+
+    EXPECT_EQ(checksum[1], checksum[0]);
+    EXPECT_EQ(checksum[2], checksum[0]);
+    std::cerr << "[lookupBenchmark] " << numEvents << " events, " << numNodes << " nodes\n"
+              << "  binary search:       " << lookupTime[0] << " [ns] per node\n"
+              << "  cursor:              " << lookupTime[1] << " [ns] per node\n"
+              << "  precomputed indices: " << lookupTime[2] << " [ns] per node\n";
+  }
+}
@@ -0,0 +1,210 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+using namespace ocs2;
+
+namespace {
+TargetTrajectories getLinearTargetTrajectories(scalar_t startTime, scalar_t timeStep, size_t numPoints) {
+  TargetTrajectories targetTrajectories(numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    const scalar_t t = startTime + i * timeStep;
+    targetTrajectories.timeTrajectory[i] = t;
+    targetTrajectories.stateTrajectory[i] = vector_t::Constant(2, t);
+    targetTrajectories.inputTrajectory[i] = vector_t::Constant(1, -t);
+  }
+  return targetTrajectories;
+}
+}  // unnamed namespace
+
+TEST(testTargetTrajectories, nonMonotoneLookup) {
+  const auto targetTrajectories = getLinearTargetTrajectories(0.0, 0.1, 101);
+
+  // forward, backward and random enquiries all use the cached lookup
+  const scalar_array_t queries{0.05, 0.15, 9.95, 0.0, 5.0, 5.0, 4.99, -1.0, 11.0, 3.33};
+  for (const auto t : queries) {
+    const scalar_t tClamped = std::min(std::max(t, 0.0), 10.0);
+    EXPECT_TRUE(targetTrajectories.getDesiredState(t).isApprox(vector_t::Constant(2, tClamped)));
+    EXPECT_TRUE(targetTrajectories.getDesiredInput(t).isApprox(vector_t::Constant(1, -tClamped)));
+  }
+}
+
+TEST(testTargetTrajectories, appendOrdering) {
+  auto targetTrajectories = getLinearTargetTrajectories(0.0, 0.1, 11);
+
+  // append after the end
+  targetTrajectories.append(getLinearTargetTrajectories(1.1, 0.1, 5));
+  ASSERT_EQ(targetTrajectories.size(), 16);
+  EXPECT_TRUE(std::is_sorted(targetTrajectories.timeTrajectory.begin(), targetTrajectories.timeTrajectory.end()));
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.back(), 1.5);
+
+  // overlapping append replaces the tail
+  auto overlapping = getLinearTargetTrajectories(1.0, 0.2, 3);
+  for (auto& x : overlapping.stateTrajectory) {
+    x *= 2.0;
+  }
+  targetTrajectories.append(overlapping);
+  ASSERT_EQ(targetTrajectories.size(), 13);
+  EXPECT_TRUE(std::is_sorted(targetTrajectories.timeTrajectory.begin(), targetTrajectories.timeTrajectory.end()));
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.back(), 1.4);
+  EXPECT_TRUE(targetTrajectories.getDesiredState(0.9).isApprox(vector_t::Constant(2, 0.9)));
+  EXPECT_TRUE(targetTrajectories.getDesiredState(1.2).isApprox(vector_t::Constant(2, 2.4)));
+
+  // invalid appends
+  EXPECT_ANY_THROW(targetTrajectories.append({2.0, 1.9}, {vector_t::Zero(2), vector_t::Zero(2)}, {vector_t::Zero(1), vector_t::Zero(1)}));
+  EXPECT_ANY_THROW(targetTrajectories.append({2.0}, {vector_t::Zero(2)}));
+  EXPECT_ANY_THROW(targetTrajectories.append({2.0}, {}));
+
+  // appending to an empty TargetTrajectories
+  TargetTrajectories emptyTargetTrajectories;
+  emptyTargetTrajectories.append({0.0, 1.0}, {vector_t::Zero(2), vector_t::Ones(2)});
+  ASSERT_EQ(emptyTargetTrajectories.size(), 2);
+  EXPECT_TRUE(emptyTargetTrajectories.inputTrajectory.empty());
+  EXPECT_TRUE(emptyTargetTrajectories.getDesiredState(0.5).isApprox(vector_t::Constant(2, 0.5)));
+}
+
+TEST(testTargetTrajectories, trimBefore) {
+  auto targetTrajectories = getLinearTargetTrajectories(0.0, 0.1, 11);
+  const auto original = targetTrajectories;
+
+  // move the lookup hint to the end, it should remain valid after the trim
+  targetTrajectories.getDesiredState(0.95);
+
+  // the obsolete points are kept as long as they are fewer than the retained ones
+  EXPECT_EQ(targetTrajectories.trimBefore(-1.0), 0);
+  EXPECT_EQ(targetTrajectories.trimBefore(0.35), 0);
+  ASSERT_EQ(targetTrajectories.size(), 11);
+  EXPECT_EQ(targetTrajectories.trimBefore(0.65), 6);
+  ASSERT_EQ(targetTrajectories.size(), 5);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.front(), 0.6);
+
+  // interpolation after the trim time is not affected
+  for (const auto t : {0.65, 0.7, 0.77, 1.0, 2.0}) {
+    EXPECT_TRUE(targetTrajectories.getDesiredState(t).isApprox(original.getDesiredState(t)));
+    EXPECT_TRUE(targetTrajectories.getDesiredInput(t).isApprox(original.getDesiredInput(t)));
+  }
+
+  // the last point is always kept
+  EXPECT_EQ(targetTrajectories.trimBefore(5.0), 4);
+  ASSERT_EQ(targetTrajectories.size(), 1);
+  EXPECT_TRUE(targetTrajectories.getDesiredState(6.0).isApprox(vector_t::Constant(2, 1.0)));
+}
+
+TEST(testTargetTrajectories, recedingReference) {
+  constexpr size_t numPoints = 101;
+  constexpr scalar_t timeStep = 0.1;
+  auto targetTrajectories = getLinearTargetTrajectories(0.0, timeStep, numPoints);
+
+  // every cycle trims up to the current time and appends one point at the end
+  size_t numRemoved = 0;
+  for (size_t i = 1; i <= 1000; i++) {
+    const scalar_t currentTime = i * timeStep;
+    numRemoved += targetTrajectories.trimBefore(currentTime);
+    targetTrajectories.append(getLinearTargetTrajectories(currentTime + (numPoints - 1) * timeStep, timeStep, 1));
+
+    // at most as many obsolete points as the required ones
+    ASSERT_LE(targetTrajectories.size(), 2 * numPoints);
+    ASSERT_LE(targetTrajectories.timeTrajectory.front(), currentTime);
+    EXPECT_TRUE(targetTrajectories.getDesiredState(currentTime + 0.05).isApprox(vector_t::Constant(2, currentTime + 0.05)));
+  }
+  EXPECT_EQ(numRemoved + targetTrajectories.size(), numPoints + 1000);
+}
+
+TEST(testTargetTrajectories, shiftTime) {
+  auto targetTrajectories = getLinearTargetTrajectories(0.0, 0.1, 11);
+  const auto original = targetTrajectories;
+
+  targetTrajectories.getDesiredState(0.5);
+  targetTrajectories.shiftTime(0.25);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.front(), 0.25);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.back(), 1.25);
+  for (const auto t : {0.0, 0.3, 0.77, 1.0}) {
+    EXPECT_TRUE(targetTrajectories.getDesiredState(t + 0.25).isApprox(original.getDesiredState(t)));
+  }
+
+  // a receding reference: shift, trim and append
+  targetTrajectories = original;
+  targetTrajectories.trimBefore(0.65);
+  targetTrajectories.append(getLinearTargetTrajectories(1.1, 0.1, 2));
+  EXPECT_EQ(targetTrajectories.size(), 7);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.front(), 0.6);
+  EXPECT_TRUE(targetTrajectories.getDesiredState(1.15).isApprox(vector_t::Constant(2, 1.15)));
+}
+
+TEST(testTargetTrajectories, benchmarkCostWithLongReference) {
+  constexpr size_t numReferencePoints = 10000;
+  constexpr size_t numNodes = 5000;
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 4;
+
+  TargetTrajectories targetTrajectories(numReferencePoints);
+  for (size_t i = 0; i < numReferencePoints; i++) {
+    targetTrajectories.timeTrajectory[i] = i * 1e-3;
+    targetTrajectories.stateTrajectory[i] = vector_t::Random(stateDim);
+    targetTrajectories.inputTrajectory[i] = vector_t::Random(inputDim);
+  }
+  const QuadraticStateInputCost cost(matrix_t::Identity(stateDim, stateDim), matrix_t::Identity(inputDim, inputDim));
+  const vector_t x = vector_t::Random(stateDim);
+  const vector_t u = vector_t::Random(inputDim);
+  const scalar_t dt = targetTrajectories.timeTrajectory.back() / numNodes;
+
+  // reference: lookup from scratch for every enquiry
+  benchmark::RepeatedTimer plainTimer;
+  scalar_t plainSum = 0.0;
+  plainTimer.startTimer();
+  for (size_t k = 0; k < numNodes; k++) {
+    const scalar_t t = k * dt;
+    const vector_t dx = x - LinearInterpolation::interpolate(t, targetTrajectories.timeTrajectory, targetTrajectories.stateTrajectory);
+    const vector_t du = u - LinearInterpolation::interpolate(t, targetTrajectories.timeTrajectory, targetTrajectories.inputTrajectory);
+    plainSum += 0.5 * dx.squaredNorm() + 0.5 * du.squaredNorm();
+  }
+  plainTimer.endTimer();
+
+  // cost evaluation with the cached lookup
+  benchmark::RepeatedTimer cachedTimer;
+  scalar_t cachedSum = 0.0;
+  cachedTimer.startTimer();
+  for (size_t k = 0; k < numNodes; k++) {
+    cachedSum += cost.getValue(k * dt, x, u, targetTrajectories, PreComputation());
+  }
+  cachedTimer.endTimer();
+
+  EXPECT_NEAR(plainSum, cachedSum, 1e-9 * std::abs(plainSum));
+  std::cerr << "[benchmarkCostWithLongReference] " << numNodes << " cost evaluations on " << numReferencePoints << " reference points\n"
+            << "  uncached lookup [ms]: " << plainTimer.getTotalInMilliseconds() << "\n"
+            << "  cached lookup   [ms]: " << cachedTimer.getTotalInMilliseconds() << "\n";
+}
@@ -0,0 +1,320 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
+#include <ocs2_core/soft_constraint/StateSoftConstraint.h>
+#include <ocs2_core/soft_constraint/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/soft_constraint/penalties/SquaredHingePenalty.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** The dropped curvature of the inactive constraints can slow down the convergence to a linear rate. */
+constexpr size_t maxIterations = 1000;
+
+/** Polytope h = e + C * x + D * u >= 0 with random unit normals, containing the origin with a distance of [1, 5] to each facet. */
+std::unique_ptr<LinearStateInputConstraint> getPolytopeConstraint(size_t numConstraints, size_t stateDim, size_t inputDim) {
+  matrix_t normals = matrix_t::Random(numConstraints, stateDim + inputDim);
+  normals.rowwise().normalize();
+  const vector_t e = 3.0 * vector_t::Ones(numConstraints) + 2.0 * vector_t::Random(numConstraints);
+  return std::unique_ptr<LinearStateInputConstraint>(
+      new LinearStateInputConstraint(e, -normals.leftCols(stateDim), -normals.rightCols(inputDim)));
+}
+
+/** Spheres h_i = r_i^2 - |x - c_i|^2 >= 0 */
+class BallConstraint final : public StateConstraint {
+ public:
+  BallConstraint(std::vector<vector_t> centers, vector_t radii)
+      : StateConstraint(ConstraintOrder::Quadratic), centers_(std::move(centers)), radii_(std::move(radii)) {}
+  ~BallConstraint() override = default;
+  BallConstraint* clone() const override { return new BallConstraint(*this); }
+
+  size_t getNumConstraints(scalar_t time) const override { return centers_.size(); }
+  vector_t getValue(scalar_t time, const vector_t& state, const PreComputation&) const override {
+    vector_t h(centers_.size());
+    for (size_t i = 0; i < centers_.size(); i++) {
+      h(i) = radii_(i) * radii_(i) - (state - centers_[i]).squaredNorm();
+    }
+    return h;
+  }
+  VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                 const PreComputation& preComp) const override {
+    VectorFunctionQuadraticApproximation h;
+    h.f = getValue(time, state, preComp);
+    h.dfdx.resize(centers_.size(), state.size());
+    h.dfdxx.resize(centers_.size());
+    for (size_t i = 0; i < centers_.size(); i++) {
+      h.dfdx.row(i) = -2.0 * (state - centers_[i]).transpose();
+      h.dfdxx[i] = -2.0 * matrix_t::Identity(state.size(), state.size());
+    }
+    return h;
+  }
+
+ private:
+  std::vector<vector_t> centers_;
+  vector_t radii_;
+};
+
+/**
+ * Minimizes 0.5 * |z - zRef|^2 + penalty(z) by a damped Newton method, where approximation returns the penalty's quadratic
+ * approximation with dfdx and dfdxx in terms of z.
+ */
+template <typename Approximation, typename Value>
+vector_t minimize(const vector_t& zRef, Approximation approximation, Value value, size_t& numIterations) {
+  vector_t z = vector_t::Zero(zRef.size());
+  auto merit = [&](const vector_t& z) { return 0.5 * (z - zRef).squaredNorm() + value(z); };
+  for (numIterations = 0; numIterations < maxIterations; numIterations++) {
+    const auto penalty = approximation(z);
+    const vector_t gradient = z - zRef + penalty.first;
+    if (gradient.norm() < 1e-6) {
+      break;
+    }
+    const matrix_t hessian = matrix_t::Identity(z.size(), z.size()) + penalty.second;
+    const vector_t dz = -hessian.ldlt().solve(gradient);
+    scalar_t stepLength = 1.0;
+    while (merit(z + stepLength * dz) > merit(z) + 1e-4 * stepLength * gradient.dot(dz) && stepLength > 1e-8) {
+      stepLength *= 0.5;
+    }
+    z += stepLength * dz;
+  }
+  return z;
+}
+
+template <typename SoftConstraint>
+vector_t minimizeStateInput(const SoftConstraint& softConstraint, const vector_t& zRef, size_t stateDim, size_t& numIterations) {
+  const TargetTrajectories targetTrajectories;
+  const PreComputation preComp;
+  const size_t inputDim = zRef.size() - stateDim;
+  auto approximation = [&](const vector_t& z) {
+    const auto penalty = softConstraint.getQuadraticApproximation(0.0, z.head(stateDim), z.tail(inputDim), targetTrajectories, preComp);
+    vector_t gradient(z.size());
+    gradient << penalty.dfdx, penalty.dfdu;
+    matrix_t hessian(z.size(), z.size());
+    hessian << penalty.dfdxx, penalty.dfdux.transpose(), penalty.dfdux, penalty.dfduu;
+    return std::make_pair(gradient, hessian);
+  };
+  auto value = [&](const vector_t& z) {
+    return softConstraint.getValue(0.0, z.head(stateDim), z.tail(inputDim), targetTrajectories, preComp);
+  };
+  return minimize(zRef, approximation, value, numIterations);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(testLazySoftConstraint, exactForSquaredHinge) {
+  constexpr size_t numConstraints = 200;
+  constexpr size_t stateDim = 6;
+  constexpr size_t inputDim = 3;
+  const SquaredHingePenalty::Config config(10.0, 0.1);
+  const auto constraintPtr = getPolytopeConstraint(numConstraints, stateDim, inputDim);
+
+  const StateInputSoftConstraint fullSoftConstraint(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                                    std::unique_ptr<PenaltyBase>(new SquaredHingePenalty(config)));
+  const StateInputSoftConstraint lazySoftConstraint(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                                    std::unique_ptr<PenaltyBase>(new SquaredHingePenalty(config)), config.delta);
+
+  const TargetTrajectories targetTrajectories;
+  const PreComputation preComp;
+  for (size_t n = 0; n < 20; n++) {
+    const vector_t x = 3.0 * vector_t::Random(stateDim);
+    const vector_t u = 3.0 * vector_t::Random(inputDim);
+    const auto full = fullSoftConstraint.getQuadraticApproximation(0.0, x, u, targetTrajectories, preComp);
+    const auto lazy = lazySoftConstraint.getQuadraticApproximation(0.0, x, u, targetTrajectories, preComp);
+    EXPECT_NEAR(full.f, lazy.f, 1e-9);
+    EXPECT_TRUE(full.dfdx.isApprox(lazy.dfdx, 1e-9) || full.dfdx.norm() < 1e-12);
+    EXPECT_TRUE(full.dfdu.isApprox(lazy.dfdu, 1e-9) || full.dfdu.norm() < 1e-12);
+    EXPECT_TRUE(full.dfdxx.isApprox(lazy.dfdxx, 1e-9) || full.dfdxx.norm() < 1e-12);
+    EXPECT_TRUE(full.dfdux.isApprox(lazy.dfdux, 1e-9) || full.dfdux.norm() < 1e-12);
+    EXPECT_TRUE(full.dfduu.isApprox(lazy.dfduu, 1e-9) || full.dfduu.norm() < 1e-12);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(testLazySoftConstraint, gradientForRelaxedBarrier) {
+  constexpr size_t numConstraints = 200;
+  constexpr size_t stateDim = 6;
+  constexpr size_t inputDim = 3;
+  const RelaxedBarrierPenalty::Config config(0.1, 0.1);
+  const auto constraintPtr = getPolytopeConstraint(numConstraints, stateDim, inputDim);
+
+  const StateInputSoftConstraint fullSoftConstraint(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                                    std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(config)));
+  const StateInputSoftConstraint lazySoftConstraint(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                                    std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(config)), 0.5);
+
+  // value and gradient are exact, only the curvature of the far constraints is dropped
+  const TargetTrajectories targetTrajectories;
+  const PreComputation preComp;
+  for (size_t n = 0; n < 20; n++) {
+    const vector_t x = 2.0 * vector_t::Random(stateDim);
+    const vector_t u = 2.0 * vector_t::Random(inputDim);
+    const auto full = fullSoftConstraint.getQuadraticApproximation(0.0, x, u, targetTrajectories, preComp);
+    const auto lazy = lazySoftConstraint.getQuadraticApproximation(0.0, x, u, targetTrajectories, preComp);
+    EXPECT_NEAR(full.f, lazy.f, 1e-9);
+    EXPECT_TRUE(full.dfdx.isApprox(lazy.dfdx, 1e-9));
+    EXPECT_TRUE(full.dfdu.isApprox(lazy.dfdu, 1e-9));
+    EXPECT_TRUE((full.dfdxx - lazy.dfdxx).norm() <= full.dfdxx.norm());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(testLazySoftConstraint, convergedSolutionIsUnchanged) {
+  constexpr size_t numConstraints = 200;
+  constexpr size_t stateDim = 6;
+  constexpr size_t inputDim = 3;
+  const RelaxedBarrierPenalty::Config config(0.1, 0.1);
+  const auto constraintPtr = getPolytopeConstraint(numConstraints, stateDim, inputDim);
+
+  const StateInputSoftConstraint fullSoftConstraint(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                                    std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(config)));
+  const StateInputSoftConstraint lazySoftConstraint(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                                    std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(config)), 0.5);
+
+  // the reference is outside the polytope such that the solution is at its boundary
+  const vector_t zRef = 10.0 * vector_t::Ones(stateDim + inputDim);
+  size_t numFullIterations, numLazyIterations;
+  const vector_t zFull = minimizeStateInput(fullSoftConstraint, zRef, stateDim, numFullIterations);
+  const vector_t zLazy = minimizeStateInput(lazySoftConstraint, zRef, stateDim, numLazyIterations);
+
+  const vector_t h = constraintPtr->getValue(0.0, zFull.head(stateDim), zFull.tail(inputDim), PreComputation());
+  ASSERT_LT(h.minCoeff(), 0.5) << "The solution should be near the boundary!";
+  EXPECT_LT(numFullIterations, maxIterations);
+  EXPECT_LT(numLazyIterations, maxIterations);
+  EXPECT_TRUE(zFull.isApprox(zLazy, 1e-5)) << "zFull: " << zFull.transpose() << "\nzLazy: " << zLazy.transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(testLazySoftConstraint, convergedSolutionIsUnchangedQuadraticConstraint) {
+  constexpr size_t numConstraints = 50;
+  constexpr size_t stateDim = 4;
+  const RelaxedBarrierPenalty::Config config(0.1, 0.1);
+
+  // every ball contains the origin
+  std::vector<vector_t> centers(numConstraints);
+  vector_t radii(numConstraints);
+  for (size_t i = 0; i < numConstraints; i++) {
+    centers[i] = vector_t::Random(stateDim);
+    radii(i) = centers[i].norm() + 0.5 + std::abs(vector_t::Random(1)(0));
+  }
+  const BallConstraint constraint(centers, radii);
+
+  const StateSoftConstraint fullSoftConstraint(std::unique_ptr<StateConstraint>(constraint.clone()),
+                                               std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(config)));
+  const StateSoftConstraint lazySoftConstraint(std::unique_ptr<StateConstraint>(constraint.clone()),
+                                               std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(config)), 1.0);
+
+  const TargetTrajectories targetTrajectories;
+  const PreComputation preComp;
+  auto solve = [&](const StateSoftConstraint& softConstraint, size_t& numIterations) {
+    auto approximation = [&](const vector_t& x) {
+      const auto penalty = softConstraint.getQuadraticApproximation(0.0, x, targetTrajectories, preComp);
+      return std::make_pair(vector_t(penalty.dfdx), matrix_t(penalty.dfdxx));
+    };
+    auto value = [&](const vector_t& x) { return softConstraint.getValue(0.0, x, targetTrajectories, preComp); };
+    return minimize(vector_t::Constant(stateDim, 5.0), approximation, value, numIterations);
+  };
+
+  size_t numFullIterations, numLazyIterations;
+  const vector_t xFull = solve(fullSoftConstraint, numFullIterations);
+  const vector_t xLazy = solve(lazySoftConstraint, numLazyIterations);
+
+  ASSERT_LT(constraint.getValue(0.0, xFull, preComp).minCoeff(), 0.5) << "The solution should be near the boundary!";
+  EXPECT_LT(numFullIterations, maxIterations);
+  EXPECT_LT(numLazyIterations, maxIterations);
+  EXPECT_TRUE(xFull.isApprox(xLazy, 1e-5)) << "xFull: " << xFull.transpose() << "\nxLazy: " << xLazy.transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(testLazySoftConstraint, benchmarkLargeInactiveSet) {
+  constexpr size_t numConstraints = 2000;
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 12;
+  constexpr size_t numEvaluations = 200;
+  const auto constraintPtr = getPolytopeConstraint(numConstraints, stateDim, inputDim);
+
+  const TargetTrajectories targetTrajectories;
+  const PreComputation preComp;
+  const vector_t x = 0.1 * vector_t::Random(stateDim);
+  const vector_t u = 0.1 * vector_t::Random(inputDim);
+
+  auto timeApproximation = [&](const StateInputSoftConstraint& softConstraint) {
+    benchmark::RepeatedTimer timer;
+    scalar_t sum = 0.0;
+    for (size_t n = 0; n < numEvaluations; n++) {
+      timer.startTimer();
+      sum += softConstraint.getQuadraticApproximation(0.0, x, u, targetTrajectories, preComp).f;
+      timer.endTimer();
+    }
+    return std::make_pair(sum, timer.getAverageInMilliseconds());
+  };
+
+  const RelaxedBarrierPenalty::Config barrierConfig(0.1, 0.1);
+  const StateInputSoftConstraint fullBarrier(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                             std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(barrierConfig)));
+  const StateInputSoftConstraint lazyBarrier(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                             std::unique_ptr<PenaltyBase>(new RelaxedBarrierPenalty(barrierConfig)), 1.5);
+  const SquaredHingePenalty::Config hingeConfig(10.0, 1.5);
+  const StateInputSoftConstraint fullHinge(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                           std::unique_ptr<PenaltyBase>(new SquaredHingePenalty(hingeConfig)));
+  const StateInputSoftConstraint lazyHinge(std::unique_ptr<StateInputConstraint>(constraintPtr->clone()),
+                                           std::unique_ptr<PenaltyBase>(new SquaredHingePenalty(hingeConfig)), hingeConfig.delta);
+
+  const auto fullBarrierResult = timeApproximation(fullBarrier);
+  const auto lazyBarrierResult = timeApproximation(lazyBarrier);
+  const auto fullHingeResult = timeApproximation(fullHinge);
+  const auto lazyHingeResult = timeApproximation(lazyHinge);
+  EXPECT_NEAR(fullBarrierResult.first, lazyBarrierResult.first, 1e-9 * std::abs(fullBarrierResult.first));
+  EXPECT_NEAR(fullHingeResult.first, lazyHingeResult.first, 1e-9 * std::abs(fullHingeResult.first));
+
+  const vector_t h = constraintPtr->getValue(0.0, x, u, preComp);
+  const auto numActive = (h.array() < 1.5).count();
+  std::cerr << "[benchmarkLargeInactiveSet] " << numActive << " of " << numConstraints << " constraints within the margin\n"
+            << "  relaxed barrier, full [ms]: " << fullBarrierResult.second << "\n"
+            << "  relaxed barrier, lazy [ms]: " << lazyBarrierResult.second << "\n"
+            << "  squared hinge,   full [ms]: " << fullHingeResult.second << "\n"
+            << "  squared hinge,   lazy [ms]: " << lazyHingeResult.second << "\n";
+}
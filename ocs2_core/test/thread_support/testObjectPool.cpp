@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <ocs2_core/thread_support/ObjectPool.h>
+
+#include <thread>
+#include <vector>
+
+using namespace ocs2;
+
+TEST(testObjectPool, recycle) {
+  ObjectPool<std::vector<double>> pool(2);
+  EXPECT_EQ(pool.size(), 0);
+
+  // a new object
+  auto objectPtr = pool.acquire();
+  ASSERT_NE(objectPtr, nullptr);
+  objectPtr->resize(100);
+  const auto* rawPtr = objectPtr.get();
+  const double* dataPtr = objectPtr->data();
+
+  // the same object with its content and capacity
+  pool.release(std::move(objectPtr));
+  EXPECT_EQ(pool.size(), 1);
+  objectPtr = pool.acquire();
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_EQ(objectPtr.get(), rawPtr);
+  EXPECT_EQ(objectPtr->data(), dataPtr);
+  EXPECT_EQ(objectPtr->size(), 100);
+
+  // null pointers are ignored
+  pool.release(nullptr);
+  EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(testObjectPool, maxNumObjects) {
+  ObjectPool<std::vector<double>> pool(2);
+  for (size_t i = 0; i < 5; i++) {
+    pool.release(std::unique_ptr<std::vector<double>>(new std::vector<double>(10)));
+  }
+  EXPECT_EQ(pool.size(), 2);
+
+  pool.clear();
+  EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(testObjectPool, concurrentAccess) {
+  constexpr size_t numThreads = 4;
+  constexpr size_t numIterations = 1000;
+  ObjectPool<std::vector<size_t>> pool(numThreads);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; t++) {
+    threads.emplace_back([&pool, t]() {
+      for (size_t i = 0; i < numIterations; i++) {
+        auto objectPtr = pool.acquire();
+        objectPtr->assign(8, t);
+        for (const auto value : *objectPtr) {
+          ASSERT_EQ(value, t);  // no other thread holds the object
+        }
+        pool.release(std::move(objectPtr));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(pool.size(), numThreads);
+  EXPECT_GE(pool.size(), 1);
+}
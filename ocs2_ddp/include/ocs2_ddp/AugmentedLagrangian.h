@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+namespace ocs2 {
+
+/**
+ * The augmented Lagrangian terms of the state-only equality constraints, h(x) = 0, and the inequality constraints, g(x, u) >= 0,
+ * of the Gauss-Newton DDP methods. The terms are
+ *   - equality:   lambda' h + 0.5 * rho * |h|^2
+ *   - inequality: 0.5 / rho * (|max(0, mu - rho * g)|^2 - |mu|^2)   (Powell-Hestenes-Rockafellar)
+ *
+ * The multipliers are stored per node of the nominal trajectory together with their time stamps. They are interpolated on the time
+ * stamps of any other trajectory, e.g. the rollouts of the line search or the nominal trajectory of the next MPC cycle.
+ */
+class AugmentedLagrangian {
+ public:
+  /** The penalty coefficients of the quadratic terms */
+  struct Penalties {
+    scalar_t stateEq = 1.0;
+    scalar_t finalStateEq = 1.0;
+    scalar_t inequality = 1.0;
+  };
+
+  /** The constraint types of which the multipliers are updated */
+  struct MultiplierUpdates {
+    bool stateEq = true;
+    bool finalStateEq = true;
+    bool inequality = true;
+  };
+
+  /** Clears the multipliers. */
+  void clear();
+
+  /** Sets the penalty coefficients. */
+  void setPenalties(const Penalties& penalties) { penalties_ = penalties; }
+
+  /** Gets the penalty coefficients. */
+  const Penalties& getPenalties() const { return penalties_; }
+
+  /**
+   * Evaluates the augmented Lagrangian terms of an intermediate node.
+   *
+   * @param [in] modelData: The model data which contains the values of the state-only equality and the inequality constraints.
+   * @return The pair of the equality and the inequality terms.
+   */
+  std::pair<scalar_t, scalar_t> getIntermediateValue(const ModelData& modelData) const;
+
+  /**
+   * Evaluates the augmented Lagrangian term of the state-only equality constraints of an event.
+   *
+   * @param [in] modelData: The model data of the event which contains the values of the state-only equality constraints.
+   * @return The equality term.
+   */
+  scalar_t getEventValue(const ModelData& modelData) const;
+
+  /**
+   * Adds the quadratic approximation of the augmented Lagrangian terms of an intermediate node to its cost.
+   *
+   * @param [in, out] modelData: The model data with the LQ approximation of the node.
+   */
+  void augmentIntermediateCost(ModelData& modelData) const;
+
+  /**
+   * Adds the quadratic approximation of the augmented Lagrangian term of an event to its cost.
+   *
+   * @param [in, out] modelData: The model data with the LQ approximation of the event.
+   */
+  void augmentEventCost(ModelData& modelData) const;
+
+  /**
+   * Updates the multipliers based on the constraint values of the nominal trajectories: lambda += rho * h, mu = max(0, mu - rho * g).
+   * The updated multipliers replace the stored ones and take the time stamps of the given model data. The multipliers of the
+   * constraint types which are not selected keep their values.
+   *
+   * @param [in] modelDataTrajectoriesStock: The model data trajectories of the partitions.
+   * @param [in] modelDataEventTimesStock: The model data of the event times of the partitions.
+   * @param [in] initActivePartition: The first active partition.
+   * @param [in] finalActivePartition: The last active partition.
+   * @param [in] multiplierUpdates: The constraint types of which the multipliers are updated.
+   */
+  void updateMultipliers(const std::vector<std::vector<ModelData>>& modelDataTrajectoriesStock,
+                         const std::vector<std::vector<ModelData>>& modelDataEventTimesStock, size_t initActivePartition,
+                         size_t finalActivePartition, const MultiplierUpdates& multiplierUpdates);
+
+  /** Gets the multiplier of the state-only equality constraints at the given time, zero if none of the right size is stored. */
+  vector_t getStateEqualityMultiplier(scalar_t time, size_t numConstraints) const;
+
+  /** Gets the multiplier of the inequality constraints at the given time, zero if none of the right size is stored. */
+  vector_t getInequalityMultiplier(scalar_t time, size_t numConstraints) const;
+
+  /** Gets the multiplier of the state-only equality constraints of the event closest to the given time, zero if none is stored. */
+  vector_t getEventStateEqualityMultiplier(scalar_t time, size_t numConstraints) const;
+
+ private:
+  Penalties penalties_;
+
+  scalar_array_t timeTrajectory_;
+  vector_array_t stateEqMultipliers_;
+  vector_array_t inequalityMultipliers_;
+
+  scalar_array_t eventTimes_;
+  vector_array_t eventStateEqMultipliers_;
+};
+
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -44,10 +46,20 @@ struct solution {
 };
 
 struct Settings {
-  /** CARE iterations are stopped if the norm of the update step is below the specified tolerance */
+  /**
+   * CARE iterations are stopped if the norm of the update step is below the specified tolerance. The Newton-Kleinman iterations
+   * are stopped if the CARE residual relative to the norm of its constant terms is below the tolerance.
+   */
   scalar_t tolerance = 1e-12;
   /** Maximum number of iterations */
   size_t maxIter = 100;
+  /** Maximum number of Newton-Kleinman iterations when a warm start is refined */
+  size_t maxNewtonKleinmanIter = 10;
+  /**
+   * CachedSolver: A cached solution is only refined if its CARE residual, relative to the norm of the constant terms, is below this
+   * value. Otherwise, the CARE is solved with the sign function algorithm.
+   */
+  scalar_t maxWarmStartResidual = 1e-5;
   /** Check numerical characteristic of the linear quadratic approximation */
   bool checkNumericalCharacteristics = true;
 };
@@ -77,5 +89,82 @@ struct Settings {
 solution solve(OptimalControlProblem& problem, scalar_t time, const vector_t& state, const vector_t& input,
                const Settings& settings = Settings());
 
+/**
+ * Solves the infinite-horizon continuous time LQR problem for the given linear quadratic approximation with the matrix sign
+ * function algorithm.
+ *
+ * @param dynamics : The linear approximation of the dynamics (dfdx, dfdu).
+ * @param cost : The quadratic approximation of the cost (dfdxx, dfduu, dfdux).
+ * @param settings : algorithm settings.
+ * @return {FeedbackGains K, Value function S}
+ */
+solution solve(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+               const Settings& settings = Settings());
+
+/**
+ * Refines an approximate solution of the CARE with the Newton-Kleinman iteration. Each iteration solves a Lyapunov equation
+ * of the closed-loop system in its real Schur form. The iteration converges quadratically if the initial guess stabilizes the
+ * system, e.g. the value function of a nearby linearization point.
+ *
+ * @param [in] dynamics : The linear approximation of the dynamics (dfdx, dfdu).
+ * @param [in] cost : The quadratic approximation of the cost (dfdxx, dfduu, dfdux).
+ * @param [in] valueFunctionGuess : The initial guess of the value function matrix S.
+ * @param [in] settings : algorithm settings.
+ * @param [out] lqrSolution : The refined solution.
+ * @return whether the iteration converged. It fails if the guess does not stabilize the system.
+ */
+bool refine(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+            const matrix_t& valueFunctionGuess, const Settings& settings, solution& lqrSolution);
+
+/**
+ * Solves the continuous time LQR problem and caches the solutions with a key of the quantized linearization point. A query whose
+ * linear quadratic approximation equals the cached one returns the cached solution. Otherwise, the cached solution of the same key,
+ * or else the last solution, is refined with the Newton-Kleinman iteration if its CARE residual is below
+ * Settings::maxWarmStartResidual. The matrix sign function algorithm is used if no close and stabilizing warm start is available.
+ */
+class CachedSolver {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param settings : algorithm settings.
+   * @param resolution : The quantization step of the time, state, and input of the cache key.
+   * @param capacity : The maximum number of cached solutions. The least recently used solution is replaced once it is full.
+   */
+  CachedSolver(Settings settings, scalar_t resolution, size_t capacity = 16);
+
+  /** Solves the LQR problem around the given time, state, and input. See continuous_time_lqr::solve. */
+  const solution& solve(OptimalControlProblem& problem, scalar_t time, const vector_t& state, const vector_t& input);
+
+  /** Removes all cached solutions, e.g. after the parameters of the problem have changed. */
+  void clear();
+
+  /** Number of queries answered by the cache without solving the CARE */
+  size_t getNumHits() const { return numHits_; }
+  /** Number of queries solved with the Newton-Kleinman iteration from a warm start */
+  size_t getNumRefinements() const { return numRefinements_; }
+  /** Number of queries solved with the matrix sign function algorithm */
+  size_t getNumColdStarts() const { return numColdStarts_; }
+
+ private:
+  struct Entry {
+    std::vector<long long> key;
+    VectorFunctionLinearApproximation dynamics;
+    ScalarFunctionQuadraticApproximation cost;
+    solution lqrSolution;
+    size_t lastUsed;
+  };
+
+  Settings settings_;
+  scalar_t resolution_;
+  size_t capacity_;
+  std::vector<Entry> entries_;
+  size_t lastEntryIndex_ = 0;
+  size_t numQueries_ = 0;
+  size_t numHits_ = 0;
+  size_t numRefinements_ = 0;
+  size_t numColdStarts_ = 0;
+};
+
 }  // namespace continuous_time_lqr
 }  // namespace ocs2
@@ -107,6 +107,14 @@ struct Settings {
   scalar_t inequalityConstraintMu_ = 0.0;
   /** Threshold parameter, \f$\delta\f$, where the relaxed log barrier function changes from log to quadratic */
   scalar_t inequalityConstraintDelta_ = 1e-6;
+  /** If true, the state-only equality and the inequality constraints are handled by an augmented Lagrangian with per-node multipliers
+   * instead of the growing quadratic penalty and the relaxed barrier. The multipliers are kept across the runs of the solver. */
+  bool useAugmentedLagrangian_ = false;
+  /** The upper bound of the penalty coefficients in the augmented Lagrangian mode. */
+  scalar_t augmentedLagrangianMaxPenalty_ = 1000.0;
+  /** The required decrease rate of the state-only equality violation between the updates of the augmented Lagrangian. If the violation
+   * decreases slower, the penalty is increased along with the multipliers. */
+  scalar_t augmentedLagrangianViolationDecreaseRate_ = 0.5;
 
   /** If true, terms of the Riccati equation will be precomputed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/control/TrajectorySpreadingControllerAdjustment.h>
@@ -48,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/rollout/RolloutBase.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
+#include "ocs2_ddp/AugmentedLagrangian.h"
 #include "ocs2_ddp/DDP_Settings.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
@@ -68,6 +71,14 @@ class GaussNewtonDDP : public SolverBase {
 
     scalar_t stateInputEqConstrPenaltyTol = 1e-3;
     scalar_t stateInputEqConstrPenaltyCoeff = 0.0;
+
+    // only used by the augmented Lagrangian mode
+    scalar_t inequalityConstrPenaltyTol = 1e-3;
+    scalar_t inequalityConstrPenaltyCoeff = 0.0;
+
+    // the state-only equality violations at the previous update of the augmented Lagrangian
+    scalar_t stateEqConstrPreviousViolation = std::numeric_limits<scalar_t>::max();
+    scalar_t stateFinalEqConstrPreviousViolation = std::numeric_limits<scalar_t>::max();
   };
 
   /**
@@ -165,9 +176,10 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] Sm: The Riccati matrix.
    * @param [out] projectedModelData: The projected model data.
    * @param [out] riccatiModification: The Riccati equation modifier.
+   * @param [in, out] hessianCorrectionShift: The diagonal shift of the Hessian correction cached for this node.
    */
   void computeProjectionAndRiccatiModification(const ModelData& modelData, const matrix_t& Sm, ModelData& projectedModelData,
-                                               riccati_modification::Data& riccatiModification) const;
+                                               riccati_modification::Data& riccatiModification, scalar_t& hessianCorrectionShift) const;
 
   /**
    * Computes the Hessian of Hamiltonian based on the search strategy and algorithm.
@@ -185,11 +197,12 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] postEventIndices: The post event indices.
    * @param [in] stateTrajectory: The state trajectory.
    * @param [in] inputTrajectory: The input trajectory.
+   * @param [in] firstNodeIndex: The index of the first node in the nodes of all the partitions, see PreComputation::setNodeIndex().
    * @param modelDataTrajectory: The model data trajectory.
    */
   virtual void approximateIntermediateLQ(const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
                                          const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
-                                         std::vector<ModelData>& modelDataTrajectory) = 0;
+                                         size_t firstNodeIndex, std::vector<ModelData>& modelDataTrajectory) = 0;
 
   /**
    * Calculates the controller. This method uses the following variables:
@@ -367,6 +380,18 @@ class GaussNewtonDDP : public SolverBase {
    */
   void updateConstraintPenalties(scalar_t stateEqConstraintISE, scalar_t stateEqFinalConstraintSSE, scalar_t stateInputEqConstraintISE);
 
+  /**
+   * Updates the augmented Lagrangian of the state-only equality, the final state-only equality, and the inequality constraints.
+   * The multipliers of a constraint type are updated on the nominal trajectories if its violation is below the penalty tolerance,
+   * otherwise its penalty is increased up to augmentedLagrangianMaxPenalty_. The penalty of the state-only equalities is increased as
+   * well if their violation has not decreased by augmentedLagrangianViolationDecreaseRate_ since the previous update. The tolerances
+   * follow the schedule of the state-input equality penalty. Once all constraints are satisfied, nothing is updated anymore. Finally,
+   * the merit of the nominal trajectories is recomputed with the updated terms.
+   *
+   * @param [in] isInitialization: If true, only the initial penalties are set.
+   */
+  void updateAugmentedLagrangian(bool isInitialization);
+
   /**
    * Runs the search strategy. It ony updates the controller or nominal trajectories is search was successful.
    * @param [in] expectedCost: The expected cost based on the LQ model optimization.
@@ -428,6 +453,17 @@ class GaussNewtonDDP : public SolverBase {
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const scalar_array_t& partitioningTimes,
                const std::vector<ControllerBase*>& controllersPtrStock) override;
 
+  /**
+   * The warm-start state of DDP consists of the time horizon, the partitioning times, the nominal controllers, and the nominal
+   * trajectories. The Riccati solution is not saved since it is recomputed after the first rollout of the next run anyway.
+   */
+  void saveWarmStartImpl(std::ostream& stream) const override;
+
+  void loadWarmStartImpl(std::istream& stream) override;
+
+  /** Copies the same state as saveWarmStartImpl() directly from another GaussNewtonDDP solver. */
+  void copyWarmStartImpl(const SolverBase& other) override;
+
  protected:
   // multi-threading helper variables
   std::atomic_size_t nextTaskId_{0};
@@ -445,6 +481,9 @@ class GaussNewtonDDP : public SolverBase {
   std::unique_ptr<SearchStrategyBase> searchStrategyPtr_;
   std::vector<OptimalControlProblem> optimalControlProblemStock_;
 
+  // augmented Lagrangian of the state-only equality and the inequality constraints, nullptr if the penalty scheme is used
+  std::unique_ptr<AugmentedLagrangian> augmentedLagrangianPtr_;
+
   // optimized controller
   std::vector<LinearController> nominalControllersStock_;
 
@@ -465,6 +504,8 @@ class GaussNewtonDDP : public SolverBase {
 
   // Riccati modification
   std::vector<std::vector<riccati_modification::Data>> riccatiModificationTrajectoriesStock_;
+  // cached Hessian correction shifts, which are kept across the iterations
+  scalar_array2_t hessianCorrectionShiftTrajectoriesStock_;
 
   // Riccati solution coefficients
   scalar_array2_t SsTimeTrajectoryStock_;
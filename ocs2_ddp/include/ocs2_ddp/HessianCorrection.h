@@ -87,5 +87,79 @@ void shiftHessian(Strategy strategy, Eigen::MatrixBase<Derived>& matrix,
   }
 }
 
+/**
+ * Checks whether the eigenvalues of the symmetric matrix are greater than minEigenvalue, using an in-place LLT decomposition of
+ * (matrix - minEigenvalue * I). The decomposition only overwrites the lower triangular part. On return, the diagonal is restored and
+ * the strictly lower triangular part is copied from the upper one.
+ *
+ * @tparam Derived type.
+ * @param matrix: The symmetric matrix.
+ * @param [in] minEigenvalue: The minimum expected eigenvalue.
+ * @return true if all the eigenvalues are greater than minEigenvalue.
+ */
+template <typename Derived>
+bool hasMinEigenvalue(Eigen::MatrixBase<Derived>& matrix, scalar_t minEigenvalue) {
+  assert(matrix.rows() == matrix.cols());
+  const vector_t diagonal = matrix.diagonal();
+  matrix.diagonal().array() -= minEigenvalue;
+
+  Eigen::Ref<matrix_t> matrixRef(matrix.derived());
+  const Eigen::LLT<Eigen::Ref<matrix_t>> llt(matrixRef);
+
+  matrix.diagonal() = diagonal;
+  for (size_t j = 0; j + 1 < matrix.cols(); j++) {
+    matrix.col(j).tail(matrix.rows() - j - 1) = matrix.row(j).tail(matrix.cols() - j - 1).transpose();
+  }
+  return llt.info() == Eigen::Success;
+}
+
+/**
+ * Corrects the Hessian with the given strategy only if its eigenvalues are not greater than minEigenvalue. This check costs an LLT
+ * decomposition, therefore the DIAGONAL_SHIFT and GERSHGORIN_MODIFICATION strategies, which are cheaper, are applied without it.
+ *
+ * Optionally, a diagonal shift which is cached from the previous correction is tried before the strategy. On return, the cached shift
+ * is zero if no correction was required, or the norm of the correction of the strategy plus minEigenvalue. The latter is a margin for
+ * the change of the matrix between the iterations. Note that the cached shift overestimates the curvature in the directions which the
+ * strategy leaves unchanged.
+ *
+ * @tparam Derived type.
+ * @param [in] strategy: Hessian matrix correction strategy.
+ * @param matrix: The Hessian matrix.
+ * @param [in] minEigenvalue: The minimum expected eigenvalue after correction.
+ * @param [in, out] cachedShiftPtr: The cached diagonal shift. If nullptr, no shift is cached.
+ */
+template <typename Derived>
+void correctHessian(Strategy strategy, Eigen::MatrixBase<Derived>& matrix, scalar_t minEigenvalue, scalar_t* cachedShiftPtr = nullptr) {
+  if (strategy == Strategy::DIAGONAL_SHIFT || strategy == Strategy::GERSHGORIN_MODIFICATION) {
+    shiftHessian(strategy, matrix, minEigenvalue);
+    return;
+  }
+
+  if (hasMinEigenvalue(matrix, minEigenvalue)) {
+    if (cachedShiftPtr != nullptr) {
+      *cachedShiftPtr = 0.0;
+    }
+    return;
+  }
+
+  if (cachedShiftPtr == nullptr) {
+    shiftHessian(strategy, matrix, minEigenvalue);
+    return;
+  }
+
+  // try the cached shift
+  if (*cachedShiftPtr > 0.0) {
+    matrix.diagonal().array() += *cachedShiftPtr;
+    if (hasMinEigenvalue(matrix, minEigenvalue)) {
+      return;
+    }
+    matrix.diagonal().array() -= *cachedShiftPtr;
+  }
+
+  const matrix_t uncorrectedMatrix = matrix;
+  shiftHessian(strategy, matrix, minEigenvalue);
+  *cachedShiftPtr = (matrix - uncorrectedMatrix).norm() + minEigenvalue;
+}
+
 }  // namespace hessian_correction
 }  // namespace ocs2
@@ -73,7 +73,7 @@ class ILQR : public GaussNewtonDDP {
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
   void approximateIntermediateLQ(const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
-                                 const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+                                 const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory, size_t firstNodeIndex,
                                  std::vector<ModelData>& modelDataTrajectory) override;
 
   /**
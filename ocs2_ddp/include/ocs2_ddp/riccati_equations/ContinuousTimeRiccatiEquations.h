@@ -184,7 +184,7 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * @param [in] Sv: The current Riccati vector.
    * @param [in] s: The current Riccati scalar.
    * @param [out] creCache: The continuous-time Riccati equation cache date.
-   * @param [out] dSm: The time derivative of the Riccati matrix.
+   * @param [out] dSm: The time derivative of the Riccati matrix. Only its upper triangular part is computed.
    * @param [out] dSv: The time derivative of the  Riccati vector.
    * @param [out] ds: The time derivative of the  Riccati scalar.
    */
@@ -199,7 +199,7 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * @param [in] Sv: The current Riccati vector.
    * @param [in] s: The current Riccati scalar.
    * @param [out] creCache: The continuous-time Riccati equation cache date.
-   * @param [out] dSm: The time derivative of the Riccati matrix.
+   * @param [out] dSm: The time derivative of the Riccati matrix. Only its upper triangular part is computed.
    * @param [out] dSv: The time derivative of the  Riccati vector.
    * @param [out] ds: The time derivative of the  Riccati scalar.
    */
@@ -88,8 +88,8 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
 
-  void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
-                                  matrix_t& deltaGm) const override;
+  void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv, matrix_t& deltaGm,
+                                  scalar_t& hessianCorrectionShift) const override;
 
   matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const override;
 
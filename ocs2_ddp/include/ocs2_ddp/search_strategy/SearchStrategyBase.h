@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
+#include "ocs2_ddp/AugmentedLagrangian.h"
 #include "StrategySettings.h"
 
 namespace ocs2 {
@@ -84,6 +85,14 @@ class SearchStrategyBase {
    */
   virtual void reset() = 0;
 
+  /**
+   * Sets the augmented Lagrangian of the state-only equality and the inequality constraints. If set, its terms replace the penalty of
+   * the inequality constraints in the performance index, and define the equality Lagrangian.
+   *
+   * @param [in] augmentedLagrangianPtr: A pointer to the augmented Lagrangian, or nullptr to use the penalty.
+   */
+  void setAugmentedLagrangian(const AugmentedLagrangian* augmentedLagrangianPtr) { augmentedLagrangianPtr_ = augmentedLagrangianPtr; }
+
   /**
    * Finds the optimal trajectories, controller, and performance index based on the given controller and its increment.
    *
@@ -126,9 +135,11 @@ class SearchStrategyBase {
    * @param [out] deltaQm: The Riccati modifier to cost 2nd derivative w.r.t. state.
    * @param [out] deltaGv: The Riccati modifier to cost derivative w.r.t. input.
    * @param [out] deltaGm: The Riccati modifier to cost input-state derivative.
+   * @param [in, out] hessianCorrectionShift: The diagonal shift of the Hessian correction cached for this node. It is only used by the
+   * strategies which correct the Hessian.
    */
-  virtual void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
-                                          matrix_t& deltaGm) const = 0;
+  virtual void computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv, matrix_t& deltaGm,
+                                          scalar_t& hessianCorrectionShift) const = 0;
 
   /**
    * Augments the Hessian of Hamiltonian based on the strategy.
@@ -215,6 +226,8 @@ class SearchStrategyBase {
   size_t finalActivePartition_ = 0;
   size_t numPartitions_ = 0;
   scalar_array_t partitioningTimes_;
+
+  const AugmentedLagrangian* augmentedLagrangianPtr_ = nullptr;
 };
 
 }  // namespace ocs2
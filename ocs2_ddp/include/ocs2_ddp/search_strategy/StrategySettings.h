@@ -97,6 +97,8 @@ struct Settings {
   hessian_correction::Strategy hessianCorrectionStrategy_ = hessian_correction::Strategy::DIAGONAL_SHIFT;
   /** The multiple used for correcting the Hessian for numerical stability of the Riccati backward pass.*/
   scalar_t hessianCorrectionMultiple_ = numeric_traits::limitEpsilon<scalar_t>();
+  /** Whether to cache the diagonal shift of the Hessian correction at each node and to try it in the next iteration. */
+  bool cacheHessianCorrectionShift_ = false;
 };  // end of Settings
 
 /**
@@ -380,12 +380,12 @@ class SLQ_Hamiltonian : public DDP_BASE<STATE_DIM, INPUT_DIM> {
                        const input_state_matrix_t& LmConstrained, const input_vector_t& LvConstrained,
                        const input_vector_t& LveConstrained) {
     // k
-    BASE::nominalControllersStock_[partitionIndex].gainArray_[timeIndex] =
+    BASE::nominalControllersStock_[partitionIndex].gainArray()[timeIndex] =
         LmConstrained - CmProjectedTrajectoryStock_[partitionIndex][timeIndex];
     // uff
     BASE::nominalControllersStock_[partitionIndex].biasArray_[timeIndex] =
         BASE::nominalInputTrajectoriesStock_[partitionIndex][timeIndex] -
-        BASE::nominalControllersStock_[partitionIndex].gainArray_[timeIndex] *
+        BASE::nominalControllersStock_[partitionIndex].gainArray()[timeIndex] *
             BASE::nominalStateTrajectoriesStock_[partitionIndex][timeIndex] +
         constraintStepSize * (LveConstrained - EvProjectedTrajectoryStock_[partitionIndex][timeIndex]);
     // deltaUff
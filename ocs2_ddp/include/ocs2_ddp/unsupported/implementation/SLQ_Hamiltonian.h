@@ -304,7 +304,7 @@ void SLQ_Hamiltonian<STATE_DIM, INPUT_DIM, LOGIC_RULES_T>::calculateController()
     const size_t N = BASE::SsTimeTrajectoryStock_[i].size();
 
     BASE::nominalControllersStock_[i].timeStamp_ = BASE::SsTimeTrajectoryStock_[i];
-    BASE::nominalControllersStock_[i].gainArray_.resize(N);
+    BASE::nominalControllersStock_[i].gainArray().resize(N);
     BASE::nominalControllersStock_[i].biasArray_.resize(N);
     BASE::nominalControllersStock_[i].deltaBiasArray_.resize(N);
 
@@ -376,15 +376,15 @@ void SLQ_Hamiltonian<STATE_DIM, INPUT_DIM, LOGIC_RULES_T>::calculateControllerWo
   input_vector_t Lve = RmInverse * (Bm.transpose() * BASE::SveTrajectoryStock_[i][k]);
 
   input_matrix_t DmNullProjection = input_matrix_t::Identity() - DmProjected;
-  BASE::nominalControllersStock_[i].gainArray_[k] = -DmNullProjection * Lm - CmProjected;
-  BASE::nominalControllersStock_[i].biasArray_[k] = nominalInput - BASE::nominalControllersStock_[i].gainArray_[k] * nominalState -
+  BASE::nominalControllersStock_[i].gainArray()[k] = -DmNullProjection * Lm - CmProjected;
+  BASE::nominalControllersStock_[i].biasArray_[k] = nominalInput - BASE::nominalControllersStock_[i].gainArray()[k] * nominalState -
                                                     BASE::constraintStepSize_ * (DmNullProjection * Lve + EvProjected);
   BASE::nominalControllersStock_[i].deltaBiasArray_[k] = -DmNullProjection * Lv;
 
   // checking the numerical stability of the controller parameters
   if (BASE::ddpSettings_.checkNumericalStability_) {
     try {
-      if (!BASE::nominalControllersStock_[i].gainArray_[k].allFinite()) {
+      if (!BASE::nominalControllersStock_[i].gainArray()[k].allFinite()) {
         throw std::runtime_error("Feedback gains are unstable.");
       }
       if (!BASE::nominalControllersStock_[i].deltaBiasArray_[k].allFinite()) {
@@ -933,7 +933,7 @@ void SLQ_Hamiltonian<STATE_DIM, INPUT_DIM, LOGIC_RULES_T>::fullRiccatiBackwardSw
 
   // controller parameters
   BASE::nominalControllersStock_[partitionIndex].timeStamp_ = BASE::nominalTimeTrajectoriesStock_[partitionIndex];
-  BASE::nominalControllersStock_[partitionIndex].gainArray_.resize(N);
+  BASE::nominalControllersStock_[partitionIndex].gainArray().resize(N);
   BASE::nominalControllersStock_[partitionIndex].biasArray_.resize(N);
   BASE::nominalControllersStock_[partitionIndex].deltaBiasArray_.resize(N);
 
@@ -1068,7 +1068,7 @@ void SLQ_Hamiltonian<STATE_DIM, INPUT_DIM, LOGIC_RULES_T>::fullRiccatiBackwardSw
 
       // checking the numerical stability of the controller parameters
       try {
-        if (BASE::nominalControllersStock_[partitionIndex].gainArray_[k].hasNaN()) {
+        if (BASE::nominalControllersStock_[partitionIndex].gainArray()[k].hasNaN()) {
           throw std::runtime_error("Feedback gains are unstable.");
         }
         if (BASE::nominalControllersStock_[partitionIndex].biasArray_[k].hasNaN()) {
@@ -0,0 +1,241 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/AugmentedLagrangian.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+namespace {
+/**
+ * Interpolates the multipliers of the given size at the given time. The nodes with a different size (i.e. of another mode) are ignored.
+ */
+vector_t interpolateMultiplier(scalar_t time, size_t numConstraints, const scalar_array_t& timeTrajectory,
+                               const vector_array_t& multiplierTrajectory) {
+  if (timeTrajectory.empty()) {
+    return vector_t::Zero(numConstraints);
+  }
+
+  const auto indexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory);
+  const size_t first = indexAlpha.first;
+  const size_t second = std::min(first + 1, timeTrajectory.size() - 1);
+  const bool isFirstValid = multiplierTrajectory[first].size() == numConstraints;
+  const bool isSecondValid = multiplierTrajectory[second].size() == numConstraints;
+  if (isFirstValid && isSecondValid) {
+    return indexAlpha.second * multiplierTrajectory[first] + (1.0 - indexAlpha.second) * multiplierTrajectory[second];
+  } else if (isFirstValid) {
+    return multiplierTrajectory[first];
+  } else if (isSecondValid) {
+    return multiplierTrajectory[second];
+  } else {
+    return vector_t::Zero(numConstraints);
+  }
+}
+
+/** Adds the quadratic approximation of lambda' h + 0.5 * rho * |h|^2 to the cost */
+void augmentEqualityCost(const VectorFunctionLinearApproximation& h, const vector_t& lambda, scalar_t rho,
+                         ScalarFunctionQuadraticApproximation& cost) {
+  cost.f += lambda.dot(h.f) + 0.5 * rho * h.f.squaredNorm();
+  cost.dfdx.noalias() += h.dfdx.transpose() * (lambda + rho * h.f);
+  cost.dfdxx.noalias() += rho * h.dfdx.transpose() * h.dfdx;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AugmentedLagrangian::clear() {
+  timeTrajectory_.clear();
+  stateEqMultipliers_.clear();
+  inequalityMultipliers_.clear();
+  eventTimes_.clear();
+  eventStateEqMultipliers_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, scalar_t> AugmentedLagrangian::getIntermediateValue(const ModelData& modelData) const {
+  scalar_t equalityValue = 0.0;
+  const vector_t& h = modelData.stateEqConstr_.f;
+  if (h.size() > 0) {
+    const vector_t lambda = getStateEqualityMultiplier(modelData.time_, h.size());
+    equalityValue = lambda.dot(h) + 0.5 * penalties_.stateEq * h.squaredNorm();
+  }
+
+  scalar_t inequalityValue = 0.0;
+  const vector_t& g = modelData.ineqConstr_.f;
+  if (g.size() > 0) {
+    const scalar_t rho = penalties_.inequality;
+    const vector_t mu = getInequalityMultiplier(modelData.time_, g.size());
+    const vector_t nu = (mu - rho * g).cwiseMax(0.0);
+    inequalityValue = 0.5 / rho * (nu.squaredNorm() - mu.squaredNorm());
+  }
+
+  return {equalityValue, inequalityValue};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t AugmentedLagrangian::getEventValue(const ModelData& modelData) const {
+  const vector_t& h = modelData.stateEqConstr_.f;
+  if (h.size() == 0) {
+    return 0.0;
+  }
+  const vector_t lambda = getEventStateEqualityMultiplier(modelData.time_, h.size());
+  return lambda.dot(h) + 0.5 * penalties_.finalStateEq * h.squaredNorm();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AugmentedLagrangian::augmentIntermediateCost(ModelData& modelData) const {
+  // state-only equality constraints
+  const auto& h = modelData.stateEqConstr_;
+  if (h.f.size() > 0) {
+    const vector_t lambda = getStateEqualityMultiplier(modelData.time_, h.f.size());
+    augmentEqualityCost(h, lambda, penalties_.stateEq, modelData.cost_);
+  }
+
+  // inequality constraints: the derivative of the term w.r.t. g is -nu, and its second derivative is rho for the active rows
+  const auto& g = modelData.ineqConstr_;
+  const size_t numInequalities = g.f.size();
+  if (numInequalities > 0) {
+    const scalar_t rho = penalties_.inequality;
+    const vector_t mu = getInequalityMultiplier(modelData.time_, numInequalities);
+    const vector_t nu = (mu - rho * g.f).cwiseMax(0.0);
+    const vector_t secondDerivative = rho * (nu.array() > 0.0).cast<scalar_t>().matrix();
+    const matrix_t secondDerivative_dgdx = secondDerivative.asDiagonal() * g.dfdx;
+
+    auto& cost = modelData.cost_;
+    cost.f += 0.5 / rho * (nu.squaredNorm() - mu.squaredNorm());
+    cost.dfdx.noalias() -= g.dfdx.transpose() * nu;
+    cost.dfdxx.noalias() += g.dfdx.transpose() * secondDerivative_dgdx;
+    for (size_t i = 0; i < numInequalities; i++) {
+      cost.dfdxx.noalias() -= nu(i) * g.dfdxx[i];
+    }
+
+    if (g.dfdu.cols() > 0) {
+      cost.dfdu.noalias() -= g.dfdu.transpose() * nu;
+      cost.dfdux.noalias() += g.dfdu.transpose() * secondDerivative_dgdx;
+      cost.dfduu.noalias() += g.dfdu.transpose() * secondDerivative.asDiagonal() * g.dfdu;
+      for (size_t i = 0; i < numInequalities; i++) {
+        cost.dfduu.noalias() -= nu(i) * g.dfduu[i];
+        cost.dfdux.noalias() -= nu(i) * g.dfdux[i];
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AugmentedLagrangian::augmentEventCost(ModelData& modelData) const {
+  const auto& h = modelData.stateEqConstr_;
+  if (h.f.size() > 0) {
+    const vector_t lambda = getEventStateEqualityMultiplier(modelData.time_, h.f.size());
+    augmentEqualityCost(h, lambda, penalties_.finalStateEq, modelData.cost_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void AugmentedLagrangian::updateMultipliers(const std::vector<std::vector<ModelData>>& modelDataTrajectoriesStock,
+                                            const std::vector<std::vector<ModelData>>& modelDataEventTimesStock, size_t initActivePartition,
+                                            size_t finalActivePartition, const MultiplierUpdates& multiplierUpdates) {
+  const scalar_t stateEqStep = multiplierUpdates.stateEq ? penalties_.stateEq : 0.0;
+  const scalar_t finalStateEqStep = multiplierUpdates.finalStateEq ? penalties_.finalStateEq : 0.0;
+  const scalar_t inequalityStep = multiplierUpdates.inequality ? penalties_.inequality : 0.0;
+
+  scalar_array_t timeTrajectory;
+  vector_array_t stateEqMultipliers;
+  vector_array_t inequalityMultipliers;
+  scalar_array_t eventTimes;
+  vector_array_t eventStateEqMultipliers;
+
+  for (size_t i = initActivePartition; i <= finalActivePartition; i++) {
+    for (const auto& modelData : modelDataTrajectoriesStock[i]) {
+      const vector_t& h = modelData.stateEqConstr_.f;
+      const vector_t& g = modelData.ineqConstr_.f;
+      timeTrajectory.push_back(modelData.time_);
+      stateEqMultipliers.emplace_back(getStateEqualityMultiplier(modelData.time_, h.size()) + stateEqStep * h);
+      inequalityMultipliers.emplace_back((getInequalityMultiplier(modelData.time_, g.size()) - inequalityStep * g).cwiseMax(0.0));
+    }
+
+    for (const auto& modelData : modelDataEventTimesStock[i]) {
+      const vector_t& h = modelData.stateEqConstr_.f;
+      eventTimes.push_back(modelData.time_);
+      eventStateEqMultipliers.emplace_back(getEventStateEqualityMultiplier(modelData.time_, h.size()) + finalStateEqStep * h);
+    }
+  }  // end of i loop
+
+  timeTrajectory_.swap(timeTrajectory);
+  stateEqMultipliers_.swap(stateEqMultipliers);
+  inequalityMultipliers_.swap(inequalityMultipliers);
+  eventTimes_.swap(eventTimes);
+  eventStateEqMultipliers_.swap(eventStateEqMultipliers);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t AugmentedLagrangian::getStateEqualityMultiplier(scalar_t time, size_t numConstraints) const {
+  return interpolateMultiplier(time, numConstraints, timeTrajectory_, stateEqMultipliers_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t AugmentedLagrangian::getInequalityMultiplier(scalar_t time, size_t numConstraints) const {
+  return interpolateMultiplier(time, numConstraints, timeTrajectory_, inequalityMultipliers_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t AugmentedLagrangian::getEventStateEqualityMultiplier(scalar_t time, size_t numConstraints) const {
+  const vector_t* closestMultiplierPtr = nullptr;
+  scalar_t closestDistance = std::numeric_limits<scalar_t>::max();
+  for (size_t j = 0; j < eventTimes_.size(); j++) {
+    const scalar_t distance = std::abs(eventTimes_[j] - time);
+    if (eventStateEqMultipliers_[j].size() == numConstraints && distance < closestDistance) {
+      closestMultiplierPtr = &eventStateEqMultipliers_[j];
+      closestDistance = distance;
+    }
+  }
+  return closestMultiplierPtr != nullptr ? *closestMultiplierPtr : vector_t::Zero(numConstraints);
+}
+
+}  // namespace ocs2
@@ -29,47 +29,136 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/ContinuousTimeLqr.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include <Eigen/Eigenvalues>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
 namespace ocs2 {
 namespace continuous_time_lqr {
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-solution solve(OptimalControlProblem& problem, scalar_t time, const vector_t& state, const vector_t& input, const Settings& settings) {
-  const size_t stateDim = state.size();
+namespace {
 
-  // --- Form the Linear quadratic approximation ---
-  LinearQuadraticApproximator lqapprox(problem, settings.checkNumericalCharacteristics);
+/** The CARE without the state-input cost: A' S + S A - S G S + Q = 0 */
+struct ReducedProblem {
+  matrix_t RinvU;     // Rinv = RinvU * RinvU.transpose()
+  matrix_t B_RinvU;   // B * RinvU
+  matrix_t PT_RinvU;  // P' * RinvU
+  matrix_t A;         // A - B * Rinv * P
+  matrix_t Q;         // Q - P' * Rinv * P
+  matrix_t G;         // B * Rinv * B'
+};
 
-  // Obtain model data at the provided reference
-  ModelData modelData;
-  modelData.time_ = time;
-  modelData.stateDim_ = stateDim;
-  modelData.inputDim_ = input.size();
-  modelData.dynamicsBias_.setZero(stateDim);
-  lqapprox.approximateLQProblem(time, state, input, modelData);
+ReducedProblem reduceProblem(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost) {
+  ReducedProblem reduced;
+  LinearAlgebra::computeInverseMatrixUUT(cost.dfduu, reduced.RinvU);
+  reduced.B_RinvU = dynamics.dfdu * reduced.RinvU;
+  reduced.PT_RinvU = cost.dfdux.transpose() * reduced.RinvU;
+  reduced.A = dynamics.dfdx;
+  reduced.A.noalias() -= reduced.B_RinvU * reduced.PT_RinvU.transpose();
+  reduced.Q = cost.dfdxx;
+  reduced.Q.noalias() -= reduced.PT_RinvU * reduced.PT_RinvU.transpose();
+  reduced.G.noalias() = reduced.B_RinvU * reduced.B_RinvU.transpose();
+  return reduced;
+}
 
-  // --- Contstruct hamiltonian ---
-  // Compute terms containing inv(R)
-  matrix_t RinvU;
-  LinearAlgebra::computeInverseMatrixUUT(modelData.cost_.dfduu, RinvU);  // Rinv = RinvU * RinvU.transpose()
-  const matrix_t B_RinvU = modelData.dynamics_.dfdu * RinvU;
-  matrix_t PT_RinvU = modelData.cost_.dfdux.transpose() * RinvU;
-  const matrix_t B_Rinv_BT = B_RinvU * B_RinvU.transpose();
-  const matrix_t B_Rinv_P = B_RinvU * PT_RinvU.transpose();
-  const matrix_t PT_Rinv_P = PT_RinvU * PT_RinvU.transpose();
+/** Feedback gains K = -Rinv * (P + B' * S) */
+matrix_t computeFeedbackGains(const ReducedProblem& reduced, const matrix_t& S) {
+  matrix_t PT_RinvU = reduced.PT_RinvU;
+  PT_RinvU.noalias() += S.transpose() * reduced.B_RinvU;
+  return -reduced.RinvU * PT_RinvU.transpose();
+}
 
-  // Correct for state-input matrix
-  const matrix_t A = modelData.dynamics_.dfdx - B_Rinv_P;
-  const matrix_t Q = modelData.cost_.dfdxx - PT_Rinv_P;
+/**
+ * Solves the Lyapunov equation A' X + X A + C = 0 with the Bartels-Stewart algorithm on the real Schur form A = U T U'.
+ * Returns false if A is not Hurwitz.
+ */
+bool solveLyapunov(const matrix_t& A, const matrix_t& C, matrix_t& X) {
+  using small_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, 0, 4, 4>;
+  using small_vector_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, 0, 4, 1>;
 
-  // The permuted Hamiltonian is the initial point of the iterative algorithm
-  matrix_t W = (matrix_t(2 * stateDim, 2 * stateDim) << -Q, -A.transpose(), -A, B_Rinv_BT).finished();
+  const Eigen::RealSchur<matrix_t> schur(A);
+  if (schur.info() != Eigen::Success) {
+    return false;
+  }
+  const matrix_t& T = schur.matrixT();
+  const matrix_t& U = schur.matrixU();
+  const int n = A.rows();
+
+  // The 1x1 and 2x2 diagonal blocks of the quasi-triangular T, and the real parts of their eigenvalues
+  std::vector<int> blockStarts;
+  blockStarts.reserve(n + 1);
+  for (int i = 0; i < n;) {
+    const int blockSize = (i + 1 < n && T(i + 1, i) != 0.0) ? 2 : 1;
+    if (T.block(i, i, blockSize, blockSize).trace() >= 0.0) {
+      return false;
+    }
+    blockStarts.push_back(i);
+    i += blockSize;
+  }
+  blockStarts.push_back(n);
+  const size_t numBlocks = blockStarts.size() - 1;
+
+  // T' Y + Y T = F with Y = U' X U and F = -U' C U. The block columns of Y follow from the block forward substitution
+  // T_kk' Y_kj + Y_kj T_jj = F_kj - sum_{i<j} Y_ki T_ij - sum_{l<k} T_lk' Y_lj
+  matrix_t Y = -U.transpose() * C * U;
+  small_matrix_t kroneckerSum;
+  for (size_t bj = 0; bj < numBlocks; bj++) {
+    const int j = blockStarts[bj];
+    const int q = blockStarts[bj + 1] - j;
+    if (j > 0) {
+      Y.middleCols(j, q).noalias() -= Y.leftCols(j) * T.block(0, j, j, q);
+    }
+    // Y is symmetric, the blocks above the diagonal are already known from the previous block columns
+    Y.block(0, j, j, q) = Y.block(j, 0, q, j).transpose();
+    for (size_t bk = bj; bk < numBlocks; bk++) {
+      const int k = blockStarts[bk];
+      const int p = blockStarts[bk + 1] - k;
+      if (k > 0) {
+        Y.block(k, j, p, q).noalias() -= T.block(0, k, k, p).transpose() * Y.block(0, j, k, q);
+      }
+      // vec(T_kk' Y_kj + Y_kj T_jj) = (I_q (x) T_kk' + T_jj' (x) I_p) vec(Y_kj)
+      kroneckerSum.setZero(p * q, p * q);
+      for (int a = 0; a < q; a++) {
+        for (int b = 0; b < q; b++) {
+          for (int r = 0; r < p; r++) {
+            kroneckerSum(a * p + r, b * p + r) += T(j + b, j + a);
+            if (a == b) {
+              for (int c = 0; c < p; c++) {
+                kroneckerSum(a * p + r, b * p + c) += T(k + c, k + r);
+              }
+            }
+          }
+        }
+      }
+      small_vector_t vecY(p * q);
+      for (int a = 0; a < q; a++) {
+        vecY.segment(a * p, p) = Y.block(k, j + a, p, 1);
+      }
+      vecY = kroneckerSum.partialPivLu().solve(vecY);
+      for (int a = 0; a < q; a++) {
+        Y.block(k, j + a, p, 1) = vecY.segment(a * p, p);
+      }
+    }
+  }
+
+  X.noalias() = U * Y * U.transpose();
+  X = 0.5 * (X + X.transpose()).eval();
+  return true;
+}
+
+/** Implements "Algorithm 13.5.6. The Matrix Sign Function Algorithm for the CARE", see ContinuousTimeLqr.h */
+solution solveMatrixSignFunction(const ReducedProblem& reduced, const Settings& settings) {
+  const size_t stateDim = reduced.A.rows();
+  const auto& A = reduced.A;
+  const auto& Q = reduced.Q;
 
-  // --- Solve CARE ---
+  // The permuted Hamiltonian is the initial point of the iterative algorithm
+  matrix_t W = (matrix_t(2 * stateDim, 2 * stateDim) << -Q, -A.transpose(), -A, reduced.G).finished();
 
   // Temporary variables used in the iteration
   matrix_t Winv(2 * stateDim, 2 * stateDim);
@@ -85,10 +174,12 @@ solution solve(OptimalControlProblem& problem, scalar_t time, const vector_t& st
 
     // Prepare update: W(k+1) = 1/(2c) * (W(k) + c^2 * J *  inv(W(k)) * J)
     // W(k+1) - W(k) = c1 * W(k) + c2 *  J *  inv(W(k)) * J
-    const scalar_t c = std::pow(std::abs(W.determinant()), exponent);
+    // The scale c = |det(W(k))|^(1/2n) is taken in the log domain from the LU factorization of the inverse
+    const Eigen::PartialPivLU<matrix_t> WLu(W);
+    const scalar_t c = std::exp(exponent * WLu.matrixLU().diagonal().array().abs().log().sum());
     const scalar_t c1 = 0.5 / c - 1.0;
     const scalar_t c2 = 0.5 * c;
-    Winv = W.partialPivLu().inverse();
+    Winv = WLu.inverse();
     JWinvJ << -Winv.bottomRightCorner(stateDim, stateDim), Winv.bottomLeftCorner(stateDim, stateDim),
         Winv.topRightCorner(stateDim, stateDim), -Winv.topLeftCorner(stateDim, stateDim);  // Implement J * Winv * J, with J = [0, I; -I 0]
     dW = c1 * W + c2 * JWinvJ;
@@ -103,13 +194,197 @@ solution solve(OptimalControlProblem& problem, scalar_t time, const vector_t& st
   lhsM << W.bottomRightCorner(stateDim, stateDim), W.topRightCorner(stateDim, stateDim) + matrix_t::Identity(stateDim, stateDim);
   matrix_t rhsN(2 * stateDim, stateDim);
   rhsN << matrix_t::Identity(stateDim, stateDim) - W.bottomLeftCorner(stateDim, stateDim), -W.topLeftCorner(stateDim, stateDim);
-  const matrix_t S = lhsM.colPivHouseholderQr().solve(rhsN);
+  matrix_t S = lhsM.colPivHouseholderQr().solve(rhsN);
 
   // Compute feedback gains
-  PT_RinvU.noalias() += S.transpose() * B_RinvU;
-  const matrix_t K = -RinvU * PT_RinvU.transpose();
+  matrix_t K = computeFeedbackGains(reduced, S);
+
+  return {std::move(K), std::move(S)};
+}
+
+/** The CARE residual A' S + S A - S G S + Q relative to the norm of the constant terms Q + S G S */
+scalar_t computeRelativeCareResidual(const ReducedProblem& reduced, const matrix_t& S) {
+  const matrix_t GS = reduced.G * S;
+  matrix_t constantTerms = reduced.Q;
+  constantTerms.noalias() += S.transpose() * GS;
+  matrix_t SA = S * reduced.A;
+  const matrix_t residual = SA + SA.transpose() - 2.0 * S.transpose() * GS + constantTerms;
+  return residual.norm() / constantTerms.norm();
+}
+
+/**
+ * Newton-Kleinman: (A - G S_k)' S_{k+1} + S_{k+1} (A - G S_k) + Q + S_k G S_k = 0.
+ * The iteration is stopped once the relative CARE residual is below the tolerance, which is cheaper to check than an additional
+ * iteration.
+ */
+bool solveNewtonKleinman(const ReducedProblem& reduced, const matrix_t& valueFunctionGuess, const Settings& settings,
+                         solution& lqrSolution) {
+  matrix_t S = valueFunctionGuess;
+  matrix_t Snext;
+  matrix_t closedLoopA;
+  matrix_t C;
+  matrix_t GS;
+  for (size_t iter = 0; iter < settings.maxNewtonKleinmanIter; iter++) {
+    GS.noalias() = reduced.G * S;
+    closedLoopA = reduced.A - GS;
+    C = reduced.Q;
+    C.noalias() += S.transpose() * GS;
+    if (!solveLyapunov(closedLoopA, C, Snext)) {
+      return false;
+    }
+
+    S.swap(Snext);
+    if (computeRelativeCareResidual(reduced, S) <= settings.tolerance) {
+      lqrSolution.feedbackGains = computeFeedbackGains(reduced, S);
+      lqrSolution.valueFunction = std::move(S);
+      return true;
+    }
+  }
+
+  return false;
+}
 
-  return {K, S};
+/** Quantizes the linearization point */
+std::vector<long long> quantize(scalar_t time, const vector_t& state, const vector_t& input, scalar_t resolution) {
+  std::vector<long long> key;
+  key.reserve(1 + state.size() + input.size());
+  key.push_back(std::llround(time / resolution));
+  for (int i = 0; i < state.size(); i++) {
+    key.push_back(std::llround(state(i) / resolution));
+  }
+  for (int i = 0; i < input.size(); i++) {
+    key.push_back(std::llround(input(i) / resolution));
+  }
+  return key;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+solution solve(OptimalControlProblem& problem, scalar_t time, const vector_t& state, const vector_t& input, const Settings& settings) {
+  const size_t stateDim = state.size();
+
+  // --- Form the Linear quadratic approximation ---
+  LinearQuadraticApproximator lqapprox(problem, settings.checkNumericalCharacteristics);
+
+  // Obtain model data at the provided reference
+  ModelData modelData;
+  modelData.time_ = time;
+  modelData.stateDim_ = stateDim;
+  modelData.inputDim_ = input.size();
+  modelData.dynamicsBias_.setZero(stateDim);
+  lqapprox.approximateLQProblem(time, state, input, modelData);
+
+  return solve(modelData.dynamics_, modelData.cost_, settings);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+solution solve(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+               const Settings& settings) {
+  return solveMatrixSignFunction(reduceProblem(dynamics, cost), settings);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool refine(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+            const matrix_t& valueFunctionGuess, const Settings& settings, solution& lqrSolution) {
+  return solveNewtonKleinman(reduceProblem(dynamics, cost), valueFunctionGuess, settings, lqrSolution);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CachedSolver::CachedSolver(Settings settings, scalar_t resolution, size_t capacity)
+    : settings_(std::move(settings)), resolution_(resolution), capacity_(capacity) {
+  if (resolution_ <= 0.0) {
+    throw std::runtime_error("[CachedSolver] The resolution of the cache key should be positive!");
+  }
+  if (capacity_ == 0) {
+    throw std::runtime_error("[CachedSolver] The capacity of the cache should be at least one!");
+  }
+  entries_.reserve(capacity_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const solution& CachedSolver::solve(OptimalControlProblem& problem, scalar_t time, const vector_t& state, const vector_t& input) {
+  numQueries_++;
+
+  // Obtain model data at the provided reference
+  LinearQuadraticApproximator lqapprox(problem, settings_.checkNumericalCharacteristics);
+  ModelData modelData;
+  modelData.time_ = time;
+  modelData.stateDim_ = state.size();
+  modelData.inputDim_ = input.size();
+  modelData.dynamicsBias_.setZero(state.size());
+  lqapprox.approximateLQProblem(time, state, input, modelData);
+  const auto& dynamics = modelData.dynamics_;
+  const auto& cost = modelData.cost_;
+
+  // The entry of the same key, or else the last used entry, is the warm start
+  auto key = quantize(time, state, input, resolution_);
+  auto entryItr = std::find_if(entries_.begin(), entries_.end(), [&](const Entry& e) { return e.key == key; });
+  const bool isKeyCached = entryItr != entries_.end();
+  const Entry* warmStartPtr = isKeyCached ? &(*entryItr) : (entries_.empty() ? nullptr : &entries_[lastEntryIndex_]);
+  if (warmStartPtr != nullptr &&
+      (warmStartPtr->dynamics.dfdx.rows() != state.size() || warmStartPtr->dynamics.dfdu.cols() != input.size())) {
+    warmStartPtr = nullptr;
+  }
+
+  solution lqrSolution;
+  if (warmStartPtr != nullptr && warmStartPtr->dynamics.dfdx == dynamics.dfdx && warmStartPtr->dynamics.dfdu == dynamics.dfdu &&
+      warmStartPtr->cost.dfdxx == cost.dfdxx && warmStartPtr->cost.dfduu == cost.dfduu && warmStartPtr->cost.dfdux == cost.dfdux) {
+    numHits_++;
+    if (isKeyCached) {
+      entryItr->lastUsed = numQueries_;
+      lastEntryIndex_ = static_cast<size_t>(entryItr - entries_.begin());
+      return entryItr->lqrSolution;
+    }
+    lqrSolution = warmStartPtr->lqrSolution;
+  } else {
+    // A warm start is only refined if it is close enough for the Newton-Kleinman iteration to be cheaper than the sign function
+    const auto reduced = reduceProblem(dynamics, cost);
+    const bool isWarmStartClose = warmStartPtr != nullptr && computeRelativeCareResidual(reduced, warmStartPtr->lqrSolution.valueFunction) <
+                                                                 settings_.maxWarmStartResidual;
+    if (isWarmStartClose && solveNewtonKleinman(reduced, warmStartPtr->lqrSolution.valueFunction, settings_, lqrSolution)) {
+      numRefinements_++;
+    } else {
+      numColdStarts_++;
+      lqrSolution = solveMatrixSignFunction(reduced, settings_);
+    }
+  }
+
+  // Store the solution in the entry of the same key, a free entry, or the least recently used entry
+  if (!isKeyCached) {
+    if (entries_.size() < capacity_) {
+      entries_.emplace_back();
+      entryItr = std::prev(entries_.end());
+    } else {
+      entryItr =
+          std::min_element(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+    }
+    entryItr->key = std::move(key);
+  }
+  entryItr->dynamics = dynamics;
+  entryItr->cost = cost;
+  entryItr->lqrSolution = std::move(lqrSolution);
+  entryItr->lastUsed = numQueries_;
+  lastEntryIndex_ = static_cast<size_t>(entryItr - entries_.begin());
+  return entryItr->lqrSolution;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CachedSolver::clear() {
+  entries_.clear();
+  lastEntryIndex_ = 0;
 }
 
 }  // namespace continuous_time_lqr
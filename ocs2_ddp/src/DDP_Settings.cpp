@@ -92,6 +92,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu_, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta_, fieldName + ".inequalityConstraintDelta", verbose);
+  loadData::loadPtreeValue(pt, settings.useAugmentedLagrangian_, fieldName + ".useAugmentedLagrangian", verbose);
+  loadData::loadPtreeValue(pt, settings.augmentedLagrangianMaxPenalty_, fieldName + ".augmentedLagrangianMaxPenalty", verbose);
 
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
   loadData::loadPtreeValue(pt, settings.useNominalTimeForBackwardPass_, fieldName + ".useNominalTimeForBackwardPass", verbose);
@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/soft_constraint/penalties/RelaxedBarrierPenalty.h>
 
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
+#include <ocs2_oc/oc_solver/WarmStartSerialization.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
 
 #include <ocs2_ddp/HessianCorrection.h>
@@ -49,6 +50,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/**
+ * Copies [first, last) to dst starting at the given index, and returns the index after the last copied element. The existing elements
+ * are assigned in place, such that the memory of equally-sized Eigen objects is reused.
+ */
+template <typename T, typename Iterator>
+size_t assignInPlace(std::vector<T>& dst, size_t index, Iterator first, Iterator last) {
+  for (; first != last; ++first, ++index) {
+    if (index < dst.size()) {
+      dst[index] = *first;
+    } else {
+      dst.push_back(*first);
+    }
+  }
+  return index;
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -77,6 +96,9 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
   penaltyPtr_.reset(new SoftConstraintPenalty(std::move(penaltyFunction)));
 
   // initialize Augmented Lagrangian parameters
+  if (ddpSettings_.useAugmentedLagrangian_) {
+    augmentedLagrangianPtr_.reset(new AugmentedLagrangian);
+  }
   initializeConstraintPenalties();
 
   // search strategy method
@@ -109,6 +131,7 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
       break;
     }
   }  // end of switch-case
+  searchStrategyPtr_->setAugmentedLagrangian(augmentedLagrangianPtr_.get());
 }
 
 /******************************************************************************************************/
@@ -169,6 +192,9 @@ void GaussNewtonDDP::reset() {
 
   // initialize Augmented Lagrangian parameters
   initializeConstraintPenalties();
+  if (augmentedLagrangianPtr_ != nullptr) {
+    augmentedLagrangianPtr_->clear();
+  }
 
   for (size_t i = 0; i < numPartitions_; i++) {
     // very important, these are variables that are carried in between iterations
@@ -187,6 +213,7 @@ void GaussNewtonDDP::reset() {
     cachedModelDataEventTimesStock_[i].clear();
     cachedProjectedModelDataTrajectoriesStock_[i].clear();
     cachedRiccatiModificationTrajectoriesStock_[i].clear();
+    hessianCorrectionShiftTrajectoriesStock_[i].clear();
   }  // end of i loop
 
   // reset timers
@@ -247,13 +274,14 @@ void GaussNewtonDDP::getPrimalSolution(scalar_t finalTime, PrimalSolution* prima
     return static_cast<int>(firstLargerValueIterator - array.begin());
   };
 
-  // fill trajectories
-  primalSolutionPtr->timeTrajectory_.clear();
-  primalSolutionPtr->timeTrajectory_.reserve(N);
-  primalSolutionPtr->stateTrajectory_.clear();
-  primalSolutionPtr->stateTrajectory_.reserve(N);
-  primalSolutionPtr->inputTrajectory_.clear();
-  primalSolutionPtr->inputTrajectory_.reserve(N);
+  // fill trajectories, the existing elements are overwritten in place such that the memory of a recycled primal solution is reused
+  auto& timeTrajectory = primalSolutionPtr->timeTrajectory_;
+  auto& stateTrajectory = primalSolutionPtr->stateTrajectory_;
+  auto& inputTrajectory = primalSolutionPtr->inputTrajectory_;
+  timeTrajectory.reserve(N);
+  stateTrajectory.reserve(N);
+  inputTrajectory.reserve(N);
+  size_t numNodes = 0;
   for (size_t i = initActivePartition_; i <= finalActivePartition_; i++) {
     // break if the start time of the partition is greater than the final time
     if (nominalTimeTrajectoriesStock_[i].front() > finalTime) {
@@ -262,18 +290,31 @@ void GaussNewtonDDP::getPrimalSolution(scalar_t finalTime, PrimalSolution* prima
     // length of the copy
     const int length = upperBound(nominalTimeTrajectoriesStock_[i], finalTime);
 
-    primalSolutionPtr->timeTrajectory_.insert(primalSolutionPtr->timeTrajectory_.end(), nominalTimeTrajectoriesStock_[i].begin(),
-                                              nominalTimeTrajectoriesStock_[i].begin() + length);
-    primalSolutionPtr->stateTrajectory_.insert(primalSolutionPtr->stateTrajectory_.end(), nominalStateTrajectoriesStock_[i].begin(),
-                                               nominalStateTrajectoriesStock_[i].begin() + length);
-    primalSolutionPtr->inputTrajectory_.insert(primalSolutionPtr->inputTrajectory_.end(), nominalInputTrajectoriesStock_[i].begin(),
-                                               nominalInputTrajectoriesStock_[i].begin() + length);
+    const auto& timeTrajectory_i = nominalTimeTrajectoriesStock_[i];
+    const auto& stateTrajectory_i = nominalStateTrajectoriesStock_[i];
+    const auto& inputTrajectory_i = nominalInputTrajectoriesStock_[i];
+    assignInPlace(timeTrajectory, numNodes, timeTrajectory_i.begin(), timeTrajectory_i.begin() + length);
+    assignInPlace(stateTrajectory, numNodes, stateTrajectory_i.begin(), stateTrajectory_i.begin() + length);
+    numNodes = assignInPlace(inputTrajectory, numNodes, inputTrajectory_i.begin(), inputTrajectory_i.begin() + length);
   }
+  timeTrajectory.resize(numNodes);
+  stateTrajectory.resize(numNodes);
+  inputTrajectory.resize(numNodes);
 
-  // fill controller
+  // fill controller, a controller of the same type is overwritten in place
   if (ddpSettings_.useFeedbackPolicy_) {
-    primalSolutionPtr->controllerPtr_.reset(new LinearController);
+    auto* controllerPtr = dynamic_cast<LinearController*>(primalSolutionPtr->controllerPtr_.get());
+    if (controllerPtr == nullptr) {
+      controllerPtr = new LinearController;
+      primalSolutionPtr->controllerPtr_.reset(controllerPtr);
+    }
+    if (controllerPtr->gainsCompressed()) {  // a recycled controller is overwritten, no need to decompress it
+      controllerPtr->clear();
+    }
+
     // concatenate controller stock into a single controller
+    size_t numTimeStamps = 0;
+    bool hasDeltaBias = true;
     for (size_t i = initActivePartition_; i <= finalActivePartition_; i++) {
       // break if the start time of the partition is greater than the final time
       if (nominalControllersStock_[i].timeStamp_.front() > finalTime) {
@@ -281,11 +322,45 @@ void GaussNewtonDDP::getPrimalSolution(scalar_t finalTime, PrimalSolution* prima
       }
       // length of the copy
       const int length = upperBound(nominalControllersStock_[i].timeStamp_, finalTime);
-      primalSolutionPtr->controllerPtr_->concatenate(&(nominalControllersStock_[i]), 0, length);
+
+      // the controllers of the solver are not compressed, but a compressed controller would be decompressed
+      const LinearController* partitionControllerPtr = &nominalControllersStock_[i];
+      std::unique_ptr<LinearController> decompressedControllerPtr;
+      if (partitionControllerPtr->gainsCompressed()) {
+        decompressedControllerPtr.reset(partitionControllerPtr->clone());
+        decompressedControllerPtr->decompressGains();
+        partitionControllerPtr = decompressedControllerPtr.get();
+      }
+
+      const auto& timeStamp = partitionControllerPtr->timeStamp_;
+      const auto& biasArray = partitionControllerPtr->biasArray_;
+      const auto& gainArray = partitionControllerPtr->gainArray();
+      const auto& deltaBiasArray = partitionControllerPtr->deltaBiasArray_;
+      if (numTimeStamps > 0 && controllerPtr->timeStamp_[numTimeStamps - 1] > timeStamp.front()) {
+        throw std::runtime_error("Concatenate requires that the nextController comes later in time.");
+      }
+      assignInPlace(controllerPtr->timeStamp_, numTimeStamps, timeStamp.begin(), timeStamp.begin() + length);
+      assignInPlace(controllerPtr->biasArray_, numTimeStamps, biasArray.begin(), biasArray.begin() + length);
+      // deltaBiasArray can be of different, incompatible size.
+      hasDeltaBias = hasDeltaBias && length < static_cast<int>(deltaBiasArray.size());
+      if (hasDeltaBias) {
+        assignInPlace(controllerPtr->deltaBiasArray_, numTimeStamps, deltaBiasArray.begin(), deltaBiasArray.begin() + length);
+      }
+      numTimeStamps = assignInPlace(controllerPtr->gainArray(), numTimeStamps, gainArray.begin(), gainArray.begin() + length);
     }
+    controllerPtr->timeStamp_.resize(numTimeStamps);
+    controllerPtr->biasArray_.resize(numTimeStamps);
+    controllerPtr->gainArray().resize(numTimeStamps);
+    controllerPtr->deltaBiasArray_.resize(hasDeltaBias ? numTimeStamps : 0);
+
   } else {
-    primalSolutionPtr->controllerPtr_.reset(
-        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+    auto* controllerPtr = dynamic_cast<FeedforwardController*>(primalSolutionPtr->controllerPtr_.get());
+    if (controllerPtr == nullptr) {
+      controllerPtr = new FeedforwardController;
+      primalSolutionPtr->controllerPtr_.reset(controllerPtr);
+    }
+    controllerPtr->timeStamp_ = timeTrajectory;
+    controllerPtr->uffArray_ = inputTrajectory;
   }
 
   // fill mode schedule
@@ -488,6 +563,7 @@ void GaussNewtonDDP::setupOptimizer(size_t numPartitions) {
    */
   riccatiModificationTrajectoriesStock_.resize(numPartitions);
   cachedRiccatiModificationTrajectoriesStock_.resize(numPartitions);
+  hessianCorrectionShiftTrajectoriesStock_.resize(numPartitions);
 }
 
 /******************************************************************************************************/
@@ -580,6 +656,7 @@ scalar_t GaussNewtonDDP::rolloutInitialTrajectory(std::vector<LinearController>&
               << "\tcontroller available till t = " << controllerAvailableTill << "\n";
   }
 
+  int eventIndex = 0;  // the mode index of the last node, see ModelData::eventIndex_
   size_t numSteps = 0;
   vector_t xCurrent = initState_;
   for (size_t i = initActivePartition_; i < finalActivePartition_ + 1; i++) {
@@ -642,10 +719,12 @@ scalar_t GaussNewtonDDP::rolloutInitialTrajectory(std::vector<LinearController>&
       inputTrajectoriesStock[i].insert(inputTrajectoriesStock[i].end(), inputTrajectoryTail.begin(), inputTrajectoryTail.end());
     }
 
-    // update model data trajectory
+    // update model data trajectory, the mode index is looked up as in ModeSchedule::modeAtTime with the previous node as the hint
     modelDataTrajectoriesStock[i].resize(timeTrajectoriesStock[i].size());
     for (size_t k = 0; k < timeTrajectoriesStock[i].size(); k++) {
+      eventIndex = lookup::findIndexInTimeArray(eventTimes, timeTrajectoriesStock[i][k], eventIndex);
       modelDataTrajectoriesStock[i][k].time_ = timeTrajectoriesStock[i][k];
+      modelDataTrajectoriesStock[i][k].eventIndex_ = eventIndex;
       modelDataTrajectoriesStock[i][k].stateDim_ = stateTrajectoriesStock[i][k].size();
       modelDataTrajectoriesStock[i][k].inputDim_ = inputTrajectoriesStock[i][k].size();
       modelDataTrajectoriesStock[i][k].dynamicsBias_.setZero(stateTrajectoriesStock[i][k].size());
@@ -656,6 +735,7 @@ scalar_t GaussNewtonDDP::rolloutInitialTrajectory(std::vector<LinearController>&
     for (size_t ke = 0; ke < postEventIndicesStock[i].size(); ke++) {
       const auto index = postEventIndicesStock[i][ke] - 1;
       modelDataEventTimesStock[i][ke].time_ = timeTrajectoriesStock[i][index];
+      modelDataEventTimesStock[i][ke].eventIndex_ = modelDataTrajectoriesStock[i][index].eventIndex_;
       modelDataEventTimesStock[i][ke].stateDim_ = stateTrajectoriesStock[i][index].size();
       modelDataEventTimesStock[i][ke].inputDim_ = inputTrajectoriesStock[i][index].size();
       modelDataEventTimesStock[i][ke].dynamicsBias_.setZero(stateTrajectoriesStock[i][index].size());
@@ -698,6 +778,14 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
   // total cost
   scalar_t merit = performanceIndex.totalCost;
 
+  if (augmentedLagrangianPtr_ != nullptr) {
+    // augmented Lagrangian terms of the state-only equality and the inequality constraints
+    merit += performanceIndex.equalityLagrangian + performanceIndex.inequalityConstraintPenalty;
+    // intermediate state-input equality constraints
+    merit += constraintPenaltyCoefficients_.stateInputEqConstrPenaltyCoeff * std::sqrt(performanceIndex.stateInputEqConstraintISE);
+    return merit;
+  }
+
   // intermediate state-only equality constraints
   merit += constraintPenaltyCoefficients_.stateEqConstrPenaltyCoeff * performanceIndex.stateEqConstraintISE;
 
@@ -847,7 +935,7 @@ void GaussNewtonDDP::calculateController() {
     const auto N = SsTimeTrajectoryStock_[i].size();
 
     nominalControllersStock_[i].timeStamp_ = SsTimeTrajectoryStock_[i];
-    nominalControllersStock_[i].gainArray_.resize(N);
+    nominalControllersStock_[i].gainArray().resize(N);
     nominalControllersStock_[i].biasArray_.resize(N);
     nominalControllersStock_[i].deltaBiasArray_.resize(N);
 
@@ -880,12 +968,12 @@ void GaussNewtonDDP::calculateController() {
     auto& ctrl = nominalControllersStock_[finalActivePartition_];
     if (ctrl.size() > 1) {
       const auto secondToLastIndex = ctrl.size() - 2;
-      ctrl.gainArray_.back() = ctrl.gainArray_[secondToLastIndex];
+      ctrl.gainArray().back() = ctrl.gainArray()[secondToLastIndex];
       ctrl.biasArray_.back() = ctrl.biasArray_[secondToLastIndex];
       ctrl.deltaBiasArray_.back() = ctrl.deltaBiasArray_[secondToLastIndex];
     } else if (finalActivePartition_ > initActivePartition_) {
       const auto secondToLastCtrl = nominalControllersStock_[finalActivePartition_ - 1];
-      ctrl.gainArray_.back() = secondToLastCtrl.gainArray_.back();
+      ctrl.gainArray().back() = secondToLastCtrl.gainArray().back();
       ctrl.biasArray_.back() = secondToLastCtrl.biasArray_.back();
       ctrl.deltaBiasArray_.back() = secondToLastCtrl.deltaBiasArray_.back();
     }
@@ -907,7 +995,7 @@ void GaussNewtonDDP::calculateControllerUpdateMaxNorm(scalar_t& maxDeltaUffNorm,
       const vector_t nominalState = LinearInterpolation::interpolate(indexAlpha, nominalStateTrajectoriesStock_[i]);
       const vector_t nominalInput = LinearInterpolation::interpolate(indexAlpha, nominalInputTrajectoriesStock_[i]);
       const vector_t deltaUee =
-          nominalInput - nominalControllersStock_[i].gainArray_[k] * nominalState - nominalControllersStock_[i].biasArray_[k];
+          nominalInput - nominalControllersStock_[i].gainArray()[k] * nominalState - nominalControllersStock_[i].biasArray_[k];
       maxDeltaUeeNorm = std::max(maxDeltaUeeNorm, deltaUee.norm());
 
     }  // end of k loop
@@ -918,6 +1006,8 @@ void GaussNewtonDDP::calculateControllerUpdateMaxNorm(scalar_t& maxDeltaUffNorm,
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  // the nodes of all the partitions are indexed consecutively, such that the nodes at the partition and the event times are distinct
+  size_t firstNodeIndex = 0;
   for (size_t i = 0; i < numPartitions_; i++) {
     /*
      * compute and augment the LQ approximation of intermediate times for the partition i
@@ -925,23 +1015,26 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
     if (!nominalTimeTrajectoriesStock_[i].empty()) {
       // perform the LQ approximation for intermediate times at partition i
       approximateIntermediateLQ(nominalTimeTrajectoriesStock_[i], nominalPostEventIndicesStock_[i], nominalStateTrajectoriesStock_[i],
-                                nominalInputTrajectoriesStock_[i], modelDataTrajectoriesStock_[i]);
-
-      // augment the intermediate cost by performing augmentCostWorker for the partition i
-      nextTimeIndex_ = 0;
-      nextTaskId_ = 0;
-      std::function<void(void)> task = [this, i] {
-        size_t timeIndex;
-        size_t taskId = nextTaskId_++;  // assign task ID (atomic)
-
-        // get next time index is atomic
-        while ((timeIndex = nextTimeIndex_++) < nominalTimeTrajectoriesStock_[i].size()) {
-          // augment cost
-          augmentCostWorker(taskId, constraintPenaltyCoefficients_.stateEqConstrPenaltyCoeff, 0.0,
-                            modelDataTrajectoriesStock_[i][timeIndex]);
-        }
-      };
-      runParallel(task, ddpSettings_.nThreads_);
+                                nominalInputTrajectoriesStock_[i], firstNodeIndex, modelDataTrajectoriesStock_[i]);
+
+      // augment the intermediate cost by performing augmentCostWorker for the partition i. The augmented Lagrangian is already
+      // added to the continuous-time approximation in approximateIntermediateLQ().
+      if (augmentedLagrangianPtr_ == nullptr) {
+        nextTimeIndex_ = 0;
+        nextTaskId_ = 0;
+        std::function<void(void)> task = [this, i] {
+          size_t timeIndex;
+          size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+
+          // get next time index is atomic
+          while ((timeIndex = nextTimeIndex_++) < nominalTimeTrajectoriesStock_[i].size()) {
+            // augment cost
+            augmentCostWorker(taskId, constraintPenaltyCoefficients_.stateEqConstrPenaltyCoeff, 0.0,
+                              modelDataTrajectoriesStock_[i][timeIndex]);
+          }
+        };
+        runParallel(task, ddpSettings_.nThreads_);
+      }
     }
 
     /*
@@ -953,7 +1046,7 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
       // perform the approximateEventsLQWorker for partition i
       nextTimeIndex_ = 0;
       nextTaskId_ = 0;
-      std::function<void(void)> task = [this, i] {
+      std::function<void(void)> task = [this, i, firstNodeIndex] {
         int timeIndex;
         const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
 
@@ -965,19 +1058,26 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
 
           // execute approximateLQ for the given partition and event time index
           const size_t k = nominalPostEventIndicesStock_[i][timeIndex] - 1;
+          optimalControlProblemStock_[taskId].preComputationPtr->setNodeIndex(firstNodeIndex + k);
+          optimalControlProblemStock_[taskId].preComputationPtr->setModeIndex(modelData.eventIndex_);
           lqapprox.approximateLQProblemAtEventTime(nominalTimeTrajectoriesStock_[i][k], nominalStateTrajectoriesStock_[i][k], modelData);
           // augment cost
-          augmentCostWorker(taskId, constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyCoeff, 0.0, modelData);
+          if (augmentedLagrangianPtr_ != nullptr) {
+            augmentedLagrangianPtr_->augmentEventCost(modelData);
+          } else {
+            augmentCostWorker(taskId, constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyCoeff, 0.0, modelData);
+          }
           // shift Hessian for event times
           if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
-            hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy_, modelData.cost_.dfdxx,
-                                             ddpSettings_.lineSearch_.hessianCorrectionMultiple_);
+            hessian_correction::correctHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy_, modelData.cost_.dfdxx,
+                                               ddpSettings_.lineSearch_.hessianCorrectionMultiple_);
           }
         }
       };
       runParallel(task, ddpSettings_.nThreads_);
     }
 
+    firstNodeIndex += nominalTimeTrajectoriesStock_[i].size();
   }  // end of i loop
 
   /*
@@ -985,14 +1085,16 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
    */
   ModelData heuristicsModelData;
   LinearQuadraticApproximator lqapprox(optimalControlProblemStock_[0], ddpSettings_.checkNumericalStability_);
+  optimalControlProblemStock_[0].preComputationPtr->setNodeIndex(firstNodeIndex - 1);
+  optimalControlProblemStock_[0].preComputationPtr->setModeIndex(modelDataTrajectoriesStock_[finalActivePartition_].back().eventIndex_);
   lqapprox.approximateLQProblemAtFinalTime(nominalTimeTrajectoriesStock_[finalActivePartition_].back(),
                                            nominalStateTrajectoriesStock_[finalActivePartition_].back(), heuristicsModelData);
   heuristics_ = std::move(heuristicsModelData.cost_);
 
   // shift Hessian for final time
   if (ddpSettings_.strategy_ == search_strategy::Type::LINE_SEARCH) {
-    hessian_correction::shiftHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy_, heuristics_.dfdxx,
-                                     ddpSettings_.lineSearch_.hessianCorrectionMultiple_);
+    hessian_correction::correctHessian(ddpSettings_.lineSearch_.hessianCorrectionStrategy_, heuristics_.dfdxx,
+                                       ddpSettings_.lineSearch_.hessianCorrectionMultiple_);
   }
 }
 
@@ -1000,7 +1102,8 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& modelData, const matrix_t& Sm, ModelData& projectedModelData,
-                                                             riccati_modification::Data& riccatiModification) const {
+                                                             riccati_modification::Data& riccatiModification,
+                                                             scalar_t& hessianCorrectionShift) const {
   // compute the Hamiltonian's Hessian
   riccatiModification.time_ = modelData.time_;
   riccatiModification.hamiltonianHessian_ = computeHamiltonianHessian(modelData, Sm);
@@ -1014,7 +1117,7 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
 
   // compute deltaQm, deltaGv, deltaGm
   searchStrategyPtr_->computeRiccatiModification(projectedModelData, riccatiModification.deltaQm_, riccatiModification.deltaGv_,
-                                                 riccatiModification.deltaGm_);
+                                                 riccatiModification.deltaGm_, hessianCorrectionShift);
 }
 
 /******************************************************************************************************/
@@ -1063,6 +1166,7 @@ void GaussNewtonDDP::projectLQ(const ModelData& modelData, const matrix_t& const
                                const matrix_t& constraintNullProjector, ModelData& projectedModelData) const {
   // dimensions and time
   projectedModelData.time_ = modelData.time_;
+  projectedModelData.eventIndex_ = modelData.eventIndex_;
   projectedModelData.stateDim_ = modelData.stateDim_;
   projectedModelData.inputDim_ = modelData.inputDim_ - modelData.stateInputEqConstr_.f.rows();
 
@@ -1179,6 +1283,22 @@ void GaussNewtonDDP::initializeConstraintPenalties() {
   constraintPenaltyCoefficients_.stateInputEqConstrPenaltyCoeff = ddpSettings_.constraintPenaltyInitialValue_;
   constraintPenaltyCoefficients_.stateInputEqConstrPenaltyTol =
       1.0 / std::pow(constraintPenaltyCoefficients_.stateInputEqConstrPenaltyCoeff, 0.1);
+
+  // inequality
+  constraintPenaltyCoefficients_.inequalityConstrPenaltyCoeff = ddpSettings_.constraintPenaltyInitialValue_;
+  constraintPenaltyCoefficients_.inequalityConstrPenaltyTol = 1.0 / std::pow(ddpSettings_.constraintPenaltyInitialValue_, 0.1);
+
+  if (augmentedLagrangianPtr_ != nullptr) {
+    constraintPenaltyCoefficients_.stateEqConstrPreviousViolation = std::numeric_limits<scalar_t>::max();
+    constraintPenaltyCoefficients_.stateFinalEqConstrPreviousViolation = std::numeric_limits<scalar_t>::max();
+
+    // the state-only constraints use the tolerance schedule of the state-input equality penalty
+    constraintPenaltyCoefficients_.stateEqConstrPenaltyTol = constraintPenaltyCoefficients_.inequalityConstrPenaltyTol;
+    constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyTol = constraintPenaltyCoefficients_.inequalityConstrPenaltyTol;
+    augmentedLagrangianPtr_->setPenalties({constraintPenaltyCoefficients_.stateEqConstrPenaltyCoeff,
+                                           constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyCoeff,
+                                           constraintPenaltyCoefficients_.inequalityConstrPenaltyCoeff});
+  }
 }
 
 /******************************************************************************************************/
@@ -1226,16 +1346,19 @@ void GaussNewtonDDP::runSearchStrategy(scalar_t expectedCost) {
 /******************************************************************************************************/
 void GaussNewtonDDP::updateConstraintPenalties(scalar_t stateEqConstraintISE, scalar_t stateEqFinalConstraintSSE,
                                                scalar_t stateInputEqConstraintISE) {
-  // state-only equality penalty
-  if (stateEqConstraintISE > ddpSettings_.constraintTolerance_) {
-    constraintPenaltyCoefficients_.stateEqConstrPenaltyCoeff *= ddpSettings_.constraintPenaltyIncreaseRate_;
-    constraintPenaltyCoefficients_.stateEqConstrPenaltyTol = ddpSettings_.constraintTolerance_;
-  }
+  // the state-only equality penalties of the augmented Lagrangian are updated in updateAugmentedLagrangian()
+  if (augmentedLagrangianPtr_ == nullptr) {
+    // state-only equality penalty
+    if (stateEqConstraintISE > ddpSettings_.constraintTolerance_) {
+      constraintPenaltyCoefficients_.stateEqConstrPenaltyCoeff *= ddpSettings_.constraintPenaltyIncreaseRate_;
+      constraintPenaltyCoefficients_.stateEqConstrPenaltyTol = ddpSettings_.constraintTolerance_;
+    }
 
-  // final state-only equality
-  if (stateEqFinalConstraintSSE > ddpSettings_.constraintTolerance_) {
-    constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyCoeff *= ddpSettings_.constraintPenaltyIncreaseRate_;
-    constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyTol = ddpSettings_.constraintTolerance_;
+    // final state-only equality
+    if (stateEqFinalConstraintSSE > ddpSettings_.constraintTolerance_) {
+      constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyCoeff *= ddpSettings_.constraintPenaltyIncreaseRate_;
+      constraintPenaltyCoefficients_.stateFinalEqConstrPenaltyTol = ddpSettings_.constraintTolerance_;
+    }
   }
 
   // state-input equality penalty
@@ -1267,10 +1390,83 @@ void GaussNewtonDDP::updateConstraintPenalties(scalar_t stateEqConstraintISE, sc
     displayText += "    State-Input Equality:";
     displayText += "    Penalty Tolerance: " + std::to_string(constraintPenaltyCoefficients_.stateInputEqConstrPenaltyTol);
     displayText += "    Penalty Coefficient: " + std::to_string(constraintPenaltyCoefficients_.stateInputEqConstrPenaltyCoeff) + ".\n";
+
+    if (augmentedLagrangianPtr_ != nullptr) {
+      displayText += "    Inequality:          ";
+      displayText += "    Penalty Tolerance: " + std::to_string(constraintPenaltyCoefficients_.inequalityConstrPenaltyTol);
+      displayText += "    Penalty Coefficient: " + std::to_string(constraintPenaltyCoefficients_.inequalityConstrPenaltyCoeff) + ".\n";
+    }
     this->printString(displayText);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateAugmentedLagrangian(bool isInitialization) {
+  auto& coefficients = constraintPenaltyCoefficients_;
+
+  // once the constraints are satisfied, the multipliers are final and the solver converges on a fixed merit
+  const bool isFeasible = performanceIndex_.stateEqConstraintISE <= ddpSettings_.constraintTolerance_ &&
+                          performanceIndex_.stateEqFinalConstraintSSE <= ddpSettings_.constraintTolerance_ &&
+                          performanceIndex_.inequalityConstraintISE <= ddpSettings_.constraintTolerance_;
+
+  if (!isInitialization && !isFeasible) {
+    // the multipliers are updated once the violation is below the tolerance, otherwise the penalty grows
+    AugmentedLagrangian::MultiplierUpdates multiplierUpdates;
+    multiplierUpdates.stateEq = performanceIndex_.stateEqConstraintISE < coefficients.stateEqConstrPenaltyTol;
+    multiplierUpdates.finalStateEq = performanceIndex_.stateEqFinalConstraintSSE < coefficients.stateFinalEqConstrPenaltyTol;
+    multiplierUpdates.inequality = performanceIndex_.inequalityConstraintISE < coefficients.inequalityConstrPenaltyTol;
+
+    // multipliers, with the penalties of the last LQ approximation
+    augmentedLagrangianPtr_->updateMultipliers(modelDataTrajectoriesStock_, modelDataEventTimesStock_, initActivePartition_,
+                                               finalActivePartition_, multiplierUpdates);
+
+    // penalties and tolerances, similar to the state-input equality penalty. The violations are squared, hence the squared rate.
+    const scalar_t violationDecreaseRate = std::pow(ddpSettings_.augmentedLagrangianViolationDecreaseRate_, 2);
+    auto updatePenalty = [&](bool multiplierUpdated, bool isSlowDecrease, scalar_t& penaltyCoeff, scalar_t& penaltyTol) {
+      if (!multiplierUpdated || isSlowDecrease) {
+        penaltyCoeff = std::min(penaltyCoeff * ddpSettings_.constraintPenaltyIncreaseRate_, ddpSettings_.augmentedLagrangianMaxPenalty_);
+      }
+      if (multiplierUpdated) {
+        // tighten tolerance
+        penaltyTol /= std::pow(penaltyCoeff, 0.9);
+      } else {
+        // reset tolerance
+        penaltyTol = 1.0 / std::pow(penaltyCoeff, 0.1);
+      }
+      penaltyTol = std::max(penaltyTol, ddpSettings_.constraintTolerance_);
+    };
+    // The multipliers of the equalities converge slowly, e.g. toward an impulse at a junction with the final cost, unless the penalty
+    // grows. The penalty of the inequalities only grows on a violation, since a stiff PHR term oscillates at the switches of the active
+    // set.
+    auto isSlowDecrease = [&](scalar_t violation, scalar_t& previousViolation) {
+      const bool slowDecrease = violation > violationDecreaseRate * previousViolation;
+      previousViolation = violation;
+      return slowDecrease;
+    };
+    updatePenalty(multiplierUpdates.stateEq,
+                  isSlowDecrease(performanceIndex_.stateEqConstraintISE, coefficients.stateEqConstrPreviousViolation),
+                  coefficients.stateEqConstrPenaltyCoeff, coefficients.stateEqConstrPenaltyTol);
+    updatePenalty(multiplierUpdates.finalStateEq,
+                  isSlowDecrease(performanceIndex_.stateEqFinalConstraintSSE, coefficients.stateFinalEqConstrPreviousViolation),
+                  coefficients.stateFinalEqConstrPenaltyCoeff, coefficients.stateFinalEqConstrPenaltyTol);
+    updatePenalty(multiplierUpdates.inequality, false, coefficients.inequalityConstrPenaltyCoeff, coefficients.inequalityConstrPenaltyTol);
+  }
+
+  augmentedLagrangianPtr_->setPenalties(
+      {coefficients.stateEqConstrPenaltyCoeff, coefficients.stateFinalEqConstrPenaltyCoeff, coefficients.inequalityConstrPenaltyCoeff});
+
+  // the merit of the nominal trajectories with the updated terms. The cost is unchanged.
+  if (!isInitialization) {
+    const auto performanceIndex = searchStrategyPtr_->calculateRolloutPerformanceIndex(
+        *penaltyPtr_, nominalTimeTrajectoriesStock_, modelDataTrajectoriesStock_, modelDataEventTimesStock_, 0.0);
+    performanceIndex_.equalityLagrangian = performanceIndex.equalityLagrangian;
+    performanceIndex_.inequalityConstraintPenalty = performanceIndex.inequalityConstraintPenalty;
+    performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -1402,6 +1598,9 @@ void GaussNewtonDDP::runInit() {
 
   // update the constraint penalty coefficients
   updateConstraintPenalties(0.0, 0.0, 0.0);
+  if (augmentedLagrangianPtr_ != nullptr) {
+    updateAugmentedLagrangian(true);
+  }
 
   // linearizing the dynamics and quadratizing the cost function along nominal trajectories
   linearQuadraticApproximationTimer_.startTimer();
@@ -1449,6 +1648,9 @@ void GaussNewtonDDP::runIteration(bool unreliableControllerIncrement) {
   // update the constraint penalty coefficients
   updateConstraintPenalties(performanceIndex_.stateEqConstraintISE, performanceIndex_.stateEqFinalConstraintSSE,
                             performanceIndex_.stateInputEqConstraintISE);
+  if (augmentedLagrangianPtr_ != nullptr) {
+    updateAugmentedLagrangian(false);
+  }
 
   // linearizing the dynamics and quadratizing the cost function along nominal trajectories
   linearQuadraticApproximationTimer_.startTimer();
@@ -1478,6 +1680,120 @@ void GaussNewtonDDP::runIteration(bool unreliableControllerIncrement) {
   Eigen::setNbThreads(0);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::saveWarmStartImpl(std::ostream& stream) const {
+  warm_start::write(stream, std::string("GaussNewtonDDP"));
+  warm_start::write(stream, initTime_);
+  warm_start::write(stream, finalTime_);
+  warm_start::write(stream, initState_);
+  warm_start::write(stream, partitioningTimes_);
+  warm_start::write(stream, nominalControllersStock_);
+  warm_start::write(stream, nominalTimeTrajectoriesStock_);
+  warm_start::write(stream, nominalPostEventIndicesStock_);
+  warm_start::write(stream, nominalStateTrajectoriesStock_);
+  warm_start::write(stream, nominalInputTrajectoriesStock_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::loadWarmStartImpl(std::istream& stream) {
+  std::string solverName;
+  warm_start::read(stream, solverName);
+  if (solverName != "GaussNewtonDDP") {
+    throw std::runtime_error("[GaussNewtonDDP::loadWarmStart] The snapshot is saved by " + solverName + ".");
+  }
+
+  // read everything before modifying the solver such that a corrupted snapshot leaves it untouched
+  scalar_t initTime, finalTime;
+  vector_t initState;
+  scalar_array_t partitioningTimes;
+  std::vector<LinearController> controllersStock;
+  scalar_array2_t timeTrajectoriesStock;
+  size_array2_t postEventIndicesStock;
+  vector_array2_t stateTrajectoriesStock;
+  vector_array2_t inputTrajectoriesStock;
+  warm_start::read(stream, initTime);
+  warm_start::read(stream, finalTime);
+  warm_start::read(stream, initState);
+  warm_start::read(stream, partitioningTimes);
+  warm_start::read(stream, controllersStock);
+  warm_start::read(stream, timeTrajectoriesStock);
+  warm_start::read(stream, postEventIndicesStock);
+  warm_start::read(stream, stateTrajectoriesStock);
+  warm_start::read(stream, inputTrajectoriesStock);
+
+  const size_t numPartitions = partitioningTimes.size() - 1;
+  if (partitioningTimes.size() < 2 || controllersStock.size() != numPartitions || timeTrajectoriesStock.size() != numPartitions ||
+      postEventIndicesStock.size() != numPartitions || stateTrajectoriesStock.size() != numPartitions ||
+      inputTrajectoriesStock.size() != numPartitions) {
+    throw std::runtime_error("[GaussNewtonDDP::loadWarmStart] The snapshot is not consistent with its partitioning times.");
+  }
+  for (size_t i = 0; i < numPartitions; i++) {
+    const auto N = timeTrajectoriesStock[i].size();
+    const bool consistentStates = std::all_of(stateTrajectoriesStock[i].cbegin(), stateTrajectoriesStock[i].cend(),
+                                              [&](const vector_t& x) { return x.size() == initState.size(); });
+    if (stateTrajectoriesStock[i].size() != N || inputTrajectoriesStock[i].size() != N || !consistentStates ||
+        std::any_of(postEventIndicesStock[i].cbegin(), postEventIndicesStock[i].cend(), [N](size_t index) { return index > N; })) {
+      throw std::runtime_error("[GaussNewtonDDP::loadWarmStart] The trajectories of partition " + std::to_string(i) +
+                               " in the snapshot are not consistent.");
+    }
+  }
+
+  reset();
+  if (numPartitions_ != numPartitions) {
+    numPartitions_ = numPartitions;
+    setupOptimizer(numPartitions_);
+  }
+
+  initTime_ = initTime;
+  finalTime_ = finalTime;
+  initState_ = std::move(initState);
+  partitioningTimes_ = std::move(partitioningTimes);
+  initActivePartition_ = lookup::findBoundedActiveIntervalInTimeArray(partitioningTimes_, initTime_);
+  finalActivePartition_ = lookup::findBoundedActiveIntervalInTimeArray(partitioningTimes_, finalTime_);
+
+  nominalControllersStock_ = std::move(controllersStock);
+  nominalTimeTrajectoriesStock_ = std::move(timeTrajectoriesStock);
+  nominalPostEventIndicesStock_ = std::move(postEventIndicesStock);
+  nominalStateTrajectoriesStock_ = std::move(stateTrajectoriesStock);
+  nominalInputTrajectoriesStock_ = std::move(inputTrajectoriesStock);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::copyWarmStartImpl(const SolverBase& other) {
+  const auto* otherPtr = dynamic_cast<const GaussNewtonDDP*>(&other);
+  if (otherPtr == nullptr) {
+    throw std::runtime_error("[GaussNewtonDDP::copyWarmStart] The warm start can only be copied from another GaussNewtonDDP solver.");
+  }
+  if (otherPtr->partitioningTimes_.size() < 2) {
+    throw std::runtime_error("[GaussNewtonDDP::copyWarmStart] The other solver has not been run yet.");
+  }
+
+  reset();
+  if (numPartitions_ != otherPtr->numPartitions_) {
+    numPartitions_ = otherPtr->numPartitions_;
+    setupOptimizer(numPartitions_);
+  }
+
+  initTime_ = otherPtr->initTime_;
+  finalTime_ = otherPtr->finalTime_;
+  initState_ = otherPtr->initState_;
+  partitioningTimes_ = otherPtr->partitioningTimes_;
+  initActivePartition_ = otherPtr->initActivePartition_;
+  finalActivePartition_ = otherPtr->finalActivePartition_;
+
+  nominalControllersStock_ = otherPtr->nominalControllersStock_;
+  nominalTimeTrajectoriesStock_ = otherPtr->nominalTimeTrajectoriesStock_;
+  nominalPostEventIndicesStock_ = otherPtr->nominalPostEventIndicesStock_;
+  nominalStateTrajectoriesStock_ = otherPtr->nominalStateTrajectoriesStock_;
+  nominalInputTrajectoriesStock_ = otherPtr->nominalInputTrajectoriesStock_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -1631,6 +1947,12 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     // check convergence
     std::tie(isConverged, convergenceInfo) =
         searchStrategyPtr_->checkConvergence(unreliableControllerIncrement, performanceIndexHistory_.back(), performanceIndex_);
+    // the augmented Lagrangian iterates until the state-only equality and the inequality constraints are satisfied
+    if (isConverged && augmentedLagrangianPtr_ != nullptr) {
+      isConverged = performanceIndex_.stateEqConstraintISE <= ddpSettings_.constraintTolerance_ &&
+                    performanceIndex_.stateEqFinalConstraintSSE <= ddpSettings_.constraintTolerance_ &&
+                    performanceIndex_.inequalityConstraintISE <= ddpSettings_.constraintTolerance_;
+    }
     unreliableControllerIncrement = false;
   }  // end of while loop
 
@@ -61,7 +61,7 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
 /******************************************************************************************************/
 /******************************************************************************************************/
 void ILQR::approximateIntermediateLQ(const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
-                                     const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+                                     const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory, size_t firstNodeIndex,
                                      std::vector<ModelData>& modelDataTrajectory) {
   BASE::nextTimeIndex_ = 0;
   BASE::nextTaskId_ = 0;
@@ -76,11 +76,18 @@ void ILQR::approximateIntermediateLQ(const scalar_array_t& timeTrajectory, const
       // execute continuous time LQ approximation for the given partition and time index
       continuousTimeModelData = modelDataTrajectory[timeIndex];
 
+      BASE::optimalControlProblemStock_[taskId].preComputationPtr->setNodeIndex(firstNodeIndex + timeIndex);
+      BASE::optimalControlProblemStock_[taskId].preComputationPtr->setModeIndex(modelDataTrajectory[timeIndex].eventIndex_);
       LinearQuadraticApproximator lqapprox(BASE::optimalControlProblemStock_[taskId], BASE::settings().checkNumericalStability_);
       lqapprox.approximateLQProblem(timeTrajectory[timeIndex], stateTrajectory[timeIndex], inputTrajectory[timeIndex],
                                     continuousTimeModelData);
       continuousTimeModelData.checkSizes(stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
 
+      // the augmented Lagrangian is a continuous-time cost, hence it is discretized with the cost
+      if (BASE::augmentedLagrangianPtr_ != nullptr) {
+        BASE::augmentedLagrangianPtr_->augmentIntermediateCost(continuousTimeModelData);
+      }
+
       // discretize LQ problem
       scalar_t timeStep = 0.0;
       if (timeIndex + 1 < timeTrajectory.size()) {
@@ -141,7 +148,7 @@ void ILQR::calculateController() {
 
   // correcting for the last controller element of partitions
   for (size_t i = BASE::initActivePartition_; i < BASE::finalActivePartition_; i++) {
-    BASE::nominalControllersStock_[i].gainArray_.back() = BASE::nominalControllersStock_[i + 1].gainArray_.front();
+    BASE::nominalControllersStock_[i].gainArray().back() = BASE::nominalControllersStock_[i + 1].gainArray().front();
     BASE::nominalControllersStock_[i].biasArray_.back() = BASE::nominalControllersStock_[i + 1].biasArray_.front();
     BASE::nominalControllersStock_[i].deltaBiasArray_.back() = BASE::nominalControllersStock_[i + 1].deltaBiasArray_.front();
   }
@@ -163,19 +170,19 @@ void ILQR::calculateControllerWorker(size_t workerIndex, size_t partitionIndex,
   const auto& Qu = BASE::riccatiModificationTrajectoriesStock_[i][k].constraintNullProjector_;
 
   // feedback gains
-  BASE::nominalControllersStock_[i].gainArray_[k] = -CmProjected;
-  BASE::nominalControllersStock_[i].gainArray_[k].noalias() += Qu * projectedKmTrajectoryStock_[i][k];
+  BASE::nominalControllersStock_[i].gainArray()[k] = -CmProjected;
+  BASE::nominalControllersStock_[i].gainArray()[k].noalias() += Qu * projectedKmTrajectoryStock_[i][k];
 
   // bias input
   BASE::nominalControllersStock_[i].biasArray_[k] = nominalInput;
-  BASE::nominalControllersStock_[i].biasArray_[k].noalias() -= BASE::nominalControllersStock_[i].gainArray_[k] * nominalState;
+  BASE::nominalControllersStock_[i].biasArray_[k].noalias() -= BASE::nominalControllersStock_[i].gainArray()[k] * nominalState;
   BASE::nominalControllersStock_[i].deltaBiasArray_[k] = -EvProjected;
   BASE::nominalControllersStock_[i].deltaBiasArray_[k].noalias() += Qu * projectedLvTrajectoryStock_[i][k];
 
   // checking the numerical stability of the controller parameters
   if (settings().checkNumericalStability_) {
     try {
-      if (!BASE::nominalControllersStock_[i].gainArray_[k].allFinite()) {
+      if (!BASE::nominalControllersStock_[i].gainArray()[k].allFinite()) {
         throw std::runtime_error("Feedback gains are unstable.");
       }
       if (!BASE::nominalControllersStock_[i].deltaBiasArray_[k].allFinite()) {
@@ -228,6 +235,7 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, size_t partitionIndex, con
 
   BASE::riccatiModificationTrajectoriesStock_[partitionIndex].resize(N);
   BASE::projectedModelDataTrajectoriesStock_[partitionIndex].resize(N);
+  BASE::hessianCorrectionShiftTrajectoriesStock_[partitionIndex].resize(N, 0.0);
 
   // terminate if the partition is not active
   if (N == 0) {
@@ -270,7 +278,8 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, size_t partitionIndex, con
     auto& projectedKmFinal = projectedKmTrajectoryStock_[partitionIndex][endTimeItr - 1];
 
     const auto SmDummy = matrix_t::Zero(modelDataFinal.stateDim_, modelDataFinal.stateDim_);
-    BASE::computeProjectionAndRiccatiModification(modelDataFinal, SmDummy, projectedModelDataFinal, riccatiModificationFinal);
+    BASE::computeProjectionAndRiccatiModification(modelDataFinal, SmDummy, projectedModelDataFinal, riccatiModificationFinal,
+                                                  BASE::hessianCorrectionShiftTrajectoriesStock_[partitionIndex][endTimeItr - 1]);
 
     // projected feedforward
     projectedLvFinal = -projectedModelDataFinal.cost_.dfdu - riccatiModificationFinal.deltaGv_;
@@ -289,7 +298,8 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, size_t partitionIndex, con
       // project
       BASE::computeProjectionAndRiccatiModification(
           BASE::modelDataTrajectoriesStock_[partitionIndex][k], BASE::SmTrajectoryStock_[partitionIndex][k + 1],
-          BASE::projectedModelDataTrajectoriesStock_[partitionIndex][k], BASE::riccatiModificationTrajectoriesStock_[partitionIndex][k]);
+          BASE::projectedModelDataTrajectoriesStock_[partitionIndex][k], BASE::riccatiModificationTrajectoriesStock_[partitionIndex][k],
+          BASE::hessianCorrectionShiftTrajectoriesStock_[partitionIndex][k]);
 
       // compute one step of Riccati difference equations
       riccatiEquationsPtrStock_[workerIndex]->computeMap(
@@ -71,7 +71,7 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SLQ::approximateIntermediateLQ(const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
-                                    const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory,
+                                    const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory, size_t firstNodeIndex,
                                     std::vector<ModelData>& modelDataTrajectory) {
   BASE::nextTimeIndex_ = 0;
   BASE::nextTaskId_ = 0;
@@ -83,11 +83,18 @@ void SLQ::approximateIntermediateLQ(const scalar_array_t& timeTrajectory, const
     while ((timeIndex = BASE::nextTimeIndex_++) < timeTrajectory.size()) {
       // execute approximateLQ for the given partition and time index
 
+      BASE::optimalControlProblemStock_[taskId].preComputationPtr->setNodeIndex(firstNodeIndex + timeIndex);
+      BASE::optimalControlProblemStock_[taskId].preComputationPtr->setModeIndex(modelDataTrajectory[timeIndex].eventIndex_);
       LinearQuadraticApproximator lqapprox(BASE::optimalControlProblemStock_[taskId], BASE::settings().checkNumericalStability_);
 
       lqapprox.approximateLQProblem(timeTrajectory[timeIndex], stateTrajectory[timeIndex], inputTrajectory[timeIndex],
                                     modelDataTrajectory[timeIndex]);
       modelDataTrajectory[timeIndex].checkSizes(stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+
+      // augmented Lagrangian of the state-only equality and the inequality constraints
+      if (BASE::augmentedLagrangianPtr_ != nullptr) {
+        BASE::augmentedLagrangianPtr_->augmentIntermediateCost(modelDataTrajectory[timeIndex]);
+      }
     }
   };
 
@@ -142,19 +149,19 @@ void SLQ::calculateControllerWorker(size_t workerIndex, size_t partitionIndex, s
   projectedLv.noalias() -= projectedBm.transpose() * BASE::SvTrajectoryStock_[i][k];
 
   // feedback gains
-  BASE::nominalControllersStock_[i].gainArray_[k] = -CmProjected;
-  BASE::nominalControllersStock_[i].gainArray_[k].noalias() += Qu * projectedKm;
+  BASE::nominalControllersStock_[i].gainArray()[k] = -CmProjected;
+  BASE::nominalControllersStock_[i].gainArray()[k].noalias() += Qu * projectedKm;
 
   // bias input
   BASE::nominalControllersStock_[i].biasArray_[k] = nominalInput;
-  BASE::nominalControllersStock_[i].biasArray_[k].noalias() -= BASE::nominalControllersStock_[i].gainArray_[k] * nominalState;
+  BASE::nominalControllersStock_[i].biasArray_[k].noalias() -= BASE::nominalControllersStock_[i].gainArray()[k] * nominalState;
   BASE::nominalControllersStock_[i].deltaBiasArray_[k] = -EvProjected;
   BASE::nominalControllersStock_[i].deltaBiasArray_[k].noalias() += Qu * projectedLv;
 
   // checking the numerical stability of the controller parameters
   if (settings().checkNumericalStability_) {
     try {
-      if (!BASE::nominalControllersStock_[i].gainArray_[k].allFinite()) {
+      if (!BASE::nominalControllersStock_[i].gainArray()[k].allFinite()) {
         throw std::runtime_error("Feedback gains are unstable.");
       }
       if (!BASE::nominalControllersStock_[i].deltaBiasArray_[k].allFinite()) {
@@ -177,6 +184,7 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const matrix_t& SmFinal, const vec
 
     BASE::riccatiModificationTrajectoriesStock_[i].resize(N);
     BASE::projectedModelDataTrajectoriesStock_[i].resize(N);
+    BASE::hessianCorrectionShiftTrajectoriesStock_[i].resize(N, 0.0);
 
     if (N > 0) {
       // perform the computeRiccatiModificationTerms for partition i
@@ -192,7 +200,8 @@ scalar_t SLQ::solveSequentialRiccatiEquations(const matrix_t& SmFinal, const vec
         while ((timeIndex = BASE::nextTimeIndex_++) < N) {
           BASE::computeProjectionAndRiccatiModification(BASE::modelDataTrajectoriesStock_[i][timeIndex], SmDummy,
                                                         BASE::projectedModelDataTrajectoriesStock_[i][timeIndex],
-                                                        BASE::riccatiModificationTrajectoriesStock_[i][timeIndex]);
+                                                        BASE::riccatiModificationTrajectoriesStock_[i][timeIndex],
+                                                        BASE::hessianCorrectionShiftTrajectoriesStock_[i][timeIndex]);
         }
       };
       BASE::runParallel(task, settings().nThreads_);
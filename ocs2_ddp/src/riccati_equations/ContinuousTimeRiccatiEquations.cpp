@@ -217,8 +217,8 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   // precomputation
   // [COMPLEXITY: nx^3 + nx^2 * np]
   creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * creCache.projectedAm_;
-  creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
   if (!reducedFormRiccati_) {
+    creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
     // Rm
     creCache.projectedRm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu);
     // [COMPLEXITY: nx * np^2]
@@ -230,21 +230,23 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   /*
    * Sm
    *
+   * Only the upper triangular part of dSm is computed, since it is the only part which is transcribed by convert2Vector.
+   *
    * reducedFormRiccati:
-   *   [TOTAL COMPLEXITY: (nx^3) + 2(nx^2 * np)]
+   *   [TOTAL COMPLEXITY: (nx^3) + 0.5(nx^2 * np)]
    * other
-   *   [TOTAL COMPLEXITY: (nx^3) + 3(nx^2 * np) + (nx * np^2)]
+   *   [TOTAL COMPLEXITY: (nx^3) + 1.5(nx^2 * np) + (nx * np^2)]
    */
   // += deltaQm + Sm^T * Am + Am^T * Sm
-  dSm += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
+  dSm.triangularView<Eigen::Upper>() += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
   if (reducedFormRiccati_) {
-    // += Km^T * Gm-
-    dSm += creCache.projectedKm_T_projectedGm_;
+    // += Km^T * Gm
+    dSm.triangularView<Eigen::Upper>() += creCache.projectedKm_.transpose() * creCache.projectedGm_;
   } else {
     // += Km^T * Gm + Gm^T * Km
-    dSm += creCache.projectedKm_T_projectedGm_ + creCache.projectedKm_T_projectedGm_.transpose();
+    dSm.triangularView<Eigen::Upper>() += creCache.projectedKm_T_projectedGm_ + creCache.projectedKm_T_projectedGm_.transpose();
     // += Km^T * Hm * Km
-    dSm.noalias() += creCache.projectedKm_.transpose() * creCache.projectedRm_projectedKm_;
+    dSm.triangularView<Eigen::Upper>() += creCache.projectedKm_.transpose() * creCache.projectedRm_projectedKm_;
   }
 
   /*
@@ -305,7 +307,7 @@ void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t>
   creCache.Sigma_Sv_.noalias() = creCache.dynamicsCovariance_ * Sv;
   creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * Sm;
 
-  dSm.noalias() += riskSensitiveCoeff_ * Sm.transpose() * creCache.Sigma_Sm_;
+  dSm.triangularView<Eigen::Upper>() += riskSensitiveCoeff_ * Sm.transpose() * creCache.Sigma_Sm_;
   dSv.noalias() += riskSensitiveCoeff_ * creCache.Sigma_Sm_.transpose() * Sv;
   ds += 0.5 * creCache.Sigma_Sm_.trace() + 0.5 * riskSensitiveCoeff_ * Sv.dot(creCache.Sigma_Sv_);
 }
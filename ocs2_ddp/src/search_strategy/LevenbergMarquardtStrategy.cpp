@@ -241,7 +241,7 @@ std::pair<bool, std::string> LevenbergMarquardtStrategy::checkConvergence(bool u
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LevenbergMarquardtStrategy::computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
-                                                            matrix_t& deltaGm) const {
+                                                            matrix_t& deltaGm, scalar_t& /*hessianCorrectionShift*/) const {
   const auto& HvProjected = projectedModelData.dynamicsBias_;
   const auto& AmProjected = projectedModelData.dynamics_.dfdx;
   const auto& BmProjected = projectedModelData.dynamics_.dfdu;
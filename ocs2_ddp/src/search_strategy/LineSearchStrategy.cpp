@@ -332,7 +332,7 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LineSearchStrategy::computeRiccatiModification(const ModelData& projectedModelData, matrix_t& deltaQm, vector_t& deltaGv,
-                                                    matrix_t& deltaGm) const {
+                                                    matrix_t& deltaGm, scalar_t& hessianCorrectionShift) const {
   const auto& QmProjected = projectedModelData.cost_.dfdxx;
   const auto& PmProjected = projectedModelData.cost_.dfdux;
 
@@ -342,7 +342,8 @@ void LineSearchStrategy::computeRiccatiModification(const ModelData& projectedMo
 
   // deltaQm
   deltaQm = Q_minus_PTRinvP;
-  hessian_correction::shiftHessian(settings_.hessianCorrectionStrategy_, deltaQm, settings_.hessianCorrectionMultiple_);
+  hessian_correction::correctHessian(settings_.hessianCorrectionStrategy_, deltaQm, settings_.hessianCorrectionMultiple_,
+                                     settings_.cacheHessianCorrectionShift_ ? &hessianCorrectionShift : nullptr);
   deltaQm -= Q_minus_PTRinvP;
 
   // deltaGv, deltaGm
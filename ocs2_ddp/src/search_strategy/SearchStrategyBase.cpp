@@ -27,7 +27,11 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <tuple>
+
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
+#include <ocs2_core/misc/Lookup.h>
 
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
@@ -79,6 +83,8 @@ scalar_t SearchStrategyBase::rolloutTrajectory(RolloutBase& rollout, const ModeS
     modelDataEventTimesStock[i].clear();
   }
 
+  const auto& eventTimes = modeSchedule.eventTimes;
+  int eventIndex = 0;  // the mode index of the last node, see ModelData::eventIndex_
   size_t numSteps = 0;
   vector_t xCurrent = initState_;
   for (size_t i = initActivePartition_; i <= finalActivePartition_; i++) {
@@ -87,13 +93,15 @@ scalar_t SearchStrategyBase::rolloutTrajectory(RolloutBase& rollout, const ModeS
     const scalar_t tf = (i == finalActivePartition_) ? finalTime_ : partitioningTimes_[i + 1];
 
     // Rollout with controller
-    xCurrent = rollout.run(t0, xCurrent, tf, &controllersStock[i], modeSchedule.eventTimes, timeTrajectoriesStock[i],
+    xCurrent = rollout.run(t0, xCurrent, tf, &controllersStock[i], eventTimes, timeTrajectoriesStock[i],
                            postEventIndicesStock[i], stateTrajectoriesStock[i], inputTrajectoriesStock[i]);
 
-    // update model data trajectory
+    // update model data trajectory, the mode index is looked up as in ModeSchedule::modeAtTime with the previous node as the hint
     modelDataTrajectoriesStock[i].resize(timeTrajectoriesStock[i].size());
     for (size_t k = 0; k < timeTrajectoriesStock[i].size(); k++) {
+      eventIndex = lookup::findIndexInTimeArray(eventTimes, timeTrajectoriesStock[i][k], eventIndex);
       modelDataTrajectoriesStock[i][k].time_ = timeTrajectoriesStock[i][k];
+      modelDataTrajectoriesStock[i][k].eventIndex_ = eventIndex;
       modelDataTrajectoriesStock[i][k].stateDim_ = stateTrajectoriesStock[i][k].size();
       modelDataTrajectoriesStock[i][k].inputDim_ = inputTrajectoriesStock[i][k].size();
       modelDataTrajectoriesStock[i][k].dynamicsBias_.setZero(stateTrajectoriesStock[i][k].size());
@@ -104,6 +112,7 @@ scalar_t SearchStrategyBase::rolloutTrajectory(RolloutBase& rollout, const ModeS
     for (size_t ke = 0; ke < postEventIndicesStock[i].size(); ke++) {
       const auto index = postEventIndicesStock[i][ke] - 1;
       modelDataEventTimesStock[i][ke].time_ = timeTrajectoriesStock[i][index];
+      modelDataEventTimesStock[i][ke].eventIndex_ = modelDataTrajectoriesStock[i][index].eventIndex_;
       modelDataEventTimesStock[i][ke].stateDim_ = stateTrajectoriesStock[i][index].size();
       modelDataEventTimesStock[i][ke].inputDim_ = inputTrajectoriesStock[i][index].size();
       modelDataEventTimesStock[i][ke].dynamicsBias_.setZero(stateTrajectoriesStock[i][index].size());
@@ -151,6 +160,7 @@ void SearchStrategyBase::rolloutCostAndConstraints(OptimalControlProblem& proble
       const auto& u = inputTrajectoriesStock[i][k];
       auto& modelData = modelDataTrajectoriesStock[i][k];
 
+      preComputation.setModeIndex(modelData.eventIndex_);
       preComputation.request(Request::Cost + Request::Constraint + Request::SoftConstraint, t, x, u);
 
       // intermediate cost
@@ -170,6 +180,7 @@ void SearchStrategyBase::rolloutCostAndConstraints(OptimalControlProblem& proble
         const auto ke = std::distance(postEventIndicesStock[i].begin(), eventsPastTheEndItr);
         auto& modelDataEvent = modelDataEventTimesStock[i][ke];
 
+        preComputation.setModeIndex(modelDataEvent.eventIndex_);
         preComputation.requestPreJump(Request::Cost + Request::Constraint + Request::SoftConstraint, t, x);
 
         // pre-jump cost
@@ -186,6 +197,7 @@ void SearchStrategyBase::rolloutCostAndConstraints(OptimalControlProblem& proble
   // calculate the Heuristics function at the final time
   const auto t = timeTrajectoriesStock[finalActivePartition_].back();
   const auto& x = stateTrajectoriesStock[finalActivePartition_].back();
+  preComputation.setModeIndex(modelDataTrajectoriesStock[finalActivePartition_].back().eventIndex_);
   preComputation.requestFinal(Request::Cost + Request::SoftConstraint, t, x);
   heuristicsValue = computeFinalCost(problem, t, x);
 }
@@ -224,17 +236,34 @@ PerformanceIndex SearchStrategyBase::calculateRolloutPerformanceIndex(const Soft
                    [this](const ModelData& m) { return m.ineqConstr_.f.cwiseMin(0.0).squaredNorm(); });
     performanceIndex.inequalityConstraintISE += trapezoidalIntegration(timeTrajectoriesStock[i], inequalityNorm2Trajectory);
 
-    // inequality constraints penalty
-    scalar_array_t inequalityPenaltyTrajectory(timeTrajectoriesStock[i].size());
-    std::transform(modelDataTrajectoriesStock[i].begin(), modelDataTrajectoriesStock[i].end(), inequalityPenaltyTrajectory.begin(),
-                   [&](const ModelData& m) { return ineqConstrPenalty.getValue(m.time_, m.ineqConstr_.f); });
+    if (augmentedLagrangianPtr_ == nullptr) {
+      // inequality constraints penalty
+      scalar_array_t inequalityPenaltyTrajectory(timeTrajectoriesStock[i].size());
+      std::transform(modelDataTrajectoriesStock[i].begin(), modelDataTrajectoriesStock[i].end(), inequalityPenaltyTrajectory.begin(),
+                     [&](const ModelData& m) { return ineqConstrPenalty.getValue(m.time_, m.ineqConstr_.f); });
+
+      performanceIndex.inequalityConstraintPenalty += trapezoidalIntegration(timeTrajectoriesStock[i], inequalityPenaltyTrajectory);
+
+    } else {
+      // augmented Lagrangian terms of the state-only equality and the inequality constraints
+      scalar_array_t equalityLagrangianTrajectory(timeTrajectoriesStock[i].size());
+      scalar_array_t inequalityLagrangianTrajectory(timeTrajectoriesStock[i].size());
+      for (size_t k = 0; k < modelDataTrajectoriesStock[i].size(); k++) {
+        std::tie(equalityLagrangianTrajectory[k], inequalityLagrangianTrajectory[k]) =
+            augmentedLagrangianPtr_->getIntermediateValue(modelDataTrajectoriesStock[i][k]);
+      }
 
-    performanceIndex.inequalityConstraintPenalty += trapezoidalIntegration(timeTrajectoriesStock[i], inequalityPenaltyTrajectory);
+      performanceIndex.equalityLagrangian += trapezoidalIntegration(timeTrajectoriesStock[i], equalityLagrangianTrajectory);
+      performanceIndex.inequalityConstraintPenalty += trapezoidalIntegration(timeTrajectoriesStock[i], inequalityLagrangianTrajectory);
+    }
 
     // final cost and constraints
     for (const auto& me : modelDataEventTimesStock[i]) {
       performanceIndex.totalCost += me.cost_.f;
       performanceIndex.stateEqFinalConstraintSSE += me.stateEqConstr_.f.squaredNorm();
+      if (augmentedLagrangianPtr_ != nullptr) {
+        performanceIndex.equalityLagrangian += augmentedLagrangianPtr_->getEventValue(me);
+      }
     }
   }  // end of i loop
 
@@ -80,6 +80,7 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
   settings.hessianCorrectionStrategy_ = hessian_correction::fromString(hessianCorrectionStrategyName);
 
   loadData::loadPtreeValue(pt, settings.hessianCorrectionMultiple_, fieldName + ".hessianCorrectionMultiple", verbose);
+  loadData::loadPtreeValue(pt, settings.cacheHessianCorrectionShift_, fieldName + ".cacheHessianCorrectionShift", verbose);
 
   if (verbose) {
     std::cerr << " #### }" << std::endl;
@@ -0,0 +1,257 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/constraint/StateInputConstraint.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include <ocs2_ddp/ILQR.h>
+#include <ocs2_ddp/SLQ.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Bounds on the scalar input: uMax - u >= 0, u + uMax >= 0 */
+class InputBounds final : public StateInputConstraint {
+ public:
+  explicit InputBounds(scalar_t uMax) : StateInputConstraint(ConstraintOrder::Quadratic), uMax_(uMax) {}
+  ~InputBounds() override = default;
+  InputBounds* clone() const override { return new InputBounds(*this); }
+
+  size_t getNumConstraints(scalar_t time) const override { return 2; }
+
+  vector_t getValue(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) const override {
+    return (vector_t(2) << uMax_ - u(0), u(0) + uMax_).finished();
+  }
+
+  VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                 const PreComputation& preComp) const override {
+    auto approximation = VectorFunctionQuadraticApproximation::Zero(2, x.size(), u.size());
+    approximation.f = getValue(t, x, u, preComp);
+    approximation.dfdu << -1.0, 1.0;
+    return approximation;
+  }
+
+ private:
+  scalar_t uMax_;
+};
+
+}  // unnamed namespace
+
+/*
+ * A double integrator, x = [p, v], that is driven toward p = 2 with the state-only equality constraint p + v = 1 or with the input
+ * bounds |u| <= 1. The augmented Lagrangian mode is compared to the growing quadratic penalty and to the relaxed barrier.
+ */
+class AugmentedLagrangianTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 2;
+  static constexpr size_t INPUT_DIM = 1;
+  static constexpr scalar_t startTime = 0.0;
+  static constexpr scalar_t finalTime = 3.0;
+
+  AugmentedLagrangianTest() : initializer(INPUT_DIM) {
+    rollout::Settings rolloutSettings;
+    rolloutSettings.absTolODE = 1e-9;
+    rolloutSettings.relTolODE = 1e-7;
+    rolloutSettings.timeStep = 1e-2;
+    const matrix_t A = (matrix_t(STATE_DIM, STATE_DIM) << 0.0, 1.0, 0.0, 0.0).finished();
+    const matrix_t B = (matrix_t(STATE_DIM, INPUT_DIM) << 0.0, 1.0).finished();
+    LinearSystemDynamics dynamics(A, B);
+    rolloutPtr.reset(new TimeTriggeredRollout(dynamics, rolloutSettings));
+
+    problem.dynamicsPtr.reset(dynamics.clone());
+    const matrix_t Q = (matrix_t(STATE_DIM, STATE_DIM) << 1.0, 0.0, 0.0, 0.1).finished();
+    const matrix_t R = 0.1 * matrix_t::Identity(INPUT_DIM, INPUT_DIM);
+    const matrix_t Qf = 10.0 * matrix_t::Identity(STATE_DIM, STATE_DIM);
+    problem.costPtr->add("cost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(Q, R)));
+    problem.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(Qf)));
+
+    const vector_t xTarget = (vector_t(STATE_DIM) << 2.0, 0.0).finished();
+    referenceManagerPtr = std::make_shared<ReferenceManager>(TargetTrajectories({startTime}, {xTarget}, {vector_t::Zero(INPUT_DIM)}));
+  }
+
+  ddp::Settings getSettings(ddp::Algorithm algorithm, bool useAugmentedLagrangian) const {
+    ddp::Settings settings;
+    settings.algorithm_ = algorithm;
+    settings.nThreads_ = 1;
+    settings.maxNumIterations_ = 50;
+    // above the change of the merit between the ILQR iterations on a converged solution
+    settings.minRelCost_ = 1e-4;
+    settings.constraintTolerance_ = 1e-6;
+    settings.timeStep_ = 1e-2;
+    settings.absTolODE_ = 1e-9;
+    settings.relTolODE_ = 1e-7;
+    settings.checkNumericalStability_ = false;
+    settings.useFeedbackPolicy_ = true;
+    settings.useAugmentedLagrangian_ = useAugmentedLagrangian;
+    settings.strategy_ = search_strategy::Type::LINE_SEARCH;
+    settings.lineSearch_.minStepLength_ = 1e-3;
+    return settings;
+  }
+
+  std::unique_ptr<GaussNewtonDDP> getSolver(const ddp::Settings& settings) const {
+    std::unique_ptr<GaussNewtonDDP> solverPtr;
+    if (settings.algorithm_ == ddp::Algorithm::SLQ) {
+      solverPtr.reset(new SLQ(settings, *rolloutPtr, problem, initializer));
+    } else {
+      solverPtr.reset(new ILQR(settings, *rolloutPtr, problem, initializer));
+    }
+    solverPtr->setReferenceManager(referenceManagerPtr);
+    return solverPtr;
+  }
+
+  OptimalControlProblem problem;
+  std::unique_ptr<RolloutBase> rolloutPtr;
+  DefaultInitializer initializer;
+  std::shared_ptr<ReferenceManager> referenceManagerPtr;
+};
+
+constexpr size_t AugmentedLagrangianTest::STATE_DIM;
+constexpr size_t AugmentedLagrangianTest::INPUT_DIM;
+constexpr scalar_t AugmentedLagrangianTest::startTime;
+constexpr scalar_t AugmentedLagrangianTest::finalTime;
+
+class AugmentedLagrangianAlgorithmTest : public AugmentedLagrangianTest, public testing::WithParamInterface<ddp::Algorithm> {};
+
+TEST_P(AugmentedLagrangianAlgorithmTest, stateEqualityConstraint) {
+  // p + v - 1 = 0, which holds at the initial state
+  const matrix_t F = (matrix_t(1, STATE_DIM) << 1.0, 1.0).finished();
+  problem.stateEqualityConstraintPtr->add("constraint", std::unique_ptr<StateConstraint>(new LinearStateConstraint(-vector_t::Ones(1), F)));
+  const vector_t initState = (vector_t(STATE_DIM) << 0.0, 1.0).finished();
+
+  const auto penaltySettings = getSettings(GetParam(), false);
+  const auto augmentedLagrangianSettings = getSettings(GetParam(), true);
+  auto penaltySolverPtr = getSolver(penaltySettings);
+  auto augmentedLagrangianSolverPtr = getSolver(augmentedLagrangianSettings);
+  penaltySolverPtr->run(startTime, initState, finalTime, {startTime, finalTime});
+  augmentedLagrangianSolverPtr->run(startTime, initState, finalTime, {startTime, finalTime});
+
+  const auto& penalty = penaltySolverPtr->getPerformanceIndeces();
+  const auto& augmentedLagrangian = augmentedLagrangianSolverPtr->getPerformanceIndeces();
+  std::cerr << "[stateEqualityConstraint] " << ddp::toAlgorithmName(GetParam()) << "\n"
+            << "  quadratic penalty,    iterations: " << penaltySolverPtr->getNumIterations()
+            << ", state equality ISE: " << penalty.stateEqConstraintISE << ", cost: " << penalty.totalCost << "\n"
+            << "  augmented Lagrangian, iterations: " << augmentedLagrangianSolverPtr->getNumIterations()
+            << ", state equality ISE: " << augmentedLagrangian.stateEqConstraintISE << ", cost: " << augmentedLagrangian.totalCost << "\n";
+
+  // the augmented Lagrangian converges with a satisfied constraint, while its penalty is bounded
+  EXPECT_LT(augmentedLagrangianSolverPtr->getNumIterations(), augmentedLagrangianSettings.maxNumIterations_);
+  EXPECT_LE(augmentedLagrangian.stateEqConstraintISE, augmentedLagrangianSettings.constraintTolerance_);
+}
+
+TEST_F(AugmentedLagrangianTest, inequalityConstraint) {
+  constexpr scalar_t uMax = 1.0;
+  problem.inequalityConstraintPtr->add("bounds", std::unique_ptr<StateInputConstraint>(new InputBounds(uMax)));
+  const vector_t initState = vector_t::Zero(STATE_DIM);
+
+  // ILQR, since the continuous-time Riccati equations of SLQ get stiff at the switches of the active set on its adaptive time grid
+  auto barrierSettings = getSettings(ddp::Algorithm::ILQR, false);
+  barrierSettings.minRelCost_ = 1e-3;
+  barrierSettings.inequalityConstraintMu_ = 0.1;
+  barrierSettings.inequalityConstraintDelta_ = 1e-3;
+  auto augmentedLagrangianSettings = getSettings(ddp::Algorithm::ILQR, true);
+  augmentedLagrangianSettings.minRelCost_ = 1e-3;
+  auto barrierSolverPtr = getSolver(barrierSettings);
+  auto augmentedLagrangianSolverPtr = getSolver(augmentedLagrangianSettings);
+  barrierSolverPtr->run(startTime, initState, finalTime, {startTime, finalTime});
+  augmentedLagrangianSolverPtr->run(startTime, initState, finalTime, {startTime, finalTime});
+
+  const auto& barrier = barrierSolverPtr->getPerformanceIndeces();
+  const auto& augmentedLagrangian = augmentedLagrangianSolverPtr->getPerformanceIndeces();
+  std::cerr << "[inequalityConstraint] ILQR\n"
+            << "  relaxed barrier,      iterations: " << barrierSolverPtr->getNumIterations()
+            << ", inequality ISE: " << barrier.inequalityConstraintISE << ", cost: " << barrier.totalCost << "\n"
+            << "  augmented Lagrangian, iterations: " << augmentedLagrangianSolverPtr->getNumIterations()
+            << ", inequality ISE: " << augmentedLagrangian.inequalityConstraintISE << ", cost: " << augmentedLagrangian.totalCost << "\n";
+
+  // the barrier keeps a margin to the bounds, while the augmented Lagrangian converges to the constrained optimum
+  EXPECT_LT(augmentedLagrangianSolverPtr->getNumIterations(), augmentedLagrangianSettings.maxNumIterations_);
+  EXPECT_LE(augmentedLagrangian.inequalityConstraintISE, augmentedLagrangianSettings.constraintTolerance_);
+  EXPECT_LT(augmentedLagrangian.totalCost, barrier.totalCost);
+  const auto primalSolution = augmentedLagrangianSolverPtr->primalSolution(finalTime);
+  for (const auto& input : primalSolution.inputTrajectory_) {
+    EXPECT_LT(std::abs(input(0)), uMax + 5e-2);
+  }
+}
+
+TEST_P(AugmentedLagrangianAlgorithmTest, warmStartMultipliers) {
+  const matrix_t F = (matrix_t(1, STATE_DIM) << 1.0, 1.0).finished();
+  problem.stateEqualityConstraintPtr->add("constraint", std::unique_ptr<StateConstraint>(new LinearStateConstraint(-vector_t::Ones(1), F)));
+  const vector_t initState = (vector_t(STATE_DIM) << 0.0, 1.0).finished();
+
+  // the first MPC cycle
+  const auto settings = getSettings(GetParam(), true);
+  auto solverPtr = getSolver(settings);
+  solverPtr->run(startTime, initState, finalTime, {startTime, finalTime});
+
+  // the same primal warm start, without the multipliers
+  auto coldMultipliersSolverPtr = getSolver(settings);
+  coldMultipliersSolverPtr->copyWarmStart(*solverPtr);
+
+  // the next MPC cycle
+  constexpr scalar_t timeAdvance = 0.1;
+  const auto primalSolution = solverPtr->primalSolution(finalTime);
+  const vector_t nextState = LinearInterpolation::interpolate(timeAdvance, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+  const scalar_array_t partitioningTimes{startTime + timeAdvance, finalTime + timeAdvance};
+  solverPtr->run(startTime + timeAdvance, nextState, finalTime + timeAdvance, partitioningTimes);
+  coldMultipliersSolverPtr->run(startTime + timeAdvance, nextState, finalTime + timeAdvance, partitioningTimes);
+
+  // the largest violation along the iterations
+  auto maxViolation = [](const std::vector<PerformanceIndex>& iterationsLog) {
+    return std::max_element(iterationsLog.begin(), iterationsLog.end(), [](const PerformanceIndex& lhs, const PerformanceIndex& rhs) {
+             return lhs.stateEqConstraintISE < rhs.stateEqConstraintISE;
+           })->stateEqConstraintISE;
+  };
+  const auto& warmLog = solverPtr->getIterationsLog();
+  const auto& coldLog = coldMultipliersSolverPtr->getIterationsLog();
+  std::cerr << "[warmStartMultipliers] " << ddp::toAlgorithmName(GetParam()) << "\n"
+            << "  warm multipliers, iterations: " << warmLog.size() << ", max state equality ISE: " << maxViolation(warmLog) << "\n"
+            << "  cold multipliers, iterations: " << coldLog.size() << ", max state equality ISE: " << maxViolation(coldLog) << "\n";
+  EXPECT_LE(warmLog.size(), coldLog.size());
+  EXPECT_LE(maxViolation(warmLog), maxViolation(coldLog));
+}
+
+INSTANTIATE_TEST_CASE_P(AugmentedLagrangianTestCase, AugmentedLagrangianAlgorithmTest,
+                        testing::Values(ddp::Algorithm::SLQ, ddp::Algorithm::ILQR),
+                        [](const testing::TestParamInfo<AugmentedLagrangianAlgorithmTest::ParamType>& info) {
+                          return ddp::toAlgorithmName(info.param);
+                        });
@@ -28,18 +28,87 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/misc/Lookup.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP0.h>
 
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
 
+namespace {
+
+/** Compares the mode index which the solver provides to the cost terms against ModeSchedule::modeAtTime() at the node time. */
+struct ModeIndexCheck {
+  explicit ModeIndexCheck(std::shared_ptr<ocs2::ReferenceManager> referenceManager) : referenceManagerPtr(std::move(referenceManager)) {}
+
+  void check(ocs2::scalar_t time, const ocs2::PreComputation& preComp) {
+    ASSERT_TRUE(preComp.hasModeIndex());
+    const auto& eventTimes = referenceManagerPtr->getModeSchedule().eventTimes;
+    numChecks++;
+    if (preComp.getModeIndex() != ocs2::lookup::findIndexInTimeArray(eventTimes, time)) {
+      numMismatches++;
+    }
+  }
+
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr;
+  std::atomic<size_t> numChecks{0};
+  std::atomic<size_t> numMismatches{0};
+};
+
+class ModeIndexCheckCost final : public ocs2::StateInputCost {
+ public:
+  explicit ModeIndexCheckCost(std::shared_ptr<ModeIndexCheck> checkPtr) : checkPtr_(std::move(checkPtr)) {}
+  ModeIndexCheckCost* clone() const override { return new ModeIndexCheckCost(*this); }
+
+  ocs2::scalar_t getValue(ocs2::scalar_t time, const ocs2::vector_t& state, const ocs2::vector_t& input, const ocs2::TargetTrajectories&,
+                          const ocs2::PreComputation& preComp) const override {
+    checkPtr_->check(time, preComp);
+    return 0.0;
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t time, const ocs2::vector_t& state,
+                                                                       const ocs2::vector_t& input, const ocs2::TargetTrajectories&,
+                                                                       const ocs2::PreComputation& preComp) const override {
+    checkPtr_->check(time, preComp);
+    return ocs2::ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+  }
+
+ private:
+  std::shared_ptr<ModeIndexCheck> checkPtr_;
+};
+
+class ModeIndexCheckStateCost final : public ocs2::StateCost {
+ public:
+  explicit ModeIndexCheckStateCost(std::shared_ptr<ModeIndexCheck> checkPtr) : checkPtr_(std::move(checkPtr)) {}
+  ModeIndexCheckStateCost* clone() const override { return new ModeIndexCheckStateCost(*this); }
+
+  ocs2::scalar_t getValue(ocs2::scalar_t time, const ocs2::vector_t& state, const ocs2::TargetTrajectories&,
+                          const ocs2::PreComputation& preComp) const override {
+    checkPtr_->check(time, preComp);
+    return 0.0;
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation getQuadraticApproximation(ocs2::scalar_t time, const ocs2::vector_t& state,
+                                                                       const ocs2::TargetTrajectories&,
+                                                                       const ocs2::PreComputation& preComp) const override {
+    checkPtr_->check(time, preComp);
+    return ocs2::ScalarFunctionQuadraticApproximation::Zero(state.size(), 0);
+  }
+
+ private:
+  std::shared_ptr<ModeIndexCheck> checkPtr_;
+};
+
+}  // namespace
+
 class Exp0 : public testing::Test {
  protected:
   static constexpr size_t STATE_DIM = 2;
@@ -229,6 +298,108 @@ TEST_F(Exp0, ddp_caching) {
   EXPECT_NO_THROW(ddp.run(startTime, initState, finalTime, partitioningTimes, std::vector<ocs2::ControllerBase*>()));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_warm_start_snapshot) {
+  const std::string snapshotFileName = "ocs2_exp0_warm_start_snapshot.bin";
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // the solver of the process which is going to be restarted
+  ocs2::SLQ ddp(ddpSettings, *rolloutPtr, *problemPtr, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ddp.run(startTime, initState, finalTime, partitioningTimes);
+  const auto solution = ddp.primalSolution(finalTime);
+  ASSERT_NO_THROW(ddp.saveWarmStart(snapshotFileName));
+
+  // cold start of the restarted process
+  ocs2::SLQ ddpColdStart(ddpSettings, *rolloutPtr, *problemPtr, *initializerPtr);
+  ddpColdStart.setReferenceManager(ocs2::getExp0ReferenceManager({0.1897}, {0, 1}));
+  ddpColdStart.run(startTime, initState, finalTime, partitioningTimes);
+
+  // restarted process with the snapshot
+  auto restartedReferenceManagerPtr = ocs2::getExp0ReferenceManager({}, {0});
+  ocs2::SLQ ddpWarmStart(ddpSettings, *rolloutPtr, *problemPtr, *initializerPtr);
+  ddpWarmStart.setReferenceManager(restartedReferenceManagerPtr);
+  ASSERT_NO_THROW(ddpWarmStart.loadWarmStart(snapshotFileName));
+
+  // round trip
+  const auto loadedSolution = ddpWarmStart.primalSolution(finalTime);
+  EXPECT_EQ(loadedSolution.timeTrajectory_, solution.timeTrajectory_);
+  EXPECT_EQ(loadedSolution.stateTrajectory_.back(), solution.stateTrajectory_.back());
+  const auto* ctrlPtr = dynamic_cast<ocs2::LinearController*>(solution.controllerPtr_.get());
+  const auto* loadedCtrlPtr = dynamic_cast<ocs2::LinearController*>(loadedSolution.controllerPtr_.get());
+  ASSERT_TRUE(ctrlPtr != nullptr && loadedCtrlPtr != nullptr);
+  EXPECT_EQ(loadedCtrlPtr->timeStamp_, ctrlPtr->timeStamp_);
+  EXPECT_EQ(loadedCtrlPtr->gainArray().front(), ctrlPtr->gainArray().front());
+  EXPECT_EQ(loadedCtrlPtr->biasArray_.back(), ctrlPtr->biasArray_.back());
+
+  // the mode schedule is restored in the ReferenceManager before the next run
+  ddpWarmStart.run(startTime, initState, finalTime, partitioningTimes, std::vector<ocs2::ControllerBase*>());
+  EXPECT_EQ(restartedReferenceManagerPtr->getModeSchedule().eventTimes, referenceManagerPtr->getModeSchedule().eventTimes);
+  EXPECT_EQ(restartedReferenceManagerPtr->getModeSchedule().modeSequence, referenceManagerPtr->getModeSchedule().modeSequence);
+  performanceIndexTest(ddpSettings, ddpWarmStart.getPerformanceIndeces());
+
+  // the first solve after the restart
+  std::cerr << "\n[Exp0 warm-start snapshot] number of iterations of the first solve:\n";
+  std::cerr << "cold start: " << ddpColdStart.getNumIterations() << "\n";
+  std::cerr << "snapshot:   " << ddpWarmStart.getNumIterations() << "\n";
+  EXPECT_LT(ddpWarmStart.getNumIterations(), ddpColdStart.getNumIterations());
+
+  // an in-memory copy holds the same warm start as the snapshot
+  ocs2::SLQ ddpCopy(ddpSettings, *rolloutPtr, *problemPtr, *initializerPtr);
+  ddpCopy.setReferenceManager(ocs2::getExp0ReferenceManager(referenceManagerPtr->getModeSchedule().eventTimes,
+                                                            referenceManagerPtr->getModeSchedule().modeSequence));
+  ddpCopy.copyWarmStart(ddp);
+  const auto copiedSolution = ddpCopy.primalSolution(finalTime);
+  EXPECT_EQ(copiedSolution.timeTrajectory_, solution.timeTrajectory_);
+  EXPECT_EQ(copiedSolution.stateTrajectory_.back(), solution.stateTrajectory_.back());
+  ddpCopy.run(startTime, initState, finalTime, partitioningTimes, std::vector<ocs2::ControllerBase*>());
+  EXPECT_EQ(ddpCopy.getNumIterations(), ddpWarmStart.getNumIterations());
+
+  // a missing snapshot throws
+  EXPECT_ANY_THROW(ddpWarmStart.loadWarmStart(snapshotFileName + ".missing"));
+
+  std::remove(snapshotFileName.c_str());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_mode_index) {
+  // the mode indices of the initial rollout and of the search strategy's rollouts are passed to the intermediate, pre-jump and final
+  // cost terms, both in the LQ approximation and in the metrics of the rollouts
+  auto checkPtr = std::make_shared<ModeIndexCheck>(referenceManagerPtr);
+  problemPtr->costPtr->add("modeIndexCheck", std::unique_ptr<ocs2::StateInputCost>(new ModeIndexCheckCost(checkPtr)));
+  problemPtr->preJumpCostPtr->add("modeIndexCheck", std::unique_ptr<ocs2::StateCost>(new ModeIndexCheckStateCost(checkPtr)));
+  problemPtr->finalCostPtr->add("modeIndexCheck", std::unique_ptr<ocs2::StateCost>(new ModeIndexCheckStateCost(checkPtr)));
+
+  const auto eventTime = referenceManagerPtr->getModeSchedule().eventTimes.front();
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    for (const auto strategy : {ocs2::search_strategy::Type::LINE_SEARCH, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT}) {
+      const auto ddpSettings = getSettings(algorithm, 2, strategy);
+      std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+      if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+        ddpPtr.reset(new ocs2::SLQ(ddpSettings, *rolloutPtr, *problemPtr, *initializerPtr));
+      } else {
+        ddpPtr.reset(new ocs2::ILQR(ddpSettings, *rolloutPtr, *problemPtr, *initializerPtr));
+      }
+      ddpPtr->setReferenceManager(referenceManagerPtr);
+
+      // the initial time is at the event
+      ddpPtr->run(eventTime, initState, finalTime, {eventTime, finalTime});
+
+      // the initial time is before the event, which is a partitioning time
+      ddpPtr->reset();
+      ddpPtr->run(startTime, initState, finalTime, partitioningTimes);
+      performanceIndexTest(ddpSettings, ddpPtr->getPerformanceIndeces());
+    }
+  }
+
+  EXPECT_GT(checkPtr->numChecks, 0);
+  EXPECT_EQ(checkPtr->numMismatches, 0);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
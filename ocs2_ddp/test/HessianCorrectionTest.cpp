@@ -0,0 +1,202 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <ocs2_ddp/HessianCorrection.h>
+
+using namespace ocs2;
+
+namespace {
+
+const std::vector<hessian_correction::Strategy> strategies{
+    hessian_correction::Strategy::DIAGONAL_SHIFT, hessian_correction::Strategy::CHOLESKY_MODIFICATION,
+    hessian_correction::Strategy::EIGENVALUE_MODIFICATION, hessian_correction::Strategy::GERSHGORIN_MODIFICATION};
+
+/** Random symmetric matrix with the given eigenvalues */
+matrix_t getSymmetricMatrix(const vector_t& eigenvalues) {
+  const Eigen::HouseholderQR<matrix_t> qr(matrix_t::Random(eigenvalues.size(), eigenvalues.size()));
+  const matrix_t Q = qr.householderQ();
+  return Q * eigenvalues.asDiagonal() * Q.transpose();
+}
+
+scalar_t getMinEigenvalue(const matrix_t& matrix) {
+  return Eigen::SelfAdjointEigenSolver<matrix_t>(matrix, Eigen::EigenvaluesOnly).eigenvalues().minCoeff();
+}
+
+}  // unnamed namespace
+
+TEST(HessianCorrectionTest, hasMinEigenvalue) {
+  constexpr size_t n = 6;
+  constexpr scalar_t minEigenvalue = 1e-3;
+  for (const scalar_t smallestEigenvalue : {-1.0, 0.0, 0.5 * minEigenvalue, 2.0 * minEigenvalue, 1.0}) {
+    vector_t eigenvalues = vector_t::LinSpaced(n, 1.0, 10.0);
+    eigenvalues(0) = smallestEigenvalue;
+    matrix_t matrix = getSymmetricMatrix(eigenvalues);
+    const matrix_t expected = matrix;
+
+    EXPECT_EQ(hessian_correction::hasMinEigenvalue(matrix, minEigenvalue), smallestEigenvalue > minEigenvalue);
+    EXPECT_TRUE(matrix.isApprox(expected, 1e-12));
+    EXPECT_TRUE(matrix.isApprox(matrix.transpose(), 1e-12));
+
+    // on a block
+    matrix_t extendedMatrix = matrix_t::Ones(n + 2, n + 2);
+    extendedMatrix.bottomRightCorner(n, n) = expected;
+    auto block = extendedMatrix.bottomRightCorner(n, n);
+    EXPECT_EQ(hessian_correction::hasMinEigenvalue(block, minEigenvalue), smallestEigenvalue > minEigenvalue);
+    EXPECT_TRUE(block.isApprox(expected, 1e-12));
+    EXPECT_TRUE(extendedMatrix.leftCols(2).isOnes());
+    EXPECT_TRUE(extendedMatrix.topRows(2).isOnes());
+  }
+}
+
+TEST(HessianCorrectionTest, correctHessian) {
+  constexpr size_t n = 6;
+  constexpr scalar_t minEigenvalue = 1e-3;
+  for (const auto strategy : strategies) {
+    // positive definite matrices are left unchanged, except by the strategies which skip the check
+    const matrix_t positiveDefinite = getSymmetricMatrix(vector_t::LinSpaced(n, 1.0, 10.0));
+    matrix_t matrix = positiveDefinite;
+    matrix_t expected = positiveDefinite;
+    hessian_correction::correctHessian(strategy, matrix, minEigenvalue);
+    if (strategy == hessian_correction::Strategy::DIAGONAL_SHIFT || strategy == hessian_correction::Strategy::GERSHGORIN_MODIFICATION) {
+      hessian_correction::shiftHessian(strategy, expected, minEigenvalue);
+    }
+    EXPECT_TRUE(matrix.isApprox(expected, 1e-12)) << hessian_correction::toString(strategy);
+
+    // indefinite matrices are corrected with the strategy
+    vector_t eigenvalues = vector_t::LinSpaced(n, -1.0, 10.0);
+    const matrix_t indefinite = getSymmetricMatrix(eigenvalues);
+    matrix = indefinite;
+    expected = indefinite;
+    hessian_correction::correctHessian(strategy, matrix, minEigenvalue);
+    hessian_correction::shiftHessian(strategy, expected, minEigenvalue);
+    EXPECT_TRUE(matrix.isApprox(expected, 1e-12)) << hessian_correction::toString(strategy);
+  }
+}
+
+TEST(HessianCorrectionTest, cachedShift) {
+  constexpr size_t n = 6;
+  constexpr scalar_t minEigenvalue = 1e-3;
+  const matrix_t indefinite = getSymmetricMatrix(vector_t::LinSpaced(n, -1.0, 10.0));
+
+  for (const auto strategy : {hessian_correction::Strategy::CHOLESKY_MODIFICATION, hessian_correction::Strategy::EIGENVALUE_MODIFICATION}) {
+    // the first correction uses the strategy and caches its norm
+    scalar_t cachedShift = 0.0;
+    matrix_t matrix = indefinite;
+    hessian_correction::correctHessian(strategy, matrix, minEigenvalue, &cachedShift);
+    EXPECT_NEAR(cachedShift, (matrix - indefinite).norm() + minEigenvalue, 1e-12);
+    EXPECT_GT(cachedShift, 1.0);
+
+    // a slightly different matrix is corrected with the cached shift
+    const matrix_t perturbed = indefinite + 1e-4 * getSymmetricMatrix(vector_t::Random(n));
+    const scalar_t previousShift = cachedShift;
+    matrix = perturbed;
+    hessian_correction::correctHessian(strategy, matrix, minEigenvalue, &cachedShift);
+    EXPECT_DOUBLE_EQ(cachedShift, previousShift);
+    EXPECT_TRUE(matrix.isApprox(perturbed + cachedShift * matrix_t::Identity(n, n)));
+    EXPECT_GT(getMinEigenvalue(matrix), minEigenvalue);
+
+    // a positive definite matrix resets the cache
+    matrix = getSymmetricMatrix(vector_t::LinSpaced(n, 1.0, 10.0));
+    hessian_correction::correctHessian(strategy, matrix, minEigenvalue, &cachedShift);
+    EXPECT_EQ(cachedShift, 0.0);
+  }
+}
+
+/**
+ * Times the Hessian correction of the Riccati modification, i.e. (Qm - Pm' * Pm), over the nodes of a backward pass. The nodes are
+ * perturbed from one iteration to the next, as it is the case in the steady state of an MPC loop.
+ */
+TEST(HessianCorrectionTest, backwardPassBenchmark) {
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 6;
+  constexpr size_t numNodes = 100;
+  constexpr size_t numIterations = 50;
+  constexpr scalar_t minEigenvalue = 1e-3;
+
+  for (const scalar_t indefiniteRatio : {0.0, 0.2}) {
+    std::vector<matrix_t> QmTrajectory(numNodes), PmTrajectory(numNodes);
+    for (size_t k = 0; k < numNodes; k++) {
+      vector_t eigenvalues = vector_t::LinSpaced(stateDim, 1.0, 10.0);
+      if (k < indefiniteRatio * numNodes) {
+        eigenvalues(0) = -1.0;
+      }
+      PmTrajectory[k] = 0.1 * matrix_t::Random(inputDim, stateDim);
+      QmTrajectory[k] = getSymmetricMatrix(eigenvalues) + PmTrajectory[k].transpose() * PmTrajectory[k];
+    }
+    std::vector<matrix_t> perturbations(numIterations);
+    for (auto& perturbation : perturbations) {
+      perturbation = 1e-4 * getSymmetricMatrix(vector_t::Random(stateDim));
+    }
+
+    std::cerr << "[backwardPassBenchmark] state dim: " << stateDim << ", input dim: " << inputDim << ", nodes: " << numNodes
+              << ", indefinite nodes: " << indefiniteRatio * 100.0 << "%\n";
+    for (const auto strategy : strategies) {
+      // 0: shiftHessian, 1: correctHessian, 2: correctHessian with the cached shift
+      for (size_t mode = 0; mode < 3; mode++) {
+        std::vector<scalar_t> cachedShifts(numNodes, 0.0);
+        matrix_t deltaQm;
+        scalar_t minCorrectedEigenvalue = std::numeric_limits<scalar_t>::max();
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numIterations; i++) {
+          for (size_t k = 0; k < numNodes; k++) {
+            matrix_t Q_minus_PTRinvP = QmTrajectory[k] + perturbations[i];
+            Q_minus_PTRinvP.noalias() -= PmTrajectory[k].transpose() * PmTrajectory[k];
+            deltaQm = Q_minus_PTRinvP;
+            if (mode == 0) {
+              hessian_correction::shiftHessian(strategy, deltaQm, minEigenvalue);
+            } else {
+              hessian_correction::correctHessian(strategy, deltaQm, minEigenvalue, mode == 2 ? &cachedShifts[k] : nullptr);
+            }
+            if (i + 1 == numIterations) {
+              minCorrectedEigenvalue = std::min(minCorrectedEigenvalue, getMinEigenvalue(deltaQm));
+            }
+            deltaQm -= Q_minus_PTRinvP;
+          }
+        }
+        const scalar_t averageTime =
+            std::chrono::duration<scalar_t, std::micro>(std::chrono::steady_clock::now() - start).count() / numIterations;
+
+        if (strategy == hessian_correction::Strategy::DIAGONAL_SHIFT || strategy == hessian_correction::Strategy::GERSHGORIN_MODIFICATION) {
+          if (mode > 0) {
+            continue;  // correctHessian is the same as shiftHessian
+          }
+        } else {
+          EXPECT_GT(minCorrectedEigenvalue, 0.0) << hessian_correction::toString(strategy) << ", mode: " << mode;
+        }
+        const std::string modeName = mode == 0 ? "shiftHessian" : (mode == 1 ? "LLT check" : "LLT check + cached shift");
+        std::cerr << "  " << hessian_correction::toString(strategy) << ", " << modeName << ": " << averageTime << " [us]\n";
+      }
+    }
+  }
+}
@@ -0,0 +1,205 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/cost/QuasiNewtonStateCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/soft_constraint/StateSoftConstraint.h>
+#include <ocs2_core/soft_constraint/penalties/QuadraticPenalty.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** End-effector position error of a planar two-link arm with unit link lengths. The state is the joint angles. */
+class PlanarEndEffectorConstraint final : public StateConstraint {
+ public:
+  explicit PlanarEndEffectorConstraint(vector_t goal) : StateConstraint(ConstraintOrder::Linear), goal_(std::move(goal)) {}
+  PlanarEndEffectorConstraint* clone() const override { return new PlanarEndEffectorConstraint(*this); }
+
+  size_t getNumConstraints(scalar_t time) const override { return 2; }
+
+  vector_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const override {
+    const scalar_t q0 = state(0);
+    const scalar_t q01 = state(0) + state(1);
+    vector_t position(2);
+    position << std::cos(q0) + std::cos(q01), std::sin(q0) + std::sin(q01);
+    return position - goal_;
+  }
+
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
+                                                           const PreComputation& preComp) const override {
+    const scalar_t q0 = state(0);
+    const scalar_t q01 = state(0) + state(1);
+    VectorFunctionLinearApproximation constraint;
+    constraint.f = getValue(time, state, preComp);
+    constraint.dfdx.resize(2, 2);
+    constraint.dfdx << -std::sin(q0) - std::sin(q01), -std::sin(q01), std::cos(q0) + std::cos(q01), std::cos(q01);
+    return constraint;
+  }
+
+ private:
+  vector_t goal_;
+};
+
+}  // unnamed namespace
+
+class QuasiNewtonTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 2;
+  static constexpr size_t INPUT_DIM = 2;
+  static constexpr size_t maxNumIterations = 50;
+
+  QuasiNewtonTest()
+      : dynamics(matrix_t::Zero(STATE_DIM, STATE_DIM), matrix_t::Identity(STATE_DIM, INPUT_DIM)),
+        rollout(dynamics, rollout::Settings()),
+        initializer(INPUT_DIM) {
+    // a mode switch in the middle of the horizon gives a pre-event and a post-event node at the same time
+    const TargetTrajectories targetTrajectories({startTime}, {vector_t::Zero(STATE_DIM)}, {vector_t::Zero(INPUT_DIM)});
+    referenceManagerPtr = std::make_shared<ReferenceManager>(targetTrajectories, ModeSchedule({0.5 * finalTime}, {0, 1}));
+
+    problem.dynamicsPtr.reset(dynamics.clone());
+    problem.costPtr->add("inputCost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(
+                                          1e-3 * matrix_t::Identity(STATE_DIM, STATE_DIM), matrix_t::Identity(INPUT_DIM, INPUT_DIM))));
+  }
+
+  /** Adds the end-effector soft constraints, optionally wrapped with quasi-Newton Hessian estimates */
+  OptimalControlProblem getProblem(const quasi_newton::Settings* settingsPtr) const {
+    OptimalControlProblem endEffectorProblem(problem);
+    auto endEffector = [&](scalar_t weight) {
+      std::unique_ptr<StateConstraint> constraintPtr(new PlanarEndEffectorConstraint(goal));
+      std::unique_ptr<StateCost> softConstraintPtr(
+          new StateSoftConstraint(std::move(constraintPtr), std::unique_ptr<PenaltyBase>(new QuadraticPenalty(weight))));
+      if (settingsPtr != nullptr) {
+        softConstraintPtr.reset(new QuasiNewtonStateCost(std::move(softConstraintPtr), *settingsPtr));
+      }
+      return softConstraintPtr;
+    };
+    endEffectorProblem.stateSoftConstraintPtr->add("endEffector", endEffector(1.0));
+    endEffectorProblem.finalSoftConstraintPtr->add("finalEndEffector", endEffector(10.0));
+    return endEffectorProblem;
+  }
+
+  ddp::Settings getSettings() const {
+    ddp::Settings ddpSettings;
+    ddpSettings.algorithm_ = ddp::Algorithm::SLQ;
+    ddpSettings.nThreads_ = 2;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.checkNumericalStability_ = false;  // the SR1 estimates can be indefinite
+    ddpSettings.maxNumIterations_ = maxNumIterations;
+    ddpSettings.minRelCost_ = 1e-4;
+    ddpSettings.absTolODE_ = 1e-9;
+    ddpSettings.relTolODE_ = 1e-7;
+    ddpSettings.backwardPassIntegratorType_ = IntegratorType::ODE45;
+    ddpSettings.strategy_ = search_strategy::Type::LINE_SEARCH;
+    ddpSettings.lineSearch_.minStepLength_ = 1e-3;
+    ddpSettings.lineSearch_.hessianCorrectionStrategy_ = hessian_correction::Strategy::CHOLESKY_MODIFICATION;
+    ddpSettings.lineSearch_.hessianCorrectionMultiple_ = 1e-3;
+    return ddpSettings;
+  }
+
+  struct Result {
+    size_t numIterations;
+    scalar_t timePerIteration;  // [ms]
+    scalar_t merit;
+  };
+
+  Result solve(const OptimalControlProblem& ocp) const {
+    SLQ slq(getSettings(), rollout, ocp, initializer);
+    slq.setReferenceManager(referenceManagerPtr);
+
+    const auto start = std::chrono::steady_clock::now();
+    slq.run(startTime, initState, finalTime, {startTime, finalTime});
+    const auto end = std::chrono::steady_clock::now();
+
+    const size_t numIterations = slq.getIterationsLog().size();
+    const scalar_t totalTime = std::chrono::duration<scalar_t, std::milli>(end - start).count();
+    return {numIterations, totalTime / static_cast<scalar_t>(numIterations), slq.getPerformanceIndeces().merit};
+  }
+
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 2.0;
+  const vector_t initState = (vector_t(STATE_DIM) << 0.1, 0.2).finished();
+  const vector_t goal = (vector_t(2) << 1.0, 1.0).finished();
+
+  LinearSystemDynamics dynamics;
+  TimeTriggeredRollout rollout;
+  DefaultInitializer initializer;
+  std::shared_ptr<ReferenceManager> referenceManagerPtr;
+  OptimalControlProblem problem;
+};
+
+constexpr size_t QuasiNewtonTest::STATE_DIM;
+constexpr size_t QuasiNewtonTest::INPUT_DIM;
+constexpr size_t QuasiNewtonTest::maxNumIterations;
+
+TEST_F(QuasiNewtonTest, endEffectorCurvature) {
+  quasi_newton::Settings bfgsSettings;
+  bfgsSettings.update = quasi_newton::HessianUpdate::BFGS;
+  quasi_newton::Settings sr1Settings;
+  sr1Settings.update = quasi_newton::HessianUpdate::SR1;
+
+  auto bfgsProblem = getProblem(&bfgsSettings);
+  auto sr1Problem = getProblem(&sr1Settings);
+  const auto gaussNewton = solve(getProblem(nullptr));
+  const auto bfgs = solve(bfgsProblem);
+  const auto sr1 = solve(sr1Problem);
+
+  auto print = [](const std::string& name, const Result& result) {
+    std::cerr << "  " << name << ": iterations: " << result.numIterations << ", time per iteration: " << result.timePerIteration
+              << " [ms], final merit: " << result.merit << "\n";
+  };
+  std::cerr << "[QuasiNewtonTest] planar end-effector soft constraint curvature, SLQ with ODE45 rollouts\n";
+  print("Gauss-Newton ", gaussNewton);
+  print("damped BFGS  ", bfgs);
+  print("SR1          ", sr1);
+
+  EXPECT_LT(bfgs.numIterations, maxNumIterations);
+  EXPECT_LT(sr1.numIterations, maxNumIterations);
+  EXPECT_NEAR(bfgs.merit, gaussNewton.merit, 1e-2 * std::abs(gaussNewton.merit));
+  EXPECT_NEAR(sr1.merit, gaussNewton.merit, 1e-2 * std::abs(gaussNewton.merit));
+
+  // the adaptive rollout changes the node times between the iterations, yet the estimates are updated
+  for (auto* problemPtr : {&bfgsProblem, &sr1Problem}) {
+    const auto& hessianEstimate = problemPtr->stateSoftConstraintPtr->get<QuasiNewtonStateCost>("endEffector").getHessianEstimate();
+    std::cerr << "  nodes: " << hessianEstimate.getNumNodes() << ", secant updates: " << hessianEstimate.getNumUpdates() << "\n";
+    EXPECT_GT(hessianEstimate.getNumUpdates(), 0);
+  }
+}
@@ -27,10 +27,14 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <chrono>
+#include <iostream>
 #include <memory>
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/integration/Observer.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
@@ -93,6 +97,45 @@ class RiccatiInitializer {
   }
 };
 
+/**
+ * Reference implementation of the reduced-form Riccati equations which integrates the full Sm matrix, i.e. n^2 + n + 1 states.
+ * It assumes time-invariant data with zero deltaGm and deltaGv.
+ */
+class FullRiccatiEquations final : public ocs2::OdeBase {
+ public:
+  FullRiccatiEquations(const ocs2::ModelData& modelData, const ocs2::matrix_t& deltaQm) : modelData_(modelData), deltaQm_(deltaQm) {}
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t z, const ocs2::vector_t& allSs) override {
+    const auto n = modelData_.stateDim_;
+    const Eigen::Map<const ocs2::matrix_t> Sm(allSs.data(), n, n);
+    const Eigen::Map<const ocs2::vector_t> Sv(allSs.data() + n * n, n);
+
+    const auto& A = modelData_.dynamics_.dfdx;
+    const auto& B = modelData_.dynamics_.dfdu;
+    const auto& Hv = modelData_.dynamicsBias_;
+    const ocs2::matrix_t Gm = modelData_.cost_.dfdux + B.transpose() * Sm;
+    const ocs2::vector_t Gv = modelData_.cost_.dfdu + B.transpose() * Sv;
+
+    ocs2::vector_t dSdz(allSs.size());
+    Eigen::Map<ocs2::matrix_t> dSm(dSdz.data(), n, n);
+    dSm = modelData_.cost_.dfdxx + deltaQm_ + Sm * A + A.transpose() * Sm - Gm.transpose() * Gm;
+    dSdz.segment(n * n, n) = modelData_.cost_.dfdx + Sm * Hv + A.transpose() * Sv - Gm.transpose() * Gv;
+    dSdz(n * n + n) = modelData_.cost_.f + Hv.dot(Sv) - 0.5 * Gv.dot(Gv);
+    return dSdz;
+  }
+
+  static ocs2::vector_t convert2Vector(const ocs2::matrix_t& Sm, const ocs2::vector_t& Sv, ocs2::scalar_t s) {
+    const auto n = Sm.rows();
+    ocs2::vector_t allSs(n * n + n + 1);
+    allSs << Eigen::Map<const ocs2::vector_t>(Sm.data(), n * n), Sv, s;
+    return allSs;
+  }
+
+ private:
+  const ocs2::ModelData modelData_;
+  const ocs2::matrix_t deltaQm_;
+};
+
 TEST(RiccatiTest, compareImplementations) {
   constexpr int STATE_DIM = 48;
   constexpr int INPUT_DIM = 10;
@@ -164,3 +207,90 @@ TEST(RiccatiTest, testFlattenAndUnflatten) {
   ASSERT_TRUE(Sv.isApprox(Sv_out));
   ASSERT_TRUE(Sm.isApprox(Sm_out));
 }
+
+TEST(RiccatiTest, compareWithFullFlowMap) {
+  constexpr int STATE_DIM = 36;
+  constexpr int INPUT_DIM = 12;
+
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  FullRiccatiEquations fullRiccatiEquations(ri.projectedModelDataTrajectory.front(), ri.riccatiModificationTrajectory.front().deltaQm_);
+
+  const ocs2::matrix_t Sm = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  const ocs2::vector_t Sv = ocs2::vector_t::Random(STATE_DIM);
+  const ocs2::scalar_t s = ocs2::vector_t::Random(1)(0);
+
+  ocs2::matrix_t dSm_full(STATE_DIM, STATE_DIM);
+  const ocs2::vector_t dSdz_full = fullRiccatiEquations.computeFlowMap(-0.6, FullRiccatiEquations::convert2Vector(Sm, Sv, s));
+  dSm_full = Eigen::Map<const ocs2::matrix_t>(dSdz_full.data(), STATE_DIM, STATE_DIM);
+
+  for (const bool reducedFormRiccati : {true, false}) {
+    riccati_t riccatiEquations(reducedFormRiccati);
+    ri.initialize(riccatiEquations);
+
+    const ocs2::vector_t dSdz = riccatiEquations.computeFlowMap(-0.6, riccati_t::convert2Vector(Sm, Sv, s));
+    ASSERT_EQ(dSdz.size(), ocs2::s_vector_dim(STATE_DIM));
+
+    ocs2::matrix_t dSm;
+    ocs2::vector_t dSv;
+    ocs2::scalar_t ds;
+    riccati_t::convert2Matrix(dSdz, dSm, dSv, ds);
+    EXPECT_TRUE(dSm.isApprox(dSm_full, 1e-9)) << "reducedFormRiccati: " << reducedFormRiccati;
+    EXPECT_TRUE(dSv.isApprox(dSdz_full.segment(STATE_DIM * STATE_DIM, STATE_DIM), 1e-9)) << "reducedFormRiccati: " << reducedFormRiccati;
+    EXPECT_NEAR(ds, dSdz_full.tail<1>()(0), 1e-9 * std::abs(ds)) << "reducedFormRiccati: " << reducedFormRiccati;
+  }
+}
+
+TEST(RiccatiTest, backwardPassBenchmark) {
+  constexpr int STATE_DIM = 36;
+  constexpr int INPUT_DIM = 12;
+  constexpr size_t numRuns = 10;
+  constexpr ocs2::scalar_t absTol = 1e-9;
+  constexpr ocs2::scalar_t relTol = 1e-7;
+
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  ri.projectedModelDataTrajectory[0].dynamics_.dfdx *= 0.2;
+  ri.projectedModelDataTrajectory[1].dynamics_.dfdx *= 0.2;
+  riccati_t riccatiEquations(true);
+  ri.initialize(riccatiEquations);
+  FullRiccatiEquations fullRiccatiEquations(ri.projectedModelDataTrajectory.front(), ri.riccatiModificationTrajectory.front().deltaQm_);
+
+  const ocs2::matrix_t SmFinal = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  const ocs2::vector_t SvFinal = ocs2::vector_t::Random(STATE_DIM);
+  const ocs2::scalar_t sFinal = 0.0;
+
+  // integrates backward in time from t = 1 to t = 0, i.e. forward in the normalized time z = -t
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::ODE45);
+  const auto integrate = [&](ocs2::OdeBase& system, const ocs2::vector_t& allSsFinal, ocs2::vector_array_t& allSsTrajectory) {
+    allSsTrajectory.clear();
+    ocs2::Observer observer(&allSsTrajectory);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numRuns; i++) {
+      allSsTrajectory.clear();
+      integrator->integrateAdaptive(system, observer, allSsFinal, -1.0, 0.0, 1e-3, absTol, relTol);
+    }
+    return std::chrono::duration<ocs2::scalar_t, std::milli>(std::chrono::steady_clock::now() - start).count() / numRuns;
+  };
+
+  ocs2::vector_array_t packedTrajectory, fullTrajectory;
+  const auto packedTime = integrate(riccatiEquations, riccati_t::convert2Vector(SmFinal, SvFinal, sFinal), packedTrajectory);
+  const auto fullTime = integrate(fullRiccatiEquations, FullRiccatiEquations::convert2Vector(SmFinal, SvFinal, sFinal), fullTrajectory);
+
+  ocs2::matrix_t Sm;
+  ocs2::vector_t Sv;
+  ocs2::scalar_t s;
+  riccati_t::convert2Matrix(packedTrajectory.back(), Sm, Sv, s);
+  const ocs2::vector_t& allSsFull = fullTrajectory.back();
+  EXPECT_TRUE(Sm.isApprox(Eigen::Map<const ocs2::matrix_t>(allSsFull.data(), STATE_DIM, STATE_DIM), 1e-5));
+  EXPECT_TRUE(Sv.isApprox(allSsFull.segment(STATE_DIM * STATE_DIM, STATE_DIM), 1e-5));
+  EXPECT_NEAR(s, allSsFull.tail<1>()(0), 1e-5 * std::max(1.0, std::abs(s)));
+
+  std::cerr << "[backwardPassBenchmark] state dim: " << STATE_DIM << ", input dim: " << INPUT_DIM << "\n";
+  std::cerr << "  packed Sm: " << ocs2::s_vector_dim(STATE_DIM) << " states, " << packedTrajectory.size() << " nodes, " << packedTime
+            << " [ms]\n";
+  std::cerr << "  full Sm:   " << STATE_DIM * STATE_DIM + STATE_DIM + 1 << " states, " << fullTrajectory.size() << " nodes, " << fullTime
+            << " [ms]\n";
+}
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 #include "ocs2_ddp/ContinuousTimeLqr.h"
 
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
@@ -38,6 +41,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace ocs2;
 
+namespace {
+
+scalar_t evaluateCareResidualNorm(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                                  const matrix_t& S) {
+  const auto& A = dynamics.dfdx;
+  const auto& B = dynamics.dfdu;
+  const auto& Q = cost.dfdxx;
+  const auto& R = cost.dfduu;
+  const auto& P = cost.dfdux;
+  const matrix_t careResidual = A.transpose() * S + S * A - (S * B + P.transpose()) * R.lu().solve(B.transpose() * S + P) + Q;
+  return careResidual.norm();
+}
+
+}  // unnamed namespace
+
 TEST(testContinousTimeLqr, compareWithMatlab) {
   // Set up problem with arbitrary values
   const matrix_t A = (matrix_t(2, 2) << 1.0, 2.0, 3.0, 4.0).finished();
@@ -112,3 +130,129 @@ TEST(testContinousTimeLqr, evaluateCAREresidual) {
     ASSERT_LT(careResidual.norm(), careResidualNormTolerance);
   }
 }
+
+TEST(testContinousTimeLqr, newtonKleinmanRefinement) {
+  const scalar_t careResidualNormTolerance = 1e-9;
+
+  for (int n = 2; n < 65; n *= 2) {
+    const int m = n / 2;
+    const auto dynamics = getRandomDynamics(n, m);
+    const auto cost = getRandomCost(n, m);
+    const auto lqrSolution = continuous_time_lqr::solve(dynamics, cost);
+
+    // The solution of a nearby linearization point is a stabilizing warm start
+    auto perturbedDynamics = dynamics;
+    perturbedDynamics.dfdx += 1e-2 * matrix_t::Random(n, n);
+    perturbedDynamics.dfdu += 1e-2 * matrix_t::Random(n, m);
+    continuous_time_lqr::solution refinedSolution;
+    ASSERT_TRUE(continuous_time_lqr::refine(perturbedDynamics, cost, lqrSolution.valueFunction, continuous_time_lqr::Settings(),
+                                            refinedSolution));
+    ASSERT_LT(evaluateCareResidualNorm(perturbedDynamics, cost, refinedSolution.valueFunction), careResidualNormTolerance);
+
+    const auto perturbedSolution = continuous_time_lqr::solve(perturbedDynamics, cost);
+    EXPECT_TRUE(refinedSolution.valueFunction.isApprox(perturbedSolution.valueFunction, 1e-8));
+    EXPECT_TRUE(refinedSolution.feedbackGains.isApprox(perturbedSolution.feedbackGains, 1e-8));
+  }
+
+  // A warm start that does not stabilize the system is rejected
+  const matrix_t A = (matrix_t(2, 2) << 1.0, 2.0, 3.0, 4.0).finished();
+  const matrix_t B = (matrix_t(2, 1) << 5.0, 6.0).finished();
+  VectorFunctionLinearApproximation dynamics;
+  dynamics.dfdx = A;
+  dynamics.dfdu = B;
+  ScalarFunctionQuadraticApproximation cost;
+  cost.dfdxx = matrix_t::Identity(2, 2);
+  cost.dfduu = matrix_t::Identity(1, 1);
+  cost.dfdux = matrix_t::Zero(1, 2);
+  continuous_time_lqr::solution refinedSolution;
+  EXPECT_FALSE(continuous_time_lqr::refine(dynamics, cost, matrix_t::Zero(2, 2), continuous_time_lqr::Settings(), refinedSolution));
+}
+
+TEST(testContinousTimeLqr, cachedSolver) {
+  const scalar_t careResidualNormTolerance = 1e-9;
+  const int n = 8;
+  const int m = 3;
+  const auto dynamicsMatrices = getRandomDynamics(n, m);
+  const auto costMatrices = getRandomCost(n, m);
+  const scalar_t time = 0.0;
+  const vector_t state = vector_t::Random(n);
+  const vector_t input = vector_t::Random(m);
+  TargetTrajectories targetTrajectories({time}, {state}, {input});
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(dynamicsMatrices);
+  problem.costPtr->add("cost", getOcs2Cost(costMatrices));
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  continuous_time_lqr::CachedSolver solver(continuous_time_lqr::Settings(), 1e-3, 2);
+  const auto expectedSolution = continuous_time_lqr::solve(problem, time, state, input);
+
+  // first query and repeated query
+  solver.solve(problem, time, state, input);
+  const auto& cachedSolution = solver.solve(problem, time, state, input);
+  EXPECT_EQ(solver.getNumColdStarts(), 1);
+  EXPECT_EQ(solver.getNumHits(), 1);
+  EXPECT_TRUE(cachedSolution.valueFunction.isApprox(expectedSolution.valueFunction, 1e-12));
+  EXPECT_TRUE(cachedSolution.feedbackGains.isApprox(expectedSolution.feedbackGains, 1e-12));
+
+  // the approximation of a linear quadratic problem does not depend on the reference
+  targetTrajectories = TargetTrajectories({time}, {vector_t::Random(n)}, {vector_t::Random(m)});
+  solver.solve(problem, time, vector_t::Random(n), input);
+  EXPECT_EQ(solver.getNumHits(), 2);
+
+  // a slightly modified problem is refined from the cached solution
+  auto perturbedDynamics = dynamicsMatrices;
+  perturbedDynamics.dfdx += 1e-6 * matrix_t::Random(n, n);
+  problem.dynamicsPtr = getOcs2Dynamics(perturbedDynamics);
+  const auto& refinedSolution = solver.solve(problem, time, state, input);
+  EXPECT_EQ(solver.getNumRefinements(), 1);
+  EXPECT_EQ(solver.getNumColdStarts(), 1);
+  EXPECT_LT(evaluateCareResidualNorm(perturbedDynamics, costMatrices, refinedSolution.valueFunction), careResidualNormTolerance);
+
+  // a different problem is solved from scratch
+  perturbedDynamics.dfdx += 1e-1 * matrix_t::Random(n, n);
+  problem.dynamicsPtr = getOcs2Dynamics(perturbedDynamics);
+  const auto& coldStartSolution = solver.solve(problem, time, state, input);
+  EXPECT_EQ(solver.getNumColdStarts(), 2);
+  EXPECT_LT(evaluateCareResidualNorm(perturbedDynamics, costMatrices, coldStartSolution.valueFunction), careResidualNormTolerance);
+
+  // no warm start after clearing the cache
+  solver.clear();
+  solver.solve(problem, time, state, input);
+  EXPECT_EQ(solver.getNumColdStarts(), 3);
+}
+
+TEST(testContinousTimeLqr, benchmark) {
+  constexpr size_t numRepetitions = 20;
+  for (const int n : {12, 24, 48}) {
+    const int m = n / 3;
+    const auto dynamics = getRandomDynamics(n, m);
+    const auto cost = getRandomCost(n, m);
+    const matrix_t valueFunctionGuess = continuous_time_lqr::solve(dynamics, cost).valueFunction;
+
+    // average time per solve [ms]
+    auto timeSolves = [&](scalar_t perturbation, bool warmStart) {
+      std::vector<VectorFunctionLinearApproximation> perturbedDynamics(numRepetitions, dynamics);
+      for (auto& d : perturbedDynamics) {
+        d.dfdx += perturbation * matrix_t::Random(n, n);
+      }
+      continuous_time_lqr::solution lqrSolution;
+      const auto start = std::chrono::steady_clock::now();
+      for (const auto& d : perturbedDynamics) {
+        if (warmStart) {
+          EXPECT_TRUE(continuous_time_lqr::refine(d, cost, valueFunctionGuess, continuous_time_lqr::Settings(), lqrSolution));
+        } else {
+          lqrSolution = continuous_time_lqr::solve(d, cost);
+        }
+      }
+      return std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - start).count() / numRepetitions;
+    };
+
+    std::cerr << "[benchmark] state dim: " << n << ", input dim: " << m << "\n"
+              << "  matrix sign function: " << timeSolves(1e-6, false) << " [ms]\n";
+    for (const scalar_t perturbation : {1e-6, 1e-4, 1e-2}) {
+      std::cerr << "  Newton-Kleinman, warm start with a perturbation of " << perturbation << ": " << timeSolves(perturbation, true)
+                << " [ms]\n";
+    }
+  }
+}
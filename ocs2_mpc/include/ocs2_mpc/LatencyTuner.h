@@ -0,0 +1,126 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <functional>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/MPC_Settings.h"
+
+namespace ocs2 {
+
+/**
+ * This class adapts the MPC problem size online such that a given percentile of the measured solve times stays below a target
+ * latency. It keeps a sliding window of the latest solve times and scales the problem by a multiplicative factor in
+ * [minScale, maxScale]: the scale shrinks when the percentile exceeds the target latency, and it grows back when there is enough
+ * slack. After each change, the statistics are restarted such that only the solve times of the new problem size are used.
+ *
+ * The scale is applied to the MPC time horizon through MPC_BASE::setTimeHorizon, which takes effect at the next MPC rewind. Therefore
+ * the solver's partitioning, mode schedule, and warm start stay consistent. Since the partitions of the old time horizon are only
+ * replaced gradually, the solve times are not collected after a change of the time horizon until the MPC has rewound and one more
+ * time horizon has passed. Only then the solved problems have the new size. Other resolution parameters, e.g. the time step of the
+ * multiple-shooting solver, can be scaled through the resolution callback. The number of MPC partitions is not adapted since it
+ * determines the layout of the solver's warm-start data.
+ */
+class LatencyTuner {
+ public:
+  /** Applies a new scale to the resolution parameters of the solver, e.g. dt = nominalDt / scale. */
+  using ResolutionCallback = std::function<void(scalar_t scale)>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] settings: The LatencyTuner settings.
+   * @param [in] mpc: The tuned MPC. The nominal time horizon is the one at construction.
+   * @param [in] resolutionCallback: Optional callback which is called with the new scale at each change.
+   */
+  LatencyTuner(mpc::LatencyTunerSettings settings, MPC_BASE& mpc, ResolutionCallback resolutionCallback = nullptr);
+
+  /** Resets the statistics, and restores the nominal time horizon and resolution. */
+  void reset();
+
+  /**
+   * Runs the MPC for the given state and time, and updates the statistics with the measured solve time.
+   *
+   * @param [in] currentTime: The given time.
+   * @param [in] currentState: The given state.
+   * @return The return value of MPC_BASE::run.
+   */
+  bool run(scalar_t currentTime, const vector_t& currentState);
+
+  /**
+   * Adds a solve time which is measured externally, e.g. including the observation and policy transmission. The solve time is
+   * discarded while a change of the time horizon is not fully active.
+   *
+   * @param [in] currentTime: The time of the MPC run.
+   * @param [in] solveTime: The solve time in seconds.
+   * @return Whether the scale has changed.
+   */
+  bool addSolveTime(scalar_t currentTime, scalar_t solveTime);
+
+  /** Gets the current scale of the time horizon and resolution relative to their nominal values. */
+  scalar_t getScale() const { return scale_; }
+
+  /** Gets the nominal time horizon. */
+  scalar_t getNominalTimeHorizon() const { return nominalTimeHorizon_; }
+
+  /** Gets the percentile of the solve times in the current window, or zero if there are no samples. */
+  scalar_t getSolveTimePercentile() const;
+
+  /** Gets the number of the solve times in the current window. */
+  size_t getNumSamples() const { return solveTimes_.size(); }
+
+  /** Whether the solve times are discarded since the last change of the time horizon is not fully active yet. */
+  bool isWaitingForTimeHorizon() const { return waitingForRewind_ || settlingTime_ > lastTime_; }
+
+ private:
+  void applyScale(scalar_t scale);
+
+  /** Whether the MPC problem has the size of the current scale at the given time. */
+  bool isSettled(scalar_t currentTime);
+
+  const mpc::LatencyTunerSettings settings_;
+  MPC_BASE& mpc_;
+  ResolutionCallback resolutionCallback_;
+  const scalar_t nominalTimeHorizon_;
+
+  scalar_t scale_;
+  std::deque<scalar_t> solveTimes_;
+
+  scalar_t requestedTimeHorizon_;
+  bool waitingForRewind_ = false;
+  scalar_t settlingTime_;
+  scalar_t lastTime_;
+};
+
+}  // namespace ocs2
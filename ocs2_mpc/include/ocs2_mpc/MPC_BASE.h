@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <string>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Benchmark.h>
 
@@ -67,6 +69,20 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Saves the warm-start state of the solver to a file. See SolverBase::saveWarmStart.
+   * @note saveWarmStart() must not be called while the solver is running.
+   */
+  void saveWarmStart(const std::string& fileName) const { getSolverPtr()->saveWarmStart(fileName); }
+
+  /**
+   * Loads a warm-start snapshot which is saved by saveWarmStart(), e.g. by the previous instance of a restarted process. The next call
+   * of run() is then treated as a warm-started run rather than an initial one, i.e. it uses the runtime settings and starts from the
+   * loaded solution. The current time of that call should be within the time horizon of the snapshot.
+   * @note loadWarmStart() must not be called while the solver is running.
+   */
+  void loadWarmStart(const std::string& fileName);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
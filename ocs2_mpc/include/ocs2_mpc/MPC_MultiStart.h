@@ -0,0 +1,140 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+namespace mpc {
+
+/** The initial guess of a candidate solver of MPC_MultiStart at each MPC cycle. */
+enum class InitialGuess {
+  /** Warm start from the best solution of the previous cycle, i.e. the shifted previous solution. */
+  BestSolution,
+  /** Cold start from the Initializer of the solver. The solver is reset before each cycle. */
+  Initializer,
+  /** Warm start from the previous solution of the candidate itself, e.g. a homotopy variant which is tracked over the cycles. */
+  OwnSolution,
+};
+
+}  // namespace mpc
+
+/**
+ * This is a multi-start MPC. At each MPC cycle, it runs several solver instances in parallel from different initial guesses and
+ * keeps the best result. A feasible solution, i.e. one whose constraint violation is below the tolerance, is preferred over an
+ * infeasible one. Among the feasible solutions the one with the smallest merit is selected, and among the infeasible ones the one
+ * with the smallest constraint violation. Ties are broken by the candidate order, therefore the selection is deterministic.
+ *
+ * The candidates share the ReferenceManager of MPC_MultiStart, which is updated once per cycle before the candidates run. Since the
+ * merits of the candidates are compared, they should solve the same optimal control problem. The alternative initial guesses, such
+ * as a mirrored gait, can be provided through the Initializer of a candidate or through its prepare function. The candidates with
+ * the BestSolution initial guess are warm started from the best solver through SolverBase::copyWarmStart, therefore they should be
+ * of the same type as all the other candidates.
+ */
+class MPC_MultiStart final : public MPC_BASE {
+ public:
+  /** Prepares a candidate before each MPC cycle, e.g. updates its homotopy parameter. It is called after the initial guess is set. */
+  using PrepareFunction = std::function<void(SolverBase& solver, scalar_t initTime, const vector_t& initState, scalar_t finalTime)>;
+
+  /** A candidate solver and its initial guess. */
+  struct Candidate {
+    std::unique_ptr<SolverBase> solverPtr;
+    mpc::InitialGuess initialGuess = mpc::InitialGuess::BestSolution;
+    /** Optional */
+    PrepareFunction prepare;
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] mpcSettings: Structure containing the settings for the MPC algorithm.
+   * @param [in] candidates: The candidate solvers. Each candidate runs on a separate thread.
+   * @param [in] constraintTolerance: The tolerance on the constraint violation for considering a solution as feasible.
+   * @param [in] threadPriority: The priority of the threads which run the candidates.
+   */
+  MPC_MultiStart(mpc::Settings mpcSettings, std::vector<Candidate> candidates, scalar_t constraintTolerance = 1e-3,
+                 int threadPriority = 50);
+
+  ~MPC_MultiStart() override = default;
+
+  void reset() override;
+
+  /** Gets the best solver of the last MPC cycle. */
+  SolverBase* getSolverPtr() override { return candidates_[bestCandidateIndex_].solverPtr.get(); }
+
+  /** Gets the best solver of the last MPC cycle. */
+  const SolverBase* getSolverPtr() const override { return candidates_[bestCandidateIndex_].solverPtr.get(); }
+
+  /** Sets the ReferenceManager which is shared by all the candidates. */
+  void setReferenceManager(std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr);
+
+  /** Gets the number of candidates. */
+  size_t getNumCandidates() const { return candidates_.size(); }
+
+  /** Gets the solver of a candidate. */
+  const SolverBase& getCandidateSolver(size_t index) const { return *candidates_[index].solverPtr; }
+
+  /** Gets the index of the best candidate of the last MPC cycle. */
+  size_t getBestCandidateIndex() const { return bestCandidateIndex_; }
+
+  /** Gets the performance indices of the candidates in the last MPC cycle. The failed candidates have an infinite merit. */
+  const std::vector<PerformanceIndex>& getCandidatePerformanceIndices() const { return candidatePerformanceIndices_; }
+
+ protected:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
+
+ private:
+  /** Sets the initial guess of the candidates, and rewinds the ones which are not rewound by MPC_BASE. */
+  void prepareCandidates(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  /** The sum of the constraint violations */
+  static scalar_t getConstraintViolation(const PerformanceIndex& performanceIndex);
+
+  /** Whether the solution with the performance index lhs is strictly better than the one with rhs. */
+  bool isBetter(const PerformanceIndex& lhs, const PerformanceIndex& rhs) const;
+
+  std::vector<Candidate> candidates_;
+  scalar_t constraintTolerance_;
+  std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
+  ThreadPool threadPool_;
+
+  size_t bestCandidateIndex_ = 0;
+  std::vector<PerformanceIndex> candidatePerformanceIndices_;
+  scalar_array_t lastPartitionTimes_;
+};
+
+}  // namespace ocs2
@@ -84,6 +84,15 @@ struct Settings {
    * set to a positive number which can be interpreted as the tracking controller's frequency.
    */
   scalar_t mrtDesiredFrequency_ = 100.0;
+
+  /**
+   * Compression of the feedback gains of a linear policy when it is handed to the MRT, see LinearController. If the stride is larger
+   * than one, the gains are only stored at every stride-th time stamp and interpolated in between. Otherwise, if the tolerance is not
+   * negative, consecutive gains which are identical up to the tolerance are stored once, which is lossless for a zero tolerance.
+   * The compression is disabled by default.
+   */
+  size_t gainCompressionStride_ = 0;
+  scalar_t gainCompressionTolerance_ = -1.0;
 };
 
 /**
@@ -96,5 +105,42 @@ struct Settings {
  */
 Settings loadSettings(const std::string& filename, const std::string& fieldName = "mpc", bool verbose = true);
 
+/**
+ * This structure holds the settings of the LatencyTuner which adapts the MPC time horizon and resolution to the measured solve time.
+ */
+struct LatencyTunerSettings {
+  /** The target solve time in seconds. */
+  scalar_t targetLatency_ = 0.01;
+  /** The percentile of the solve times, in (0, 1], which should stay below the target latency. */
+  scalar_t percentile_ = 0.9;
+  /** Number of the latest solve times which are used for the statistics. */
+  size_t windowSize_ = 50;
+  /** Minimum number of solve times which are measured after a change before the next change. */
+  size_t minNumSamples_ = 10;
+  /** The scale is multiplied by this factor when the percentile exceeds the target latency. */
+  scalar_t shrinkFactor_ = 0.8;
+  /** The scale is multiplied by this factor when the percentile is below slackRatio_ * targetLatency_. */
+  scalar_t growFactor_ = 1.1;
+  /** The ratio of the target latency below which there is slack for growing the scale. */
+  scalar_t slackRatio_ = 0.7;
+  /** The minimum scale of the time horizon and resolution relative to their nominal values. */
+  scalar_t minScale_ = 0.5;
+  /** The maximum scale of the time horizon and resolution relative to their nominal values. */
+  scalar_t maxScale_ = 1.0;
+  /** Whether the MPC time horizon is scaled. */
+  bool adaptTimeHorizon_ = true;
+};
+
+/**
+ * Loads the LatencyTuner settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The LatencyTuner settings
+ */
+LatencyTunerSettings loadLatencyTunerSettings(const std::string& filename, const std::string& fieldName = "latencyTuner",
+                                              bool verbose = true);
+
 }  // namespace mpc
 }  // namespace ocs2
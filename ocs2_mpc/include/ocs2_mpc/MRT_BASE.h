@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/ObjectPool.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
@@ -160,10 +161,35 @@ class MRT_BASE {
    */
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
+  /**
+   * Sets the compression of the feedback gains of the linear policies which are moved to the buffer. It is disabled by default.
+   *
+   * @param [in] stride: If larger than one, see LinearController::compressGainsStride().
+   * @param [in] tolerance: If not negative and the stride is not used, see LinearController::compressGainsRunLength().
+   */
+  void setGainCompression(size_t stride, scalar_t tolerance) {
+    gainCompressionStride_ = stride;
+    gainCompressionTolerance_ = tolerance;
+  }
+
  protected:
+  /**
+   * Moves a new policy to the buffer. The policy which is replaced in the buffer, i.e. either a policy that has never been swapped in
+   * or the policy that has been active before the last updatePolicy() call, is retired to the object pools. The feedback gains of a
+   * linear policy are compressed according to setGainCompression().
+   */
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
+  /**
+   * Gets a retired CommandData, PrimalSolution, or PerformanceIndex for the next moveToBuffer() call, or a new one if the pool is empty.
+   * The content of a retired object is stale, but overwriting it in place reuses its memory, e.g. the capacity of its trajectories and
+   * the storage of its controller. Therefore, in steady state the policy hand-off does not allocate on the heap.
+   */
+  std::unique_ptr<CommandData> acquireCommandData() { return commandPool_.acquire(); }
+  std::unique_ptr<PrimalSolution> acquirePrimalSolution() { return primalSolutionPool_.acquire(); }
+  std::unique_ptr<PerformanceIndex> acquirePerformanceIndex() { return performanceIndexPool_.acquire(); }
+
  private:
   /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
@@ -183,6 +209,11 @@ class MRT_BASE {
   std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
   std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
 
+  // retired policies
+  ObjectPool<CommandData> commandPool_;
+  ObjectPool<PrimalSolution> primalSolutionPool_;
+  ObjectPool<PerformanceIndex> performanceIndexPool_;
+
   // thread safety
   mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
   const size_t mrtTrylockWarningThreshold_ = 5;
@@ -190,8 +221,12 @@ class MRT_BASE {
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  int modeScheduleCursor_;  // the policy is evaluated at monotone times, see ModeSchedule::modeAtTime(time, cursor)
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
+
+  size_t gainCompressionStride_ = 0;
+  scalar_t gainCompressionTolerance_ = -1.0;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,181 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/LatencyTuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LatencyTuner::LatencyTuner(mpc::LatencyTunerSettings settings, MPC_BASE& mpc, ResolutionCallback resolutionCallback)
+    : settings_(std::move(settings)),
+      mpc_(mpc),
+      resolutionCallback_(std::move(resolutionCallback)),
+      nominalTimeHorizon_(mpc.getTimeHorizon()),
+      scale_(1.0),
+      requestedTimeHorizon_(nominalTimeHorizon_) {
+  if (settings_.targetLatency_ <= 0.0) {
+    throw std::runtime_error("[LatencyTuner] targetLatency should be positive!");
+  }
+  if (settings_.percentile_ <= 0.0 || settings_.percentile_ > 1.0) {
+    throw std::runtime_error("[LatencyTuner] percentile should be in (0, 1]!");
+  }
+  if (settings_.windowSize_ == 0 || settings_.minNumSamples_ == 0 || settings_.minNumSamples_ > settings_.windowSize_) {
+    throw std::runtime_error("[LatencyTuner] minNumSamples should be in [1, windowSize]!");
+  }
+  if (settings_.shrinkFactor_ <= 0.0 || settings_.shrinkFactor_ >= 1.0 || settings_.growFactor_ <= 1.0) {
+    throw std::runtime_error("[LatencyTuner] shrinkFactor should be in (0, 1) and growFactor should be larger than one!");
+  }
+  if (settings_.slackRatio_ <= 0.0 || settings_.slackRatio_ >= 1.0) {
+    throw std::runtime_error("[LatencyTuner] slackRatio should be in (0, 1)!");
+  }
+  if (settings_.minScale_ <= 0.0 || settings_.minScale_ > settings_.maxScale_) {
+    throw std::runtime_error("[LatencyTuner] minScale should be positive and not larger than maxScale!");
+  }
+
+  reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LatencyTuner::reset() {
+  solveTimes_.clear();
+  waitingForRewind_ = false;
+  settlingTime_ = -std::numeric_limits<scalar_t>::infinity();
+  lastTime_ = -std::numeric_limits<scalar_t>::infinity();
+  applyScale(std::min(std::max(1.0, settings_.minScale_), settings_.maxScale_));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LatencyTuner::run(scalar_t currentTime, const vector_t& currentState) {
+  const auto start = std::chrono::steady_clock::now();
+  const bool success = mpc_.run(currentTime, currentState);
+  const auto end = std::chrono::steady_clock::now();
+
+  // failed runs return early, therefore they do not represent the solve time of the problem
+  if (success) {
+    addSolveTime(currentTime, std::chrono::duration<scalar_t>(end - start).count());
+  }
+  return success;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LatencyTuner::addSolveTime(scalar_t currentTime, scalar_t solveTime) {
+  if (!isSettled(currentTime)) {
+    return false;
+  }
+
+  solveTimes_.push_back(solveTime);
+  if (solveTimes_.size() > settings_.windowSize_) {
+    solveTimes_.pop_front();
+  }
+
+  if (solveTimes_.size() < settings_.minNumSamples_) {
+    return false;
+  }
+
+  const scalar_t percentile = getSolveTimePercentile();
+  scalar_t newScale = scale_;
+  if (percentile > settings_.targetLatency_) {
+    newScale = std::max(scale_ * settings_.shrinkFactor_, settings_.minScale_);
+  } else if (percentile < settings_.slackRatio_ * settings_.targetLatency_) {
+    newScale = std::min(scale_ * settings_.growFactor_, settings_.maxScale_);
+  }
+
+  if (newScale == scale_) {
+    return false;
+  }
+
+  // restart the statistics for the new problem size
+  solveTimes_.clear();
+  applyScale(newScale);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LatencyTuner::getSolveTimePercentile() const {
+  if (solveTimes_.empty()) {
+    return 0.0;
+  }
+
+  std::vector<scalar_t> solveTimes(solveTimes_.begin(), solveTimes_.end());
+  const auto rank = static_cast<size_t>(std::ceil(settings_.percentile_ * solveTimes.size()));
+  const auto nth = solveTimes.begin() + (std::max<size_t>(rank, 1) - 1);
+  std::nth_element(solveTimes.begin(), nth, solveTimes.end());
+  return *nth;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LatencyTuner::isSettled(scalar_t currentTime) {
+  lastTime_ = currentTime;
+  if (waitingForRewind_) {
+    if (mpc_.getTimeHorizon() != requestedTimeHorizon_) {
+      return false;
+    }
+    // the MPC has rewound: the partitions of the old time horizon are replaced within one time horizon
+    waitingForRewind_ = false;
+    settlingTime_ = currentTime + requestedTimeHorizon_;
+  }
+  return currentTime >= settlingTime_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LatencyTuner::applyScale(scalar_t scale) {
+  scale_ = scale;
+  if (settings_.adaptTimeHorizon_) {
+    requestedTimeHorizon_ = scale_ * nominalTimeHorizon_;
+    mpc_.setTimeHorizon(requestedTimeHorizon_);
+    // a change which is reverted before the next rewind does not change the MPC problem
+    waitingForRewind_ = mpc_.getTimeHorizon() != requestedTimeHorizon_;
+  }
+  if (resolutionCallback_ != nullptr) {
+    resolutionCallback_(scale_);
+  }
+}
+
+}  // namespace ocs2
@@ -55,6 +55,28 @@ void MPC_BASE::reset() {
   getSolverPtr()->reset();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::loadWarmStart(const std::string& fileName) {
+  getSolverPtr()->loadWarmStart(fileName);
+
+  const auto& solverPartitionTimes = getSolverPtr()->getPartitioningTimes();
+  if (solverPartitionTimes.size() == partitionTimes_.size()) {
+    // the solver's internal variables are bound to the partitioning of the snapshot
+    partitionTimes_ = solverPartitionTimes;
+  } else {
+    // the solver does not use the MPC partitioning: place the partitions as the initial run would do for the snapshot
+    const scalar_t snapshotInitTime = getSolverPtr()->getFinalTime() - mpcSettings_.timeHorizon_;
+    const scalar_t deltaTime = snapshotInitTime - partitionTimes_[mpcSettings_.numPartitions_];
+    for (auto& t : partitionTimes_) {
+      t += deltaTime;
+    }
+  }
+
+  initRun_ = false;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -39,6 +39,7 @@ namespace ocs2 {
 /******************************************************************************************************/
 MPC_MRT_Interface::MPC_MRT_Interface(MPC_BASE& mpc) : mpc_(mpc) {
   mpcTimer_.reset();
+  setGainCompression(mpc_.settings().gainCompressionStride_, mpc_.settings().gainCompressionTolerance_);
 }
 
 /******************************************************************************************************/
@@ -117,19 +118,19 @@ void MPC_MRT_Interface::advanceMpc() {
 /******************************************************************************************************/
 void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
   // policy
-  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+  auto primalSolutionPtr = acquirePrimalSolution();
   const scalar_t startTime = mpcInitObservation.time;
   const scalar_t finalTime =
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
   mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
 
   // command
-  std::unique_ptr<CommandData> commandPtr(new CommandData);
+  auto commandPtr = acquireCommandData();
   commandPtr->mpcInitObservation_ = mpcInitObservation;
   commandPtr->mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
 
   // performance indices
-  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
+  auto performanceIndicesPtr = acquirePerformanceIndex();
   *performanceIndicesPtr = mpc_.getSolverPtr()->getPerformanceIndeces();
 
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
@@ -0,0 +1,221 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_MultiStart.h"
+
+#include <atomic>
+#include <exception>
+#include <limits>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/synchronized_module/ReferenceManagerDecorator.h>
+
+namespace ocs2 {
+
+namespace {
+/**
+ * The ReferenceManager of a candidate. It forwards to the shared ReferenceManager, except preSolverRun() which is called once per
+ * MPC cycle by MPC_MultiStart, such that the candidates running in parallel only read the references.
+ */
+class CandidateReferenceManager final : public ReferenceManagerDecorator {
+ public:
+  using ReferenceManagerDecorator::ReferenceManagerDecorator;
+  ~CandidateReferenceManager() override = default;
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) override {}
+};
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_MultiStart::MPC_MultiStart(mpc::Settings mpcSettings, std::vector<Candidate> candidates, scalar_t constraintTolerance,
+                               int threadPriority)
+    : MPC_BASE(std::move(mpcSettings)),
+      candidates_(std::move(candidates)),
+      constraintTolerance_(constraintTolerance),
+      threadPool_(std::max(candidates_.size(), size_t(1)) - 1, threadPriority) {
+  if (candidates_.empty()) {
+    throw std::runtime_error("[MPC_MultiStart] There should be at least one candidate.");
+  }
+  for (const auto& candidate : candidates_) {
+    if (candidate.solverPtr == nullptr) {
+      throw std::runtime_error("[MPC_MultiStart] The solver of a candidate cannot be a nullptr!");
+    }
+  }
+
+  candidatePerformanceIndices_.resize(candidates_.size());
+  setReferenceManager(std::make_shared<ReferenceManager>());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::reset() {
+  MPC_BASE::reset();
+  for (size_t i = 0; i < candidates_.size(); i++) {
+    if (i != bestCandidateIndex_) {
+      candidates_[i].solverPtr->reset();
+    }
+  }
+  bestCandidateIndex_ = 0;
+  candidatePerformanceIndices_.assign(candidates_.size(), PerformanceIndex());
+  lastPartitionTimes_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::setReferenceManager(std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr) {
+  if (referenceManagerPtr == nullptr) {
+    throw std::runtime_error("[MPC_MultiStart] ReferenceManager pointer cannot be a nullptr!");
+  }
+  referenceManagerPtr_ = std::move(referenceManagerPtr);
+  for (auto& candidate : candidates_) {
+    candidate.solverPtr->setReferenceManager(std::make_shared<CandidateReferenceManager>(referenceManagerPtr_));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::prepareCandidates(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  // MPC_BASE only rewinds the best solver of the previous cycle
+  const bool isRewound = !lastPartitionTimes_.empty() && partitionTimes_.front() != lastPartitionTimes_.front();
+
+  const auto& bestSolver = *candidates_[bestCandidateIndex_].solverPtr;
+  for (size_t i = 0; i < candidates_.size(); i++) {
+    auto& candidate = candidates_[i];
+    if (!initRun_) {
+      switch (candidate.initialGuess) {
+        case mpc::InitialGuess::BestSolution:
+          if (i != bestCandidateIndex_) {
+            candidate.solverPtr->copyWarmStart(bestSolver);
+          }
+          break;
+        case mpc::InitialGuess::Initializer:
+          candidate.solverPtr->reset();
+          break;
+        case mpc::InitialGuess::OwnSolution:
+          if (isRewound && i != bestCandidateIndex_) {
+            candidate.solverPtr->rewindOptimizer(settings().numPartitions_);
+          }
+          break;
+      }
+    }
+
+    if (candidate.prepare) {
+      candidate.prepare(*candidate.solverPtr, initTime, initState, finalTime);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  // the candidates only read the shared references
+  referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
+  prepareCandidates(initTime, initState, finalTime);
+
+  // run the candidates in parallel
+  std::vector<std::exception_ptr> exceptions(candidates_.size());
+  std::atomic_size_t nextCandidateIndex{0};
+  auto task = [&](int) {
+    size_t i;
+    while ((i = nextCandidateIndex++) < candidates_.size()) {
+      auto& solver = *candidates_[i].solverPtr;
+      try {
+        if (initRun_ || candidates_[i].initialGuess == mpc::InitialGuess::Initializer) {
+          solver.run(initTime, initState, finalTime, partitionTimes_);
+        } else {
+          solver.run(initTime, initState, finalTime, partitionTimes_, std::vector<ControllerBase*>());
+        }
+        candidatePerformanceIndices_[i] = solver.getPerformanceIndeces();
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+        candidatePerformanceIndices_[i] = PerformanceIndex();
+        candidatePerformanceIndices_[i].merit = std::numeric_limits<scalar_t>::infinity();
+      }
+    }
+  };
+  threadPool_.runParallel(std::move(task), candidates_.size());
+
+  // select the best candidate
+  const size_t numCandidates = candidates_.size();
+  size_t bestCandidateIndex = numCandidates;
+  for (size_t i = 0; i < numCandidates; i++) {
+    if (exceptions[i] != nullptr) {
+      continue;
+    }
+    const auto& performanceIndex = candidatePerformanceIndices_[i];
+    if (bestCandidateIndex == numCandidates || isBetter(performanceIndex, candidatePerformanceIndices_[bestCandidateIndex])) {
+      bestCandidateIndex = i;
+    }
+  }
+  if (bestCandidateIndex == numCandidates) {
+    std::rethrow_exception(exceptions.front());
+  }
+
+  bestCandidateIndex_ = bestCandidateIndex;
+  lastPartitionTimes_ = partitionTimes_;
+
+  if (settings().debugPrint_) {
+    std::cerr << "\n### MPC_MultiStart: candidate " << bestCandidateIndex_ << " is selected among " << candidates_.size()
+              << " candidates.\n";
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t MPC_MultiStart::getConstraintViolation(const PerformanceIndex& performanceIndex) {
+  return performanceIndex.stateEqConstraintISE + performanceIndex.stateEqFinalConstraintSSE +
+         performanceIndex.stateInputEqConstraintISE + performanceIndex.inequalityConstraintISE;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_MultiStart::isBetter(const PerformanceIndex& lhs, const PerformanceIndex& rhs) const {
+  const scalar_t lhsViolation = getConstraintViolation(lhs);
+  const scalar_t rhsViolation = getConstraintViolation(rhs);
+  const bool lhsFeasible = lhsViolation <= constraintTolerance_;
+  const bool rhsFeasible = rhsViolation <= constraintTolerance_;
+
+  if (lhsFeasible != rhsFeasible) {
+    return lhsFeasible;
+  } else if (lhsFeasible) {
+    return lhs.merit < rhs.merit;
+  } else {
+    return lhsViolation < rhsViolation;
+  }
+}
+
+}  // namespace ocs2
@@ -67,6 +67,38 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.mpcDesiredFrequency_, fieldName + ".mpcDesiredFrequency", verbose);
   loadData::loadPtreeValue(pt, settings.mrtDesiredFrequency_, fieldName + ".mrtDesiredFrequency", verbose);
 
+  loadData::loadPtreeValue(pt, settings.gainCompressionStride_, fieldName + ".gainCompressionStride", verbose);
+  loadData::loadPtreeValue(pt, settings.gainCompressionTolerance_, fieldName + ".gainCompressionTolerance", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return settings;
+}
+
+LatencyTunerSettings loadLatencyTunerSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+
+  LatencyTunerSettings settings;
+
+  if (verbose) {
+    std::cerr << "\n #### MPC Latency Tuner Settings:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  loadData::loadPtreeValue(pt, settings.targetLatency_, fieldName + ".targetLatency", verbose);
+  loadData::loadPtreeValue(pt, settings.percentile_, fieldName + ".percentile", verbose);
+  loadData::loadPtreeValue(pt, settings.windowSize_, fieldName + ".windowSize", verbose);
+  loadData::loadPtreeValue(pt, settings.minNumSamples_, fieldName + ".minNumSamples", verbose);
+  loadData::loadPtreeValue(pt, settings.shrinkFactor_, fieldName + ".shrinkFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.growFactor_, fieldName + ".growFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.slackRatio_, fieldName + ".slackRatio", verbose);
+  loadData::loadPtreeValue(pt, settings.minScale_, fieldName + ".minScale", verbose);
+  loadData::loadPtreeValue(pt, settings.maxScale_, fieldName + ".maxScale", verbose);
+  loadData::loadPtreeValue(pt, settings.adaptTimeHorizon_, fieldName + ".adaptTimeHorizon", verbose);
+
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
   }
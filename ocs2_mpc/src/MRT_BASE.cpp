@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MRT_BASE.h"
 
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
 namespace ocs2 {
@@ -49,6 +50,7 @@ void MRT_BASE::reset() {
   policyReceivedEver_ = false;
   newPolicyInBuffer_ = false;
   mrtTrylockWarningCount_ = 0;
+  modeScheduleCursor_ = 0;
 
   activeCommandPtr_.reset();
   bufferCommandPtr_.reset();
@@ -115,7 +117,7 @@ void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState
   mpcState =
       LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime, modeScheduleCursor_);
 }
 
 /******************************************************************************************************/
@@ -148,7 +150,7 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime, modeScheduleCursor_);
 }
 
 /******************************************************************************************************/
@@ -197,17 +199,33 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
-  std::lock_guard<std::mutex> lk(bufferMutex_);
-  // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  // compress the feedback gains before taking the lock
+  if (auto* linearControllerPtr = dynamic_cast<LinearController*>(primalSolutionPtr->controllerPtr_.get())) {
+    if (gainCompressionStride_ > 1) {
+      linearControllerPtr->compressGainsStride(gainCompressionStride_);
+    } else if (gainCompressionTolerance_ >= 0.0) {
+      linearControllerPtr->compressGainsRunLength(gainCompressionTolerance_);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(bufferMutex_);
+    // use swap such that the old objects are retired after releasing the lock.
+    bufferCommandPtr_.swap(commandDataPtr);
+    bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
+    bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
 
-  // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+    // allow user to modify the buffer
+    modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+
+    newPolicyInBuffer_ = true;
+    policyReceivedEver_ = true;
+  }
 
-  newPolicyInBuffer_ = true;
-  policyReceivedEver_ = true;
+  // recycle the old objects
+  commandPool_.release(std::move(commandDataPtr));
+  primalSolutionPool_.release(std::move(primalSolutionPtr));
+  performanceIndexPool_.release(std::move(performanceIndicesPtr));
 }
 
 /******************************************************************************************************/
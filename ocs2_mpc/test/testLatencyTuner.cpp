@@ -0,0 +1,314 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <limits>
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include "ocs2_mpc/LatencyTuner.h"
+#include "ocs2_mpc/MPC_DDP.h"
+
+using namespace ocs2;
+
+namespace {
+/** The CPU time of the calling thread in seconds, which is not affected by the other processes on the machine. */
+scalar_t threadCpuTime() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<scalar_t>(ts.tv_sec) + 1e-9 * static_cast<scalar_t>(ts.tv_nsec);
+}
+}  // unnamed namespace
+
+/** An MPC_DDP of decoupled double integrators which is tuned by a LatencyTuner. */
+class LatencyTunerTest : public testing::Test {
+ protected:
+  LatencyTunerTest() {
+    setupProblem(1);
+
+    mpcSettings.timeHorizon_ = 1.0;
+    mpcSettings.numPartitions_ = 1;
+
+    ddpSettings.algorithm_ = ddp::Algorithm::SLQ;
+    ddpSettings.nThreads_ = 1;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.timeStep_ = 0.01;
+
+    mpcPtr = createMpc();
+
+    tunerSettings.targetLatency_ = 0.01;
+    tunerSettings.percentile_ = 0.9;
+    tunerSettings.windowSize_ = 20;
+    tunerSettings.minNumSamples_ = 10;
+    tunerSettings.shrinkFactor_ = 0.8;
+    tunerSettings.growFactor_ = 1.1;
+    tunerSettings.slackRatio_ = 0.7;
+    tunerSettings.minScale_ = 0.5;
+    tunerSettings.maxScale_ = 1.0;
+  }
+
+  /** Sets up the problem of the given number of decoupled double integrators. */
+  void setupProblem(size_t numIntegrators) {
+    stateDim = 2 * numIntegrators;
+    inputDim = numIntegrators;
+    matrix_t A = matrix_t::Zero(stateDim, stateDim);
+    matrix_t B = matrix_t::Zero(stateDim, inputDim);
+    for (size_t i = 0; i < numIntegrators; i++) {
+      A(2 * i, 2 * i + 1) = 1.0;
+      B(2 * i + 1, i) = 1.0;
+    }
+    problem = OptimalControlProblem();
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(A, B));
+    problem.costPtr->add("cost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(
+                                     matrix_t::Identity(stateDim, stateDim), 0.1 * matrix_t::Identity(inputDim, inputDim))));
+    problem.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(matrix_t::Identity(stateDim, stateDim))));
+    rolloutPtr.reset(new TimeTriggeredRollout(*problem.dynamicsPtr));
+  }
+
+  std::unique_ptr<MPC_DDP> createMpc() const {
+    std::unique_ptr<MPC_DDP> mpcPtr(new MPC_DDP(mpcSettings, ddpSettings, *rolloutPtr, problem, DefaultInitializer(inputDim)));
+    const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(stateDim)}, {vector_t::Zero(inputDim)});
+    mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<ReferenceManager>(targetTrajectories));
+    return mpcPtr;
+  }
+
+  size_t stateDim;
+  size_t inputDim;
+  OptimalControlProblem problem;
+  std::unique_ptr<RolloutBase> rolloutPtr;
+  mpc::Settings mpcSettings;
+  ddp::Settings ddpSettings;
+  std::unique_ptr<MPC_DDP> mpcPtr;
+  mpc::LatencyTunerSettings tunerSettings;
+};
+
+TEST_F(LatencyTunerTest, shrinkAndGrow) {
+  // the statistics only: the MPC does not run, therefore the time horizon would never become active
+  tunerSettings.adaptTimeHorizon_ = false;
+  scalar_t resolutionScale = 0.0;
+  LatencyTuner tuner(tunerSettings, *mpcPtr, [&](scalar_t scale) { resolutionScale = scale; });
+  EXPECT_DOUBLE_EQ(tuner.getScale(), 1.0);
+  EXPECT_DOUBLE_EQ(resolutionScale, 1.0);
+
+  // 10% of the samples above the target latency: the 90th percentile is still within the target
+  for (size_t i = 0; i < tunerSettings.minNumSamples_; i++) {
+    EXPECT_FALSE(tuner.addSolveTime(0.0, i == 0 ? 0.1 : 0.009));
+  }
+  EXPECT_DOUBLE_EQ(tuner.getSolveTimePercentile(), 0.009);
+  EXPECT_DOUBLE_EQ(tuner.getScale(), 1.0);
+
+  // 20% of the samples above the target latency
+  EXPECT_TRUE(tuner.addSolveTime(0.0, 0.1));
+  EXPECT_DOUBLE_EQ(tuner.getScale(), 0.8);
+  EXPECT_DOUBLE_EQ(resolutionScale, 0.8);
+  EXPECT_EQ(tuner.getNumSamples(), 0);
+
+  // shrinks down to minScale
+  for (size_t i = 0; i < 10 * tunerSettings.minNumSamples_; i++) {
+    tuner.addSolveTime(0.0, 0.1);
+  }
+  EXPECT_DOUBLE_EQ(tuner.getScale(), tunerSettings.minScale_);
+
+  // no change within the slack band
+  for (size_t i = 0; i < tunerSettings.windowSize_; i++) {
+    EXPECT_FALSE(tuner.addSolveTime(0.0, 0.008));
+  }
+
+  // grows back up to maxScale
+  for (size_t i = 0; i < 10 * tunerSettings.minNumSamples_; i++) {
+    tuner.addSolveTime(0.0, 0.001);
+  }
+  EXPECT_DOUBLE_EQ(tuner.getScale(), tunerSettings.maxScale_);
+
+  tuner.addSolveTime(0.0, 0.1);
+  tuner.reset();
+  EXPECT_EQ(tuner.getNumSamples(), 0);
+  EXPECT_DOUBLE_EQ(tuner.getScale(), 1.0);
+}
+
+TEST_F(LatencyTunerTest, invalidSettings) {
+  auto settings = tunerSettings;
+  settings.minNumSamples_ = settings.windowSize_ + 1;
+  EXPECT_THROW(LatencyTuner(settings, *mpcPtr), std::runtime_error);
+
+  settings = tunerSettings;
+  settings.minScale_ = 2.0 * settings.maxScale_;
+  EXPECT_THROW(LatencyTuner(settings, *mpcPtr), std::runtime_error);
+}
+
+TEST_F(LatencyTunerTest, timeHorizonAtRewind) {
+  // an unreachable target latency: the time horizon shrinks to its minimum
+  tunerSettings.targetLatency_ = 1e-9;
+  tunerSettings.windowSize_ = 2;
+  tunerSettings.minNumSamples_ = 2;
+  LatencyTuner tuner(tunerSettings, *mpcPtr);
+  const scalar_t nominalTimeHorizon = tuner.getNominalTimeHorizon();
+
+  const scalar_t dt = 0.05;
+  scalar_t time = 0.0;
+  vector_t state = vector_t::Ones(stateDim);
+  scalar_t scale = tuner.getScale();
+  bool waitingForRewind = false;
+  scalar_t activationTime = -std::numeric_limits<scalar_t>::infinity();
+  size_t numChanges = 0;
+  for (size_t cycle = 0; cycle < 300; cycle++) {
+    ASSERT_TRUE(tuner.run(time, state));
+
+    // the time horizon is activated at a rewind, and the partitions of the previous time horizon are replaced within one time horizon
+    const scalar_t timeHorizon = tuner.getScale() * nominalTimeHorizon;
+    if (tuner.getScale() != scale) {
+      scale = tuner.getScale();
+      waitingForRewind = true;
+      numChanges++;
+    } else if (waitingForRewind && mpcPtr->getTimeHorizon() == timeHorizon) {
+      waitingForRewind = false;
+      activationTime = time;
+    }
+    const bool waiting = waitingForRewind || time < activationTime + timeHorizon;
+    EXPECT_EQ(tuner.isWaitingForTimeHorizon(), waiting) << "time: " << time;
+    if (waiting) {
+      EXPECT_EQ(tuner.getNumSamples(), 0) << "time: " << time;
+    }
+
+    const scalar_t solutionHorizon = mpcPtr->getSolverPtr()->getFinalTime() - time;
+    EXPECT_GT(solutionHorizon, 0.0);
+    EXPECT_LE(solutionHorizon, nominalTimeHorizon + 1e-6);
+    if (!waiting) {
+      EXPECT_NEAR(solutionHorizon, timeHorizon, 1e-6) << "time: " << time;
+    }
+
+    const auto primalSolution = mpcPtr->getSolverPtr()->primalSolution(mpcPtr->getSolverPtr()->getFinalTime());
+
+    time += dt;
+    state = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+  }
+
+  // 1.0 -> 0.8 -> 0.64 -> 0.512 -> 0.5
+  EXPECT_EQ(numChanges, 4);
+  EXPECT_DOUBLE_EQ(tuner.getScale(), tunerSettings.minScale_);
+  EXPECT_DOUBLE_EQ(mpcPtr->getTimeHorizon(), tunerSettings.minScale_ * nominalTimeHorizon);
+  EXPECT_FALSE(tuner.isWaitingForTimeHorizon());
+  EXPECT_LT(state.norm(), 0.5);
+}
+
+/**
+ * An MPC loop of the real solver, ILQR with one iteration per MPC cycle, whose measured solve times are stretched by a load factor
+ * which triples in the middle of the run, e.g. due to other processes on the same CPU. The solve times are measured in the CPU time of
+ * the thread to keep the rest of the machine's load out of the comparison. The target latency is calibrated from the solve times of
+ * the nominal problem. The adaptive scale is compared against the fixed nominal and the fixed minimum scale.
+ */
+TEST_F(LatencyTunerTest, simulatedLoadBenchmark) {
+  // a fixed-step rollout such that the problem size is proportional to the time horizon
+  setupProblem(4);
+  rollout::Settings rolloutSettings;
+  rolloutSettings.integratorType = IntegratorType::RK4;
+  rolloutSettings.timeStep = 0.004;
+  rolloutPtr.reset(new TimeTriggeredRollout(*problem.dynamicsPtr, rolloutSettings));
+  ddpSettings.algorithm_ = ddp::Algorithm::ILQR;
+  mpcSettings.runtimeMaxNumIterations_ = 1;
+  const scalar_t dt = 0.1;
+  const size_t numCycles = 600;
+  auto loadFactor = [&](size_t cycle) { return (cycle >= numCycles / 3 && cycle < 2 * numCycles / 3) ? 3.0 : 1.0; };
+  tunerSettings.minScale_ = 0.3;
+
+  // the solve times, the deadline misses, and the mean scale of an MPC loop
+  struct LoopStatistics {
+    std::vector<scalar_t> solveTimes;
+    scalar_t deadlineMisses = 0.0;
+    scalar_t meanScale = 0.0;
+  };
+  auto runLoop = [&](const mpc::LatencyTunerSettings& settings, size_t numLoopCycles) {
+    mpcPtr = createMpc();
+    LatencyTuner tuner(settings, *mpcPtr);
+
+    LoopStatistics statistics;
+    scalar_t time = 0.0;
+    vector_t state = vector_t::Ones(stateDim);
+    for (size_t cycle = 0; cycle < numLoopCycles; cycle++) {
+      const scalar_t scale = tuner.getScale();
+      const scalar_t start = threadCpuTime();
+      mpcPtr->run(time, state);
+      const scalar_t solveTime = loadFactor(cycle) * (threadCpuTime() - start);
+      tuner.addSolveTime(time, solveTime);
+
+      statistics.solveTimes.push_back(solveTime);
+      if (solveTime > settings.targetLatency_) {
+        statistics.deadlineMisses += 1.0 / numLoopCycles;
+      }
+      statistics.meanScale += scale / numLoopCycles;
+
+      // a periodic disturbance such that the solver does not settle at the origin
+      const auto primalSolution = mpcPtr->getSolverPtr()->primalSolution(mpcPtr->getSolverPtr()->getFinalTime());
+      time += dt;
+      state = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+      state(1) += 0.2 * std::sin(time);
+    }
+    return statistics;
+  };
+
+  // calibrate the target latency from the median of the unloaded solve times of the nominal problem
+  auto fixedSettings = tunerSettings;
+  fixedSettings.targetLatency_ = std::numeric_limits<scalar_t>::max();
+  fixedSettings.minScale_ = fixedSettings.maxScale_ = 1.0;
+  auto calibration = runLoop(fixedSettings, numCycles / 3).solveTimes;
+  const auto median = calibration.begin() + calibration.size() / 2;
+  std::nth_element(calibration.begin(), median, calibration.end());
+  tunerSettings.targetLatency_ = 1.5 * (*median);
+  fixedSettings.targetLatency_ = tunerSettings.targetLatency_;
+
+  const auto nominal = runLoop(fixedSettings, numCycles);
+  fixedSettings.minScale_ = fixedSettings.maxScale_ = tunerSettings.minScale_;
+  const auto minimum = runLoop(fixedSettings, numCycles);
+  const auto adaptive = runLoop(tunerSettings, numCycles);
+
+  std::cerr << "[simulatedLoadBenchmark] target latency: " << 1e3 * tunerSettings.targetLatency_ << " [ms], 3x load in the middle third\n"
+            << "  fixed nominal scale: deadline misses: " << 100.0 * nominal.deadlineMisses << " [%], mean scale: " << nominal.meanScale
+            << "\n"
+            << "  fixed minimum scale: deadline misses: " << 100.0 * minimum.deadlineMisses << " [%], mean scale: " << minimum.meanScale
+            << "\n"
+            << "  adaptive scale:      deadline misses: " << 100.0 * adaptive.deadlineMisses << " [%], mean scale: " << adaptive.meanScale
+            << "\n";
+
+  EXPECT_GT(nominal.deadlineMisses, 0.15);
+  EXPECT_LT(adaptive.deadlineMisses, 0.5 * nominal.deadlineMisses);
+  EXPECT_GT(adaptive.meanScale, minimum.meanScale);
+  EXPECT_LT(adaptive.meanScale, nominal.meanScale);
+}
@@ -0,0 +1,273 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include "ocs2_mpc/MPC_DDP.h"
+#include "ocs2_mpc/MPC_MultiStart.h"
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t STATE_DIM = 4;
+constexpr size_t INPUT_DIM = 2;
+
+/** Gaussian penalty of a circular obstacle at the origin of the position plane. */
+class ObstacleCost final : public StateCost {
+ public:
+  ObstacleCost(scalar_t weight, scalar_t radius) : weight_(weight), radius_(radius) {}
+  ~ObstacleCost() override = default;
+  ObstacleCost* clone() const override { return new ObstacleCost(*this); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories&, const PreComputation&) const override {
+    return weight_ * std::exp(-0.5 * state.head<2>().squaredNorm() / (radius_ * radius_));
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories&,
+                                                                 const PreComputation&) const override {
+    const vector_t position = state.head<2>();
+    const scalar_t invRadiusSquared = 1.0 / (radius_ * radius_);
+    ScalarFunctionQuadraticApproximation approximation = ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, 0);
+    approximation.f = weight_ * std::exp(-0.5 * position.squaredNorm() * invRadiusSquared);
+    approximation.dfdx.head<2>() = -approximation.f * invRadiusSquared * position;
+    approximation.dfdxx.topLeftCorner<2, 2>() =
+        approximation.f * invRadiusSquared * (invRadiusSquared * position * position.transpose() - matrix_t::Identity(2, 2));
+    return approximation;
+  }
+
+ private:
+  scalar_t weight_;
+  scalar_t radius_;
+};
+
+/** Applies a constant input, e.g. to pass the obstacle on one side. */
+class ConstantInputInitializer final : public Initializer {
+ public:
+  explicit ConstantInputInitializer(vector_t input) : input_(std::move(input)) {}
+  ~ConstantInputInitializer() override = default;
+  ConstantInputInitializer* clone() const override { return new ConstantInputInitializer(*this); }
+
+  void compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input, vector_t& nextState) override {
+    input = input_;
+    nextState = state;
+  }
+
+ private:
+  vector_t input_;
+};
+
+}  // unnamed namespace
+
+/**
+ * A point mass in the plane moves to a target on the other side of an obstacle. The problem is symmetric, therefore a DDP started from
+ * zero inputs keeps its straight path through the obstacle. The candidates which are initialized with a lateral input pass it.
+ */
+class MPC_MultiStartTest : public testing::Test {
+ protected:
+  MPC_MultiStartTest() {
+    // double integrator
+    matrix_t A = matrix_t::Zero(STATE_DIM, STATE_DIM);
+    A.topRightCorner<2, 2>().setIdentity();
+    matrix_t B = matrix_t::Zero(STATE_DIM, INPUT_DIM);
+    B.bottomRows<2>().setIdentity();
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(A, B));
+
+    problem.costPtr->add("tracking", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(
+                                         0.1 * matrix_t::Identity(STATE_DIM, STATE_DIM), 0.1 * matrix_t::Identity(INPUT_DIM, INPUT_DIM))));
+    problem.stateCostPtr->add("obstacle", std::unique_ptr<StateCost>(new ObstacleCost(10.0, 0.3)));
+    problem.finalCostPtr->add("final", std::unique_ptr<StateCost>(new QuadraticStateCost(10.0 * matrix_t::Identity(STATE_DIM, STATE_DIM))));
+
+    rolloutPtr.reset(new TimeTriggeredRollout(*problem.dynamicsPtr));
+
+    mpcSettings.timeHorizon_ = 2.0;
+    mpcSettings.numPartitions_ = 1;
+    mpcSettings.initMaxNumIterations_ = 20;
+    mpcSettings.runtimeMaxNumIterations_ = 5;
+
+    ddpSettings.algorithm_ = ddp::Algorithm::SLQ;
+    ddpSettings.nThreads_ = 1;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.checkNumericalStability_ = false;
+    ddpSettings.maxNumIterations_ = 20;
+    ddpSettings.minRelCost_ = 1e-4;
+    ddpSettings.timeStep_ = 0.02;
+    ddpSettings.lineSearch_.hessianCorrectionStrategy_ = hessian_correction::Strategy::EIGENVALUE_MODIFICATION;
+    ddpSettings.lineSearch_.hessianCorrectionMultiple_ = 1e-3;
+
+    targetTrajectories = TargetTrajectories({0.0}, {targetState}, {vector_t::Zero(INPUT_DIM)});
+  }
+
+  std::unique_ptr<SolverBase> getSolver(const Initializer& initializer) const {
+    return std::unique_ptr<SolverBase>(new SLQ(ddpSettings, *rolloutPtr, problem, initializer));
+  }
+
+  /** Multi-start MPC with the shifted previous solution and a candidate for each side of the obstacle. */
+  std::unique_ptr<MPC_MultiStart> getMultiStartMpc() const {
+    const vector_t upInput = (vector_t(INPUT_DIM) << 0.0, 1.0).finished();
+    std::vector<MPC_MultiStart::Candidate> candidates(3);
+    candidates[0].solverPtr = getSolver(DefaultInitializer(INPUT_DIM));
+    candidates[0].initialGuess = mpc::InitialGuess::BestSolution;
+    candidates[1].solverPtr = getSolver(ConstantInputInitializer(upInput));
+    candidates[1].initialGuess = mpc::InitialGuess::Initializer;
+    candidates[2].solverPtr = getSolver(ConstantInputInitializer(-upInput));
+    candidates[2].initialGuess = mpc::InitialGuess::Initializer;
+
+    std::unique_ptr<MPC_MultiStart> mpcPtr(new MPC_MultiStart(mpcSettings, std::move(candidates)));
+    mpcPtr->getSolverPtr()->getReferenceManager().setTargetTrajectories(targetTrajectories);
+    return mpcPtr;
+  }
+
+  std::unique_ptr<MPC_DDP> getSingleStartMpc() const {
+    std::unique_ptr<MPC_DDP> mpcPtr(new MPC_DDP(mpcSettings, ddpSettings, *rolloutPtr, problem, DefaultInitializer(INPUT_DIM)));
+    mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<ReferenceManager>(targetTrajectories));
+    return mpcPtr;
+  }
+
+  /** Closed-loop cost of an MPC loop with a perfect model, and the average latency of the MPC in [ms] */
+  std::pair<scalar_t, scalar_t> runMpcLoop(MPC_BASE& mpc, std::vector<size_t>* bestCandidateIndices = nullptr) {
+    const scalar_t dt = 0.05;
+    const auto& tracking = problem.costPtr->get("tracking");
+    const auto& obstacle = problem.stateCostPtr->get("obstacle");
+
+    scalar_t time = 0.0;
+    vector_t state = initState;
+    scalar_t closedLoopCost = 0.0;
+    scalar_t totalLatency = 0.0;
+    for (size_t cycle = 0; cycle < numCycles; cycle++) {
+      const auto start = std::chrono::steady_clock::now();
+      mpc.run(time, state);
+      totalLatency += std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - start).count();
+      if (bestCandidateIndices != nullptr) {
+        bestCandidateIndices->push_back(dynamic_cast<MPC_MultiStart&>(mpc).getBestCandidateIndex());
+      }
+
+      const auto primalSolution = mpc.getSolverPtr()->primalSolution(time + mpcSettings.timeHorizon_);
+      const vector_t input = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.inputTrajectory_);
+      closedLoopCost += dt * (tracking.getValue(time, state, input, targetTrajectories, PreComputation()) +
+                              obstacle.getValue(time, state, targetTrajectories, PreComputation()));
+
+      // advance along the optimal trajectory
+      time += dt;
+      state = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+    }
+    return {closedLoopCost, totalLatency / numCycles};
+  }
+
+  static constexpr size_t numCycles = 20;
+  const vector_t initState = (vector_t(STATE_DIM) << -1.0, 0.0, 0.0, 0.0).finished();
+  const vector_t targetState = (vector_t(STATE_DIM) << 1.0, 0.0, 0.0, 0.0).finished();
+
+  OptimalControlProblem problem;
+  std::unique_ptr<TimeTriggeredRollout> rolloutPtr;
+  TargetTrajectories targetTrajectories;
+  mpc::Settings mpcSettings;
+  ddp::Settings ddpSettings;
+};
+
+constexpr size_t MPC_MultiStartTest::numCycles;
+
+TEST_F(MPC_MultiStartTest, selection) {
+  auto mpcPtr = getMultiStartMpc();
+  mpcPtr->run(0.0, initState);
+
+  // the zero-input candidate goes through the obstacle, and the two sides have the same merit by symmetry
+  const auto& performanceIndices = mpcPtr->getCandidatePerformanceIndices();
+  ASSERT_EQ(performanceIndices.size(), 3);
+  EXPECT_GT(performanceIndices[0].merit, performanceIndices[1].merit);
+  EXPECT_NEAR(performanceIndices[1].merit, performanceIndices[2].merit, 1e-6 * performanceIndices[1].merit);
+  EXPECT_EQ(mpcPtr->getBestCandidateIndex(), performanceIndices[1].merit <= performanceIndices[2].merit ? 1 : 2);
+  EXPECT_EQ(mpcPtr->getSolverPtr(), &mpcPtr->getCandidateSolver(mpcPtr->getBestCandidateIndex()));
+
+  auto getMaxLateralDistance = [](const PrimalSolution& primalSolution) {
+    scalar_t maxLateralDistance = 0.0;
+    for (const auto& state : primalSolution.stateTrajectory_) {
+      maxLateralDistance = std::max(maxLateralDistance, std::abs(state(1)));
+    }
+    return maxLateralDistance;
+  };
+
+  // the selected solution passes the obstacle
+  const scalar_t finalTime = mpcSettings.timeHorizon_;
+  const auto primalSolution = mpcPtr->getSolverPtr()->primalSolution(finalTime);
+  EXPECT_GT(getMaxLateralDistance(primalSolution), 0.1);
+  EXPECT_LT(getMaxLateralDistance(mpcPtr->getCandidateSolver(0).primalSolution(finalTime)), 1e-9);
+
+  // in the next cycle, the shifted previous solution continues from the best solution
+  mpcPtr->run(0.05, LinearInterpolation::interpolate(0.05, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_));
+  EXPECT_GT(getMaxLateralDistance(mpcPtr->getCandidateSolver(0).primalSolution(finalTime)), 0.1);
+}
+
+TEST_F(MPC_MultiStartTest, deterministic) {
+  std::vector<size_t> bestCandidateIndices1, bestCandidateIndices2;
+  auto mpcPtr1 = getMultiStartMpc();
+  auto mpcPtr2 = getMultiStartMpc();
+  const auto result1 = runMpcLoop(*mpcPtr1, &bestCandidateIndices1);
+  const auto result2 = runMpcLoop(*mpcPtr2, &bestCandidateIndices2);
+  EXPECT_EQ(bestCandidateIndices1, bestCandidateIndices2);
+  EXPECT_DOUBLE_EQ(result1.first, result2.first);
+
+  // after a reset the MPC starts over
+  std::vector<size_t> bestCandidateIndices3;
+  mpcPtr1->reset();
+  const auto result3 = runMpcLoop(*mpcPtr1, &bestCandidateIndices3);
+  EXPECT_EQ(bestCandidateIndices1, bestCandidateIndices3);
+  EXPECT_DOUBLE_EQ(result1.first, result3.first);
+}
+
+TEST_F(MPC_MultiStartTest, closedLoopBenchmark) {
+  auto singleStartMpcPtr = getSingleStartMpc();
+  auto multiStartMpcPtr = getMultiStartMpc();
+  std::vector<size_t> bestCandidateIndices;
+  const auto singleStart = runMpcLoop(*singleStartMpcPtr);
+  const auto multiStart = runMpcLoop(*multiStartMpcPtr, &bestCandidateIndices);
+
+  std::cerr << "[closedLoopBenchmark] " << numCycles << " MPC cycles, " << multiStartMpcPtr->getNumCandidates() << " candidates\n"
+            << "  single start: closed-loop cost: " << singleStart.first << ", latency: " << singleStart.second << " [ms]\n"
+            << "  multi start:  closed-loop cost: " << multiStart.first << ", latency: " << multiStart.second << " [ms]\n"
+            << "  selected candidates:";
+  for (const auto i : bestCandidateIndices) {
+    std::cerr << " " << i;
+  }
+  std::cerr << "\n";
+  EXPECT_LT(multiStart.first, singleStart.first);
+}
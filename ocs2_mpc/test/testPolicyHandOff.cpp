@@ -0,0 +1,281 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include "ocs2_mpc/MPC_DDP.h"
+#include "ocs2_mpc/MRT_BASE.h"
+
+/*
+ * Counts the heap allocations and deallocations of this process by interposing malloc and free of glibc. Both operator new and the
+ * Eigen allocator end up in malloc.
+ */
+#ifdef __GLIBC__
+namespace {
+std::atomic_bool countAllocations{false};
+std::atomic_size_t numAllocations{0};
+std::atomic_size_t numDeallocations{0};
+}  // unnamed namespace
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+void* calloc(size_t num, size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_calloc(num, size);
+}
+void* realloc(void* ptr, size_t size) {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_realloc(ptr, size);
+}
+void free(void* ptr) {
+  if (countAllocations && ptr != nullptr) {
+    ++numDeallocations;
+  }
+  __libc_free(ptr);
+}
+}
+#endif
+
+using namespace ocs2;
+
+namespace {
+
+/** An MRT which receives the policy from a solver in the same process, like MPC_MRT_Interface::copyToBuffer. */
+class LocalMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override {}
+  void setCurrentObservation(const SystemObservation& observation) override {}
+
+  /** Moves the current solution of the solver to the buffer, either into the recycled objects or into new ones. */
+  void handOff(const SolverBase& solver, const SystemObservation& observation, bool recycle) {
+    auto primalSolutionPtr = recycle ? acquirePrimalSolution() : std::unique_ptr<PrimalSolution>(new PrimalSolution);
+    solver.getPrimalSolution(solver.getFinalTime(), primalSolutionPtr.get());
+
+    auto commandPtr = recycle ? acquireCommandData() : std::unique_ptr<CommandData>(new CommandData);
+    commandPtr->mpcInitObservation_ = observation;
+    commandPtr->mpcTargetTrajectories_ = solver.getReferenceManager().getTargetTrajectories();
+
+    auto performanceIndicesPtr = recycle ? acquirePerformanceIndex() : std::unique_ptr<PerformanceIndex>(new PerformanceIndex);
+    *performanceIndicesPtr = solver.getPerformanceIndeces();
+
+    moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  }
+};
+
+}  // unnamed namespace
+
+/** The solution of an MPC_DDP with feedback policy for a chain of double integrators. */
+class PolicyHandOffTest : public testing::Test {
+ protected:
+  static constexpr size_t STATE_DIM = 12;
+  static constexpr size_t INPUT_DIM = 6;
+
+  PolicyHandOffTest() {
+    matrix_t A = matrix_t::Zero(STATE_DIM, STATE_DIM);
+    A.topRightCorner<INPUT_DIM, INPUT_DIM>().setIdentity();
+    matrix_t B = matrix_t::Zero(STATE_DIM, INPUT_DIM);
+    B.bottomRows<INPUT_DIM>().setIdentity();
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(A, B));
+    problem.costPtr->add("cost", std::unique_ptr<StateInputCost>(new QuadraticStateInputCost(
+                                     matrix_t::Identity(STATE_DIM, STATE_DIM), 0.1 * matrix_t::Identity(INPUT_DIM, INPUT_DIM))));
+    problem.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(matrix_t::Identity(STATE_DIM, STATE_DIM))));
+    TimeTriggeredRollout rollout(*problem.dynamicsPtr);
+
+    mpc::Settings mpcSettings;
+    mpcSettings.timeHorizon_ = 1.0;
+    mpcSettings.numPartitions_ = 2;
+
+    ddp::Settings ddpSettings;
+    ddpSettings.algorithm_ = ddp::Algorithm::SLQ;
+    ddpSettings.nThreads_ = 1;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.timeStep_ = 0.01;
+    ddpSettings.useFeedbackPolicy_ = true;
+
+    mpcPtr.reset(new MPC_DDP(mpcSettings, ddpSettings, rollout, problem, DefaultInitializer(INPUT_DIM)));
+    const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(STATE_DIM)}, {vector_t::Zero(INPUT_DIM)});
+    mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<ReferenceManager>(targetTrajectories));
+
+    observation.time = 0.0;
+    observation.state = vector_t::Ones(STATE_DIM);
+    observation.input = vector_t::Zero(INPUT_DIM);
+    mpcPtr->run(observation.time, observation.state);
+  }
+
+  OptimalControlProblem problem;
+  std::unique_ptr<MPC_DDP> mpcPtr;
+  SystemObservation observation;
+};
+
+constexpr size_t PolicyHandOffTest::STATE_DIM;
+constexpr size_t PolicyHandOffTest::INPUT_DIM;
+
+TEST_F(PolicyHandOffTest, recycledPolicy) {
+  const auto& solver = *mpcPtr->getSolverPtr();
+  const auto expectedSolution = solver.primalSolution(solver.getFinalTime());
+
+  LocalMrt mrt;
+  for (size_t i = 0; i < 5; i++) {
+    mrt.handOff(solver, observation, /*recycle=*/true);
+    ASSERT_TRUE(mrt.updatePolicy());
+
+    // the recycled objects are fully overwritten
+    const auto& policy = mrt.getPolicy();
+    ASSERT_EQ(policy.timeTrajectory_, expectedSolution.timeTrajectory_);
+    ASSERT_EQ(policy.stateTrajectory_.size(), expectedSolution.stateTrajectory_.size());
+    for (size_t k = 0; k < policy.timeTrajectory_.size(); k++) {
+      ASSERT_TRUE(policy.stateTrajectory_[k].isApprox(expectedSolution.stateTrajectory_[k]));
+      ASSERT_TRUE(policy.inputTrajectory_[k].isApprox(expectedSolution.inputTrajectory_[k]));
+    }
+    const auto& controller = dynamic_cast<const LinearController&>(*policy.controllerPtr_);
+    const auto& expectedController = dynamic_cast<const LinearController&>(*expectedSolution.controllerPtr_);
+    ASSERT_EQ(controller.timeStamp_, expectedController.timeStamp_);
+    for (size_t k = 0; k < controller.timeStamp_.size(); k++) {
+      ASSERT_TRUE(controller.biasArray_[k].isApprox(expectedController.biasArray_[k]));
+      ASSERT_TRUE(controller.gainArray()[k].isApprox(expectedController.gainArray()[k]));
+    }
+    ASSERT_EQ(controller.deltaBiasArray_.size(), expectedController.deltaBiasArray_.size());
+  }
+}
+
+TEST_F(PolicyHandOffTest, compressedGains) {
+  const auto& solver = *mpcPtr->getSolverPtr();
+  const auto expectedSolution = solver.primalSolution(solver.getFinalTime());
+  const auto& expectedController = dynamic_cast<const LinearController&>(*expectedSolution.controllerPtr_);
+
+  // lossless run-length compression, and stride compression with a bounded error
+  for (const size_t stride : {0, 5}) {
+    LocalMrt mrt;
+    mrt.setGainCompression(stride, 0.0);
+    auto strideCompressed = expectedController;
+    const scalar_t maxError = (stride > 1) ? strideCompressed.compressGainsStride(stride) : 0.0;
+
+    // the recycled policies are compressed, they are overwritten by the solver
+    for (size_t i = 0; i < 3; i++) {
+      mrt.handOff(solver, observation, /*recycle=*/true);
+      ASSERT_TRUE(mrt.updatePolicy());
+
+      const auto& controller = dynamic_cast<const LinearController&>(*mrt.getPolicy().controllerPtr_);
+      ASSERT_TRUE(controller.gainsCompressed());
+      ASSERT_LT(controller.numStoredGains(), expectedController.size());
+      matrix_t gain, expectedGain;
+      for (const scalar_t t : expectedController.timeStamp_) {
+        controller.getFeedbackGain(t, gain);
+        expectedController.getFeedbackGain(t, expectedGain);
+        ASSERT_LE((gain - expectedGain).cwiseAbs().maxCoeff(), maxError + 1e-12) << "stride: " << stride;
+      }
+    }
+  }
+}
+
+#ifdef __GLIBC__
+TEST_F(PolicyHandOffTest, allocationCount) {
+  const auto& solver = *mpcPtr->getSolverPtr();
+
+  // the number of heap allocations and deallocations per hand-off, after the warm-up of the pools
+  auto countPerHandOff = [&](bool recycle) {
+    LocalMrt mrt;
+    for (size_t i = 0; i < 3; i++) {
+      mrt.handOff(solver, observation, recycle);
+      mrt.updatePolicy();
+    }
+
+    constexpr size_t numHandOffs = 10;
+    numAllocations = 0;
+    numDeallocations = 0;
+    countAllocations = true;
+    for (size_t i = 0; i < numHandOffs; i++) {
+      mrt.handOff(solver, observation, recycle);
+      mrt.updatePolicy();
+    }
+    countAllocations = false;
+    return std::make_pair(numAllocations / numHandOffs, numDeallocations / numHandOffs);
+  };
+
+  const auto withoutPool = countPerHandOff(false);
+  const auto withPool = countPerHandOff(true);
+  std::cerr << "[allocationCount] per policy hand-off\n"
+            << "  new objects:      " << withoutPool.first << " allocations, " << withoutPool.second << " deallocations\n"
+            << "  recycled objects: " << withPool.first << " allocations, " << withPool.second << " deallocations\n";
+
+  EXPECT_GT(withoutPool.first, 0);
+  EXPECT_EQ(withPool.first, 0);
+  EXPECT_EQ(withPool.second, 0);
+}
+#endif
+
+TEST_F(PolicyHandOffTest, benchmark) {
+  const auto& solver = *mpcPtr->getSolverPtr();
+  constexpr size_t numHandOffs = 1000;
+
+  // average time of a policy hand-off [us]
+  auto timePerHandOff = [&](bool recycle) {
+    LocalMrt mrt;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numHandOffs; i++) {
+      mrt.handOff(solver, observation, recycle);
+      mrt.updatePolicy();
+    }
+    return std::chrono::duration<scalar_t, std::micro>(std::chrono::steady_clock::now() - start).count() / numHandOffs;
+  };
+
+  const scalar_t withoutPool = timePerHandOff(false);
+  const scalar_t withPool = timePerHandOff(true);
+  std::cerr << "[benchmark] state dim: " << STATE_DIM << ", input dim: " << INPUT_DIM
+            << ", policy nodes: " << solver.primalSolution(solver.getFinalTime()).timeTrajectory_.size() << "\n"
+            << "  new objects:      " << withoutPool << " [us] per hand-off\n"
+            << "  recycled objects: " << withPool << " [us] per hand-off\n";
+}
@@ -54,6 +54,8 @@ struct PerformanceIndex {
   scalar_t inequalityConstraintISE = 0.0;
   /** The total penalty of the intermediate inequality constraints violation. */
   scalar_t inequalityConstraintPenalty = 0.0;
+  /** The total augmented Lagrangian term of the state-only equality constraints. It is only used by the augmented Lagrangian methods. */
+  scalar_t equalityLagrangian = 0.0;
 
   /** Add performance indices */
   PerformanceIndex& operator+=(const PerformanceIndex& rhs) {
@@ -64,6 +66,7 @@ struct PerformanceIndex {
     this->stateInputEqConstraintISE += rhs.stateInputEqConstraintISE;
     this->inequalityConstraintISE += rhs.inequalityConstraintISE;
     this->inequalityConstraintPenalty += rhs.inequalityConstraintPenalty;
+    this->equalityLagrangian += rhs.equalityLagrangian;
     return *this;
   }
 };
@@ -92,6 +95,7 @@ inline std::ostream& operator<<(std::ostream& stream, const PerformanceIndex& pe
 
   stream << std::setw(indentation) << "";
   stream << "state equality final constraints SSE: " << std::setw(tabSpace) << performanceIndex.stateEqFinalConstraintSSE;
+  stream << "equality Lagrangian:                  " << std::setw(tabSpace) << performanceIndex.equalityLagrangian;
 
   return stream;
 }
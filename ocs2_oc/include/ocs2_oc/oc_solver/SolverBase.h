@@ -160,7 +160,8 @@ class SolverBase {
    * @brief Returns the optimized policy data.
    *
    * @param [in] finalTime: The final time.
-   * @param [out] primalSolutionPtr: The primal problem's solution.
+   * @param [out] primalSolutionPtr: The primal problem's solution. It can hold the stale content of a recycled solution, which should
+   * be overwritten in place, if possible, to reuse its memory.
    */
   virtual void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const = 0;
 
@@ -209,6 +210,31 @@ class SolverBase {
    */
   virtual std::string getBenchmarkingInfo() const { return {}; }
 
+  /**
+   * Saves the warm-start state of the solver, i.e. the data that the next call of run() starts from, and the ModeSchedule of the
+   * ReferenceManager to a binary file. The file is first written to a temporary file which is then renamed, therefore an existing
+   * snapshot is never left half written.
+   *
+   * @param [in] fileName: The snapshot file.
+   */
+  void saveWarmStart(const std::string& fileName) const;
+
+  /**
+   * Loads a warm-start state which is saved by saveWarmStart(). The next call of run() (without initial controllers) starts from the
+   * loaded state as if it had been computed by this instance. The ModeSchedule of the ReferenceManager is also restored.
+   *
+   * @param [in] fileName: The snapshot file.
+   */
+  void loadWarmStart(const std::string& fileName);
+
+  /**
+   * Copies the warm-start state of another solver of the same type, such that the next call of run() (without initial controllers)
+   * starts from the solution of the other solver. Unlike loadWarmStart(), the ModeSchedule of the ReferenceManager is not modified.
+   *
+   * @param [in] other: The solver to copy the warm-start state from.
+   */
+  void copyWarmStart(const SolverBase& other);
+
   /**
    * Prints to output.
    *
@@ -222,6 +248,18 @@ class SolverBase {
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const scalar_array_t& partitioningTimes,
                        const std::vector<ControllerBase*>& controllersPtrStock) = 0;
 
+  /** Writes the solver-specific warm-start state. The default implementation throws since the snapshots are not supported. */
+  virtual void saveWarmStartImpl(std::ostream& stream) const;
+
+  /** Reads the solver-specific warm-start state. The default implementation throws since the snapshots are not supported. */
+  virtual void loadWarmStartImpl(std::istream& stream);
+
+  /**
+   * Copies the solver-specific warm-start state of another solver. The default implementation passes the state through
+   * saveWarmStartImpl() and loadWarmStartImpl(). Solvers override it to copy the state in memory.
+   */
+  virtual void copyWarmStartImpl(const SolverBase& other);
+
   void preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
 
   void postRun();
@@ -0,0 +1,107 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+namespace warm_start {
+
+/**
+ * Binary (de)serialization of the data that makes up the warm-start state of a solver. The format is a plain native-endian
+ * dump which is meant for restarting a process on the same machine, not for exchanging data between machines.
+ *
+ * All read functions throw std::runtime_error if the stream ends before the requested data is read, if a stored size exceeds the
+ * remaining length of the stream, or if the sizes of the related containers are inconsistent.
+ */
+void write(std::ostream& stream, scalar_t value);
+void write(std::ostream& stream, size_t value);
+void write(std::ostream& stream, const std::string& value);
+void write(std::ostream& stream, const vector_t& value);
+void write(std::ostream& stream, const matrix_t& value);
+void write(std::ostream& stream, const ModeSchedule& value);
+void write(std::ostream& stream, const LinearController& value);
+void write(std::ostream& stream, const FeedforwardController& value);
+/** Writes the trajectories, the mode schedule, and the controller. Only linear and feedforward controllers are supported. */
+void write(std::ostream& stream, const PrimalSolution& value);
+
+template <typename T, typename Alloc>
+void write(std::ostream& stream, const std::vector<T, Alloc>& value) {
+  write(stream, value.size());
+  for (const auto& v : value) {
+    write(stream, v);
+  }
+}
+
+/**
+ * Reads a stored container size and checks that the remaining length of the stream can hold that many elements.
+ *
+ * @param [in] stream: The input stream.
+ * @param [in] elementSize: The minimum number of bytes of each element. If zero, the size is not validated.
+ * @return The container size.
+ */
+size_t readSize(std::istream& stream, size_t elementSize);
+
+/** Throws std::runtime_error if the size of the read container, name, does not match the expected size. */
+void checkSize(size_t size, size_t expectedSize, const std::string& name);
+
+void read(std::istream& stream, scalar_t& value);
+void read(std::istream& stream, size_t& value);
+void read(std::istream& stream, std::string& value);
+void read(std::istream& stream, vector_t& value);
+void read(std::istream& stream, matrix_t& value);
+void read(std::istream& stream, ModeSchedule& value);
+void read(std::istream& stream, LinearController& value);
+void read(std::istream& stream, FeedforwardController& value);
+void read(std::istream& stream, PrimalSolution& value);
+
+template <typename T, typename Alloc>
+void read(std::istream& stream, std::vector<T, Alloc>& value) {
+  // every serialized element takes at least one size_t or scalar_t
+  const size_t size = readSize(stream, std::min(sizeof(size_t), sizeof(scalar_t)));
+  value.resize(size);
+  for (auto& v : value) {
+    read(stream, v);
+  }
+}
+
+}  // namespace warm_start
+}  // namespace ocs2
@@ -37,11 +37,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/integration/StateTriggeredEventHandler.h>
 
 #include "RolloutBase.h"
+#include "RootFinder.h"
 
 namespace ocs2 {
 
 /**
  * This class is an interface class for forward rollout of the system dynamics.
+ *
+ * The events are triggered by the guard surfaces. When a guard surface changes sign over an integration step, the crossing is located
+ * on the cubic Hermite interpolation of the step, for all the guard surfaces at once. The integration is then only repeated from the
+ * cached start of the bracket to the located crossing.
  */
 class StateTriggeredRollout : public RolloutBase {
  public:
@@ -87,6 +92,31 @@ class StateTriggeredRollout : public RolloutBase {
                    vector_array_t& inputTrajectory) override;
 
  private:
+  /** An end of the bracket of an event, with the cached flow map and guard surfaces */
+  struct BracketEnd {
+    scalar_t time;
+    vector_t state;
+    vector_t flow;
+    vector_t guardSurfaces;
+  };
+
+  /** Evaluates the flow map and the guard surfaces at the given time and state. */
+  BracketEnd getBracketEnd(scalar_t time, vector_t state);
+
+  /** The cubic Hermite interpolation of the state between the bracket ends, i.e., the dense output of the integration step. */
+  static vector_t interpolate(const BracketEnd& left, const BracketEnd& right, scalar_t time);
+
+  /**
+   * Locates the earliest crossing of the guard surfaces which change sign over the bracket. The roots are found on the interpolated
+   * state, therefore no integration is required.
+   *
+   * @param [in] left: The bracket end before the event.
+   * @param [in] right: The bracket end after the event.
+   * @param [in] rootFinder: The root-finding method.
+   * @return The time of the earliest crossing and the ID of the crossed guard surface.
+   */
+  std::pair<scalar_t, size_t> locateEvent(const BracketEnd& left, const BracketEnd& right, RootFinder& rootFinder);
+
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
 
@@ -52,12 +52,9 @@ class ReferenceManager : public ReferenceManagerInterface {
   void setModeSchedule(ModeSchedule&& modeSchedule) override { modeSchedule_.setBuffer(std::move(modeSchedule)); }
 
   const TargetTrajectories& getTargetTrajectories() const override { return targetTrajectories_.get(); }
-  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override {
-    return targetTrajectories_.setBuffer(targetTrajectories);
-  }
-  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
-    return targetTrajectories_.setBuffer(std::move(targetTrajectories));
-  }
+  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override;
+  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override;
+  void appendTargetTrajectories(const TargetTrajectories& targetTrajectories) override;
 
  protected:
   /**
@@ -77,6 +74,7 @@ class ReferenceManager : public ReferenceManagerInterface {
  private:
   BufferedValue<ModeSchedule> modeSchedule_;
   BufferedValue<TargetTrajectories> targetTrajectories_;
+  Synchronized<TargetTrajectories> appendedTargetTrajectories_;
 };
 
 }  // namespace ocs2
@@ -90,6 +90,14 @@ class ReferenceManagerInterface {
    * @note: This method must be thread safe.
    */
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
+
+  /**
+   * Appends points to the TargetTrajectories without replacing the whole object. The points are accumulated in a buffer and appended
+   * in place to the active TargetTrajectories once preSolverRun() is called. The points of the active TargetTrajectories at or after
+   * the first appended time are replaced. A later call to setTargetTrajectories() discards the points which are not yet applied.
+   * @note: This method must be thread safe.
+   */
+  virtual void appendTargetTrajectories(const TargetTrajectories& targetTrajectories) = 0;
 };
 
 }  // namespace ocs2
@@ -27,17 +27,26 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <mutex>
+#include <sstream>
 
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/Numerics.h>
 
 #include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/oc_solver/WarmStartSerialization.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
 
 namespace ocs2 {
 
+namespace {
+const std::string warmStartFileHeader = "ocs2_warm_start";
+constexpr size_t warmStartFileVersion = 1;
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -71,6 +80,88 @@ PrimalSolution SolverBase::primalSolution(scalar_t finalTime) const {
   return primalSolution;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::saveWarmStart(const std::string& fileName) const {
+  const std::string tmpFileName = fileName + ".tmp";
+  {
+    std::ofstream stream(tmpFileName, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+      throw std::runtime_error("[SolverBase::saveWarmStart] Could not open the file: " + tmpFileName);
+    }
+
+    warm_start::write(stream, warmStartFileHeader);
+    warm_start::write(stream, warmStartFileVersion);
+    warm_start::write(stream, referenceManagerPtr_->getModeSchedule());
+    saveWarmStartImpl(stream);
+
+    if (!stream.flush()) {
+      throw std::runtime_error("[SolverBase::saveWarmStart] Could not write the file: " + tmpFileName);
+    }
+  }
+
+  if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    throw std::runtime_error("[SolverBase::saveWarmStart] Could not rename " + tmpFileName + " to " + fileName);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::loadWarmStart(const std::string& fileName) {
+  std::ifstream stream(fileName, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("[SolverBase::loadWarmStart] Could not open the file: " + fileName);
+  }
+
+  std::string header;
+  size_t version;
+  warm_start::read(stream, header);
+  warm_start::read(stream, version);
+  if (header != warmStartFileHeader || version != warmStartFileVersion) {
+    throw std::runtime_error("[SolverBase::loadWarmStart] " + fileName + " is not a compatible warm-start snapshot.");
+  }
+
+  ModeSchedule modeSchedule;
+  warm_start::read(stream, modeSchedule);
+  loadWarmStartImpl(stream);
+
+  referenceManagerPtr_->setModeSchedule(std::move(modeSchedule));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::copyWarmStart(const SolverBase& other) {
+  if (&other != this) {
+    copyWarmStartImpl(other);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::saveWarmStartImpl(std::ostream& stream) const {
+  throw std::runtime_error("[SolverBase] This solver does not support warm-start snapshots.");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::loadWarmStartImpl(std::istream& stream) {
+  throw std::runtime_error("[SolverBase] This solver does not support warm-start snapshots.");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverBase::copyWarmStartImpl(const SolverBase& other) {
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  other.saveWarmStartImpl(stream);
+  loadWarmStartImpl(stream);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,304 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_solver/WarmStartSerialization.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace warm_start {
+
+namespace {
+
+template <typename T>
+void writeRaw(std::ostream& stream, const T* data, size_t size) {
+  stream.write(reinterpret_cast<const char*>(data), size * sizeof(T));
+}
+
+template <typename T>
+void readRaw(std::istream& stream, T* data, size_t size) {
+  stream.read(reinterpret_cast<char*>(data), size * sizeof(T));
+  if (!stream) {
+    throw std::runtime_error("[warm_start::read] Unexpected end of the stream.");
+  }
+}
+
+/** Returns the number of bytes which are left in the stream, or the maximum value if the stream is not seekable. */
+size_t remainingLength(std::istream& stream) {
+  const auto current = stream.tellg();
+  if (current < 0) {
+    return std::numeric_limits<size_t>::max();
+  }
+  stream.seekg(0, std::ios::end);
+  const auto end = stream.tellg();
+  stream.seekg(current);
+  return static_cast<size_t>(end - current);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t readSize(std::istream& stream, size_t elementSize) {
+  size_t size;
+  readRaw(stream, &size, 1);
+  if (elementSize > 0 && size > remainingLength(stream) / elementSize) {
+    throw std::runtime_error("[warm_start::read] The stored size (" + std::to_string(size) + ") exceeds the length of the stream.");
+  }
+  return size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void checkSize(size_t size, size_t expectedSize, const std::string& name) {
+  if (size != expectedSize) {
+    throw std::runtime_error("[warm_start::read] The size of " + name + " (" + std::to_string(size) +
+                             ") does not match the expected size (" + std::to_string(expectedSize) + ").");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, scalar_t value) {
+  writeRaw(stream, &value, 1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, size_t value) {
+  writeRaw(stream, &value, 1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const std::string& value) {
+  write(stream, value.size());
+  writeRaw(stream, value.data(), value.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const vector_t& value) {
+  write(stream, static_cast<size_t>(value.size()));
+  writeRaw(stream, value.data(), value.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const matrix_t& value) {
+  write(stream, static_cast<size_t>(value.rows()));
+  write(stream, static_cast<size_t>(value.cols()));
+  writeRaw(stream, value.data(), value.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const ModeSchedule& value) {
+  write(stream, value.eventTimes);
+  write(stream, value.modeSequence);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const LinearController& value) {
+  if (value.gainsCompressed()) {  // serialize one gain per time stamp
+    LinearController decompressed(value);
+    decompressed.decompressGains();
+    write(stream, decompressed);
+    return;
+  }
+
+  write(stream, value.timeStamp_);
+  write(stream, value.biasArray_);
+  write(stream, value.deltaBiasArray_);
+  write(stream, value.gainArray());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const FeedforwardController& value) {
+  write(stream, value.timeStamp_);
+  write(stream, value.uffArray_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void write(std::ostream& stream, const PrimalSolution& value) {
+  write(stream, value.timeTrajectory_);
+  write(stream, value.stateTrajectory_);
+  write(stream, value.inputTrajectory_);
+  write(stream, value.modeSchedule_);
+
+  const auto controllerType = value.controllerPtr_ ? value.controllerPtr_->getType() : ControllerType::UNKNOWN;
+  write(stream, static_cast<size_t>(controllerType));
+  switch (controllerType) {
+    case ControllerType::UNKNOWN:
+      break;
+    case ControllerType::LINEAR:
+      write(stream, static_cast<const LinearController&>(*value.controllerPtr_));
+      break;
+    case ControllerType::FEEDFORWARD:
+      write(stream, static_cast<const FeedforwardController&>(*value.controllerPtr_));
+      break;
+    default:
+      throw std::runtime_error("[warm_start::write] Only linear and feedforward controllers can be serialized.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, scalar_t& value) {
+  readRaw(stream, &value, 1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, size_t& value) {
+  readRaw(stream, &value, 1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, std::string& value) {
+  const size_t size = readSize(stream, sizeof(char));
+  value.resize(size);
+  readRaw(stream, &value[0], size);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, vector_t& value) {
+  const size_t size = readSize(stream, sizeof(scalar_t));
+  value.resize(size);
+  readRaw(stream, value.data(), size);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, matrix_t& value) {
+  const size_t rows = readSize(stream, 0);
+  const size_t cols = readSize(stream, 0);
+  if (rows > 0 && cols > remainingLength(stream) / sizeof(scalar_t) / rows) {
+    throw std::runtime_error("[warm_start::read] The stored matrix size (" + std::to_string(rows) + "x" + std::to_string(cols) +
+                             ") exceeds the length of the stream.");
+  }
+  value.resize(rows, cols);
+  readRaw(stream, value.data(), rows * cols);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, ModeSchedule& value) {
+  scalar_array_t eventTimes;
+  size_array_t modeSequence;
+  read(stream, eventTimes);
+  read(stream, modeSequence);
+  checkSize(modeSequence.size(), eventTimes.size() + 1, "ModeSchedule::modeSequence");
+  value = ModeSchedule(std::move(eventTimes), std::move(modeSequence));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, LinearController& value) {
+  value.clear();  // resets the gain compression
+  read(stream, value.timeStamp_);
+  read(stream, value.biasArray_);
+  read(stream, value.deltaBiasArray_);
+  read(stream, value.gainArray());
+  checkSize(value.biasArray_.size(), value.timeStamp_.size(), "LinearController::biasArray_");
+  checkSize(value.gainArray().size(), value.timeStamp_.size(), "LinearController::gainArray");
+  if (!value.deltaBiasArray_.empty()) {
+    checkSize(value.deltaBiasArray_.size(), value.timeStamp_.size(), "LinearController::deltaBiasArray_");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, FeedforwardController& value) {
+  read(stream, value.timeStamp_);
+  read(stream, value.uffArray_);
+  checkSize(value.uffArray_.size(), value.timeStamp_.size(), "FeedforwardController::uffArray_");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void read(std::istream& stream, PrimalSolution& value) {
+  read(stream, value.timeTrajectory_);
+  read(stream, value.stateTrajectory_);
+  read(stream, value.inputTrajectory_);
+  read(stream, value.modeSchedule_);
+  checkSize(value.stateTrajectory_.size(), value.timeTrajectory_.size(), "PrimalSolution::stateTrajectory_");
+  checkSize(value.inputTrajectory_.size(), value.timeTrajectory_.size(), "PrimalSolution::inputTrajectory_");
+
+  size_t controllerType;
+  read(stream, controllerType);
+  switch (static_cast<ControllerType>(controllerType)) {
+    case ControllerType::UNKNOWN:
+      value.controllerPtr_.reset();
+      break;
+    case ControllerType::LINEAR: {
+      std::unique_ptr<LinearController> controllerPtr(new LinearController);
+      read(stream, *controllerPtr);
+      value.controllerPtr_ = std::move(controllerPtr);
+      break;
+    }
+    case ControllerType::FEEDFORWARD: {
+      std::unique_ptr<FeedforwardController> controllerPtr(new FeedforwardController);
+      read(stream, *controllerPtr);
+      value.controllerPtr_ = std::move(controllerPtr);
+      break;
+    }
+    default:
+      throw std::runtime_error("[warm_start::read] Unsupported controller type.");
+  }
+}
+
+}  // namespace warm_start
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_oc/rollout/StateTriggeredRollout.h>
 
+#include <iterator>
+
 #include <ocs2_core/control/StateBasedLinearController.h>
 #include <ocs2_oc/rollout/RootFinder.h>
 
@@ -74,111 +76,183 @@ vector_t StateTriggeredRollout::runImpl(const time_interval_array_t& timeInterva
   systemEventHandlersPtr_->reset();
 
   vector_t x0 = initState;
-  int k_u = 0;  // control input iterator
-
-  size_t eventID = 0;
   scalar_t t0 = timeIntervalArray.front().first;
-  scalar_t t1 = timeIntervalArray.back().second;
-  const scalar_t finalTime = t1;  // stored separately due to overwriting t1 when refining
-
-  bool refining = false;
-  int singleEventIterations = 0;  // iterations for a single event
-  int numTotalIterations = 0;     // overall number of iterations
+  const scalar_t finalTime = timeIntervalArray.back().second;
+  const scalar_t tolerance = this->settings().absTolODE;
 
   RootFinder rootFinder(this->settings().rootFindingAlgorithm);  // root-finding algorithm
 
-  while (true) {  // keeps looping until end time condition is fulfilled, after which the loop is broken
-    bool triggered = false;
+  // the trajectory of the integration inside a bracket
+  scalar_array_t segmentTimeTrajectory;
+  vector_array_t segmentStateTrajectory;
+
+  // integrates from (t0, x0) to t1, and returns true if a guard surface is crossed
+  auto integrate = [&](scalar_t startTime, const vector_t& startState, scalar_t endTime, scalar_array_t& times, vector_array_t& states) {
     try {
-      Observer observer(&stateTrajectory, &timeTrajectory);  // concatenate trajectory
-      dynamicsIntegratorPtr_->integrateAdaptive(*systemDynamicsPtr_, observer, x0, t0, t1, this->settings().timeStep,
+      Observer observer(&states, &times);  // concatenate trajectory
+      dynamicsIntegratorPtr_->integrateAdaptive(*systemDynamicsPtr_, observer, startState, startTime, endTime, this->settings().timeStep,
                                                 this->settings().absTolODE, this->settings().relTolODE, maxNumSteps);
-    } catch (const size_t& e) {
-      eventID = e;
-      triggered = true;
+    } catch (const size_t&) {
+      return true;
     }
-    // calculate guard surface value of last query state and time
-    const scalar_t queryTime = timeTrajectory.back();
-    const vector_t queryState = stateTrajectory.back();
-    const vector_t guardSurfaces = systemDynamicsPtr_->computeGuardSurfaces(queryTime, queryState);
-    const scalar_t queryGuard = guardSurfaces[eventID];
-
-    // accuracy conditions on the obtained query guard and width of time window
-    const bool guardAccuracyCondition = std::fabs(queryGuard) < this->settings().absTolODE;
-    const bool timeAccuracyCondition = std::fabs(t1 - t0) < this->settings().absTolODE;
-    const bool accuracyCondition = guardAccuracyCondition || timeAccuracyCondition;
-    // condition to check whether max number of iterations has not been reached, to prevent an infinite loop
-    const bool maxNumIterationsReached = singleEventIterations >= this->settings().maxSingleEventIterations;
-
-    // remove the element past the guard surface if the event handler was triggered
-    // (Due to checking in EventHandler this can only happen to the last element of the trajectory)
-    // Exception is when the element is outside the guardSurface but within tolerance
-    if (triggered && !accuracyCondition) {
-      stateTrajectory.pop_back();
-      timeTrajectory.pop_back();
+    return false;
+  };
+
+  // keeps looping until end time condition is fulfilled, after which the loop is broken
+  while (integrate(t0, x0, finalTime, timeTrajectory, stateTrajectory)) {
+    // The last element is past a guard surface and the one before it is in front of the guard surfaces. The start of the bracket is
+    // removed as it is observed again by the next integration from it.
+    auto right = getBracketEnd(timeTrajectory.back(), std::move(stateTrajectory.back()));
+    timeTrajectory.pop_back();
+    stateTrajectory.pop_back();
+    auto left = getBracketEnd(timeTrajectory.back(), std::move(stateTrajectory.back()));
+    timeTrajectory.pop_back();
+    stateTrajectory.pop_back();
+
+    // refine the bracket until the located crossing is accurate
+    auto event = locateEvent(left, right, rootFinder);
+    for (int singleEventIterations = 0; singleEventIterations < this->settings().maxSingleEventIterations; singleEventIterations++) {
+      // accuracy condition on the width of the bracket, or on the crossed guard surface past the bracket
+      if (right.time - left.time < tolerance || std::abs(right.guardSurfaces(event.second)) < tolerance) {
+        break;
+      }
+
+      segmentTimeTrajectory.clear();
+      segmentStateTrajectory.clear();
+      const bool triggered = integrate(left.time, left.state, event.first, segmentTimeTrajectory, segmentStateTrajectory);
+
+      // the last element of the segment is either past a guard surface, or is the located crossing in front of the guard surfaces
+      auto query = getBracketEnd(segmentTimeTrajectory.back(), std::move(segmentStateTrajectory.back()));
+      segmentTimeTrajectory.pop_back();
+      segmentStateTrajectory.pop_back();
+      if (triggered) {
+        right = std::move(query);
+        if (segmentTimeTrajectory.size() > 1) {
+          left = getBracketEnd(segmentTimeTrajectory.back(), std::move(segmentStateTrajectory.back()));
+          segmentTimeTrajectory.pop_back();
+          segmentStateTrajectory.pop_back();
+        } else {
+          segmentTimeTrajectory.clear();
+          segmentStateTrajectory.clear();
+        }
+      } else {
+        // a crossing which is not detected due to the minimum time between the events is also accepted
+        const bool accurate = query.guardSurfaces(event.second) < tolerance;
+        left = std::move(query);
+        if (accurate) {
+          right = left;
+        }
+      }
+      // the segment before the start of the bracket is part of the trajectory
+      timeTrajectory.insert(timeTrajectory.end(), segmentTimeTrajectory.begin(), segmentTimeTrajectory.end());
+      stateTrajectory.insert(stateTrajectory.end(), std::make_move_iterator(segmentStateTrajectory.begin()),
+                             std::make_move_iterator(segmentStateTrajectory.end()));
+
+      event = locateEvent(left, right, rootFinder);
     }
-    triggered = false;
 
-    // compute control input trajectory and concatenate to inputTrajectory
-    if (this->settings().reconstructInputTrajectory) {
-      for (; k_u < timeTrajectory.size(); k_u++) {
-        inputTrajectory.emplace_back(systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k_u], stateTrajectory[k_u]));
-      }  // end of k_u loop
+    // the event is triggered at the end of the bracket
+    const scalar_t eventTime = right.time;
+    if (right.time > left.time) {
+      timeTrajectory.push_back(left.time);
+      stateTrajectory.push_back(std::move(left.state));
     }
+    timeTrajectory.push_back(eventTime);
+    stateTrajectory.push_back(std::move(right.state));
 
-    // end time condition to detect end of simulation, means iteration procedure is done
-    if (numerics::almost_eq(finalTime, timeTrajectory.back())) {
+    // end time condition to detect end of simulation
+    if (numerics::almost_eq(finalTime, eventTime)) {
       break;
     }
 
-    // accuracy condition for event refinement. If sufficiently accurate crossing location has been determined
-    if (accuracyCondition || maxNumIterationsReached) {
-      // set new begin/end time and begin state
-      t0 = queryTime + numeric_traits::weakEpsilon<scalar_t>();
-      t1 = finalTime;
-      // compute jump
-      x0 = systemDynamicsPtr_->computeJumpMap(queryTime, queryState);
-
-      // append the event to array with event indices
-      eventsPastTheEndIndeces.push_back(stateTrajectory.size());
-
-      // determine guard surface cross value and update the eventHandler
-      vector_t guardSurfacesCross = systemDynamicsPtr_->computeGuardSurfaces(t0, x0);
-      // updates the last event triggering times of Event Handler
-      systemEventHandlersPtr_->setLastEvent(t0, guardSurfacesCross);
-
-      // reset relevant boolean and counter
-      refining = false;
-      singleEventIterations = 0;
-    } else {           // otherwise keep or start refining
-      if (refining) {  // apply the rules of the root-finding method to continue refining
-        rootFinder.updateBracket(queryTime, queryGuard);
-      } else {  // properly configure root-finding method to start refining
-        const scalar_t& timeBefore = timeTrajectory.back();
-        const vector_t& stateBefore = stateTrajectory.back();
-        const vector_t guardSurfacesBefore = systemDynamicsPtr_->computeGuardSurfaces(timeBefore, stateBefore);
-        const scalar_t& guardBefore = guardSurfacesBefore[eventID];
-
-        rootFinder.setInitBracket(timeBefore, queryTime, guardBefore, queryGuard);
-        refining = true;
-      }
-      t1 = rootFinder.getNewQuery();
-      t0 = timeTrajectory.back();
-      x0 = stateTrajectory.back();
-
-      stateTrajectory.pop_back();
-      timeTrajectory.pop_back();
-      inputTrajectory.pop_back();
-      k_u--;
-    }
-    singleEventIterations++;
-    numTotalIterations++;
+    // set new begin time and begin state
+    t0 = eventTime + numeric_traits::weakEpsilon<scalar_t>();
+    // compute jump
+    x0 = systemDynamicsPtr_->computeJumpMap(eventTime, stateTrajectory.back());
+
+    // append the event to array with event indices
+    eventsPastTheEndIndeces.push_back(stateTrajectory.size());
+
+    // determine guard surface cross value and update the eventHandler
+    vector_t guardSurfacesCross = systemDynamicsPtr_->computeGuardSurfaces(t0, x0);
+    // updates the last event triggering times of Event Handler
+    systemEventHandlersPtr_->setLastEvent(t0, guardSurfacesCross);
   }  // end of while loop
 
+  // compute control input trajectory
+  if (this->settings().reconstructInputTrajectory) {
+    for (size_t k = 0; k < timeTrajectory.size(); k++) {
+      inputTrajectory.emplace_back(systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k], stateTrajectory[k]));
+    }
+  }
+
   // check for the numerical stability
   this->checkNumericalStability(controller, timeTrajectory, eventsPastTheEndIndeces, stateTrajectory, inputTrajectory);
 
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+StateTriggeredRollout::BracketEnd StateTriggeredRollout::getBracketEnd(scalar_t time, vector_t state) {
+  BracketEnd bracketEnd;
+  bracketEnd.time = time;
+  bracketEnd.flow = systemDynamicsPtr_->computeFlowMap(time, state);
+  bracketEnd.guardSurfaces = systemDynamicsPtr_->computeGuardSurfaces(time, state);
+  bracketEnd.state = std::move(state);
+  return bracketEnd;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t StateTriggeredRollout::interpolate(const BracketEnd& left, const BracketEnd& right, scalar_t time) {
+  const scalar_t h = right.time - left.time;
+  const scalar_t s = (time - left.time) / h;
+  const scalar_t s2 = s * s;
+  const scalar_t s3 = s2 * s;
+  return (2.0 * s3 - 3.0 * s2 + 1.0) * left.state + (s3 - 2.0 * s2 + s) * h * left.flow + (3.0 * s2 - 2.0 * s3) * right.state +
+         (s3 - s2) * h * right.flow;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, size_t> StateTriggeredRollout::locateEvent(const BracketEnd& left, const BracketEnd& right, RootFinder& rootFinder) {
+  constexpr int maxNumIterations = 100;
+  const scalar_t tolerance = this->settings().absTolODE;
+
+  std::pair<scalar_t, size_t> event{right.time, 0};
+  for (size_t i = 0; i < right.guardSurfaces.size(); i++) {
+    if (left.guardSurfaces(i) <= 0.0 || right.guardSurfaces(i) > 0.0) {
+      continue;
+    }
+
+    // a crossing after the earliest one so far is not required
+    scalar_t rightTime = event.first;
+    scalar_t rightGuard = right.guardSurfaces(i);
+    if (rightTime < right.time) {
+      rightGuard = systemDynamicsPtr_->computeGuardSurfaces(rightTime, interpolate(left, right, rightTime))(i);
+      if (rightGuard > 0.0) {
+        continue;
+      }
+    }
+
+    rootFinder.setInitBracket(left.time, rightTime, left.guardSurfaces(i), rightGuard);
+    scalar_t queryTime = rightTime;
+    for (int iteration = 0; iteration < maxNumIterations; iteration++) {
+      queryTime = rootFinder.getNewQuery();
+      const scalar_t queryGuard = systemDynamicsPtr_->computeGuardSurfaces(queryTime, interpolate(left, right, queryTime))(i);
+      if (std::abs(queryGuard) < tolerance) {
+        break;
+      }
+      rootFinder.updateBracket(queryTime, queryGuard);
+    }
+    event = {queryTime, i};
+  }
+
+  return event;
+}
+
 }  // namespace ocs2
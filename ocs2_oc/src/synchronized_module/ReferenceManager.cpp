@@ -42,8 +42,45 @@ ReferenceManager::ReferenceManager(TargetTrajectories initialTargetTrajectories,
 /******************************************************************************************************/
 void ReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) {
   targetTrajectories_.updateFromBuffer();
+
+  std::unique_ptr<TargetTrajectories> appendedTargetTrajectoriesPtr(nullptr);
+  appendedTargetTrajectories_.swap(appendedTargetTrajectoriesPtr);
+  if (appendedTargetTrajectoriesPtr != nullptr) {
+    auto& targetTrajectories = targetTrajectories_.get();
+    targetTrajectories.append(*appendedTargetTrajectoriesPtr);
+    targetTrajectories.trimBefore(initTime);
+  }
+
   modeSchedule_.updateFromBuffer();
   modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceManager::setTargetTrajectories(const TargetTrajectories& targetTrajectories) {
+  appendedTargetTrajectories_.reset(nullptr);
+  targetTrajectories_.setBuffer(targetTrajectories);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceManager::setTargetTrajectories(TargetTrajectories&& targetTrajectories) {
+  appendedTargetTrajectories_.reset(nullptr);
+  targetTrajectories_.setBuffer(std::move(targetTrajectories));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceManager::appendTargetTrajectories(const TargetTrajectories& targetTrajectories) {
+  auto lockedAppendedTargetTrajectoriesPtr = appendedTargetTrajectories_.lock();
+  if (lockedAppendedTargetTrajectoriesPtr) {
+    lockedAppendedTargetTrajectoriesPtr->append(targetTrajectories);
+  } else {
+    lockedAppendedTargetTrajectoriesPtr.reset(std::unique_ptr<TargetTrajectories>(new TargetTrajectories(targetTrajectories)));
+  }
+}
+
 }  // namespace ocs2
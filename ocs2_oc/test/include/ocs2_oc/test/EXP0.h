@@ -89,21 +89,28 @@ class EXP0_System : public SystemDynamicsBase {
   EXP0_System* clone() const final { return new EXP0_System(*this); }
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) final {
-    const auto activeMode = referenceManagerPtr_->getModeSchedule().modeAtTime(t);
+    const auto activeMode = getActiveMode(t, preComp);
     return subsystemDynamicsPtr_[activeMode]->computeFlowMap(t, x, u, preComp);
   }
 
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                         const PreComputation& preComp) final {
-    const auto activeMode = referenceManagerPtr_->getModeSchedule().modeAtTime(t);
+    const auto activeMode = getActiveMode(t, preComp);
     return subsystemDynamicsPtr_[activeMode]->linearApproximation(t, x, u, preComp);
   }
 
  private:
+  /** The solver's precomputed mode index is used if it is provided, see PreComputation::setModeIndex(). */
+  size_t getActiveMode(scalar_t t, const PreComputation& preComp) {
+    const auto& modeSchedule = referenceManagerPtr_->getModeSchedule();
+    return preComp.hasModeIndex() ? modeSchedule.modeSequence[preComp.getModeIndex()] : modeSchedule.modeAtTime(t, modeScheduleCursor_);
+  }
+
   EXP0_System(const EXP0_System& other) : EXP0_System(other.referenceManagerPtr_) {}
 
   std::vector<std::shared_ptr<SystemDynamicsBase>> subsystemDynamicsPtr_;
   std::shared_ptr<ReferenceManager> referenceManagerPtr_;
+  int modeScheduleCursor_ = 0;  // each clone is used by a single thread
 };
 
 /******************************************************************************************************/
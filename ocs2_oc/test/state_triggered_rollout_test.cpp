@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_oc/rollout/RolloutSettings.h>
@@ -294,3 +297,50 @@ TEST(StateRolloutTests, runHybridDynamics) {
     }
   }
 }
+
+/*
+ *     Benchmark for StateTriggeredRollout
+ *     The bouncing ball system of Test 1, with the accuracy settings of Test 1.
+ *
+ *     Reports the average time of a rollout and the number of the dynamics function calls, and checks the accuracy of the events.
+ */
+TEST(StateRolloutTests, benchmarkBallDynamics) {
+  const size_t nx = 2;
+  const size_t nu = 1;
+  const size_t numRollouts = 20;
+
+  ocs2::rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-10;
+  rolloutSettings.relTolODE = 1e-7;
+  rolloutSettings.timeStep = 1e-3;
+  ocs2::ballDyn dynamics;
+  ocs2::StateTriggeredRollout rollout(dynamics, rolloutSettings);
+
+  const scalar_t t0 = 0;
+  const scalar_t t1 = 10;
+  vector_t initState(nx);
+  initState << 1, 0;
+  ocs2::LinearController control({t0}, {vector_t::Zero(nu)}, {matrix_t::Zero(nu, nx)});
+
+  scalar_array_t timeTrajectory;
+  size_array_t eventsPastTheEndIndeces;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numRollouts; i++) {
+    rollout.run(t0, initState, t1, &control, {t0}, timeTrajectory, eventsPastTheEndIndeces, stateTrajectory, inputTrajectory);
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  std::cerr << "[benchmarkBallDynamics] number of events: " << eventsPastTheEndIndeces.size()
+            << ", dynamics function calls: " << rollout.systemDynamicsPtr()->getNumFunctionCalls()
+            << ", time per rollout: " << std::chrono::duration<scalar_t, std::milli>(end - start).count() / numRollouts << " [ms]\n";
+  EXPECT_EQ(eventsPastTheEndIndeces.size(), 25);
+
+  // the state before each event is on one of the guard surfaces
+  for (const auto index : eventsPastTheEndIndeces) {
+    const vector_t guardSurfaces = dynamics.computeGuardSurfaces(timeTrajectory[index - 1], stateTrajectory[index - 1]);
+    EXPECT_LT(guardSurfaces.cwiseAbs().minCoeff(), rolloutSettings.absTolODE);
+  }
+}
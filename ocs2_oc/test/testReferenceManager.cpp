@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/synchronized_module/ReferenceManager.h"
+
+using namespace ocs2;
+
+namespace {
+TargetTrajectories getLinearTargetTrajectories(scalar_t startTime, scalar_t timeStep, size_t numPoints) {
+  TargetTrajectories targetTrajectories(numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    const scalar_t t = startTime + i * timeStep;
+    targetTrajectories.timeTrajectory[i] = t;
+    targetTrajectories.stateTrajectory[i] = vector_t::Constant(2, t);
+    targetTrajectories.inputTrajectory[i] = vector_t::Constant(1, -t);
+  }
+  return targetTrajectories;
+}
+}  // unnamed namespace
+
+TEST(testReferenceManager, appendIsAppliedInPreSolverRun) {
+  ReferenceManager referenceManager(getLinearTargetTrajectories(0.0, 0.1, 11));
+  const vector_t initState = vector_t::Zero(2);
+
+  // appended points are buffered until the next preSolverRun
+  referenceManager.appendTargetTrajectories(getLinearTargetTrajectories(1.1, 0.1, 5));
+  referenceManager.appendTargetTrajectories(getLinearTargetTrajectories(1.6, 0.1, 5));
+  EXPECT_EQ(referenceManager.getTargetTrajectories().size(), 11);
+
+  referenceManager.preSolverRun(0.0, 1.0, initState);
+  const auto& targetTrajectories = referenceManager.getTargetTrajectories();
+  ASSERT_EQ(targetTrajectories.size(), 21);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.back(), 2.0);
+  EXPECT_TRUE(std::is_sorted(targetTrajectories.timeTrajectory.begin(), targetTrajectories.timeTrajectory.end()));
+  EXPECT_TRUE(targetTrajectories.getDesiredState(1.55).isApprox(vector_t::Constant(2, 1.55)));
+  EXPECT_TRUE(targetTrajectories.getDesiredInput(1.55).isApprox(vector_t::Constant(1, -1.55)));
+
+  // without new points nothing changes
+  referenceManager.preSolverRun(0.0, 1.0, initState);
+  EXPECT_EQ(referenceManager.getTargetTrajectories().size(), 21);
+}
+
+TEST(testReferenceManager, overlappingAppend) {
+  ReferenceManager referenceManager(getLinearTargetTrajectories(0.0, 0.1, 11));
+
+  auto overlapping = getLinearTargetTrajectories(0.8, 0.2, 3);
+  for (auto& x : overlapping.stateTrajectory) {
+    x *= 2.0;
+  }
+  referenceManager.appendTargetTrajectories(overlapping);
+  referenceManager.preSolverRun(0.0, 1.0, vector_t::Zero(2));
+
+  const auto& targetTrajectories = referenceManager.getTargetTrajectories();
+  ASSERT_EQ(targetTrajectories.size(), 11);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.back(), 1.2);
+  EXPECT_TRUE(targetTrajectories.getDesiredState(0.7).isApprox(vector_t::Constant(2, 0.7)));
+  EXPECT_TRUE(targetTrajectories.getDesiredState(1.1).isApprox(vector_t::Constant(2, 2.2)));
+}
+
+TEST(testReferenceManager, setDiscardsPendingAppend) {
+  ReferenceManager referenceManager(getLinearTargetTrajectories(0.0, 0.1, 11));
+
+  referenceManager.appendTargetTrajectories(getLinearTargetTrajectories(1.1, 0.1, 5));
+  referenceManager.setTargetTrajectories(getLinearTargetTrajectories(0.0, 0.5, 3));
+  referenceManager.preSolverRun(0.0, 1.0, vector_t::Zero(2));
+
+  const auto& targetTrajectories = referenceManager.getTargetTrajectories();
+  ASSERT_EQ(targetTrajectories.size(), 3);
+  EXPECT_DOUBLE_EQ(targetTrajectories.timeTrajectory.back(), 1.0);
+
+  // an append after the set is applied on top of the new TargetTrajectories
+  referenceManager.setTargetTrajectories(getLinearTargetTrajectories(0.0, 0.1, 11));
+  referenceManager.appendTargetTrajectories(getLinearTargetTrajectories(1.1, 0.1, 5));
+  referenceManager.preSolverRun(0.0, 1.0, vector_t::Zero(2));
+  EXPECT_EQ(referenceManager.getTargetTrajectories().size(), 16);
+}
+
+TEST(testReferenceManager, recedingHorizon) {
+  constexpr size_t numPoints = 11;
+  constexpr scalar_t timeStep = 0.1;
+  constexpr scalar_t timeHorizon = (numPoints - 1) * timeStep;
+  ReferenceManager referenceManager(getLinearTargetTrajectories(0.0, timeStep, numPoints));
+
+  // every MPC cycle streams one new point and trims the reference up to the start of the horizon
+  for (size_t i = 1; i <= 100; i++) {
+    const scalar_t initTime = i * timeStep;
+    referenceManager.appendTargetTrajectories(getLinearTargetTrajectories(initTime + timeHorizon, timeStep, 1));
+    referenceManager.preSolverRun(initTime, initTime + timeHorizon, vector_t::Zero(2));
+
+    const auto& targetTrajectories = referenceManager.getTargetTrajectories();
+    ASSERT_LE(targetTrajectories.size(), 2 * (numPoints + 1));
+    ASSERT_LE(targetTrajectories.timeTrajectory.front(), initTime);
+    ASSERT_NEAR(targetTrajectories.timeTrajectory.back(), initTime + timeHorizon, 1e-9);
+    const scalar_t t = initTime + 0.5 * timeHorizon;
+    EXPECT_TRUE(targetTrajectories.getDesiredState(t).isApprox(vector_t::Constant(2, t)));
+  }
+}
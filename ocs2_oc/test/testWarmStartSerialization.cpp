@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+
+#include "ocs2_oc/oc_solver/WarmStartSerialization.h"
+
+using namespace ocs2;
+
+namespace {
+PrimalSolution getRandomPrimalSolution(size_t numPoints) {
+  constexpr size_t stateDim = 3;
+  constexpr size_t inputDim = 2;
+
+  PrimalSolution solution;
+  solution.modeSchedule_ = ModeSchedule({0.5}, {0, 1});
+  std::unique_ptr<LinearController> controllerPtr(new LinearController);
+  for (size_t i = 0; i < numPoints; i++) {
+    const scalar_t t = static_cast<scalar_t>(i) / numPoints;
+    solution.timeTrajectory_.push_back(t);
+    solution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    solution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+    controllerPtr->timeStamp_.push_back(t);
+    controllerPtr->biasArray_.push_back(vector_t::Random(inputDim));
+    controllerPtr->gainArray().push_back(matrix_t::Random(inputDim, stateDim));
+  }
+  solution.controllerPtr_ = std::move(controllerPtr);
+  return solution;
+}
+
+std::string serialize(const PrimalSolution& solution) {
+  std::stringstream stream;
+  warm_start::write(stream, solution);
+  return stream.str();
+}
+}  // unnamed namespace
+
+TEST(testWarmStartSerialization, primalSolutionRoundTrip) {
+  const auto solution = getRandomPrimalSolution(10);
+
+  std::istringstream stream(serialize(solution));
+  PrimalSolution loaded;
+  warm_start::read(stream, loaded);
+
+  EXPECT_EQ(loaded.timeTrajectory_, solution.timeTrajectory_);
+  EXPECT_EQ(loaded.stateTrajectory_, solution.stateTrajectory_);
+  EXPECT_EQ(loaded.inputTrajectory_, solution.inputTrajectory_);
+  EXPECT_EQ(loaded.modeSchedule_.eventTimes, solution.modeSchedule_.eventTimes);
+  EXPECT_EQ(loaded.modeSchedule_.modeSequence, solution.modeSchedule_.modeSequence);
+
+  const auto* ctrlPtr = dynamic_cast<const LinearController*>(solution.controllerPtr_.get());
+  const auto* loadedCtrlPtr = dynamic_cast<const LinearController*>(loaded.controllerPtr_.get());
+  ASSERT_TRUE(loadedCtrlPtr != nullptr);
+  EXPECT_EQ(loadedCtrlPtr->timeStamp_, ctrlPtr->timeStamp_);
+  EXPECT_EQ(loadedCtrlPtr->biasArray_, ctrlPtr->biasArray_);
+  EXPECT_EQ(loadedCtrlPtr->gainArray(), ctrlPtr->gainArray());
+}
+
+TEST(testWarmStartSerialization, truncatedStream) {
+  const auto data = serialize(getRandomPrimalSolution(10));
+  for (const size_t length : {size_t(0), sizeof(size_t) + 3, data.size() / 2, data.size() - 1}) {
+    std::istringstream stream(data.substr(0, length));
+    PrimalSolution loaded;
+    EXPECT_THROW(warm_start::read(stream, loaded), std::runtime_error) << "length: " << length;
+  }
+}
+
+TEST(testWarmStartSerialization, hugeStoredSize) {
+  // a corrupted size must be rejected before anything is allocated
+  for (const size_t size : {size_t(1) << 40, std::numeric_limits<size_t>::max()}) {
+    std::stringstream stream;
+    warm_start::write(stream, size);
+    warm_start::write(stream, scalar_t(1.0));
+
+    vector_t vector;
+    EXPECT_THROW(warm_start::read(stream, vector), std::runtime_error);
+    stream.seekg(0);
+    std::string string;
+    EXPECT_THROW(warm_start::read(stream, string), std::runtime_error);
+    stream.seekg(0);
+    scalar_array_t array;
+    EXPECT_THROW(warm_start::read(stream, array), std::runtime_error);
+  }
+
+  // matrix with a valid number of rows but a huge number of columns
+  std::stringstream stream;
+  warm_start::write(stream, size_t(2));
+  warm_start::write(stream, std::numeric_limits<size_t>::max() / 2);
+  warm_start::write(stream, scalar_t(1.0));
+  matrix_t matrix;
+  EXPECT_THROW(warm_start::read(stream, matrix), std::runtime_error);
+}
+
+TEST(testWarmStartSerialization, inconsistentSizes) {
+  // the state trajectory is shorter than the time trajectory
+  auto solution = getRandomPrimalSolution(10);
+  solution.stateTrajectory_.pop_back();
+  {
+    std::istringstream stream(serialize(solution));
+    PrimalSolution loaded;
+    EXPECT_THROW(warm_start::read(stream, loaded), std::runtime_error);
+  }
+
+  // the gains of the controller are shorter than its time stamps
+  solution = getRandomPrimalSolution(10);
+  dynamic_cast<LinearController&>(*solution.controllerPtr_).gainArray().pop_back();
+  {
+    std::istringstream stream(serialize(solution));
+    PrimalSolution loaded;
+    EXPECT_THROW(warm_start::read(stream, loaded), std::runtime_error);
+  }
+
+  // the mode sequence does not match the event times
+  std::stringstream stream;
+  warm_start::write(stream, scalar_array_t{0.5, 1.0});
+  warm_start::write(stream, size_array_t{0, 1});
+  ModeSchedule modeSchedule;
+  EXPECT_THROW(warm_start::read(stream, modeSchedule), std::runtime_error);
+}
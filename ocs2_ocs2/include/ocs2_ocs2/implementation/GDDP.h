@@ -301,7 +301,7 @@ void GDDP<STATE_DIM, INPUT_DIM>::propagateRolloutSensitivity(size_t workerIndex,
     rolloutSensitivityEquationsPtrStock_[workerIndex]->resetNumFunctionCalls();
     rolloutSensitivityEquationsPtrStock_[workerIndex]->setData(
         &dataCollectorPtr_->nominalTimeTrajectoriesStock_[i], &dataCollectorPtr_->modelDataTrajectoriesStock_[i],
-        &controllersStock[i].timeStamp_, &LvTrajectoriesStock[i], &controllersStock[i].gainArray_);
+        &controllersStock[i].timeStamp_, &LvTrajectoriesStock[i], &controllersStock[i].gainArray());
 
     // max number of steps of integration
     const size_t maxNumSteps = gddpSettings_.maxNumStepsPerSecond_ *
@@ -595,7 +595,7 @@ void GDDP<STATE_DIM, INPUT_DIM>::solveSensitivityBVP(size_t workerIndex, const s
         &dataCollectorPtr_->nominalTimeTrajectoriesStock_[i], &dataCollectorPtr_->modelDataTrajectoriesStock_[i],
         &dataCollectorPtr_->projectedModelDataTrajectoriesStock_[i], &nominalCostateTrajectoriesStock_[i],
         &nominalLagrangianTrajectoriesStock_[i], &dataCollectorPtr_->optimizedControllersStock_[i].timeStamp_,
-        &dataCollectorPtr_->optimizedControllersStock_[i].gainArray_, &dataCollectorPtr_->SmTrajectoriesStock_[i]);
+        &dataCollectorPtr_->optimizedControllersStock_[i].gainArray(), &dataCollectorPtr_->SmTrajectoriesStock_[i]);
 
     // set data for Riccati error equations
     bvpSensitivityErrorEquationsPtrStock_[workerIndex]->resetNumFunctionCalls();
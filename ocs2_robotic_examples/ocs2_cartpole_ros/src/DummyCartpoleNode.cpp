@@ -60,6 +60,7 @@ int main(int argc, char** argv) {
 
   // MRT
   ocs2::MRT_ROS_Interface mrt(robotName);
+  mrt.setGainCompression(cartPoleInterface.mpcSettings().gainCompressionStride_, cartPoleInterface.mpcSettings().gainCompressionTolerance_);
   mrt.initRollout(&cartPoleInterface.getRollout());
   mrt.launchNodes(nodeHandle);
 
@@ -0,0 +1,138 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/cost/QuasiNewtonStateCost.h>
+#include <ocs2_ddp/SLQ.h>
+
+#include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
+#include "ocs2_mobile_manipulator/package_path.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+class testQuasiNewtonEndEffector : public testing::Test {
+ protected:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using quaternion_t = Eigen::Quaternion<scalar_t, Eigen::DontAlign>;
+
+  testQuasiNewtonEndEffector() {
+    const std::string taskFile = ocs2::mobile_manipulator::getPath() + "/config/mpc/task.info";
+    const std::string libFolder = ocs2::mobile_manipulator::getPath() + "/auto_generated";
+    const std::string urdfFile = ocs2::mobile_manipulator::getPath() + "/urdf/mobile_manipulator.urdf";
+    mobileManipulatorInterfacePtr.reset(new MobileManipulatorInterface(taskFile, libFolder, urdfFile));
+
+    const vector_t goalState = (vector_t(7) << goalPosition, goalOrientation.coeffs()).finished();
+    TargetTrajectories targetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)});
+    mobileManipulatorInterfacePtr->getReferenceManagerPtr()->setTargetTrajectories(std::move(targetTrajectories));
+  }
+
+  /** Copies the optimal control problem, wrapping the end-effector soft constraints with quasi-Newton Hessian estimates */
+  OptimalControlProblem getQuasiNewtonProblem(const quasi_newton::Settings& settings) const {
+    const auto& problem = mobileManipulatorInterfacePtr->getOptimalControlProblem();
+    OptimalControlProblem quasiNewtonProblem(problem);
+
+    auto wrap = [&](StateCostCollection& collection, const std::string& name) {
+      std::unique_ptr<StateCost> eeConstraint(collection.get<StateCost>(name).clone());
+      return std::unique_ptr<StateCost>(new QuasiNewtonStateCost(std::move(eeConstraint), settings));
+    };
+    quasiNewtonProblem.stateSoftConstraintPtr.reset(new StateCostCollection);
+    quasiNewtonProblem.stateSoftConstraintPtr->add(
+        "selfCollision", std::unique_ptr<StateCost>(problem.stateSoftConstraintPtr->get<StateCost>("selfCollision").clone()));
+    quasiNewtonProblem.stateSoftConstraintPtr->add("enfEffector", wrap(*problem.stateSoftConstraintPtr, "enfEffector"));
+    quasiNewtonProblem.finalSoftConstraintPtr.reset(new StateCostCollection);
+    quasiNewtonProblem.finalSoftConstraintPtr->add("finalEndEffector", wrap(*problem.finalSoftConstraintPtr, "finalEndEffector"));
+    return quasiNewtonProblem;
+  }
+
+  /** Solves the problem from the initial state, and returns the number of iterations and the average time per iteration [ms] */
+  std::pair<size_t, scalar_t> solve(const OptimalControlProblem& problem, scalar_t& finalCost) const {
+    auto& interface = *mobileManipulatorInterfacePtr;
+    auto ddpSettings = interface.ddpSettings();
+    ddpSettings.maxNumIterations_ = maxNumIterations;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+
+    SLQ slq(ddpSettings, interface.getRollout(), problem, interface.getInitializer());
+    slq.setReferenceManager(interface.getReferenceManagerPtr());
+
+    const auto start = std::chrono::steady_clock::now();
+    slq.run(initTime, interface.getInitialState(), finalTime, {initTime, finalTime});
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto numIterations = slq.getIterationsLog().size();
+    finalCost = slq.getPerformanceIndeces().merit;
+    const scalar_t totalTime = std::chrono::duration<scalar_t, std::milli>(end - start).count();
+    return {numIterations, totalTime / static_cast<scalar_t>(numIterations)};
+  }
+
+  static constexpr scalar_t initTime = 0.0;
+  static constexpr scalar_t finalTime = 1.0;
+  static constexpr size_t maxNumIterations = 50;
+
+  const vector3_t goalPosition = vector3_t(1.0, 0.0, 1.0);
+  const quaternion_t goalOrientation = quaternion_t(1.0, 0.0, 0.0, 0.0);
+
+  std::unique_ptr<MobileManipulatorInterface> mobileManipulatorInterfacePtr;
+};
+
+constexpr scalar_t testQuasiNewtonEndEffector::initTime;
+constexpr scalar_t testQuasiNewtonEndEffector::finalTime;
+constexpr size_t testQuasiNewtonEndEffector::maxNumIterations;
+
+TEST_F(testQuasiNewtonEndEffector, convergence) {
+  quasi_newton::Settings bfgsSettings;
+  bfgsSettings.update = quasi_newton::HessianUpdate::BFGS;
+  quasi_newton::Settings sr1Settings;
+  sr1Settings.update = quasi_newton::HessianUpdate::SR1;
+
+  scalar_t gaussNewtonCost, bfgsCost, sr1Cost;
+  const auto gaussNewton = solve(mobileManipulatorInterfacePtr->getOptimalControlProblem(), gaussNewtonCost);
+  const auto bfgs = solve(getQuasiNewtonProblem(bfgsSettings), bfgsCost);
+  const auto sr1 = solve(getQuasiNewtonProblem(sr1Settings), sr1Cost);
+
+  auto print = [](const std::string& name, const std::pair<size_t, scalar_t>& result, scalar_t cost) {
+    std::cerr << "  " << name << ": iterations: " << result.first << ", time per iteration: " << result.second
+              << " [ms], final merit: " << cost << "\n";
+  };
+  std::cerr << "[testQuasiNewtonEndEffector] end-effector soft constraint curvature\n";
+  print("Gauss-Newton", gaussNewton, gaussNewtonCost);
+  print("damped BFGS  ", bfgs, bfgsCost);
+  print("SR1          ", sr1, sr1Cost);
+
+  EXPECT_LT(bfgs.first, maxNumIterations);
+  EXPECT_LT(sr1.first, maxNumIterations);
+  EXPECT_NEAR(bfgsCost, gaussNewtonCost, 1e-2 * std::abs(gaussNewtonCost) + 1e-3);
+  EXPECT_NEAR(sr1Cost, gaussNewtonCost, 1e-2 * std::abs(gaussNewtonCost) + 1e-3);
+}
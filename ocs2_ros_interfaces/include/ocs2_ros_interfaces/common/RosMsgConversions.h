@@ -50,18 +50,27 @@ ocs2_msgs::mpc_observation createObservationMsg(const SystemObservation& observa
 /** Reads the observation message. */
 SystemObservation readObservationMsg(const ocs2_msgs::mpc_observation& observationMsg);
 
+/** Reads the observation message into the given observation, whose memory is reused. */
+void readObservationMsg(const ocs2_msgs::mpc_observation& observationMsg, SystemObservation& observation);
+
 /** Creates the mode sequence message. */
 ocs2_msgs::mode_schedule createModeScheduleMsg(const ModeSchedule& modeSchedule);
 
 /** Reads the mode sequence message. */
 ModeSchedule readModeScheduleMsg(const ocs2_msgs::mode_schedule& modeScheduleMsg);
 
+/** Reads the mode sequence message into the given mode schedule, whose memory is reused. */
+void readModeScheduleMsg(const ocs2_msgs::mode_schedule& modeScheduleMsg, ModeSchedule& modeSchedule);
+
 /** Creates the target trajectories message. */
 ocs2_msgs::mpc_target_trajectories createTargetTrajectoriesMsg(const TargetTrajectories& targetTrajectories);
 
 /** Returns the TargetTrajectories message. */
 TargetTrajectories readTargetTrajectoriesMsg(const ocs2_msgs::mpc_target_trajectories& targetTrajectoriesMsg);
 
+/** Reads the TargetTrajectories message into the given target trajectories, whose memory is reused. */
+void readTargetTrajectoriesMsg(const ocs2_msgs::mpc_target_trajectories& targetTrajectoriesMsg, TargetTrajectories& targetTrajectories);
+
 /**
  * Creates the performance indices message.
  *
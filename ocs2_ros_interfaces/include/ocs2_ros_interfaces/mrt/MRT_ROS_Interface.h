@@ -55,6 +55,8 @@ namespace ocs2 {
 
 /**
  * This class implements MRT (Model Reference Tracking) communication interface using ROS.
+ * The feedback gains of the received linear policies can be compressed with setGainCompression(), e.g. with the gainCompressionStride
+ * and gainCompressionTolerance fields of the MPC settings.
  */
 class MRT_ROS_Interface : public MRT_BASE {
  public:
@@ -108,7 +110,9 @@ class MRT_ROS_Interface : public MRT_BASE {
   void mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg);
 
   /**
-   * Helper function to read a MPC policy message.
+   * Helper function to read a MPC policy message. The outputs are overwritten in place: the trajectories, the target trajectories, and
+   * a controller of the same type reuse their memory, such that reading into a recycled policy of the same size does not allocate
+   * apart from the temporary dimension and pointer arrays.
    *
    * @param [in] msg: A constant pointer to the message
    * @param [out] commandData: The MPC command data
@@ -60,7 +60,14 @@ ocs2_msgs::mpc_observation createObservationMsg(const SystemObservation& observa
 /******************************************************************************************************/
 SystemObservation readObservationMsg(const ocs2_msgs::mpc_observation& observationMsg) {
   SystemObservation observation;
+  readObservationMsg(observationMsg, observation);
+  return observation;
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void readObservationMsg(const ocs2_msgs::mpc_observation& observationMsg, SystemObservation& observation) {
   observation.time = observationMsg.time;
 
   const auto& state = observationMsg.state.value;
@@ -70,8 +77,6 @@ SystemObservation readObservationMsg(const ocs2_msgs::mpc_observation& observati
   observation.input = Eigen::Map<const Eigen::VectorXf>(input.data(), input.size()).cast<scalar_t>();
 
   observation.mode = observationMsg.mode;
-
-  return observation;
 }
 
 /******************************************************************************************************/
@@ -100,21 +105,20 @@ ocs2_msgs::mode_schedule createModeScheduleMsg(const ModeSchedule& modeSchedule)
 /******************************************************************************************************/
 /******************************************************************************************************/
 ModeSchedule readModeScheduleMsg(const ocs2_msgs::mode_schedule& modeScheduleMsg) {
+  ModeSchedule modeSchedule;
+  readModeScheduleMsg(modeScheduleMsg, modeSchedule);
+  return modeSchedule;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void readModeScheduleMsg(const ocs2_msgs::mode_schedule& modeScheduleMsg, ModeSchedule& modeSchedule) {
   // event times
-  scalar_array_t eventTimes;
-  eventTimes.reserve(modeScheduleMsg.eventTimes.size());
-  for (const auto& ti : modeScheduleMsg.eventTimes) {
-    eventTimes.push_back(ti);
-  }
+  modeSchedule.eventTimes.assign(modeScheduleMsg.eventTimes.begin(), modeScheduleMsg.eventTimes.end());
 
   // mode sequence
-  size_array_t modeSequence;
-  modeSequence.reserve(modeScheduleMsg.modeSequence.size());
-  for (const auto& si : modeScheduleMsg.modeSequence) {
-    modeSequence.push_back(si);
-  }
-
-  return {eventTimes, modeSequence};
+  modeSchedule.modeSequence.assign(modeScheduleMsg.modeSequence.begin(), modeScheduleMsg.modeSequence.end());
 }
 
 /******************************************************************************************************/
@@ -189,14 +193,25 @@ ocs2_msgs::mpc_target_trajectories createTargetTrajectoriesMsg(const TargetTraje
 /******************************************************************************************************/
 /******************************************************************************************************/
 TargetTrajectories readTargetTrajectoriesMsg(const ocs2_msgs::mpc_target_trajectories& targetTrajectoriesMsg) {
+  TargetTrajectories targetTrajectories;
+  readTargetTrajectoriesMsg(targetTrajectoriesMsg, targetTrajectories);
+  return targetTrajectories;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void readTargetTrajectoriesMsg(const ocs2_msgs::mpc_target_trajectories& targetTrajectoriesMsg, TargetTrajectories& targetTrajectories) {
   size_t N = targetTrajectoriesMsg.stateTrajectory.size();
   if (N == 0) {
     throw std::runtime_error("An empty target trajectories message is received.");
   }
 
   // state and time
-  scalar_array_t desiredTimeTrajectory(N);
-  vector_array_t desiredStateTrajectory(N);
+  auto& desiredTimeTrajectory = targetTrajectories.timeTrajectory;
+  auto& desiredStateTrajectory = targetTrajectories.stateTrajectory;
+  desiredTimeTrajectory.resize(N);
+  desiredStateTrajectory.resize(N);
   for (size_t i = 0; i < N; i++) {
     desiredTimeTrajectory[i] = targetTrajectoriesMsg.timeTrajectory[i];
 
@@ -207,14 +222,13 @@ TargetTrajectories readTargetTrajectoriesMsg(const ocs2_msgs::mpc_target_traject
 
   // input
   N = targetTrajectoriesMsg.inputTrajectory.size();
-  vector_array_t desiredInputTrajectory(N);
+  auto& desiredInputTrajectory = targetTrajectories.inputTrajectory;
+  desiredInputTrajectory.resize(N);
   for (size_t i = 0; i < N; i++) {
     desiredInputTrajectory[i] = Eigen::Map<const Eigen::VectorXf>(targetTrajectoriesMsg.inputTrajectory[i].value.data(),
                                                                   targetTrajectoriesMsg.inputTrajectory[i].value.size())
                                     .cast<scalar_t>();
   }  // end of i loop
-
-  return {desiredTimeTrajectory, desiredStateTrajectory, desiredInputTrajectory};
 }
 
 }  // namespace ros_msg_conversions
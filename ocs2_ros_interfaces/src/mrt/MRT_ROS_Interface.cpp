@@ -129,10 +129,10 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
   auto& inputBuffer = primalSolution.inputTrajectory_;
   auto& controlBuffer = primalSolution.controllerPtr_;
 
-  commandData.mpcInitObservation_ = ros_msg_conversions::readObservationMsg(msg.initObservation);
-  commandData.mpcTargetTrajectories_ = ros_msg_conversions::readTargetTrajectoriesMsg(msg.planTargetTrajectories);
+  ros_msg_conversions::readObservationMsg(msg.initObservation, commandData.mpcInitObservation_);
+  ros_msg_conversions::readTargetTrajectoriesMsg(msg.planTargetTrajectories, commandData.mpcTargetTrajectories_);
   performanceIndices = ros_msg_conversions::readPerformanceIndicesMsg(msg.performanceIndices);
-  primalSolution.modeSchedule_ = ros_msg_conversions::readModeScheduleMsg(msg.modeSchedule);
+  ros_msg_conversions::readModeScheduleMsg(msg.modeSchedule, primalSolution.modeSchedule_);
 
   const size_t N = msg.timeTrajectory.size();
   size_array_t stateDim(N);
@@ -144,19 +144,16 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
     throw std::runtime_error("[MRT_ROS_Interface::readPolicyMsg] controller must have same size!");
   }
 
-  timeBuffer.clear();
-  timeBuffer.reserve(N);
-  stateBuffer.clear();
-  stateBuffer.reserve(N);
-  inputBuffer.clear();
-  inputBuffer.reserve(N);
-
+  // the elements are overwritten in place, such that the memory of a recycled solution is reused
+  timeBuffer.resize(N);
+  stateBuffer.resize(N);
+  inputBuffer.resize(N);
   for (size_t i = 0; i < N; i++) {
-    timeBuffer.emplace_back(msg.timeTrajectory[i]);
+    timeBuffer[i] = msg.timeTrajectory[i];
     stateDim[i] = msg.stateTrajectory[i].value.size();
-    stateBuffer.emplace_back(Eigen::Map<const Eigen::VectorXf>(msg.stateTrajectory[i].value.data(), stateDim[i]).cast<scalar_t>());
+    stateBuffer[i] = Eigen::Map<const Eigen::VectorXf>(msg.stateTrajectory[i].value.data(), stateDim[i]).cast<scalar_t>();
     inputDim[i] = msg.inputTrajectory[i].value.size();
-    inputBuffer.emplace_back(Eigen::Map<const Eigen::VectorXf>(msg.inputTrajectory[i].value.data(), inputDim[i]).cast<scalar_t>());
+    inputBuffer[i] = Eigen::Map<const Eigen::VectorXf>(msg.inputTrajectory[i].value.data(), inputDim[i]).cast<scalar_t>();
   }
 
   // check data size
@@ -169,16 +166,24 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
     controllerDataPtrArray[i] = &(msg.data[i].data);
   }
 
-  // instantiate the correct controller
+  // instantiate the correct controller, a controller of the same type is overwritten in place
   switch (msg.controllerType) {
     case ocs2_msgs::mpc_flattened_controller::CONTROLLER_FEEDFORWARD: {
-      auto controller = FeedforwardController::unFlatten(timeBuffer, controllerDataPtrArray);
-      controlBuffer.reset(new FeedforwardController(std::move(controller)));
+      auto* controllerPtr = dynamic_cast<FeedforwardController*>(controlBuffer.get());
+      if (controllerPtr == nullptr) {
+        controllerPtr = new FeedforwardController;
+        controlBuffer.reset(controllerPtr);
+      }
+      FeedforwardController::unFlatten(timeBuffer, controllerDataPtrArray, *controllerPtr);
       break;
     }
     case ocs2_msgs::mpc_flattened_controller::CONTROLLER_LINEAR: {
-      auto controller = LinearController::unFlatten(stateDim, inputDim, timeBuffer, controllerDataPtrArray);
-      controlBuffer.reset(new LinearController(std::move(controller)));
+      auto* controllerPtr = dynamic_cast<LinearController*>(controlBuffer.get());
+      if (controllerPtr == nullptr) {
+        controllerPtr = new LinearController;
+        controlBuffer.reset(controllerPtr);
+      }
+      LinearController::unFlatten(stateDim, inputDim, timeBuffer, controllerDataPtrArray, *controllerPtr);
       break;
     }
     default:
@@ -191,9 +196,9 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
 /******************************************************************************************************/
 void MRT_ROS_Interface::mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg) {
   // read new policy and command from msg
-  std::unique_ptr<CommandData> commandPtr(new CommandData);
-  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
-  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
+  auto commandPtr = acquireCommandData();
+  auto primalSolutionPtr = acquirePrimalSolution();
+  auto performanceIndicesPtr = acquirePerformanceIndex();
   readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
 
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
@@ -33,6 +33,38 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * Cache of the input Jacobian factorization used by the constraint projections. The factorization and the null-space basis of the last
+ * input Jacobian D are stored, such that they are reused when the next projection has the same D, e.g. for linear state-input constraints
+ * across nodes and across iterations.
+ */
+struct ConstraintProjectionCache {
+  /** Returns true if D is the input Jacobian of the cached factorization. */
+  bool isCached(const matrix_t& D) const {
+    return inputJacobian.rows() == D.rows() && inputJacobian.cols() == D.cols() && inputJacobian == D;
+  }
+
+  /** Sets D as the input Jacobian of the cache and invalidates the stored factorizations. */
+  void reset(const matrix_t& D) {
+    inputJacobian = D;
+    hasLu = false;
+    hasQr = false;
+  }
+
+  matrix_t inputJacobian;  // input Jacobian D of the cached factorization
+
+  // LU based projection
+  bool hasLu = false;
+  Eigen::FullPivLU<matrix_t> lu;
+  matrix_t luKernel;
+
+  // QR based projection
+  bool hasQr = false;
+  matrix_t Q1;  // range of D^T
+  matrix_t Q2;  // null-space of D
+  matrix_t RT;  // lower triangular R^T
+};
+
 /**
  * Returns the linear projection
  *  u = Pu * \tilde{u} + Px * x + Pe
@@ -46,6 +78,17 @@ namespace ocs2 {
  */
 VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Same as qrConstraintProjection(constraint), but the QR decomposition of D^T is reused from the cache if D is unchanged.
+ * Otherwise, the cache is updated with the new decomposition.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f;
+ * @param cache : Cache of the last factorization.
+ * @return Px = dfdx, Pu = dfdu, Pe = f;
+ */
+VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                                         ConstraintProjectionCache& cache);
+
 /**
  * Returns the linear projection
  *  u = Pu * \tilde{u} + Px * x + Pe
@@ -59,4 +102,15 @@ VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLin
  */
 VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Same as luConstraintProjection(constraint), but the LU decomposition of D and its kernel are reused from the cache if D is unchanged.
+ * Otherwise, the cache is updated with the new decomposition.
+ *
+ * @param constraint : C = dfdx, D = dfdu, e = f;
+ * @param cache : Cache of the last factorization.
+ * @return Px = dfdx, Pu = dfdu, Pe = f;
+ */
+VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                                         ConstraintProjectionCache& cache);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -0,0 +1,95 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_sqp/TimeDiscretization.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Decides on the input move blocking along the horizon. Consecutive nodes of a block share one input decision variable. The first
+ * numUnblockedNodes nodes have an independent input, after that each block is ceil(growth * previous block size) nodes long, up to
+ * maxBlockSize. Blocks are cut at events, event nodes have no input.
+ *
+ * @param time : time discretization of the horizon (N+1 nodes).
+ * @param numUnblockedNodes : number of nodes at the start of the horizon that keep an independent input.
+ * @param growth : growth factor of the block size.
+ * @param maxBlockSize : maximum number of nodes in a block.
+ * @return for each of the N intermediate and event nodes, the index of the first node of its block.
+ */
+std::vector<int> getMoveBlocks(const std::vector<AnnotatedTime>& time, size_t numUnblockedNodes, scalar_t growth, size_t maxBlockSize);
+
+/**
+ * QP subproblem with one stage per block. The states inside a block are eliminated with the linearized dynamics (condensing), such that
+ * the QP has the states at the start of the blocks and one input per block as decision variables.
+ */
+struct MoveBlockedSubproblem {
+  std::vector<int> stageNodes;  // Node at the start of each stage, the last entry is the terminal node
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  std::vector<VectorFunctionLinearApproximation> constraints;
+};
+
+/**
+ * Condenses the QP subproblem over the blocks. The time discretization of the dynamics is unchanged.
+ *
+ * @param moveBlocks : move blocking, see getMoveBlocks.
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param cost : Quadratic approximation of the cost.
+ * @param constraints : Linearized approximation of the constraints, or nullptr for an unconstrained QP. The constraints of the nodes
+ *                      inside a block are stacked in the constraints of its stage.
+ * @param blockedSubproblem : QP subproblem with the move blocking. The constraints are only set if constraints are provided.
+ */
+void blockQuadraticSubproblem(const std::vector<int>& moveBlocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                              const std::vector<VectorFunctionLinearApproximation>* constraints, MoveBlockedSubproblem& blockedSubproblem);
+
+/**
+ * Recovers the state and input of every node from the solution of the blocked QP subproblem.
+ *
+ * @param blockedSubproblem : QP subproblem with the move blocking.
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param stageXSol : states at the start of the stages.
+ * @param stageUSol : inputs of the stages.
+ * @param deltaXSol : states of all nodes.
+ * @param deltaUSol : inputs of all nodes, equal for all nodes of a block.
+ */
+void unblockSolution(const MoveBlockedSubproblem& blockedSubproblem, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const vector_array_t& stageXSol, const vector_array_t& stageUSol, vector_array_t& deltaXSol,
+                     vector_array_t& deltaUSol);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <string>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
@@ -37,6 +39,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
+/** Initialization of the part of the horizon that is not covered by the previous solution */
+enum class WarmStartTail {
+  Initializer,    // use the initializer of the solver
+  HoldLastInput,  // hold the last input of the previous solution
+  LastFeedback    // apply the feedback policy of the previous solution at its last node
+};
+
+/** Returns the name of the warm-start tail initialization */
+std::string toString(WarmStartTail warmStartTail);
+
+/** Returns the warm-start tail initialization from its name */
+WarmStartTail warmStartTailFromString(const std::string& name);
+
 struct Settings {
   // Sqp settings
   size_t sqpIteration = 10;  // Maximum number of SQP iterations
@@ -53,10 +68,28 @@ struct Settings {
   scalar_t armijoFactor = 1e-4;  // Armijo condition: c{i+1} < c{i} + armijoFactor * dc/dw'{i} * delta_w
   scalar_t gamma_c = 1e-6;       // (2b): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR c{i+1} < (1-gamma_c) * g{i}
 
+  // Linesearch - filter and second order correction
+  // Replaces (2a) and (2b) by the filter linesearch: a step has to be acceptable to the filter of previous iterates {(g, c)} and satisfy
+  // the armijo condition if the switching condition holds near feasibility, (2b) otherwise. Followed by a feasibility restoration step.
+  bool useFilterLineSearch = false;
+  size_t maxSecondOrderCorrections = 0;  // Maximum number of second order corrections after a rejected full step (filter only)
+
   // controller type
   bool useFeedbackPolicy = true;  // true to use feedback, false to use feedforward
 
+  // Warm start
+  bool useShiftWarmStart = false;  // Reuse the previous solution node by node if the new time grid is aligned with the previous one
+  scalar_t shiftTolerance = 0.1;   // Nodes are aligned if their times differ less than shiftTolerance * dt
+  WarmStartTail warmStartTail = WarmStartTail::Initializer;  // Initialization beyond the horizon of the previous solution
+
+  // Input move blocking: consecutive nodes share one input decision variable, with blocks growing toward the end of the horizon
+  bool useMoveBlocking = false;
+  size_t moveBlockingUnblockedNodes = 10;  // Number of nodes at the start of the horizon that keep an independent input
+  scalar_t moveBlockingGrowth = 1.5;       // Each block is ceil(moveBlockingGrowth * previous block size) nodes long
+  size_t moveBlockingMaxBlockSize = 8;     // Maximum number of nodes in a block
+
   // QP subproblem solver settings
+  bool usePartitionedRiccati = false;  // Use the parallel partitioned Riccati solver instead of HPIPM. Only for QPs without constraints.
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
   // Discretization method
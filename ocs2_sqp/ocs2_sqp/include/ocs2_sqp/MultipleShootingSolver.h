@@ -39,7 +39,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <hpipm_catkin/HpipmInterface.h>
 
+#include "ocs2_sqp/ConstraintProjection.h"
+#include "ocs2_sqp/MoveBlocking.h"
 #include "ocs2_sqp/MultipleShootingSettings.h"
+#include "ocs2_sqp/MultipleShootingTranscription.h"
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
 #include "ocs2_sqp/TimeDiscretization.h"
 
 namespace ocs2 {
@@ -79,6 +83,15 @@ class MultipleShootingSolver : public SolverBase {
     throw std::runtime_error("[MultipleShootingSolver] getStateInputEqualityConstraintLagrangian() not available yet.");
   }
 
+  /** Returns the time discretization step. */
+  scalar_t getTimeStep() const { return settings_.dt; }
+
+  /**
+   * Sets the time discretization step which is used from the next run. The previous solution is interpolated on the new grid.
+   * @note setTimeStep() must not be called while the solver is running.
+   */
+  void setTimeStep(scalar_t dt);
+
   // Irrelevant baseclass stuff
   void rewindOptimizer(size_t firstIndex) override{};
   const unsigned long long int& getRewindCounter() const override {
@@ -94,6 +107,14 @@ class MultipleShootingSolver : public SolverBase {
     runImpl(initTime, initState, finalTime, partitioningTimes);
   }
 
+  /** The warm-start state of the multiple-shooting solver is its primal solution. */
+  void saveWarmStartImpl(std::ostream& stream) const override;
+
+  void loadWarmStartImpl(std::istream& stream) override;
+
+  /** Copies the primal solution and its time discretization directly from another MultipleShootingSolver. */
+  void copyWarmStartImpl(const SolverBase& other) override;
+
   /** Run a task in parallel with settings.nThreads */
   void runParallel(std::function<void(int)> taskFunction);
 
@@ -104,6 +125,15 @@ class MultipleShootingSolver : public SolverBase {
   void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
                                         vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
 
+  /**
+   * Matches the nodes of the time discretization with the nodes of the previous solution. Returns for each node the index of the
+   * aligned node in the previous solution, or -1 if the node is beyond its horizon. Returns an empty array if the grids are not aligned.
+   */
+  std::vector<int> getShiftedNodeIndices(const std::vector<AnnotatedTime>& timeDiscretization) const;
+
+  /** Initializes the input and next state of an intermediate node beyond the horizon of the previous solution */
+  std::pair<vector_t, vector_t> initializeTailNode(scalar_t t, scalar_t tNext, const vector_t& x);
+
   /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u);
@@ -126,6 +156,12 @@ class MultipleShootingSolver : public SolverBase {
   /** Compute 2-norm of the trajectory: sqrt(sum_i v[i]^2)  */
   static scalar_t trajectoryNorm(const vector_array_t& v);
 
+  /**
+   * Shifts the constant terms of the dynamics and state-input equality constraints of the QP by their values at the trial point
+   * {x(t), u(t)}, such that the next QP solution is the second order correction of the rejected trial step.
+   */
+  void addSecondOrderCorrection(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u);
+
   /** Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} */
   std::pair<bool, PerformanceIndex> takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                              const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
@@ -143,19 +179,31 @@ class MultipleShootingSolver : public SolverBase {
 
   // Solution
   PrimalSolution primalSolution_;
+  std::vector<AnnotatedTime> primalSolutionTimeDiscretization_;
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  PartitionedRiccatiSolver partitionedRiccatiSolver_;
 
   // LQ approximation
   std::vector<VectorFunctionLinearApproximation> dynamics_;
   std::vector<ScalarFunctionQuadraticApproximation> cost_;
   std::vector<VectorFunctionLinearApproximation> constraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<ConstraintProjectionCache> projectionCaches_;  // one per worker, reused across nodes and iterations
+  std::vector<multiple_shooting::ProjectionSensitivity> projectionSensitivities_;  // only filled for the second order correction
+
+  // Input move blocking, moveBlocks_ is empty if not used
+  std::vector<int> moveBlocks_;
+  multiple_shooting::MoveBlockedSubproblem moveBlockedSubproblem_;
 
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
+  // Filter of the linesearch: pairs of {constraint violation, merit} that a step has to improve on
+  std::vector<std::pair<scalar_t, scalar_t>> filter_;
+  scalar_t filterMinConstraintViolation_ = 0.0;  // below this violation, a step can be accepted for the armijo condition
+
   // Benchmarking
   size_t totalNumIterations_{0};
   benchmark::RepeatedTimer initializationTimer_;
@@ -34,9 +34,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
 
+#include "ocs2_sqp/ConstraintProjection.h"
+
 namespace ocs2 {
 namespace multiple_shooting {
 
+/**
+ * Sensitivity of the projected LQ approximation of an intermediate node w.r.t. the value e of the state-input equality constraints.
+ * Changing e to e + de, without changing the constraint Jacobians, changes the dynamics bias by dynamicsBias * de, the cost gradients by
+ * costStateGradient * de and costInputGradient * de, and the offset Pe of the projection by projectionBias * de.
+ */
+struct ProjectionSensitivity {
+  matrix_t dynamicsBias;
+  matrix_t costStateGradient;
+  matrix_t costInputGradient;
+  matrix_t projectionBias;
+};
+
 /**
  * Results of the transcription at an intermediate node
  */
@@ -46,6 +60,7 @@ struct Transcription {
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
   VectorFunctionLinearApproximation constraintsProjection;
+  ProjectionSensitivity projectionSensitivity;  // Only computed on request, and if the constraints are projected
 };
 
 /**
@@ -59,11 +74,15 @@ struct Transcription {
  * @param x : State at start of the interval
  * @param x_next : State at the end of the interval
  * @param u : Input, taken to be constant across the interval.
+ * @param projectionCachePtr : Optional cache of the constraint projection factorization. It is reused if the input Jacobian of the
+ *                             state-input equality constraints is the same as in the last call with this cache.
+ * @param computeProjectionSensitivity : Compute the sensitivity of the projected LQ approximation w.r.t. the constraint value.
  * @return multiple shooting transcription for this node.
  */
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                    ConstraintProjectionCache* projectionCachePtr = nullptr, bool computeProjectionSensitivity = false);
 
 /**
  * Compute only the performance index for a single intermediate node.
@@ -72,6 +91,23 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
 PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
                                                 scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * Values of the equality constraints of an intermediate node: the dynamics gap x_{k+1} - F(x_{k}, u_{k}), and the state-input equality
+ * constraints, which are empty if the problem has none.
+ */
+struct ConstraintValues {
+  vector_t dynamicsGap;
+  vector_t stateInputEqConstraints;
+};
+
+/**
+ * Compute only the values of the equality constraints for a single intermediate node.
+ * Corresponds to the constant terms of the dynamics and constraints returned by "setupIntermediateNode"
+ */
+ConstraintValues computeIntermediateConstraintValues(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
+                                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next,
+                                                     const vector_t& u);
+
 /**
  * Results of the transcription at a terminal node
  */
@@ -119,6 +155,13 @@ struct EventTranscription {
 EventTranscription setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
                                   const vector_t& x_next);
 
+/**
+ * Compute only the dynamics gap of the event node.
+ * Corresponds to the constant term of the dynamics returned by "setupEventNode"
+ */
+vector_t computeEventDynamicsGap(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                 const vector_t& x_next);
+
 /**
  * Compute only the performance index for the event node.
  * Corresponds to the performance index returned by "setupEventNode"
@@ -0,0 +1,161 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Solves the unconstrained discrete linear quadratic optimal control problem with a partitioned Riccati recursion, as an alternative
+ * to HPIPM when the QP has no constraints (e.g. when the state-input equality constraints are projected).
+ *
+ * The horizon is split into partitions that are processed in parallel on a thread pool:
+ * 1. Each partition runs a Riccati recursion backward with the terminal cost 0.5 * x_end' * P_end * x_end + lambda' * x_end, where
+ *    the costate offset lambda is still unknown. The feedforward and the state at the end of the partition are therefore affine in
+ *    (x_start, lambda).
+ * 2. The small coupling system in the boundary states and costates is solved with a serial recursion over the partitions.
+ * 3. Each partition rolls out its states and inputs from the now known boundary state and costate.
+ *
+ * The terminal Hessian P_end of a partition is the value function Hessian at the start of the next partition, propagated from the
+ * previous call of solve(). It makes the input Hessians of the partitions positive definite whenever the ones of a single Riccati
+ * recursion are, also for stages with a positive semi-definite input cost. On the first call, or if the propagated Hessians fail,
+ * they are computed by a serial Riccati recursion without the affine terms.
+ *
+ * The result is the exact solution of the QP, identical to the one of a single Riccati recursion over the whole horizon, for any
+ * choice of P_end.
+ */
+class PartitionedRiccatiSolver {
+ public:
+  /**
+   * Constructor
+   *
+   * @param threadPool : Thread pool to run the partitions on. It must outlive this object.
+   * @param numThreads : Number of threads to use, including the calling thread.
+   * @param numPartitions : Number of partitions of the horizon. It is limited to the number of stages.
+   */
+  PartitionedRiccatiSolver(ThreadPool& threadPool, size_t numThreads, size_t numPartitions);
+
+  /**
+   * Solves the discrete linear quadratic optimal control problem
+   *    min  sum_k l_k(x_k, u_k) + l_N(x_N)
+   *    s.t. x_{k+1} = A_k x_k + B_k u_k + b_k,  x_0 = x0
+   *
+   * The state and input dimensions may vary over the horizon, e.g. event nodes without input.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics, of size N.
+   * @param cost : Quadratic approximation of the cost, of size N + 1.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory, of size N + 1.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory, of size N.
+   * @return false if the input Hessian of the Riccati recursion is not positive definite at some stage.
+   */
+  bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+             vector_array_t& inputTrajectory);
+
+  /**
+   * Returns the sequence of N feedback matrices for the previously solved problem. The problem data has to be the same as in the
+   * last call to solve(). The feedback of the partitions whose terminal Hessian matched the value function of the next partition
+   * is reused from solve(), only the others are recomputed.
+   *
+   * @param dynamics : Linearized approximation of the discrete dynamics, of size N.
+   * @param cost : Quadratic approximation of the cost, of size N + 1.
+   * @return Sequence of feedback matrices K of the optimal solution u = K x + k
+   */
+  matrix_array_t getRiccatiFeedback(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                    const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+ private:
+  /** Runs the Riccati recursion of all partitions in parallel. Returns false if it fails for any of them. */
+  bool solvePartitions(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                       const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+  /** Checks whether the terminal Hessians of the partitions from the previous call have the right dimensions. */
+  bool hasTerminalHessians(const std::vector<VectorFunctionLinearApproximation>& dynamics) const;
+
+  /** Computes the exact terminal Hessians of the partitions with a serial Riccati recursion. Returns false if it fails. */
+  bool computeTerminalHessians(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                               const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+  /** Riccati recursion and affine boundary map of a partition, given the value function (P, p + Gamma * lambda) at its end. */
+  bool solvePartition(size_t partitionIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                      const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+  /** Solves the coupling system of the boundary states and costates. */
+  void solveCoupling(const vector_t& x0);
+
+  /** Rolls out the states and inputs of a partition from its boundary state and costate. */
+  void rolloutPartition(size_t partitionIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const;
+
+  /** Runs task(partitionIndex) for all partitions on the thread pool. */
+  void runParallelOverPartitions(const std::function<void(size_t)>& task);
+
+  /** Data of a partition covering the stages [start, end) */
+  struct Partition {
+    int start;
+    int end;
+
+    // Hessian of the terminal cost and whether it is equal to the value function Hessian at the start of the next partition
+    matrix_t terminalHessian;
+    bool exactTerminalHessian = false;
+
+    // value function at the start: V(x) = 0.5 x' P x + (p + Gamma * lambda)' x
+    matrix_t P;
+    vector_t p;
+    matrix_t Gamma;
+
+    // state at the end: x_end = Phi * x_start + Psi * lambda + c
+    matrix_t Phi;
+    matrix_t Psi;
+    vector_t c;
+
+    // solution of the coupling system: value function Hessian, state and costate at the boundaries
+    matrix_t S;
+    vector_t s;
+    matrix_t lambdaHessian;  // d(lambda) / d(x_end) = S_next - terminalHessian
+    vector_t xStart;
+    vector_t lambda;
+    Eigen::PartialPivLU<matrix_t> couplingLu;
+  };
+
+  ThreadPool& threadPool_;
+  size_t numThreads_;
+  size_t numPartitions_;
+
+  std::vector<Partition> partitions_;
+  matrix_array_t feedback_;           // K_k
+  vector_array_t feedforward_;        // k_k
+  matrix_array_t feedforwardLambda_;  // d(k_k) / d(lambda)
+};
+
+}  // namespace ocs2
@@ -64,4 +64,54 @@ VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLin
   return projectionTerms;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                                         ConstraintProjectionCache& cache) {
+  if (!cache.isCached(constraint.dfdu)) {
+    cache.reset(constraint.dfdu);
+  }
+
+  if (!cache.hasQr) {
+    const auto numConstraints = constraint.dfdu.rows();
+    const auto numInputs = constraint.dfdu.cols();
+    const Eigen::HouseholderQR<matrix_t> QRof_DT(constraint.dfdu.transpose());
+
+    cache.RT = QRof_DT.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>().transpose();
+    const matrix_t Q = QRof_DT.householderQ();
+    cache.Q1 = Q.leftCols(numConstraints);
+    cache.Q2 = Q.rightCols(numInputs - numConstraints);
+    cache.hasQr = true;
+  }
+
+  const auto RT = cache.RT.triangularView<Eigen::Lower>();
+  const matrix_t RTinvC = RT.solve(constraint.dfdx);  // inv(R^T) * C
+  const matrix_t RTinve = RT.solve(constraint.f);     // inv(R^T) * e
+
+  VectorFunctionLinearApproximation projectionTerms;
+  projectionTerms.dfdu = cache.Q2;
+  projectionTerms.dfdx.noalias() = -cache.Q1 * RTinvC;
+  projectionTerms.f.noalias() = -cache.Q1 * RTinve;
+
+  return projectionTerms;
+}
+
+VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
+                                                         ConstraintProjectionCache& cache) {
+  if (!cache.isCached(constraint.dfdu)) {
+    cache.reset(constraint.dfdu);
+  }
+
+  if (!cache.hasLu) {
+    cache.lu.compute(constraint.dfdu);
+    cache.luKernel = cache.lu.kernel();
+    cache.hasLu = true;
+  }
+
+  VectorFunctionLinearApproximation projectionTerms;
+  projectionTerms.dfdu = cache.luKernel;
+  projectionTerms.dfdx.noalias() = -cache.lu.solve(constraint.dfdx);
+  projectionTerms.f.noalias() = -cache.lu.solve(constraint.f);
+
+  return projectionTerms;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,213 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_sqp/MoveBlocking.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+std::vector<int> getMoveBlocks(const std::vector<AnnotatedTime>& time, size_t numUnblockedNodes, scalar_t growth, size_t maxBlockSize) {
+  const int N = static_cast<int>(time.size()) - 1;
+  std::vector<int> moveBlocks(std::max(N, 0));
+
+  int blockStart = 0;
+  int blockEnd = 0;  // first node after the current block
+  int blockSize = 1;
+  for (int i = 0; i < N; i++) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node, no input. The next node starts a new block.
+      moveBlocks[i] = i;
+      blockEnd = i + 1;
+      continue;
+    }
+
+    if (i >= blockEnd) {
+      if (i >= numUnblockedNodes) {
+        blockSize = std::max(std::min(static_cast<int>(std::ceil(growth * blockSize)), static_cast<int>(maxBlockSize)), 1);
+      }
+      blockStart = i;
+      blockEnd = i + blockSize;
+    }
+    moveBlocks[i] = blockStart;
+  }
+
+  return moveBlocks;
+}
+
+void blockQuadraticSubproblem(const std::vector<int>& moveBlocks, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                              const std::vector<VectorFunctionLinearApproximation>* constraints, MoveBlockedSubproblem& blockedSubproblem) {
+  const int N = static_cast<int>(dynamics.size());
+  if (moveBlocks.size() != N) {
+    throw std::runtime_error("[blockQuadraticSubproblem] The move blocking should have one entry per node of the dynamics.");
+  }
+
+  auto& stageNodes = blockedSubproblem.stageNodes;
+  stageNodes.clear();
+  for (int i = 0; i < N; i++) {
+    if (moveBlocks[i] == i) {
+      stageNodes.push_back(i);
+    }
+  }
+  stageNodes.push_back(N);
+
+  const int numStages = static_cast<int>(stageNodes.size()) - 1;
+  blockedSubproblem.dynamics.resize(numStages);
+  blockedSubproblem.cost.resize(numStages + 1);
+  if (constraints != nullptr) {
+    blockedSubproblem.constraints.resize(numStages + 1);
+  }
+
+  // State inside the block as a function of the state at the start of the block and the input: dx_j = Phi * dx + Gamma * du + c
+  matrix_t Phi, Gamma, QPhi, QGamma, tmp;
+  vector_t c, Qc;
+  for (int stage = 0; stage < numStages; stage++) {
+    const int start = stageNodes[stage];
+    const int end = stageNodes[stage + 1];
+    auto& stageDynamics = blockedSubproblem.dynamics[stage];
+    auto& stageCost = blockedSubproblem.cost[stage];
+
+    stageCost = cost[start];
+    if (constraints != nullptr) {
+      blockedSubproblem.constraints[stage] = (*constraints)[start];
+    }
+    if (end == start + 1) {  // Nothing to condense
+      stageDynamics = dynamics[start];
+      continue;
+    }
+
+    const int nu = dynamics[start].dfdu.cols();
+    Phi = dynamics[start].dfdx;
+    Gamma = dynamics[start].dfdu;
+    c = dynamics[start].f;
+
+    // Stack the constraints of the block
+    int numConstraints = 0;
+    if (constraints != nullptr) {
+      for (int j = start; j < end; j++) {
+        numConstraints += (*constraints)[j].f.size();
+      }
+      auto& stageConstraints = blockedSubproblem.constraints[stage];
+      const int nc = stageConstraints.f.size();
+      stageConstraints.dfdx.conservativeResize(numConstraints, Phi.cols());
+      stageConstraints.dfdu.conservativeResize(numConstraints, nu);
+      stageConstraints.f.conservativeResize(numConstraints);
+      numConstraints = nc;
+    }
+
+    for (int j = start + 1; j < end; j++) {
+      if (dynamics[j].dfdu.cols() != nu) {
+        throw std::runtime_error("[blockQuadraticSubproblem] The number of inputs changes inside a block at node " + std::to_string(j));
+      }
+
+      // Cost of node j in terms of the state at the start of the block and the input
+      const auto& Q = cost[j].dfdxx;
+      const auto& P = cost[j].dfdux;
+      QPhi.noalias() = Q * Phi;
+      QGamma.noalias() = Q * Gamma;
+      Qc.noalias() = Q * c;
+      stageCost.f += cost[j].f + c.dot(cost[j].dfdx + 0.5 * Qc);
+      Qc += cost[j].dfdx;  // gradient w.r.t. dx_j at dx = 0 and du = 0
+      stageCost.dfdx.noalias() += Phi.transpose() * Qc;
+      stageCost.dfdu.noalias() += Gamma.transpose() * Qc;
+      stageCost.dfdu.noalias() += P * c;
+      stageCost.dfdu += cost[j].dfdu;
+      stageCost.dfdxx.noalias() += Phi.transpose() * QPhi;
+      stageCost.dfdux.noalias() += Gamma.transpose() * QPhi;
+      stageCost.dfdux.noalias() += P * Phi;
+      tmp.noalias() = P * Gamma;
+      stageCost.dfduu.noalias() += Gamma.transpose() * QGamma;
+      stageCost.dfduu += tmp + tmp.transpose() + cost[j].dfduu;
+
+      // Constraints of node j
+      if (constraints != nullptr && (*constraints)[j].f.size() > 0) {
+        const auto& constraint = (*constraints)[j];
+        const int nc = constraint.f.size();
+        auto& stageConstraints = blockedSubproblem.constraints[stage];
+        stageConstraints.dfdx.middleRows(numConstraints, nc).noalias() = constraint.dfdx * Phi;
+        stageConstraints.dfdu.middleRows(numConstraints, nc) = constraint.dfdu;
+        stageConstraints.dfdu.middleRows(numConstraints, nc).noalias() += constraint.dfdx * Gamma;
+        stageConstraints.f.segment(numConstraints, nc) = constraint.f;
+        stageConstraints.f.segment(numConstraints, nc).noalias() += constraint.dfdx * c;
+        numConstraints += nc;
+      }
+
+      // Propagate to the next node
+      const auto& A = dynamics[j].dfdx;
+      tmp.noalias() = A * Phi;
+      Phi.swap(tmp);
+      tmp.noalias() = A * Gamma;
+      Gamma = tmp + dynamics[j].dfdu;
+      Qc.noalias() = A * c;
+      c = Qc + dynamics[j].f;
+    }
+
+    stageDynamics.dfdx = Phi;
+    stageDynamics.dfdu = Gamma;
+    stageDynamics.f = c;
+  }
+
+  // Terminal node
+  blockedSubproblem.cost[numStages] = cost[N];
+  if (constraints != nullptr) {
+    blockedSubproblem.constraints[numStages] = (*constraints)[N];
+  }
+}
+
+void unblockSolution(const MoveBlockedSubproblem& blockedSubproblem, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const vector_array_t& stageXSol, const vector_array_t& stageUSol, vector_array_t& deltaXSol,
+                     vector_array_t& deltaUSol) {
+  const auto& stageNodes = blockedSubproblem.stageNodes;
+  const int numStages = static_cast<int>(stageNodes.size()) - 1;
+  const int N = stageNodes.back();
+  deltaXSol.resize(N + 1);
+  deltaUSol.resize(N);
+
+  for (int stage = 0; stage < numStages; stage++) {
+    const int start = stageNodes[stage];
+    const int end = stageNodes[stage + 1];
+    deltaXSol[start] = stageXSol[stage];
+    for (int j = start; j < end; j++) {
+      deltaUSol[j] = stageUSol[stage];
+      if (j + 1 < end) {
+        deltaXSol[j + 1] = dynamics[j].f;
+        deltaXSol[j + 1].noalias() += dynamics[j].dfdx * deltaXSol[j];
+        deltaXSol[j + 1].noalias() += dynamics[j].dfdu * deltaUSol[j];
+      }
+    }
+  }
+  deltaXSol[N] = stageXSol[numStages];
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
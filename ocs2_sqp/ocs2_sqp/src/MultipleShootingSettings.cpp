@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSettings.h"
 
+#include <unordered_map>
+
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
@@ -37,6 +39,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
+std::string toString(WarmStartTail warmStartTail) {
+  static const std::unordered_map<WarmStartTail, std::string> warmStartTailMap = {{WarmStartTail::Initializer, "Initializer"},
+                                                                                 {WarmStartTail::HoldLastInput, "HoldLastInput"},
+                                                                                 {WarmStartTail::LastFeedback, "LastFeedback"}};
+
+  return warmStartTailMap.at(warmStartTail);
+}
+
+WarmStartTail warmStartTailFromString(const std::string& name) {
+  static const std::unordered_map<std::string, WarmStartTail> warmStartTailMap = {{"Initializer", WarmStartTail::Initializer},
+                                                                                 {"HoldLastInput", WarmStartTail::HoldLastInput},
+                                                                                 {"LastFeedback", WarmStartTail::LastFeedback}};
+
+  return warmStartTailMap.at(name);
+}
+
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(filename, pt);
@@ -57,8 +75,20 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
+  loadData::loadPtreeValue(pt, settings.useFilterLineSearch, fieldName + ".useFilterLineSearch", verbose);
+  loadData::loadPtreeValue(pt, settings.maxSecondOrderCorrections, fieldName + ".maxSecondOrderCorrections", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
+  loadData::loadPtreeValue(pt, settings.usePartitionedRiccati, fieldName + ".usePartitionedRiccati", verbose);
+  loadData::loadPtreeValue(pt, settings.useShiftWarmStart, fieldName + ".useShiftWarmStart", verbose);
+  loadData::loadPtreeValue(pt, settings.shiftTolerance, fieldName + ".shiftTolerance", verbose);
+  auto warmStartTailName = toString(settings.warmStartTail);
+  loadData::loadPtreeValue(pt, warmStartTailName, fieldName + ".warmStartTail", verbose);
+  settings.warmStartTail = warmStartTailFromString(warmStartTailName);
+  loadData::loadPtreeValue(pt, settings.useMoveBlocking, fieldName + ".useMoveBlocking", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingUnblockedNodes, fieldName + ".moveBlockingUnblockedNodes", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingGrowth, fieldName + ".moveBlockingGrowth", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingMaxBlockSize, fieldName + ".moveBlockingMaxBlockSize", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
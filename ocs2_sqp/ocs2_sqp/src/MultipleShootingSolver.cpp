@@ -29,12 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/soft_constraint/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_oc/oc_solver/WarmStartSerialization.h>
 
 #include "ocs2_sqp/MultipleShootingInitialization.h"
 #include "ocs2_sqp/MultipleShootingTranscription.h"
@@ -46,7 +48,8 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
     : SolverBase(),
       settings_(std::move(settings)),
       hpipmInterface_(hpipm_interface::OcpSize(), settings.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      partitionedRiccatiSolver_(threadPool_, settings_.nThreads, settings_.nThreads) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -59,12 +62,19 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
     ocpDefinitions_.push_back(optimalControlProblem);
   }
 
+  projectionCaches_.resize(settings_.nThreads);
+
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
   if (optimalControlProblem.equalityConstraintPtr->empty()) {
     settings_.projectStateInputEqualityConstraints = false;  // True does not make sense if there are no constraints.
   }
+
+  if (settings_.usePartitionedRiccati && !optimalControlProblem.equalityConstraintPtr->empty() &&
+      !settings_.projectStateInputEqualityConstraints) {
+    throw std::runtime_error("[MultipleShootingSolver] The partitioned Riccati solver requires projected state-input constraints.");
+  }
 }
 
 MultipleShootingSolver::~MultipleShootingSolver() {
@@ -76,7 +86,9 @@ MultipleShootingSolver::~MultipleShootingSolver() {
 void MultipleShootingSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  primalSolutionTimeDiscretization_.clear();
   performanceIndeces_.clear();
+  filter_.clear();
 
   // reset timers
   totalNumIterations_ = 0;
@@ -86,6 +98,13 @@ void MultipleShootingSolver::reset() {
   computeControllerTimer_.reset();
 }
 
+void MultipleShootingSolver::setTimeStep(scalar_t dt) {
+  if (dt <= 0.0) {
+    throw std::runtime_error("[MultipleShootingSolver::setTimeStep] The time step should be positive!");
+  }
+  settings_.dt = dt;
+}
+
 std::string MultipleShootingSolver::getBenchmarkingInformation() const {
   const auto linearQuadraticApproximationTotal = linearQuadraticApproximationTimer_.getTotalInMilliseconds();
   const auto solveQpTotal = solveQpTimer_.getTotalInMilliseconds();
@@ -120,6 +139,42 @@ const std::vector<PerformanceIndex>& MultipleShootingSolver::getIterationsLog()
   }
 }
 
+void MultipleShootingSolver::saveWarmStartImpl(std::ostream& stream) const {
+  warm_start::write(stream, std::string("MultipleShootingSolver"));
+  warm_start::write(stream, partitionTime_);
+  warm_start::write(stream, primalSolution_);
+}
+
+void MultipleShootingSolver::loadWarmStartImpl(std::istream& stream) {
+  std::string solverName;
+  warm_start::read(stream, solverName);
+  if (solverName != "MultipleShootingSolver") {
+    throw std::runtime_error("[MultipleShootingSolver::loadWarmStart] The snapshot is saved by " + solverName + ".");
+  }
+
+  scalar_array_t partitionTime;
+  PrimalSolution primalSolution;
+  warm_start::read(stream, partitionTime);
+  warm_start::read(stream, primalSolution);
+
+  reset();
+  partitionTime_ = std::move(partitionTime);
+  primalSolution_ = std::move(primalSolution);
+}
+
+void MultipleShootingSolver::copyWarmStartImpl(const SolverBase& other) {
+  const auto* otherPtr = dynamic_cast<const MultipleShootingSolver*>(&other);
+  if (otherPtr == nullptr) {
+    throw std::runtime_error(
+        "[MultipleShootingSolver::copyWarmStart] The warm start can only be copied from another MultipleShootingSolver.");
+  }
+
+  reset();
+  partitionTime_ = otherPtr->partitionTime_;
+  primalSolution_ = otherPtr->primalSolution_;
+  primalSolutionTimeDiscretization_ = otherPtr->primalSolutionTimeDiscretization_;
+}
+
 void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
                                      const scalar_array_t& partitioningTimes) {
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -136,6 +191,15 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   vector_array_t x, u;
   initializeStateInputTrajectories(initState, timeDiscretization, x, u);
 
+  // Nodes of a block share the input of the first node of the block
+  if (settings_.useMoveBlocking) {
+    moveBlocks_ = multiple_shooting::getMoveBlocks(timeDiscretization, settings_.moveBlockingUnblockedNodes, settings_.moveBlockingGrowth,
+                                                   settings_.moveBlockingMaxBlockSize);
+    for (int i = 0; i < moveBlocks_.size(); i++) {
+      u[i] = u[moveBlocks_[i]];
+    }
+  }
+
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
@@ -144,6 +208,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 
   // Bookkeeping
   performanceIndeces_.clear();
+  filter_.clear();
 
   for (int iter = 0; iter < settings_.sqpIteration; iter++) {
     if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -198,7 +263,11 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   inputTrajectory.reserve(N);
 
   // Determine till when to use the previous solution
-  const scalar_t interpolateTill = (totalNumIterations_ > 0) ? primalSolution_.timeTrajectory_.back() : timeDiscretization.front().time;
+  const scalar_t interpolateTill =
+      (!primalSolution_.timeTrajectory_.empty()) ? primalSolution_.timeTrajectory_.back() : timeDiscretization.front().time;
+
+  // Node by node correspondence with the previous solution, empty if the previous solution has to be interpolated
+  const auto shiftedNodeIndices = settings_.useShiftWarmStart ? getShiftedNodeIndices(timeDiscretization) : std::vector<int>();
 
   stateTrajectory.push_back(initState);
   for (int i = 0; i < N; i++) {
@@ -213,11 +282,16 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
       vector_t input, nextState;
       if (time < interpolateTill) {  // Using previous solution
         const bool useController = (i == 0);
-        std::tie(input, nextState) =
-            multiple_shooting::initializeIntermediateNode(primalSolution_, time, nextTime, stateTrajectory.back(), useController);
-      } else {  // Using initializer
-        std::tie(input, nextState) =
-            multiple_shooting::initializeIntermediateNode(*initializerPtr_, time, nextTime, stateTrajectory.back());
+        if (!shiftedNodeIndices.empty() && shiftedNodeIndices[i + 1] >= 0) {  // Shifting
+          input = useController ? primalSolution_.controllerPtr_->computeInput(time, stateTrajectory.back())
+                                : primalSolution_.inputTrajectory_[shiftedNodeIndices[i]];
+          nextState = primalSolution_.stateTrajectory_[shiftedNodeIndices[i + 1]];
+        } else {  // Interpolating
+          std::tie(input, nextState) =
+              multiple_shooting::initializeIntermediateNode(primalSolution_, time, nextTime, stateTrajectory.back(), useController);
+        }
+      } else {  // Beyond the previous solution
+        std::tie(input, nextState) = initializeTailNode(time, nextTime, stateTrajectory.back());
       }
       inputTrajectory.push_back(std::move(input));
       stateTrajectory.push_back(std::move(nextState));
@@ -225,23 +299,96 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   }
 }
 
+std::vector<int> MultipleShootingSolver::getShiftedNodeIndices(const std::vector<AnnotatedTime>& timeDiscretization) const {
+  const auto& previousTime = primalSolutionTimeDiscretization_;
+  if (previousTime.empty() || primalSolution_.controllerPtr_ == nullptr) {
+    return {};
+  }
+
+  const scalar_t tolerance = settings_.shiftTolerance * settings_.dt;
+  std::vector<int> shiftedNodeIndices(timeDiscretization.size(), -1);
+  int j = 0;
+  for (int i = 0; i < timeDiscretization.size(); i++) {
+    const auto& node = timeDiscretization[i];
+    if (node.time > previousTime.back().time + tolerance) {
+      break;  // this and all following nodes are beyond the previous horizon
+    }
+
+    // First node of the previous solution that is not before this node
+    while (j < previousTime.size() && previousTime[j].time < node.time - tolerance) {
+      j++;
+    }
+    // Pre- and post-event nodes share the same time
+    if (j + 1 < previousTime.size() && previousTime[j].event != node.event && previousTime[j + 1].event == node.event &&
+        std::abs(previousTime[j + 1].time - node.time) <= tolerance) {
+      j++;
+    }
+
+    const bool isAligned = j < previousTime.size() && std::abs(previousTime[j].time - node.time) <= tolerance;
+    // The first node is post-event if there is an event at the initial time, but it is initialized with the initial state anyway
+    const bool isSameEvent = (i == 0) || previousTime[j].event == node.event;
+    if (!isAligned || !isSameEvent) {
+      return {};
+    }
+    shiftedNodeIndices[i] = j;
+  }
+
+  return shiftedNodeIndices;
+}
+
+std::pair<vector_t, vector_t> MultipleShootingSolver::initializeTailNode(scalar_t t, scalar_t tNext, const vector_t& x) {
+  if (primalSolution_.inputTrajectory_.empty() || settings_.warmStartTail == multiple_shooting::WarmStartTail::Initializer) {
+    return multiple_shooting::initializeIntermediateNode(*initializerPtr_, t, tNext, x);
+  }
+
+  vector_t input;
+  if (settings_.warmStartTail == multiple_shooting::WarmStartTail::LastFeedback && primalSolution_.controllerPtr_ != nullptr) {
+    input = primalSolution_.controllerPtr_->computeInput(primalSolution_.timeTrajectory_.back(), x);
+  } else {
+    input = primalSolution_.inputTrajectory_.back();
+  }
+  vector_t nextState = discretizer_(*ocpDefinitions_.front().dynamicsPtr, t, x, input, tNext - t);
+  return {std::move(input), std::move(nextState)};
+}
+
 MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, &constraints_));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, &constraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  // without constraints, or when using projection, we have an unconstrained QP.
+  const bool constrainedQp = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+
+  // With move blocking, the QP is solved in terms of the blocked subproblem
+  auto* qpDynamics = &dynamics_;
+  auto* qpCost = &cost_;
+  auto* qpConstraints = constrainedQp ? &constraints_ : nullptr;
+  vector_array_t stageXSol, stageUSol;
+  auto& qpXSol = moveBlocks_.empty() ? deltaXSol : stageXSol;
+  auto& qpUSol = moveBlocks_.empty() ? deltaUSol : stageUSol;
+  if (!moveBlocks_.empty()) {
+    multiple_shooting::blockQuadraticSubproblem(moveBlocks_, dynamics_, cost_, qpConstraints, moveBlockedSubproblem_);
+    qpDynamics = &moveBlockedSubproblem_.dynamics;
+    qpCost = &moveBlockedSubproblem_.cost;
+    qpConstraints = constrainedQp ? &moveBlockedSubproblem_.constraints : nullptr;
   }
 
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
+  if (settings_.usePartitionedRiccati) {  // unconstrained QP, checked in the constructor
+    if (!partitionedRiccatiSolver_.solve(delta_x0, *qpDynamics, *qpCost, qpXSol, qpUSol)) {
+      throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
+    }
+  } else {
+    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(*qpDynamics, *qpCost, qpConstraints));
+    const auto status = hpipmInterface_.solve(delta_x0, *qpDynamics, *qpCost, qpConstraints, qpXSol, qpUSol, settings_.printSolverStatus);
+
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
+    }
+  }
+
+  if (!moveBlocks_.empty()) {
+    multiple_shooting::unblockSolution(moveBlockedSubproblem_, dynamics_, stageXSol, stageUSol, deltaXSol, deltaUSol);
   }
 
   // To determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -288,7 +435,24 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
     // see doc/LQR_full.pdf for detailed derivation for feedback terms
     uff = u;  // Copy and adapt in loop
     controllerGain.reserve(time.size());
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices;
+    if (moveBlocks_.empty()) {
+      KMatrices = settings_.usePartitionedRiccati ? partitionedRiccatiSolver_.getRiccatiFeedback(dynamics_, cost_)
+                                                  : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    } else {
+      const auto& blocked = moveBlockedSubproblem_;
+      const auto stageK = settings_.usePartitionedRiccati ? partitionedRiccatiSolver_.getRiccatiFeedback(blocked.dynamics, blocked.cost)
+                                                          : hpipmInterface_.getRiccatiFeedback(blocked.dynamics[0], blocked.cost[0]);
+      // Inside a block, the input of the QP does not depend on the state of the node
+      KMatrices.resize(moveBlocks_.size());
+      for (int stage = 0; stage + 1 < blocked.stageNodes.size(); stage++) {
+        const int start = blocked.stageNodes[stage];
+        KMatrices[start] = stageK[stage];
+        for (int j = start + 1; j < blocked.stageNodes[stage + 1]; j++) {
+          KMatrices[j].setZero(dynamics_[j].dfdu.cols(), dynamics_[j].dfdx.cols());
+        }
+      }
+    }
     for (int i = 0; (i + 1) < time.size(); i++) {
       if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
         uff[i] = uff[i - 1];
@@ -312,6 +476,7 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
   }
 
   // Construct nominal state and inputs
+  primalSolutionTimeDiscretization_ = time;
   primalSolution_.stateTrajectory_ = std::move(x);
   u.push_back(u.back());  // Repeat last input to make equal length vectors
   primalSolution_.inputTrajectory_ = std::move(u);
@@ -338,16 +503,19 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   cost_.resize(N + 1);
   constraints_.resize(N + 1);
   constraintsProjection_.resize(N);
+  const bool projection = settings_.projectStateInputEqualityConstraints;
+  const bool projectionSensitivity = projection && settings_.useFilterLineSearch && settings_.maxSecondOrderCorrections > 0;
+  projectionSensitivities_.resize(projectionSensitivity ? N : 0);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-    const bool projection = settings_.projectStateInputEqualityConstraints;
 
     int i = timeIndex++;
     while (i < N) {
+      ocpDefinition.preComputationPtr->setNodeIndex(i);
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
@@ -361,12 +529,16 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
         auto result =
-            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i]);
+            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i],
+                                                     &projectionCaches_[workerId], projectionSensitivity);
         workerPerformance += result.performance;
         dynamics_[i] = std::move(result.dynamics);
         cost_[i] = std::move(result.cost);
         constraints_[i] = std::move(result.constraints);
         constraintsProjection_[i] = std::move(result.constraintsProjection);
+        if (projectionSensitivity) {
+          projectionSensitivities_[i] = std::move(result.projectionSensitivity);
+        }
       }
 
       i = timeIndex++;
@@ -374,6 +546,7 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
+      ocpDefinition.preComputationPtr->setNodeIndex(N);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
       workerPerformance += result.performance;
       cost_[i] = std::move(result.cost);
@@ -440,6 +613,49 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
   return totalPerformance;
 }
 
+void MultipleShootingSolver::addSecondOrderCorrection(const std::vector<AnnotatedTime>& time, const vector_array_t& x,
+                                                      const vector_array_t& u) {
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  std::atomic_int timeIndex{0};
+  auto parallelTask = [&](int workerId) {
+    // Get worker specific resources
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    const bool projection = settings_.projectStateInputEqualityConstraints;
+
+    int i = timeIndex++;
+    while (i < N) {
+      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+        // Event node
+        dynamics_[i].f += multiple_shooting::computeEventDynamicsGap(ocpDefinition, time[i].time, x[i], x[i + 1]);
+      } else {
+        // Normal, intermediate node
+        const scalar_t ti = getIntervalStart(time[i]);
+        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+        const auto values =
+            multiple_shooting::computeIntermediateConstraintValues(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        dynamics_[i].f += values.dynamicsGap;
+        const auto& e = values.stateInputEqConstraints;
+        if (e.size() > 0) {
+          if (projection) {  // The constraint value enters the projected dynamics and cost through the projection offset
+            const auto& sensitivity = projectionSensitivities_[i];
+            dynamics_[i].f.noalias() += sensitivity.dynamicsBias * e;
+            cost_[i].dfdx.noalias() += sensitivity.costStateGradient * e;
+            cost_[i].dfdu.noalias() += sensitivity.costInputGradient * e;
+            constraintsProjection_[i].f.noalias() += sensitivity.projectionBias * e;
+          } else {
+            constraints_[i].f += e;
+          }
+        }
+      }
+
+      i = timeIndex++;
+    }
+  };
+  runParallel(std::move(parallelTask));
+}
+
 scalar_t MultipleShootingSolver::trajectoryNorm(const vector_array_t& v) {
   scalar_t norm = 0.0;
   for (const auto& vi : v) {
@@ -485,11 +701,85 @@ std::pair<bool, PerformanceIndex> MultipleShootingSolver::takeStep(const Perform
   };
 
   const scalar_t baselineConstraintViolation = constraintViolation(baseline);
+  if (performanceIndeces_.empty()) {  // first iteration of this run
+    filterMinConstraintViolation_ = 1e-4 * std::max(1.0, baselineConstraintViolation);
+  }
+
+  // Filter linesearch of A. Waechter and L. T. Biegler, "On the implementation of an interior-point filter line-search algorithm for
+  // large-scale nonlinear programming", Mathematical Programming 106, 2006.
+  // Filter: the step has to decrease either the constraint violation or the merit w.r.t. each entry
+  auto isAcceptableToFilter = [&](const PerformanceIndex& performanceNew, scalar_t newConstraintViolation) {
+    return !settings_.useFilterLineSearch ||
+           std::all_of(filter_.begin(), filter_.end(), [&](const std::pair<scalar_t, scalar_t>& entry) {
+             return newConstraintViolation < entry.first || performanceNew.merit < entry.second;
+           });
+  };
+
+  // The margins of the current iterate, a step has to improve on them if it is not accepted for the armijo condition
+  const std::pair<scalar_t, scalar_t> baselineFilterEntry{(1.0 - gamma_c) * baselineConstraintViolation,
+                                                          baseline.merit - gamma_c * baselineConstraintViolation};
+
+  // Returns whether the step sufficiently decreases the merit or constraints w.r.t. the baseline, and whether the baseline has to be
+  // added to the filter when the step is accepted, i.e., it was not accepted for the armijo condition. The filter itself is checked by
+  // isAcceptableToFilter().
+  auto checkStep = [&](const PerformanceIndex& performanceNew, scalar_t newConstraintViolation, scalar_t alpha) -> std::pair<bool, bool> {
+    const bool sufficientDecrease =
+        performanceNew.merit < baselineFilterEntry.second || newConstraintViolation < baselineFilterEntry.first;
+
+    if (newConstraintViolation > g_max) {
+      return {false, false};
+    } else if (settings_.useFilterLineSearch) {
+      // Switching condition: the expected merit decrease dominates the constraint violation. Near feasibility, the step is then
+      // required to satisfy the armijo condition (f-type), otherwise a sufficient decrease of the merit or constraints (h-type).
+      constexpr scalar_t s_merit = 2.3;
+      constexpr scalar_t s_constraint = 1.1;
+      const bool switchingCondition = armijoDescentMetric < 0.0 && alpha * std::pow(-armijoDescentMetric, s_merit) >
+                                                                       std::pow(baselineConstraintViolation, s_constraint);
+      if (switchingCondition && baselineConstraintViolation <= filterMinConstraintViolation_) {
+        return {performanceNew.merit <= baseline.merit + armijoFactor * alpha * armijoDescentMetric, false};
+      } else {
+        return {sufficientDecrease, true};
+      }
+    } else if (newConstraintViolation < g_min && baselineConstraintViolation < g_min && armijoDescentMetric < 0.0) {
+      // With low violation and having a descent direction, require the armijo condition.
+      return {performanceNew.merit < baseline.merit + armijoFactor * alpha * armijoDescentMetric, false};
+    } else {
+      // Medium violation: either merit or constraints decrease (with small gamma_c mixing of old constraints)
+      return {sufficientDecrease, false};
+    }
+  };
+
+  auto printTrialStep = [](const PerformanceIndex& performanceNew, bool stepAccepted, scalar_t dxNorm, scalar_t duNorm) {
+    std::cerr << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+    std::cerr << "|dx| = " << dxNorm << "\t|du| = " << duNorm << "\n";
+    std::cerr << "\tMerit: " << performanceNew.merit << "\t DynamicsISE: " << performanceNew.stateEqConstraintISE
+              << "\t StateInputISE: " << performanceNew.stateInputEqConstraintISE
+              << "\t IneqISE: " << performanceNew.inequalityConstraintISE << "\t Penalty: " << performanceNew.inequalityConstraintPenalty
+              << "\n";
+  };
 
   // Update norm
   const scalar_t deltaUnorm = trajectoryNorm(du);
   const scalar_t deltaXnorm = trajectoryNorm(dx);
 
+  // Overrides the trajectories with an accepted step and returns whether the solver converged
+  auto acceptStep = [&](vector_array_t&& xNew, vector_array_t&& uNew, const PerformanceIndex& performanceNew, scalar_t alpha) {
+    x = std::move(xNew);
+    u = std::move(uNew);
+    const bool stepSizeBelowTol = alpha * deltaUnorm < settings_.deltaTol && alpha * deltaXnorm < settings_.deltaTol;
+    const bool improvementBelowTol =
+        std::abs(baseline.merit - performanceNew.merit) < costTol && constraintViolation(performanceNew) < g_min;
+    return stepSizeBelowTol || improvementBelowTol;
+  };
+
+  // The first step that is only rejected by the filter. It is taken, and the filter is reset, if the restoration fails as well.
+  struct {
+    bool isSet = false;
+    vector_array_t x, u;
+    PerformanceIndex performance;
+    scalar_t alpha;
+  } filterRejectedStep;
+
   scalar_t alpha = 1.0;
   vector_array_t xNew(x.size());
   vector_array_t uNew(u.size());
@@ -505,50 +795,155 @@ std::pair<bool, PerformanceIndex> MultipleShootingSolver::takeStep(const Perform
     }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
-    const scalar_t newConstraintViolation = constraintViolation(performanceNew);
-
-    const bool stepAccepted = [&]() {
-      if (newConstraintViolation > g_max) {
-        return false;
-      } else if (newConstraintViolation < g_min && baselineConstraintViolation < g_min && armijoDescentMetric < 0.0) {
-        // With low violation and having a descent direction, require the armijo condition.
-        return (performanceNew.merit < baseline.merit + armijoFactor * alpha * armijoDescentMetric);
-      } else {
-        // Medium violation: either merit or constraints decrease (with small gamma_c mixing of old constraints)
-        return performanceNew.merit < (baseline.merit - gamma_c * baselineConstraintViolation) ||
-               newConstraintViolation < ((1.0 - gamma_c) * baselineConstraintViolation);
-      }
-    }();
+    PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
+    scalar_t newConstraintViolation = constraintViolation(performanceNew);
+    auto stepCheck = checkStep(performanceNew, newConstraintViolation, alpha);
+    bool acceptableToFilter = isAcceptableToFilter(performanceNew, newConstraintViolation);
 
     if (settings_.printLinesearch) {
-      std::cerr << "Stepsize = " << alpha << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << "\tMerit: " << performanceNew.merit << "\t DynamicsISE: " << performanceNew.stateEqConstraintISE
-                << "\t StateInputISE: " << performanceNew.stateInputEqConstraintISE
-                << "\t IneqISE: " << performanceNew.inequalityConstraintISE << "\t Penalty: " << performanceNew.inequalityConstraintPenalty
-                << "\n";
+      std::cerr << "Stepsize = " << alpha;
+      printTrialStep(performanceNew, stepCheck.first && acceptableToFilter, alpha * deltaXnorm, alpha * deltaUnorm);
+    }
+
+    // Second order correction of a rejected full step that increases the constraint violation, Sec. 2.4 of the reference above.
+    // The QP is solved again with the constant terms of the constraints shifted by their values at the trial point.
+    const bool useSecondOrderCorrection = settings_.useFilterLineSearch && settings_.maxSecondOrderCorrections > 0;
+    const bool fullStepRejected = alpha == 1.0 && !(stepCheck.first && acceptableToFilter);
+    if (useSecondOrderCorrection && fullStepRejected && newConstraintViolation >= baselineConstraintViolation) {
+      constexpr scalar_t kappa_soc = 0.99;  // required decrease of the constraint violation between corrections
+      const auto dynamicsBackup = dynamics_;
+      const auto costBackup = cost_;
+      const auto constraintsBackup = constraints_;
+      const auto constraintsProjectionBackup = constraintsProjection_;
+
+      vector_array_t xCorrected = xNew;
+      vector_array_t uCorrected = uNew;
+      scalar_t previousConstraintViolation = baselineConstraintViolation;
+      scalar_t correctedConstraintViolation = newConstraintViolation;
+      for (size_t p = 0; p < settings_.maxSecondOrderCorrections; p++) {
+        addSecondOrderCorrection(timeDiscretization, xCorrected, uCorrected);
+        const auto correction = getOCPSolution(initState - x[0]);
+        for (int i = 0; i < u.size(); i++) {
+          if (correction.deltaUSol[i].size() > 0) {
+            uCorrected[i] = u[i] + correction.deltaUSol[i];
+          }
+        }
+        for (int i = 0; i < x.size(); i++) {
+          xCorrected[i] = x[i] + correction.deltaXSol[i];
+        }
+
+        const PerformanceIndex performanceCorrected = computePerformance(timeDiscretization, initState, xCorrected, uCorrected);
+        correctedConstraintViolation = constraintViolation(performanceCorrected);
+        const auto correctedStepCheck = checkStep(performanceCorrected, correctedConstraintViolation, alpha);
+        const bool correctionAccepted =
+            correctedStepCheck.first && isAcceptableToFilter(performanceCorrected, correctedConstraintViolation);
+
+        if (settings_.printLinesearch) {
+          std::cerr << "Second order correction " << p + 1;
+          printTrialStep(performanceCorrected, correctionAccepted, trajectoryNorm(correction.deltaXSol),
+                         trajectoryNorm(correction.deltaUSol));
+        }
+        if (correctionAccepted) {
+          xNew = std::move(xCorrected);
+          uNew = std::move(uCorrected);
+          performanceNew = performanceCorrected;
+          newConstraintViolation = correctedConstraintViolation;
+          stepCheck = correctedStepCheck;
+          acceptableToFilter = true;
+          break;
+        } else if (correctedConstraintViolation > kappa_soc * previousConstraintViolation) {
+          break;
+        }
+        previousConstraintViolation = correctedConstraintViolation;
+      }
+
+      // Restore the QP of the current iterate, it defines the feedback policy
+      dynamics_ = dynamicsBackup;
+      cost_ = costBackup;
+      constraints_ = constraintsBackup;
+      constraintsProjection_ = constraintsProjectionBackup;
+    }
+
+    if (stepCheck.first && acceptableToFilter) {  // Return if step accepted
+      if (stepCheck.second) {
+        filter_.push_back(baselineFilterEntry);
+      }
+      return {acceptStep(std::move(xNew), std::move(uNew), performanceNew, alpha), performanceNew};
+    } else if (stepCheck.first && !filterRejectedStep.isSet) {
+      filterRejectedStep.isSet = true;
+      filterRejectedStep.x = xNew;
+      filterRejectedStep.u = uNew;
+      filterRejectedStep.performance = performanceNew;
+      filterRejectedStep.alpha = alpha;
     }
 
     // Exit conditions
     const bool stepSizeBelowTol = alpha * deltaUnorm < settings_.deltaTol && alpha * deltaXnorm < settings_.deltaTol;
-
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      const bool improvementBelowTol = std::abs(baseline.merit - performanceNew.merit) < costTol && newConstraintViolation < g_min;
-      return {stepSizeBelowTol || improvementBelowTol, performanceNew};
-    } else if (stepSizeBelowTol) {  // Return if steps get too small without being accepted
+    if (stepSizeBelowTol) {  // Stop if steps get too small without being accepted
       if (settings_.printLinesearch) {
         std::cerr << "Stepsize is smaller than provided deltaTol -> converged \n";
       }
-      return {true, baseline};
+      break;
     } else {  // Try smaller step
       alpha *= alpha_decay;
     }
   } while (alpha > alpha_min);
 
-  return {true, baseline};  // Alpha_min reached and no improvement found -> Converged
+  // Feasibility restoration, Sec. 3.3 of the reference above: when no step of an infeasible iterate is accepted, the iterate is added
+  // to the filter and a step is taken towards the linearized constraints only. It is the solution of the QP without the cost gradients,
+  // i.e., the correction of the constraints that is smallest in the norm of the cost Hessian. A single restoration step is taken per
+  // iteration, it has to decrease the constraint violation and be acceptable to the filter.
+  if (settings_.useFilterLineSearch && baselineConstraintViolation > g_min) {
+    filter_.push_back(baselineFilterEntry);
+
+    const auto costBackup = cost_;
+    for (auto& cost : cost_) {
+      cost.dfdx.setZero();
+      cost.dfdu.setZero();
+    }
+    const auto restoration = getOCPSolution(initState - x[0]);
+    cost_ = costBackup;
+
+    for (alpha = 1.0; alpha > alpha_min; alpha *= alpha_decay) {
+      for (int i = 0; i < u.size(); i++) {
+        if (restoration.deltaUSol[i].size() > 0) {
+          uNew[i] = u[i] + alpha * restoration.deltaUSol[i];
+        }
+      }
+      for (int i = 0; i < x.size(); i++) {
+        xNew[i] = x[i] + alpha * restoration.deltaXSol[i];
+      }
+
+      const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
+      const scalar_t newConstraintViolation = constraintViolation(performanceNew);
+      const bool stepAccepted =
+          newConstraintViolation < baselineFilterEntry.first && isAcceptableToFilter(performanceNew, newConstraintViolation);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Restoration stepsize = " << alpha;
+        printTrialStep(performanceNew, stepAccepted, alpha * trajectoryNorm(restoration.deltaXSol),
+                       alpha * trajectoryNorm(restoration.deltaUSol));
+      }
+      if (stepAccepted) {
+        x = std::move(xNew);
+        u = std::move(uNew);
+        return {false, performanceNew};
+      }
+    }
+  }
+
+  // Fallback if the restoration fails: the filter is reset and the first step that was only rejected by the filter is taken
+  if (filterRejectedStep.isSet) {
+    if (settings_.printLinesearch) {
+      std::cerr << "Filter reset, stepsize = " << filterRejectedStep.alpha << " (Accepted)\n";
+    }
+    filter_.clear();
+    const bool converged = acceptStep(std::move(filterRejectedStep.x), std::move(filterRejectedStep.u), filterRejectedStep.performance,
+                                      filterRejectedStep.alpha);
+    return {converged, filterRejectedStep.performance};
+  }
+
+  return {true, baseline};  // Alpha_min reached or steps got too small without improvement -> Converged
 }
 
 }  // namespace ocs2
@@ -39,7 +39,8 @@ namespace multiple_shooting {
 
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
-                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                    ConstraintProjectionCache* projectionCachePtr, bool computeProjectionSensitivity) {
   // Results and short-hand notation
   Transcription transcription;
   auto& dynamics = transcription.dynamics;
@@ -76,7 +77,21 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
       performance.stateInputEqConstraintISE = dt * constraints.f.squaredNorm();
       if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
         // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
-        projection = luConstraintProjection(constraints);
+        projection = (projectionCachePtr != nullptr) ? luConstraintProjection(constraints, *projectionCachePtr)
+                                                     : luConstraintProjection(constraints);
+
+        if (computeProjectionSensitivity) {
+          // Pe = -inv(D) * e, the other terms follow from the change of input variables with u0 = Pe
+          auto& sensitivity = transcription.projectionSensitivity;
+          const matrix_t identity = matrix_t::Identity(constraints.f.size(), constraints.f.size());
+          sensitivity.projectionBias = (projectionCachePtr != nullptr) ? -projectionCachePtr->lu.solve(identity)
+                                                                       : -Eigen::FullPivLU<matrix_t>(constraints.dfdu).solve(identity);
+          sensitivity.dynamicsBias.noalias() = dynamics.dfdu * sensitivity.projectionBias;
+          const matrix_t R_Pe = cost.dfduu * sensitivity.projectionBias;
+          sensitivity.costStateGradient.noalias() = cost.dfdux.transpose() * sensitivity.projectionBias;
+          sensitivity.costStateGradient.noalias() += projection.dfdx.transpose() * R_Pe;
+          sensitivity.costInputGradient.noalias() = projection.dfdu.transpose() * R_Pe;
+        }
         constraints = VectorFunctionLinearApproximation();
 
         // Adapt dynamics and cost
@@ -115,6 +130,24 @@ PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& opt
   return performance;
 }
 
+ConstraintValues computeIntermediateConstraintValues(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
+                                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next,
+                                                     const vector_t& u) {
+  ConstraintValues values;
+
+  // Dynamics
+  values.dynamicsGap = discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt) - x_next;
+
+  // Constraints
+  if (!optimalControlProblem.equalityConstraintPtr->empty()) {
+    optimalControlProblem.preComputationPtr->request(Request::Constraint, t, x, u);
+    values.stateInputEqConstraints =
+        optimalControlProblem.equalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
+  }
+
+  return values;
+}
+
 TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
   // Results and short-hand notation
   TerminalTranscription transcription;
@@ -170,6 +203,12 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
   return transcription;
 }
 
+vector_t computeEventDynamicsGap(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                 const vector_t& x_next) {
+  optimalControlProblem.preComputationPtr->requestPreJump(Request::Dynamics, t, x);
+  return optimalControlProblem.dynamicsPtr->computeJumpMap(t, x) - x_next;
+}
+
 PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
                                          const vector_t& x_next) {
   PerformanceIndex performance;
@@ -0,0 +1,353 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace ocs2 {
+
+namespace {
+/** One step of the Riccati recursion of the value function Hessian P. Returns false if the input Hessian is not positive definite. */
+bool riccatiHessianStep(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                        matrix_t& P, matrix_t& K) {
+  const auto& A = dynamics.dfdx;
+  const auto& B = dynamics.dfdu;
+  const matrix_t PA = P * A;
+  matrix_t Pnew = cost.dfdxx;
+  Pnew.noalias() += A.transpose() * PA;
+  if (B.cols() > 0) {
+    const matrix_t PB = P * B;
+    matrix_t H = cost.dfduu;
+    H.noalias() += B.transpose() * PB;
+    matrix_t G = cost.dfdux;
+    G.noalias() += B.transpose() * PA;
+    const Eigen::LLT<matrix_t> HChol(H);
+    if (HChol.info() != Eigen::Success) {
+      return false;
+    }
+    K = -HChol.solve(G);
+    Pnew.noalias() += G.transpose() * K;
+  } else {
+    K.setZero(0, A.cols());
+  }
+  P = 0.5 * (Pnew + Pnew.transpose());
+  return true;
+}
+}  // unnamed namespace
+
+PartitionedRiccatiSolver::PartitionedRiccatiSolver(ThreadPool& threadPool, size_t numThreads, size_t numPartitions)
+    : threadPool_(threadPool), numThreads_(std::max(numThreads, size_t(1))), numPartitions_(std::max(numPartitions, size_t(1))) {}
+
+bool PartitionedRiccatiSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                                     vector_array_t& inputTrajectory) {
+  const int N = static_cast<int>(dynamics.size());
+  if (cost.size() != N + 1) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] The cost should have one more node than the dynamics.");
+  }
+
+  // Split the horizon in partitions of (almost) equal length
+  const int numPartitions = std::max(std::min(static_cast<int>(numPartitions_), N), 1);
+  partitions_.resize(numPartitions);
+  for (int j = 0; j < numPartitions; j++) {
+    partitions_[j].start = (j * N) / numPartitions;
+    partitions_[j].end = ((j + 1) * N) / numPartitions;
+  }
+  feedback_.resize(N);
+  feedforward_.resize(N);
+  feedforwardLambda_.resize(N);
+
+  // Riccati recursion per partition, with the terminal Hessians of the previous call or else the exact ones
+  const bool success = (hasTerminalHessians(dynamics) && solvePartitions(dynamics, cost)) ||
+                       (computeTerminalHessians(dynamics, cost) && solvePartitions(dynamics, cost));
+  if (!success) {
+    return false;
+  }
+
+  // Boundary states and costates
+  solveCoupling(x0);
+
+  // Solution per partition
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+  runParallelOverPartitions([&](size_t j) { rolloutPartition(j, dynamics, stateTrajectory, inputTrajectory); });
+
+  return true;
+}
+
+matrix_array_t PartitionedRiccatiSolver::getRiccatiFeedback(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                            const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  matrix_array_t riccatiFeedback(feedback_.size());
+  std::atomic_bool success{true};
+  runParallelOverPartitions([&](size_t j) {
+    const auto& partition = partitions_[j];
+    if (partition.exactTerminalHessian) {
+      std::copy(feedback_.begin() + partition.start, feedback_.begin() + partition.end, riccatiFeedback.begin() + partition.start);
+      return;
+    }
+
+    // Value function Hessian from the start of the next partition
+    matrix_t P = partitions_[j + 1].S;
+    for (int k = partition.end - 1; k >= partition.start; k--) {
+      if (!riccatiHessianStep(dynamics[k], cost[k], P, riccatiFeedback[k])) {
+        success = false;
+        return;
+      }
+    }
+  });
+  if (!success) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] The input Hessian is not positive definite.");
+  }
+
+  return riccatiFeedback;
+}
+
+bool PartitionedRiccatiSolver::solvePartitions(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                               const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  std::atomic_bool success{true};
+  runParallelOverPartitions([&](size_t j) {
+    if (!solvePartition(j, dynamics, cost)) {
+      success = false;
+    }
+  });
+  return success;
+}
+
+bool PartitionedRiccatiSolver::hasTerminalHessians(const std::vector<VectorFunctionLinearApproximation>& dynamics) const {
+  return std::all_of(partitions_.begin(), partitions_.end() - 1, [&](const Partition& partition) {
+    const auto nx = dynamics[partition.end - 1].dfdx.rows();
+    return partition.terminalHessian.rows() == nx && partition.terminalHessian.cols() == nx;
+  });
+}
+
+bool PartitionedRiccatiSolver::computeTerminalHessians(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                       const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  matrix_t P = cost.back().dfdxx;
+  matrix_t K;
+  for (int j = static_cast<int>(partitions_.size()) - 1; j > 0; j--) {
+    for (int k = partitions_[j].end - 1; k >= partitions_[j].start; k--) {
+      if (!riccatiHessianStep(dynamics[k], cost[k], P, K)) {
+        return false;
+      }
+    }
+    partitions_[j - 1].terminalHessian = P;
+  }
+  return true;
+}
+
+bool PartitionedRiccatiSolver::solvePartition(size_t partitionIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                              const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  auto& partition = partitions_[partitionIndex];
+  const bool isLastPartition = (partitionIndex + 1 == partitions_.size());
+
+  // Value function at the end of the partition
+  matrix_t P, Gamma;
+  vector_t p;
+  if (isLastPartition) {
+    P = cost[partition.end].dfdxx;
+    p = cost[partition.end].dfdx;
+    Gamma.setZero(P.rows(), 0);
+  } else {
+    const auto nx = dynamics[partition.end - 1].dfdx.rows();
+    P = partition.terminalHessian;
+    p.setZero(nx);
+    Gamma.setIdentity(nx, nx);
+  }
+
+  // Backward Riccati recursion
+  matrix_t PA, PB, H, G, BtGamma;
+  vector_t Pbp, g;
+  for (int k = partition.end - 1; k >= partition.start; k--) {
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    const auto& b = dynamics[k].f;
+
+    PA.noalias() = P * A;
+    Pbp = p;
+    Pbp.noalias() += P * b;
+
+    matrix_t Pnew = cost[k].dfdxx;
+    Pnew.noalias() += A.transpose() * PA;
+    vector_t pnew = cost[k].dfdx;
+    pnew.noalias() += A.transpose() * Pbp;
+    matrix_t GammaNew;
+    GammaNew.noalias() = A.transpose() * Gamma;
+
+    if (B.cols() > 0) {
+      PB.noalias() = P * B;
+      H = cost[k].dfduu;
+      H.noalias() += B.transpose() * PB;
+      G = cost[k].dfdux;
+      G.noalias() += B.transpose() * PA;
+      g = cost[k].dfdu;
+      g.noalias() += B.transpose() * Pbp;
+      BtGamma.noalias() = B.transpose() * Gamma;
+
+      const Eigen::LLT<matrix_t> HChol(H);
+      if (HChol.info() != Eigen::Success) {
+        return false;
+      }
+      feedback_[k] = -HChol.solve(G);
+      feedforward_[k] = -HChol.solve(g);
+      feedforwardLambda_[k] = -HChol.solve(BtGamma);
+
+      Pnew.noalias() += G.transpose() * feedback_[k];
+      pnew.noalias() += G.transpose() * feedforward_[k];
+      GammaNew.noalias() += feedback_[k].transpose() * BtGamma;
+    } else {
+      feedback_[k].setZero(0, A.cols());
+      feedforward_[k].setZero(0);
+      feedforwardLambda_[k].setZero(0, Gamma.cols());
+    }
+
+    P = 0.5 * (Pnew + Pnew.transpose());
+    p.swap(pnew);
+    Gamma.swap(GammaNew);
+  }
+  partition.P.swap(P);
+  partition.p.swap(p);
+  partition.Gamma.swap(Gamma);
+
+  // Affine map from the start state and end costate to the end state
+  const auto nxStart = dynamics[partition.start].dfdx.cols();
+  partition.Phi.setIdentity(nxStart, nxStart);
+  partition.Psi.setZero(nxStart, partition.Gamma.cols());
+  partition.c.setZero(nxStart);
+  matrix_t closedLoopA, tmp;
+  for (int k = partition.start; k < partition.end; k++) {
+    const auto& B = dynamics[k].dfdu;
+    closedLoopA = dynamics[k].dfdx;
+    closedLoopA.noalias() += B * feedback_[k];
+
+    tmp.noalias() = closedLoopA * partition.Phi;
+    partition.Phi.swap(tmp);
+    tmp.noalias() = closedLoopA * partition.Psi;
+    tmp.noalias() += B * feedforwardLambda_[k];
+    partition.Psi.swap(tmp);
+    vector_t c = dynamics[k].f;
+    c.noalias() += closedLoopA * partition.c;
+    c.noalias() += B * feedforward_[k];
+    partition.c.swap(c);
+  }
+
+  return true;
+}
+
+void PartitionedRiccatiSolver::solveCoupling(const vector_t& x0) {
+  const int numPartitions = static_cast<int>(partitions_.size());
+
+  // Backward: value function gradient at the start of each partition, grad V(x_start) = S * x_start + s
+  auto& last = partitions_.back();
+  last.S = last.P;
+  last.s = last.p;
+  last.exactTerminalHessian = true;
+  for (int j = numPartitions - 2; j >= 0; j--) {
+    auto& partition = partitions_[j];
+    const auto& next = partitions_[j + 1];
+    // The costate at the end is S_next * x_end + s_next = terminalHessian * x_end + lambda, hence
+    // lambda = lambdaHessian * x_end + s_next and x_end = Phi * x_start + Psi * lambda + c
+    //  => x_end = (I - Psi * lambdaHessian)^-1 * (Phi * x_start + Psi * s_next + c)
+    partition.lambdaHessian = next.S - partition.terminalHessian;
+    partition.exactTerminalHessian = next.S.isApprox(partition.terminalHessian, 1e-9);
+    matrix_t IminusPsiS = matrix_t::Identity(partition.Psi.rows(), partition.Psi.rows());
+    IminusPsiS.noalias() -= partition.Psi * partition.lambdaHessian;
+    partition.couplingLu.compute(IminusPsiS);
+
+    if (j > 0) {
+      vector_t endOffset = partition.c;
+      endOffset.noalias() += partition.Psi * next.s;
+      const matrix_t SnextM = partition.lambdaHessian * partition.couplingLu.solve(matrix_t(partition.Phi));
+      partition.S = partition.P;
+      partition.S.noalias() += partition.Gamma * SnextM;
+      partition.S = 0.5 * (partition.S + partition.S.transpose()).eval();
+      vector_t lambdaOffset = next.s;
+      lambdaOffset.noalias() += partition.lambdaHessian * partition.couplingLu.solve(endOffset);
+      partition.s = partition.p;
+      partition.s.noalias() += partition.Gamma * lambdaOffset;
+    }
+  }
+
+  // Forward: boundary states and costates
+  partitions_.front().xStart = x0;
+  for (int j = 0; j + 1 < numPartitions; j++) {
+    auto& partition = partitions_[j];
+    auto& next = partitions_[j + 1];
+    vector_t rhs = partition.c;
+    rhs.noalias() += partition.Phi * partition.xStart;
+    rhs.noalias() += partition.Psi * next.s;
+    next.xStart = partition.couplingLu.solve(rhs);
+    partition.lambda = next.s;
+    partition.lambda.noalias() += partition.lambdaHessian * next.xStart;
+  }
+  last.lambda.resize(0);
+
+  // Propagate the value function Hessians as the terminal Hessians of the next call
+  for (int j = 0; j + 1 < numPartitions; j++) {
+    partitions_[j].terminalHessian = partitions_[j + 1].S;
+  }
+}
+
+void PartitionedRiccatiSolver::rolloutPartition(size_t partitionIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const {
+  const auto& partition = partitions_[partitionIndex];
+  vector_t x = partition.xStart;
+  for (int k = partition.start; k < partition.end; k++) {
+    vector_t u = feedforward_[k];
+    u.noalias() += feedback_[k] * x;
+    u.noalias() += feedforwardLambda_[k] * partition.lambda;
+
+    vector_t xNext = dynamics[k].f;
+    xNext.noalias() += dynamics[k].dfdx * x;
+    xNext.noalias() += dynamics[k].dfdu * u;
+
+    stateTrajectory[k] = std::move(x);
+    inputTrajectory[k] = std::move(u);
+    x = std::move(xNext);
+  }
+
+  // The end state is the start state of the next partition, which is set by its own rollout.
+  if (partitionIndex + 1 == partitions_.size()) {
+    stateTrajectory[partition.end] = std::move(x);
+  }
+}
+
+void PartitionedRiccatiSolver::runParallelOverPartitions(const std::function<void(size_t)>& task) {
+  std::atomic_size_t nextPartition{0};
+  auto parallelTask = [&](int) {
+    size_t j;
+    while ((j = nextPartition++) < partitions_.size()) {
+      task(j);
+    }
+  };
+  threadPool_.runParallel(std::move(parallelTask), std::min(numThreads_, partitions_.size()));
+}
+
+}  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <memory>
+
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
@@ -142,4 +145,175 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     // Feed forward part
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
-}
\ No newline at end of file
+}
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_partitionedRiccati) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 4;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  const ocs2::scalar_array_t partitioningTimes{0.0};                            // doesn't matter
+
+  // Solve with HPIPM and with the partitioned Riccati solver
+  ocs2::MultipleShootingSolver hpipmSolver(settings, problem, zeroInitializer);
+  hpipmSolver.run(startTime, initState, finalTime, partitioningTimes);
+  settings.usePartitionedRiccati = true;
+  ocs2::MultipleShootingSolver riccatiSolver(settings, problem, zeroInitializer);
+  riccatiSolver.run(startTime, initState, finalTime, partitioningTimes);
+
+  // Compare solutions
+  const auto hpipmSolution = hpipmSolver.primalSolution(finalTime);
+  const auto riccatiSolution = riccatiSolver.primalSolution(finalTime);
+  ASSERT_EQ(riccatiSolution.timeTrajectory_.size(), hpipmSolution.timeTrajectory_.size());
+  for (int i = 0; i < riccatiSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = riccatiSolution.timeTrajectory_[i];
+    const auto& x = riccatiSolution.stateTrajectory_[i];
+    ASSERT_TRUE(x.isApprox(hpipmSolution.stateTrajectory_[i], 1e-6));
+    ASSERT_TRUE(riccatiSolution.inputTrajectory_[i].isApprox(hpipmSolution.inputTrajectory_[i], 1e-6));
+    ASSERT_TRUE(riccatiSolution.controllerPtr_->computeInput(t, x).isApprox(hpipmSolution.controllerPtr_->computeInput(t, x), 1e-6));
+  }
+}
+
+namespace {
+/** Circular kinematics constraint that counts its evaluations, to measure the cost of the linesearch */
+class CountingCircularKinematicsConstraints final : public ocs2::StateInputConstraint {
+ public:
+  CountingCircularKinematicsConstraints()
+      : ocs2::StateInputConstraint(ocs2::ConstraintOrder::Linear), numEvaluationsPtr_(std::make_shared<std::atomic_size_t>(0)) {}
+  ~CountingCircularKinematicsConstraints() override = default;
+  CountingCircularKinematicsConstraints* clone() const override { return new CountingCircularKinematicsConstraints(*this); }
+
+  size_t getNumConstraints(ocs2::scalar_t time) const override { return constraint_.getNumConstraints(time); }
+
+  ocs2::vector_t getValue(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                          const ocs2::PreComputation& preComp) const override {
+    ++(*numEvaluationsPtr_);
+    return constraint_.getValue(t, x, u, preComp);
+  }
+
+  ocs2::VectorFunctionLinearApproximation getLinearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                                 const ocs2::PreComputation& preComp) const override {
+    return constraint_.getLinearApproximation(t, x, u, preComp);
+  }
+
+  /** Number of evaluations of the constraint value of this constraint and all its clones */
+  size_t getNumEvaluations() const { return *numEvaluationsPtr_; }
+
+ private:
+  ocs2::CircularKinematicsConstraints constraint_;
+  std::shared_ptr<std::atomic_size_t> numEvaluationsPtr_;
+};
+/** Result of a solve: number of SQP iterations, number of constraint evaluations, and the performance of the solution */
+struct CountedSolution {
+  size_t numIterations;
+  size_t numEvaluations;
+  ocs2::PerformanceIndex performance;
+};
+
+/** Solves the circular kinematics problem starting at {radius, 0}, and counts the constraint evaluations of all trial steps */
+CountedSolution solveCounting(const ocs2::multiple_shooting::Settings& settings, ocs2::scalar_t radius) {
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  std::unique_ptr<CountingCircularKinematicsConstraints> constraintPtr(new CountingCircularKinematicsConstraints);
+  const auto& constraint = *constraintPtr;
+  problem.equalityConstraintPtr.reset(new ocs2::StateInputConstraintCollection);
+  problem.equalityConstraintPtr->add("constraint", std::move(constraintPtr));
+
+  ocs2::DefaultInitializer zeroInitializer(2);
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  const size_t numEvaluations = constraint.getNumEvaluations();  // the solver evaluates its own clones of the constraint
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << radius, 0.0).finished();
+  solver.run(0.0, initState, 1.0, {0.0});
+  return {solver.getNumIterations(), constraint.getNumEvaluations() - numEvaluations, solver.getPerformanceIndeces()};
+}
+}  // unnamed namespace
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_filterLineSearch) {
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 50;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+
+  auto filterSettings = settings;
+  filterSettings.useFilterLineSearch = true;
+  filterSettings.maxSecondOrderCorrections = 2;
+
+  for (const ocs2::scalar_t radius : {1.0, 2.0, 0.5}) {
+    const auto backtracking = solveCounting(settings, radius);
+    const auto filter = solveCounting(filterSettings, radius);
+
+    std::cerr << "[filterLineSearch] radius: " << radius << "\n"
+              << "  backtracking linesearch, SQP iterations: " << backtracking.numIterations
+              << ", constraint evaluations: " << backtracking.numEvaluations << ", merit: " << backtracking.performance.merit << "\n"
+              << "  filter linesearch with second order correction, SQP iterations: " << filter.numIterations
+              << ", constraint evaluations: " << filter.numEvaluations << ", merit: " << filter.performance.merit << "\n";
+
+    // Same local solution, feasible
+    EXPECT_LT(filter.performance.stateInputEqConstraintISE, 1e-6);
+    EXPECT_LT(filter.performance.stateEqConstraintISE, 1e-6);
+    EXPECT_NEAR(filter.performance.merit, backtracking.performance.merit, 1e-6);
+    EXPECT_LE(filter.numIterations, backtracking.numIterations);
+  }
+}
+
+TEST(test_circular_kinematics, solve_EqConstraints_filterLineSearch_secondOrderCorrection) {
+  // Coarse discretization and a small circle: the full steps are rejected for their constraint violation (Maratos effect)
+  const ocs2::scalar_t radius = 0.2;
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 100;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+
+  // The non-projected case corrects the constant term of the constraints in the QP subproblem, the projected case its projection
+  for (const bool projectConstraints : {true, false}) {
+    settings.projectStateInputEqualityConstraints = projectConstraints;
+
+    auto filterSettings = settings;
+    filterSettings.useFilterLineSearch = true;
+    filterSettings.maxSecondOrderCorrections = 0;
+
+    auto correctionSettings = filterSettings;
+    correctionSettings.maxSecondOrderCorrections = 1;
+
+    const auto backtracking = solveCounting(settings, radius);
+    const auto filter = solveCounting(filterSettings, radius);
+    const auto correction = solveCounting(correctionSettings, radius);
+
+    std::cerr << "[secondOrderCorrection] projected: " << projectConstraints << "\n"
+              << "  backtracking, SQP iterations: " << backtracking.numIterations
+              << ", constraint evaluations: " << backtracking.numEvaluations << ", merit: " << backtracking.performance.merit << "\n"
+              << "  filter, SQP iterations: " << filter.numIterations << ", constraint evaluations: " << filter.numEvaluations
+              << ", merit: " << filter.performance.merit << "\n"
+              << "  filter with second order correction, SQP iterations: " << correction.numIterations
+              << ", constraint evaluations: " << correction.numEvaluations << ", merit: " << correction.performance.merit << "\n";
+
+    // The second order correction converges to a feasible solution
+    EXPECT_LT(correction.numIterations, settings.sqpIteration);
+    EXPECT_LT(correction.performance.stateInputEqConstraintISE, 1e-6);
+    EXPECT_LT(correction.performance.stateEqConstraintISE, 1e-6);
+
+    // The backtracking linesearch stalls at a worse point, the filter alone takes many short steps and does not get further
+    EXPECT_LT(correction.performance.merit, backtracking.performance.merit);
+    EXPECT_LE(correction.performance.merit, filter.performance.merit + 1e-6);
+    EXPECT_LT(correction.numIterations, filter.numIterations);
+    EXPECT_LT(correction.numEvaluations, filter.numEvaluations);
+    EXPECT_LT(correction.numEvaluations, backtracking.numEvaluations);
+  }
+}
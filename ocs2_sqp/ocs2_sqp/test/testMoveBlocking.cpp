@@ -0,0 +1,281 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include <hpipm_catkin/HpipmInterface.h>
+#include <ocs2_qp_solver/test/testProblemsGeneration.h>
+
+#include "ocs2_sqp/MoveBlocking.h"
+#include "ocs2_sqp/MultipleShootingSolver.h"
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+namespace {
+/** Random unconstrained LQ problem in the format of the multiple shooting solver */
+void getRandomProblem(int N, int nx, int nu, std::vector<ocs2::VectorFunctionLinearApproximation>& dynamics,
+                      std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost) {
+  const auto lqProblem = ocs2::qp_solver::generateRandomLqProblem(N, nx, nu, 0);
+  dynamics.clear();
+  cost.clear();
+  for (int k = 0; k < N; k++) {
+    dynamics.push_back(lqProblem[k].dynamics);
+    cost.push_back(lqProblem[k].cost);
+  }
+  cost.push_back(lqProblem[N].cost);
+}
+
+/** Cost of the LQ problem for the inputs u, starting from x0 */
+ocs2::scalar_t rolloutCost(const std::vector<ocs2::VectorFunctionLinearApproximation>& dynamics,
+                           const std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost, const ocs2::vector_t& x0,
+                           const ocs2::vector_array_t& u) {
+  ocs2::scalar_t totalCost = 0.0;
+  ocs2::vector_t x = x0;
+  for (int k = 0; k < dynamics.size(); k++) {
+    const auto& c = cost[k];
+    totalCost += c.f + c.dfdx.dot(x) + c.dfdu.dot(u[k]) + 0.5 * x.dot(c.dfdxx * x) + u[k].dot(c.dfdux * x) + 0.5 * u[k].dot(c.dfduu * u[k]);
+    x = dynamics[k].dfdx * x + dynamics[k].dfdu * u[k] + dynamics[k].f;
+  }
+  totalCost += cost.back().f + cost.back().dfdx.dot(x) + 0.5 * x.dot(cost.back().dfdxx * x);
+  return totalCost;
+}
+}  // namespace
+
+using namespace ocs2;
+
+TEST(test_move_blocking, schedule) {
+  const auto time = timeDiscretizationWithEvents(0.0, 1.0, 0.05, {});
+  const auto moveBlocks = multiple_shooting::getMoveBlocks(time, 3, 1.5, 4);
+  const std::vector<int> expected{0, 1, 2, 3, 3, 5, 5, 5, 8, 8, 8, 8, 12, 12, 12, 12, 16, 16, 16, 16};
+  EXPECT_EQ(moveBlocks, expected);
+
+  // Without growth, every node has its own input
+  const auto unblocked = multiple_shooting::getMoveBlocks(time, 3, 1.0, 4);
+  for (int i = 0; i < unblocked.size(); i++) {
+    EXPECT_EQ(unblocked[i], i);
+  }
+
+  // Blocks are cut at events
+  const auto timeWithEvent = timeDiscretizationWithEvents(0.0, 1.0, 0.05, {0.375});
+  const auto moveBlocksWithEvent = multiple_shooting::getMoveBlocks(timeWithEvent, 3, 1.5, 4);
+  for (int i = 0; i < moveBlocksWithEvent.size(); i++) {
+    ASSERT_LE(moveBlocksWithEvent[i], i);
+    for (int j = moveBlocksWithEvent[i]; j < i; j++) {
+      EXPECT_NE(timeWithEvent[j].event, AnnotatedTime::Event::PreEvent);
+    }
+  }
+}
+
+TEST(test_move_blocking, blockedQp) {
+  constexpr int N = 20;
+  constexpr int nx = 4;
+  constexpr int nu = 3;
+
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  getRandomProblem(N, nx, nu, dynamics, cost);
+  const vector_t x0 = vector_t::Random(nx);
+  const auto moveBlocks = multiple_shooting::getMoveBlocks(timeDiscretizationWithEvents(0.0, 1.0, 1.0 / N, {}), 4, 1.5, 5);
+
+  multiple_shooting::MoveBlockedSubproblem blockedSubproblem;
+  multiple_shooting::blockQuadraticSubproblem(moveBlocks, dynamics, cost, nullptr, blockedSubproblem);
+
+  const int numStages = blockedSubproblem.dynamics.size();
+  ASSERT_EQ(blockedSubproblem.stageNodes.size(), numStages + 1);
+  ASSERT_LT(numStages, N);
+
+  HpipmInterface hpipmInterface;
+  hpipmInterface.resize(hpipm_interface::extractSizesFromProblem(blockedSubproblem.dynamics, blockedSubproblem.cost, nullptr));
+  vector_array_t stageX, stageU, x, u;
+  ASSERT_EQ(hpipmInterface.solve(x0, blockedSubproblem.dynamics, blockedSubproblem.cost, nullptr, stageX, stageU), hpipm_status::SUCCESS);
+  multiple_shooting::unblockSolution(blockedSubproblem, dynamics, stageX, stageU, x, u);
+
+  ThreadPool threadPool(1);
+  PartitionedRiccatiSolver riccatiSolver(threadPool, 2, 3);
+  vector_array_t stageXRiccati, stageURiccati, xRiccati, uRiccati;
+  ASSERT_TRUE(riccatiSolver.solve(x0, blockedSubproblem.dynamics, blockedSubproblem.cost, stageXRiccati, stageURiccati));
+  multiple_shooting::unblockSolution(blockedSubproblem, dynamics, stageXRiccati, stageURiccati, xRiccati, uRiccati);
+
+  // Inputs are shared in a block, the dynamics are satisfied
+  ASSERT_EQ(x.size(), N + 1);
+  ASSERT_EQ(u.size(), N);
+  EXPECT_TRUE(x[0].isApprox(x0));
+  for (int k = 0; k < N; k++) {
+    ASSERT_EQ(x[k].size(), nx);
+    ASSERT_EQ(u[k].size(), nu);
+    EXPECT_TRUE(u[k].isApprox(u[moveBlocks[k]]));
+    EXPECT_TRUE(x[k + 1].isApprox(dynamics[k].dfdx * x[k] + dynamics[k].dfdu * u[k] + dynamics[k].f, 1e-9));
+    EXPECT_TRUE(xRiccati[k].isApprox(x[k], 1e-6));
+    EXPECT_TRUE(uRiccati[k].isApprox(u[k], 1e-6));
+  }
+
+  // Optimal among all blocked input trajectories
+  const scalar_t optimalCost = rolloutCost(dynamics, cost, x0, u);
+  for (int trial = 0; trial < 10; trial++) {
+    vector_array_t uPerturbed = u;
+    for (int k = 0; k < N; k++) {
+      uPerturbed[k] = (moveBlocks[k] == k) ? vector_t(u[k] + 0.1 * vector_t::Random(nu)) : uPerturbed[moveBlocks[k]];
+    }
+    EXPECT_GT(rolloutCost(dynamics, cost, x0, uPerturbed), optimalCost);
+  }
+
+  // Not better than the problem without blocking
+  vector_array_t xUnblocked, uUnblocked;
+  hpipmInterface.resize(hpipm_interface::extractSizesFromProblem(dynamics, cost, nullptr));
+  ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, nullptr, xUnblocked, uUnblocked), hpipm_status::SUCCESS);
+  EXPECT_LE(rolloutCost(dynamics, cost, x0, uUnblocked), optimalCost);
+}
+
+namespace {
+/** Linear MPC problem with quadratic cost around a constant target */
+struct LinearMpcProblem {
+  LinearMpcProblem(int nx, int nu)
+      : dynamicsMatrices(getRandomDynamics(nx, nu)),
+        costMatrices(getRandomCost(nx, nu)),
+        referenceManagerPtr(
+            std::make_shared<ReferenceManager>(TargetTrajectories({0.0}, {vector_t::Ones(nx)}, {vector_t::Zero(nu)}))),
+        initializer(nu) {
+    problem.dynamicsPtr = getOcs2Dynamics(dynamicsMatrices);
+    problem.costPtr->add("intermediateCost", getOcs2Cost(costMatrices));
+    problem.finalCostPtr->add("finalCost", getOcs2StateCost(costMatrices));
+    problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+  }
+
+  VectorFunctionLinearApproximation dynamicsMatrices;
+  ScalarFunctionQuadraticApproximation costMatrices;
+  std::shared_ptr<ReferenceManager> referenceManagerPtr;
+  DefaultInitializer initializer;
+  OptimalControlProblem problem;
+};
+
+multiple_shooting::Settings getLinearMpcSettings() {
+  multiple_shooting::Settings settings;
+  settings.dt = 0.02;
+  settings.sqpIteration = 5;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+  settings.moveBlockingUnblockedNodes = 5;
+  settings.moveBlockingGrowth = 1.5;
+  settings.moveBlockingMaxBlockSize = 5;
+  return settings;
+}
+}  // namespace
+
+TEST(test_move_blocking, solver) {
+  constexpr int nx = 4;
+  constexpr int nu = 2;
+  constexpr scalar_t finalTime = 1.0;
+  LinearMpcProblem mpcProblem(nx, nu);
+  const vector_t initState = vector_t::Zero(nx);
+
+  auto settings = getLinearMpcSettings();
+  MultipleShootingSolver unblockedSolver(settings, mpcProblem.problem, mpcProblem.initializer);
+  unblockedSolver.setReferenceManager(mpcProblem.referenceManagerPtr);
+  unblockedSolver.run(0.0, initState, finalTime, {0.0});
+
+  settings.useMoveBlocking = true;
+  MultipleShootingSolver blockedSolver(settings, mpcProblem.problem, mpcProblem.initializer);
+  blockedSolver.setReferenceManager(mpcProblem.referenceManagerPtr);
+  blockedSolver.run(0.0, initState, finalTime, {0.0});
+
+  // Linear dynamics are satisfied, inputs are shared in a block, and the optimal cost increases
+  const auto blockedSolution = blockedSolver.primalSolution(finalTime);
+  const auto moveBlocks = multiple_shooting::getMoveBlocks(timeDiscretizationWithEvents(0.0, finalTime, settings.dt, {}),
+                                                           settings.moveBlockingUnblockedNodes, settings.moveBlockingGrowth,
+                                                           settings.moveBlockingMaxBlockSize);
+  EXPECT_LT(blockedSolver.getIterationsLog().back().stateEqConstraintISE, 1e-9);
+  for (int i = 0; i < moveBlocks.size(); i++) {
+    EXPECT_TRUE(blockedSolution.inputTrajectory_[i].isApprox(blockedSolution.inputTrajectory_[moveBlocks[i]]));
+    const auto t = blockedSolution.timeTrajectory_[i];
+    const auto& x = blockedSolution.stateTrajectory_[i];
+    EXPECT_TRUE(blockedSolution.controllerPtr_->computeInput(t, x).isApprox(blockedSolution.inputTrajectory_[i]));
+  }
+  EXPECT_GE(blockedSolver.getIterationsLog().back().totalCost, unblockedSolver.getIterationsLog().back().totalCost - 1e-9);
+}
+
+TEST(test_move_blocking, benchmarkClosedLoop) {
+  constexpr int nx = 12;
+  constexpr int nu = 4;
+  constexpr scalar_t timeHorizon = 1.0;
+  constexpr scalar_t timeAdvance = 0.02;
+  constexpr int numCycles = 25;
+  LinearMpcProblem mpcProblem(nx, nu);
+  const auto& targetTrajectories = mpcProblem.referenceManagerPtr->getTargetTrajectories();
+
+  struct Schedule {
+    size_t unblockedNodes;
+    scalar_t growth;
+    size_t maxBlockSize;
+  };
+  // The first schedule does not block any input. The QP is solved with HPIPM and with the partitioned Riccati solver.
+  for (const bool usePartitionedRiccati : {false, true}) {
+    for (const auto& schedule : {Schedule{50, 1.0, 1}, Schedule{10, 1.5, 4}, Schedule{5, 1.5, 8}, Schedule{2, 2.0, 16}}) {
+      auto settings = getLinearMpcSettings();
+      settings.usePartitionedRiccati = usePartitionedRiccati;
+      settings.useMoveBlocking = true;
+      settings.moveBlockingUnblockedNodes = schedule.unblockedNodes;
+      settings.moveBlockingGrowth = schedule.growth;
+      settings.moveBlockingMaxBlockSize = schedule.maxBlockSize;
+      MultipleShootingSolver solver(settings, mpcProblem.problem, mpcProblem.initializer);
+      solver.setReferenceManager(mpcProblem.referenceManagerPtr);
+
+      // MPC loop with a perfect model
+      scalar_t time = 0.0;
+      vector_t state = vector_t::Zero(nx);
+      scalar_t closedLoopCost = 0.0;
+      benchmark::RepeatedTimer solveTimer;
+      for (int cycle = 0; cycle < numCycles; cycle++) {
+        solveTimer.startTimer();
+        solver.run(time, state, time + timeHorizon, {time});
+        solveTimer.endTimer();
+
+        const auto primalSolution = solver.primalSolution(time + timeHorizon);
+        const vector_t input = primalSolution.controllerPtr_->computeInput(time, state);
+        closedLoopCost += timeAdvance * mpcProblem.problem.costPtr->getValue(time, state, input, targetTrajectories, PreComputation());
+        time += timeAdvance;
+        state = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+      }
+
+      std::cerr << "[benchmarkClosedLoop] QP solver: " << (usePartitionedRiccati ? "partitioned Riccati" : "HPIPM")
+                << ", unblocked nodes: " << schedule.unblockedNodes << ", growth: " << schedule.growth
+                << ", max block size: " << schedule.maxBlockSize << "\n"
+                << "  closed-loop cost: " << closedLoopCost << ", average solve time [ms]: " << solveTimer.getAverageInMilliseconds()
+                << "\n";
+    }
+  }
+}
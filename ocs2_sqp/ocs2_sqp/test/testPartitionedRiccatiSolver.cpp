@@ -0,0 +1,216 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include <hpipm_catkin/HpipmInterface.h>
+#include <ocs2_qp_solver/test/testProblemsGeneration.h>
+
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+namespace {
+/** Random unconstrained LQ problem in the format of the multiple shooting solver */
+void getRandomProblem(int N, int nx, int nu, std::vector<ocs2::VectorFunctionLinearApproximation>& dynamics,
+                      std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost) {
+  const auto lqProblem = ocs2::qp_solver::generateRandomLqProblem(N, nx, nu, 0);
+  dynamics.clear();
+  cost.clear();
+  for (int k = 0; k < N; k++) {
+    dynamics.push_back(lqProblem[k].dynamics);
+    cost.push_back(lqProblem[k].cost);
+  }
+  cost.push_back(lqProblem[N].cost);
+}
+}  // namespace
+
+using namespace ocs2;
+
+TEST(test_partitioned_riccati, compareToHpipm) {
+  constexpr int N = 20;
+  constexpr int nx = 4;
+  constexpr int nu = 3;
+
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  getRandomProblem(N, nx, nu, dynamics, cost);
+  const vector_t x0 = vector_t::Random(nx);
+
+  HpipmInterface hpipmInterface(HpipmInterface::OcpSize(N, nx, nu));
+  vector_array_t xHpipm, uHpipm;
+  ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, nullptr, xHpipm, uHpipm), hpipm_status::SUCCESS);
+  const auto KHpipm = hpipmInterface.getRiccatiFeedback(dynamics[0], cost[0]);
+
+  ThreadPool threadPool(3);
+  for (size_t numPartitions : {1, 2, 3, 7, N, 2 * N}) {
+    PartitionedRiccatiSolver riccatiSolver(threadPool, 4, numPartitions);
+    vector_array_t x, u;
+    ASSERT_TRUE(riccatiSolver.solve(x0, dynamics, cost, x, u));
+    const auto K = riccatiSolver.getRiccatiFeedback(dynamics, cost);
+
+    ASSERT_EQ(x.size(), N + 1);
+    ASSERT_EQ(u.size(), N);
+    ASSERT_EQ(K.size(), N);
+    for (int k = 0; k < N; k++) {
+      EXPECT_TRUE(x[k].isApprox(xHpipm[k], 1e-6)) << "numPartitions: " << numPartitions << ", k: " << k;
+      EXPECT_TRUE(u[k].isApprox(uHpipm[k], 1e-6)) << "numPartitions: " << numPartitions << ", k: " << k;
+      EXPECT_TRUE(K[k].isApprox(KHpipm[k], 1e-6)) << "numPartitions: " << numPartitions << ", k: " << k;
+    }
+    EXPECT_TRUE(x[N].isApprox(xHpipm[N], 1e-6)) << "numPartitions: " << numPartitions;
+  }
+}
+
+TEST(test_partitioned_riccati, varyingSizes) {
+  constexpr int N = 12;
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  getRandomProblem(N, nx, nu, dynamics, cost);
+  // event nodes without input
+  for (int k : {4, 5, 9}) {
+    dynamics[k] = getRandomDynamics(nx, 0);
+    cost[k] = getRandomCost(nx, 0);
+  }
+  const vector_t x0 = vector_t::Random(nx);
+
+  HpipmInterface hpipmInterface;
+  hpipmInterface.resize(hpipm_interface::extractSizesFromProblem(dynamics, cost, nullptr));
+  vector_array_t xHpipm, uHpipm;
+  ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, nullptr, xHpipm, uHpipm), hpipm_status::SUCCESS);
+
+  ThreadPool threadPool(1);
+  PartitionedRiccatiSolver riccatiSolver(threadPool, 2, 5);
+  vector_array_t x, u;
+  ASSERT_TRUE(riccatiSolver.solve(x0, dynamics, cost, x, u));
+  for (int k = 0; k < N; k++) {
+    EXPECT_TRUE(x[k].isApprox(xHpipm[k], 1e-6));
+    ASSERT_EQ(u[k].size(), dynamics[k].dfdu.cols());
+    EXPECT_TRUE(u[k].isApprox(uHpipm[k], 1e-6));
+  }
+  EXPECT_TRUE(x[N].isApprox(xHpipm[N], 1e-6));
+}
+
+TEST(test_partitioned_riccati, semiDefiniteInputCost) {
+  constexpr int N = 20;
+  constexpr int nx = 4;
+  constexpr int nu = 3;
+
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  getRandomProblem(N, nx, nu, dynamics, cost);
+  // no input cost: the input Hessian is only positive definite through the value function of the next stage
+  for (int k = 0; k < N; k++) {
+    cost[k].dfduu.setZero();
+    cost[k].dfdux.setZero();
+  }
+  const vector_t x0 = vector_t::Random(nx);
+
+  HpipmInterface hpipmInterface(HpipmInterface::OcpSize(N, nx, nu));
+  vector_array_t xHpipm, uHpipm;
+  ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, nullptr, xHpipm, uHpipm), hpipm_status::SUCCESS);
+  const auto KHpipm = hpipmInterface.getRiccatiFeedback(dynamics[0], cost[0]);
+
+  ThreadPool threadPool(1);
+  PartitionedRiccatiSolver riccatiSolver(threadPool, 2, 4);
+  // the second solve uses the propagated terminal Hessians of the first one
+  for (int i = 0; i < 2; i++) {
+    vector_array_t x, u;
+    ASSERT_TRUE(riccatiSolver.solve(x0, dynamics, cost, x, u));
+    const auto K = riccatiSolver.getRiccatiFeedback(dynamics, cost);
+    for (int k = 0; k < N; k++) {
+      EXPECT_TRUE(x[k].isApprox(xHpipm[k], 1e-6)) << "k: " << k;
+      EXPECT_TRUE(u[k].isApprox(uHpipm[k], 1e-6)) << "k: " << k;
+      EXPECT_TRUE(K[k].isApprox(KHpipm[k], 1e-6)) << "k: " << k;
+    }
+    EXPECT_TRUE(x[N].isApprox(xHpipm[N], 1e-6));
+  }
+}
+
+TEST(test_partitioned_riccati, changingProblem) {
+  constexpr int N = 20;
+  constexpr int nx = 4;
+  constexpr int nu = 3;
+
+  ThreadPool threadPool(1);
+  PartitionedRiccatiSolver riccatiSolver(threadPool, 2, 4);
+  // the terminal Hessians propagated from the previous problem are not exact, which must not change the solution
+  for (int i = 0; i < 3; i++) {
+    std::vector<VectorFunctionLinearApproximation> dynamics;
+    std::vector<ScalarFunctionQuadraticApproximation> cost;
+    getRandomProblem(N, nx, nu, dynamics, cost);
+    const vector_t x0 = vector_t::Random(nx);
+
+    HpipmInterface hpipmInterface(HpipmInterface::OcpSize(N, nx, nu));
+    vector_array_t xHpipm, uHpipm;
+    ASSERT_EQ(hpipmInterface.solve(x0, dynamics, cost, nullptr, xHpipm, uHpipm), hpipm_status::SUCCESS);
+    const auto KHpipm = hpipmInterface.getRiccatiFeedback(dynamics[0], cost[0]);
+
+    vector_array_t x, u;
+    ASSERT_TRUE(riccatiSolver.solve(x0, dynamics, cost, x, u));
+    const auto K = riccatiSolver.getRiccatiFeedback(dynamics, cost);
+    for (int k = 0; k < N; k++) {
+      EXPECT_TRUE(x[k].isApprox(xHpipm[k], 1e-6)) << "problem: " << i << ", k: " << k;
+      EXPECT_TRUE(u[k].isApprox(uHpipm[k], 1e-6)) << "problem: " << i << ", k: " << k;
+      EXPECT_TRUE(K[k].isApprox(KHpipm[k], 1e-6)) << "problem: " << i << ", k: " << k;
+    }
+  }
+}
+
+TEST(test_partitioned_riccati, benchmarkScaling) {
+  constexpr int nx = 12;
+  constexpr int nu = 4;
+  constexpr int numRepeats = 20;
+
+  for (int N : {100, 200, 400}) {
+    std::vector<VectorFunctionLinearApproximation> dynamics;
+    std::vector<ScalarFunctionQuadraticApproximation> cost;
+    getRandomProblem(N, nx, nu, dynamics, cost);
+    const vector_t x0 = vector_t::Random(nx);
+
+    std::cerr << "[benchmarkScaling] horizon: " << N << " (nx: " << nx << ", nu: " << nu << ")\n";
+    for (size_t numThreads : {1, 2, 4, 8}) {
+      ThreadPool threadPool(numThreads - 1);
+      PartitionedRiccatiSolver riccatiSolver(threadPool, numThreads, numThreads);
+      vector_array_t x, u;
+      benchmark::RepeatedTimer timer;
+      for (int i = 0; i < numRepeats; i++) {
+        timer.startTimer();
+        ASSERT_TRUE(riccatiSolver.solve(x0, dynamics, cost, x, u));
+        timer.endTimer();
+      }
+      std::cerr << "  threads: " << numThreads << ", average solve time [ms]: " << timer.getAverageInMilliseconds() << "\n";
+    }
+  }
+}
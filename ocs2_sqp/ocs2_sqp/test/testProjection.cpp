@@ -61,4 +61,33 @@ TEST(test_projection, testProjectionLU) {
 
   // D * Pe cancels the e term
   ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
-}
\ No newline at end of file
+}
+
+TEST(test_projection, testCachedProjection) {
+  ocs2::ConstraintProjectionCache cache;
+  auto constraint = ocs2::getRandomConstraints(30, 20, 10);
+
+  for (int i = 0; i < 3; i++) {
+    // new C and e with the same D: the factorization is reused
+    constraint.dfdx.setRandom();
+    constraint.f.setRandom();
+    if (i == 2) {
+      // new D: the factorization is updated
+      constraint.dfdu.setRandom();
+    }
+
+    const auto luProjection = ocs2::luConstraintProjection(constraint);
+    const auto luProjectionCached = ocs2::luConstraintProjection(constraint, cache);
+    ASSERT_TRUE(cache.isCached(constraint.dfdu));
+    ASSERT_TRUE(luProjectionCached.dfdu.isApprox(luProjection.dfdu));
+    ASSERT_TRUE(luProjectionCached.dfdx.isApprox(luProjection.dfdx));
+    ASSERT_TRUE(luProjectionCached.f.isApprox(luProjection.f));
+
+    const auto qrProjection = ocs2::qrConstraintProjection(constraint);
+    const auto qrProjectionCached = ocs2::qrConstraintProjection(constraint, cache);
+    ASSERT_TRUE(cache.isCached(constraint.dfdu));
+    ASSERT_TRUE(qrProjectionCached.dfdu.isApprox(qrProjection.dfdu));
+    ASSERT_TRUE(qrProjectionCached.dfdx.isApprox(qrProjection.dfdx));
+    ASSERT_TRUE(qrProjectionCached.f.isApprox(qrProjection.f));
+  }
+}
@@ -29,6 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
 #include <ocs2_oc/test/circular_kinematics.h>
@@ -109,3 +113,52 @@ TEST(test_transcription, event_performance) {
 
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
 }
+
+TEST(test_transcription, benchmark_cached_projection) {
+  constexpr int nx = 24;
+  constexpr int nu = 18;
+  constexpr int nc = 12;  // many state-input equality constraints with a constant input Jacobian
+  constexpr int numNodes = 100;
+  constexpr int numIterations = 20;
+
+  OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+  problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+  problem.equalityConstraintPtr->add("constraint", getOcs2Constraints(getRandomConstraints(nx, nu, nc)));
+
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK2);
+  const scalar_t dt = 0.01;
+  vector_array_t x(numNodes + 1);
+  vector_array_t u(numNodes);
+  for (int i = 0; i < numNodes; i++) {
+    x[i] = vector_t::Random(nx);
+    u[i] = vector_t::Random(nu);
+  }
+  x[numNodes] = vector_t::Random(nx);
+
+  ConstraintProjectionCache cache;
+  benchmark::RepeatedTimer uncachedTimer;
+  benchmark::RepeatedTimer cachedTimer;
+  for (int iter = 0; iter < numIterations; iter++) {
+    for (int i = 0; i < numNodes; i++) {
+      const scalar_t t = i * dt;
+      uncachedTimer.startTimer();
+      const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x[i], x[i + 1], u[i]);
+      uncachedTimer.endTimer();
+
+      cachedTimer.startTimer();
+      const auto cachedTranscription = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x[i], x[i + 1], u[i], &cache);
+      cachedTimer.endTimer();
+
+      ASSERT_TRUE(cachedTranscription.constraintsProjection.dfdu.isApprox(transcription.constraintsProjection.dfdu));
+      ASSERT_TRUE(cachedTranscription.cost.dfduu.isApprox(transcription.cost.dfduu));
+    }
+  }
+
+  std::cerr << "[benchmark_cached_projection] intermediate node transcription (nx: " << nx << ", nu: " << nu << ", nc: " << nc << ")\n"
+            << "  without projection cache [ms]: " << uncachedTimer.getTotalInMilliseconds() << "\n"
+            << "  with projection cache [ms]: " << cachedTimer.getTotalInMilliseconds() << "\n";
+}
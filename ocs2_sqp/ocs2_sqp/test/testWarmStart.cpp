@@ -0,0 +1,185 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "ocs2_sqp/MultipleShootingSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+#include <ocs2_oc/test/circular_kinematics.h>
+
+namespace {
+ocs2::multiple_shooting::Settings getSettings() {
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 1;
+  return settings;
+}
+
+/** Runs an MPC loop with a perfect model and returns the iterations log of each cycle after the first one */
+std::vector<std::vector<ocs2::PerformanceIndex>> runMpcLoop(const ocs2::multiple_shooting::Settings& settings,
+                                                            ocs2::scalar_t timeAdvance) {
+  constexpr size_t numCycles = 11;
+  constexpr ocs2::scalar_t timeHorizon = 1.0;
+
+  const auto problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+
+  ocs2::scalar_t time = 0.0;
+  ocs2::vector_t state = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  std::vector<std::vector<ocs2::PerformanceIndex>> iterationsLogs;
+  for (size_t cycle = 0; cycle < numCycles; cycle++) {
+    solver.run(time, state, time + timeHorizon, {time});
+    if (cycle > 0) {
+      iterationsLogs.push_back(solver.getIterationsLog());
+    }
+
+    // advance along the optimal trajectory
+    ocs2::PrimalSolution primalSolution;
+    solver.getPrimalSolution(time + timeHorizon, &primalSolution);
+    time += timeAdvance;
+    state = ocs2::LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+  }
+  return iterationsLogs;
+}
+}  // unnamed namespace
+
+TEST(test_warm_start, shiftWarmStart) {
+  // baseline: interpolation of the previous solution and the initializer beyond its horizon
+  auto settings = getSettings();
+  settings.deltaTol = 1e-5;
+
+  auto shiftSettings = settings;
+  shiftSettings.useShiftWarmStart = true;
+  shiftSettings.warmStartTail = ocs2::multiple_shooting::WarmStartTail::LastFeedback;
+
+  // Total number of iterations, and the constraint violation of the initial guess of each cycle
+  auto summarize = [](const std::vector<std::vector<ocs2::PerformanceIndex>>& iterationsLogs) {
+    size_t numIterations = 0;
+    ocs2::scalar_t initialConstraintISE = 0.0;
+    for (const auto& log : iterationsLogs) {
+      numIterations += log.size();
+      initialConstraintISE += log.front().stateInputEqConstraintISE;
+    }
+    return std::make_pair(numIterations, initialConstraintISE);
+  };
+
+  // time advance of a multiple of dt, and close to a multiple of dt
+  for (const ocs2::scalar_t timeAdvance : {2.0 * settings.dt, 2.05 * settings.dt}) {
+    const auto interpolation = summarize(runMpcLoop(settings, timeAdvance));
+    const auto shift = summarize(runMpcLoop(shiftSettings, timeAdvance));
+
+    std::cerr << "[shiftWarmStart] time advance: " << timeAdvance << " [s]\n"
+              << "  interpolation warm start, total SQP iterations: " << interpolation.first
+              << ", constraint ISE of the initial guesses: " << interpolation.second << "\n"
+              << "  shift warm start, total SQP iterations: " << shift.first << ", constraint ISE of the initial guesses: " << shift.second
+              << "\n";
+    EXPECT_LT(shift.first, interpolation.first);
+    EXPECT_LT(shift.second, interpolation.second);
+  }
+}
+
+TEST(test_warm_start, snapshotRoundTrip) {
+  const std::string snapshotFileName = "ocs2_sqp_warm_start_snapshot.bin";
+  const auto problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  const ocs2::DefaultInitializer zeroInitializer(2);
+  const auto settings = getSettings();
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  const ocs2::scalar_array_t partitioningTimes{0.0};
+
+  // the solver of the process which is going to be restarted
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime, partitioningTimes);
+  const auto solution = solver.primalSolution(finalTime);
+  ASSERT_NO_THROW(solver.saveWarmStart(snapshotFileName));
+
+  // round trip
+  ocs2::MultipleShootingSolver warmStartSolver(settings, problem, zeroInitializer);
+  ASSERT_NO_THROW(warmStartSolver.loadWarmStart(snapshotFileName));
+  const auto loadedSolution = warmStartSolver.primalSolution(finalTime);
+  EXPECT_EQ(loadedSolution.timeTrajectory_, solution.timeTrajectory_);
+  EXPECT_EQ(loadedSolution.stateTrajectory_, solution.stateTrajectory_);
+  EXPECT_EQ(loadedSolution.inputTrajectory_, solution.inputTrajectory_);
+  const auto t = solution.timeTrajectory_[solution.timeTrajectory_.size() / 2];
+  const auto& x = solution.stateTrajectory_[solution.stateTrajectory_.size() / 2];
+  EXPECT_TRUE(loadedSolution.controllerPtr_->computeInput(t, x).isApprox(solution.controllerPtr_->computeInput(t, x)));
+
+  // the first solve after the restart starts from the converged solution
+  warmStartSolver.run(startTime, initState, finalTime, partitioningTimes);
+  std::cerr << "[SQP warm-start snapshot] number of iterations of the first solve:\n";
+  std::cerr << "cold start: " << solver.getNumIterations() << "\n";
+  std::cerr << "snapshot:   " << warmStartSolver.getNumIterations() << "\n";
+  EXPECT_LT(warmStartSolver.getNumIterations(), solver.getNumIterations());
+  EXPECT_LT(warmStartSolver.getPerformanceIndeces().stateInputEqConstraintISE, 1e-6);
+
+  // an in-memory copy holds the same warm start as the snapshot
+  ocs2::MultipleShootingSolver copiedSolver(settings, problem, zeroInitializer);
+  copiedSolver.copyWarmStart(solver);
+  const auto copiedSolution = copiedSolver.primalSolution(finalTime);
+  EXPECT_EQ(copiedSolution.timeTrajectory_, solution.timeTrajectory_);
+  EXPECT_EQ(copiedSolution.stateTrajectory_, solution.stateTrajectory_);
+  EXPECT_EQ(copiedSolution.inputTrajectory_, solution.inputTrajectory_);
+  EXPECT_TRUE(copiedSolution.controllerPtr_->computeInput(t, x).isApprox(solution.controllerPtr_->computeInput(t, x)));
+  copiedSolver.run(startTime, initState, finalTime, partitioningTimes);
+  EXPECT_EQ(copiedSolver.getNumIterations(), warmStartSolver.getNumIterations());
+
+  // a truncated snapshot throws and leaves the solver untouched
+  std::string data;
+  {
+    std::ifstream file(snapshotFileName, std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(snapshotFileName, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size() / 2);
+  }
+  EXPECT_THROW(warmStartSolver.loadWarmStart(snapshotFileName), std::runtime_error);
+  EXPECT_EQ(warmStartSolver.primalSolution(finalTime).timeTrajectory_, solution.timeTrajectory_);
+
+  // a missing snapshot throws
+  EXPECT_ANY_THROW(warmStartSolver.loadWarmStart(snapshotFileName + ".missing"));
+
+  std::remove(snapshotFileName.c_str());
+}
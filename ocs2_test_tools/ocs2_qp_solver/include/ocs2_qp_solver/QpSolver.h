@@ -46,6 +46,18 @@ namespace qp_solver {
 std::pair<vector_array_t, vector_array_t> solveLinearQuadraticProblem(const std::vector<LinearQuadraticStage>& lqApproximation,
                                                                       const vector_t& dx0);
 
+/**
+ * Solves the discretized linear quadratic optimal control problem with a sparse LDLT factorization of the KKT system.
+ * The primal and dual variables are ordered stage by stage, such that the KKT matrix is block-tridiagonal and the factorization
+ * scales linearly in the horizon length. The result is the same as solveLinearQuadraticProblem.
+ *
+ * @param lqApproximation : vector of stage-wise discrete quadratic cost and linear dynamics
+ * @param dx0 : initial state deviation from the nominal trajectories.
+ * @return trajectory of state and inputs (in relative coordinates), .i.e. dx(t), du(t)
+ */
+std::pair<vector_array_t, vector_array_t> solveLinearQuadraticProblemSparse(const std::vector<LinearQuadraticStage>& lqApproximation,
+                                                                            const vector_t& dx0);
+
 /**
  * Constructs the matrix of stacked dynamic constraints A w + b = 0
  *
@@ -107,6 +119,25 @@ std::pair<ScalarFunctionQuadraticApproximation, VectorFunctionLinearApproximatio
 std::pair<vector_t, vector_t> solveDenseQp(const ScalarFunctionQuadraticApproximation& cost,
                                            const VectorFunctionLinearApproximation& constraints);
 
+/**
+ * Solves the equality constrained QP of the discretized linear quadratic control problem without forming the dense matrices.
+ * The KKT system
+ *   [H A'] [ w     ] = [-g]
+ *   [A 0 ] [lambda ]   [-b]
+ * is assembled in the stagewise order [lambda_0, x_0, u_0, nu_0, lambda_1, x_1, u_1, nu_1, ..., lambda_N, x_N, nu_N], where
+ * lambda_0 belongs to the initial state constraint, lambda_{k+1} to the dynamics of stage k, and nu_k to the constraints of stage k.
+ * In this order the KKT matrix is block-tridiagonal, and it is factorized with a sparse LDLT without fill-reducing permutation.
+ * A small regularization makes the matrix quasi-definite, such that the factorization exists without pivoting. Its error is
+ * removed by iterative refinement on the unregularized system.
+ *
+ *   Assumes the KKT matrix is nonsingular.
+ *
+ * @param lqp : linear quadratic problem.
+ * @param dx0 : initial state deviation from the nominal trajectories.
+ * @return {w, lambda} at the solution in the same order as solveDenseQp.
+ */
+std::pair<vector_t, vector_t> solveSparseQp(const std::vector<LinearQuadraticStage>& lqp, const vector_t& dx0);
+
 /**
  * Reconstructs the optimal state and input trajectory recursively based on the full qp solution vector
  * @param numStates : number of states per stage
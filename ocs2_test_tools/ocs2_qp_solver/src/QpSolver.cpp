@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_qp_solver/QpSolver.h"
 
 #include <Eigen/LU>
+#include <Eigen/SparseCholesky>
+#include <limits>
 #include <numeric>
 #include <tuple>
 
@@ -104,6 +106,21 @@ std::pair<vector_array_t, vector_array_t> solveLinearQuadraticProblem(const std:
   return getStateAndInputTrajectory(numStates, numInputs, primalDualSolution.first);
 }
 
+std::pair<vector_array_t, vector_array_t> solveLinearQuadraticProblemSparse(const std::vector<LinearQuadraticStage>& lqApproximation,
+                                                                            const vector_t& dx0) {
+  // Extract sizes
+  std::vector<int> numStates;
+  std::vector<int> numInputs;
+  std::vector<int> numConstraints;
+  std::tie(numStates, numInputs, numConstraints) = getNumStatesInputsConstraints(lqApproximation);
+
+  // Solve
+  const auto primalDualSolution = solveSparseQp(lqApproximation, dx0);
+
+  // Extract solution
+  return getStateAndInputTrajectory(numStates, numInputs, primalDualSolution.first);
+}
+
 VectorFunctionLinearApproximation getConstraintMatrices(const std::vector<LinearQuadraticStage>& lqp, const vector_t& dx0,
                                                         int numConstraints, int numDecisionVariables) {
   if (lqp.empty()) {
@@ -242,6 +259,161 @@ std::pair<vector_t, vector_t> solveDenseQp(const ScalarFunctionQuadraticApproxim
   return {sol.head(n), sol.tail(m)};
 }
 
+std::pair<vector_t, vector_t> solveSparseQp(const std::vector<LinearQuadraticStage>& lqp, const vector_t& dx0) {
+  using sparse_matrix_t = Eigen::SparseMatrix<scalar_t>;
+  using triplet_t = Eigen::Triplet<scalar_t>;
+
+  if (lqp.empty()) {
+    return {vector_t(), vector_t()};
+  }
+
+  std::vector<int> numStates;
+  std::vector<int> numInputs;
+  std::vector<int> numConstraints;
+  std::tie(numStates, numInputs, numConstraints) = getNumStatesInputsConstraints(lqp);
+  const int N = lqp.size() - 1;
+  const int numDecisionVariables = getNumDecisionVariables(numStates, numInputs);
+  const int numQpConstraints = getNumConstraints(numStates, numConstraints);
+  const int kktSize = numDecisionVariables + numQpConstraints;
+
+  // Offsets of [lambda_k, x_k, u_k, nu_k] in the KKT system, and of x_k and the constraints of stage k in the dense ordering
+  std::vector<int> lambdaIndex(N + 1);
+  std::vector<int> stateIndex(N + 1);
+  std::vector<int> inputIndex(N + 1);
+  std::vector<int> nuIndex(N + 1);
+  std::vector<int> primalOffset(N + 1);
+  std::vector<int> dualOffset(N + 1);
+  int kktIndex = 0;
+  int primalIndex = 0;
+  int dualIndex = 0;
+  for (int k = 0; k <= N; ++k) {
+    const int nu_k = (k < N) ? numInputs[k] : 0;
+    lambdaIndex[k] = kktIndex;
+    stateIndex[k] = lambdaIndex[k] + numStates[k];
+    inputIndex[k] = stateIndex[k] + numStates[k];
+    nuIndex[k] = inputIndex[k] + nu_k;
+    kktIndex = nuIndex[k] + numConstraints[k];
+    primalOffset[k] = primalIndex;
+    primalIndex += numStates[k] + nu_k;
+    dualOffset[k] = dualIndex;
+    dualIndex += numStates[k] + numConstraints[k];
+  }
+
+  // Assemble the lower triangular part of the KKT matrix and the right hand side
+  std::vector<triplet_t> triplets;
+  triplets.reserve(kktSize * (lqp.front().dynamics.dfdx.cols() + lqp.front().dynamics.dfdu.cols() + 1));
+  vector_t kktRhs(kktSize);
+  auto addBlock = [&](int row, int col, const matrix_t& block, scalar_t scaling) {
+    for (int j = 0; j < block.cols(); ++j) {
+      for (int i = 0; i < block.rows(); ++i) {
+        if (row + i >= col + j && block(i, j) != 0.0) {
+          triplets.emplace_back(row + i, col + j, scaling * block(i, j));
+        }
+      }
+    }
+  };
+  auto addIdentity = [&](int row, int col, int size, scalar_t scaling) {
+    for (int i = 0; i < size; ++i) {
+      triplets.emplace_back(row + i, col + i, scaling);
+    }
+  };
+
+  // Initial state constraint: -x_0 + dx0 = 0
+  addIdentity(stateIndex[0], lambdaIndex[0], numStates[0], -1.0);
+  kktRhs.segment(lambdaIndex[0], numStates[0]) = -dx0;
+
+  for (int k = 0; k <= N; ++k) {
+    const auto& cost_k = lqp[k].cost;
+    const auto& constraints_k = lqp[k].constraints;
+    const int nx_k = numStates[k];
+    const int nc_k = numConstraints[k];
+
+    // [Q, P'; P, R], [q; r]
+    addBlock(stateIndex[k], stateIndex[k], cost_k.dfdxx, 1.0);
+    kktRhs.segment(stateIndex[k], nx_k) = -cost_k.dfdx;
+    if (k < N) {
+      const int nu_k = numInputs[k];
+      addBlock(inputIndex[k], stateIndex[k], cost_k.dfdux, 1.0);
+      addBlock(inputIndex[k], inputIndex[k], cost_k.dfduu, 1.0);
+      kktRhs.segment(inputIndex[k], nu_k) = -cost_k.dfdu;
+    }
+
+    // [C, D], [e]
+    if (nc_k > 0) {
+      addBlock(nuIndex[k], stateIndex[k], constraints_k.dfdx, 1.0);
+      if (k < N) {
+        addBlock(nuIndex[k], inputIndex[k], constraints_k.dfdu, 1.0);
+      }
+      kktRhs.segment(nuIndex[k], nc_k) = -constraints_k.f;
+    }
+
+    // [A, B, -I], [b]
+    if (k < N) {
+      const auto& dynamics_k = lqp[k].dynamics;
+      addBlock(lambdaIndex[k + 1], stateIndex[k], dynamics_k.dfdx, 1.0);
+      addBlock(lambdaIndex[k + 1], inputIndex[k], dynamics_k.dfdu, 1.0);
+      addIdentity(stateIndex[k + 1], lambdaIndex[k + 1], numStates[k + 1], -1.0);
+      kktRhs.segment(lambdaIndex[k + 1], numStates[k + 1]) = -dynamics_k.f;
+    }
+  }
+
+  sparse_matrix_t kktMatrix(kktSize, kktSize);
+  kktMatrix.setFromTriplets(triplets.begin(), triplets.end());
+
+  // Quasi-definite regularization: +delta on the primal and -delta on the dual variables
+  constexpr scalar_t regularization = 1e-9;
+  for (int k = 0; k <= N; ++k) {
+    addIdentity(lambdaIndex[k], lambdaIndex[k], numStates[k], -regularization);
+    addIdentity(stateIndex[k], stateIndex[k], nuIndex[k] - stateIndex[k], regularization);
+    addIdentity(nuIndex[k], nuIndex[k], numConstraints[k], -regularization);
+  }
+  sparse_matrix_t regularizedKktMatrix(kktSize, kktSize);
+  regularizedKktMatrix.setFromTriplets(triplets.begin(), triplets.end());
+
+  Eigen::SimplicialLDLT<sparse_matrix_t, Eigen::Lower, Eigen::NaturalOrdering<int>> ldlt(regularizedKktMatrix);
+  if (ldlt.info() != Eigen::Success) {
+    throw std::runtime_error("KKT matrix is not full rank");
+  }
+
+  // Iterative refinement on the unregularized system until the residual stagnates at the level of the machine precision. The
+  // KKT matrix is singular if the backward error |r| / (|K| |sol| + |rhs|) remains large.
+  constexpr int maxNumRefinements = 10;
+  constexpr scalar_t backwardErrorTolerance = 1e-12;
+  const scalar_t kktMatrixNorm = kktMatrix.coeffs().cwiseAbs().maxCoeff();
+  const scalar_t rhsNorm = kktRhs.lpNorm<Eigen::Infinity>();
+  vector_t sol = ldlt.solve(kktRhs);
+  vector_t residual(kktSize);
+  scalar_t residualNorm = std::numeric_limits<scalar_t>::max();
+  for (int i = 0; i < maxNumRefinements; ++i) {
+    residual = kktRhs;
+    residual.noalias() -= kktMatrix.selfadjointView<Eigen::Lower>() * sol;
+    const scalar_t previousResidualNorm = residualNorm;
+    residualNorm = residual.lpNorm<Eigen::Infinity>();
+    if (residualNorm > 0.5 * previousResidualNorm) {
+      break;
+    }
+    sol += ldlt.solve(residual);
+  }
+  if (residualNorm > backwardErrorTolerance * (kktMatrixNorm * sol.lpNorm<Eigen::Infinity>() + rhsNorm)) {
+    throw std::runtime_error("KKT matrix is not full rank");
+  }
+
+  // Reorder to the dense layout
+  vector_t w(numDecisionVariables);
+  vector_t lambda(numQpConstraints);
+  for (int k = 0; k <= N; ++k) {
+    const int nx_k = numStates[k];
+    const int nu_k = (k < N) ? numInputs[k] : 0;
+    const int nc_k = numConstraints[k];
+    w.segment(primalOffset[k], nx_k + nu_k) = sol.segment(stateIndex[k], nx_k + nu_k);
+    // dense constraint order: [x_0 constraint; e_0; b_0; e_1; b_1; ... e_N], i.e. [lambda_0, nu_0, lambda_1, nu_1, ..., nu_N]
+    lambda.segment(dualOffset[k], nx_k) = sol.segment(lambdaIndex[k], nx_k);
+    lambda.segment(dualOffset[k] + nx_k, nc_k) = sol.segment(nuIndex[k], nc_k);
+  }
+
+  return {w, lambda};
+}
+
 std::pair<vector_array_t, vector_array_t> getStateAndInputTrajectory(const std::vector<int>& numStates, const std::vector<int>& numInputs,
                                                                      const vector_t& w) {
   assert(numStates.size() == numInputs.size() + 1);
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 #include "ocs2_qp_solver/QpSolver.h"
 #include "ocs2_qp_solver/test/testProblemsGeneration.h"
 
@@ -81,3 +84,86 @@ TEST_F(QpSolverTest, costMatrixFullRank) {
 TEST_F(QpSolverTest, constraintMatrixFullRank) {
   ASSERT_TRUE(constraints.dfdx.fullPivLu().rank() == constraints.dfdx.rows());
 }
+
+TEST_F(QpSolverTest, sparseSolution) {
+  ocs2::vector_t sparsePrimalSolution;
+  ocs2::vector_t sparseDualSolution;
+  std::tie(sparsePrimalSolution, sparseDualSolution) = ocs2::qp_solver::solveSparseQp(lqProblem, x0);
+  ASSERT_TRUE(sparsePrimalSolution.isApprox(primalSolution, 1e-9));
+  ASSERT_TRUE(sparseDualSolution.isApprox(dualSolution, 1e-9));
+}
+
+TEST(SparseQpSolverTest, compareWithDense) {
+  srand(0);
+  for (const int nc : {0, 2}) {
+    for (const int N : {2, 10, 50}) {
+      const int nx = 6;
+      const int nu = 3;
+      const auto lqProblem = ocs2::qp_solver::generateRandomLqProblem(N, nx, nu, nc);
+      const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+
+      const auto denseSolution = ocs2::qp_solver::solveLinearQuadraticProblem(lqProblem, x0);
+      const auto sparseSolution = ocs2::qp_solver::solveLinearQuadraticProblemSparse(lqProblem, x0);
+      for (int k = 0; k < N; ++k) {
+        ASSERT_TRUE(sparseSolution.first[k].isApprox(denseSolution.first[k], 1e-9)) << "N: " << N << ", k: " << k;
+        ASSERT_TRUE(sparseSolution.second[k].isApprox(denseSolution.second[k], 1e-9)) << "N: " << N << ", k: " << k;
+      }
+      ASSERT_TRUE(sparseSolution.first[N].isApprox(denseSolution.first[N], 1e-9)) << "N: " << N;
+    }
+  }
+
+  // more constraints than decision variables
+  const auto lqProblem = ocs2::qp_solver::generateRandomLqProblem(1, 6, 3, 2);
+  ASSERT_ANY_THROW(ocs2::qp_solver::solveSparseQp(lqProblem, ocs2::vector_t::Random(6)));
+}
+
+TEST(SparseQpSolverTest, longHorizon) {
+  srand(0);
+  const int N = 2000;
+  const int nx = 12;
+  const int nu = 4;
+  const int nc = 2;
+  const auto lqProblem = ocs2::qp_solver::generateRandomLqProblem(N, nx, nu, nc);
+  const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+
+  const auto start = std::chrono::steady_clock::now();
+  ocs2::vector_t w;
+  ocs2::vector_t lambda;
+  std::tie(w, lambda) = ocs2::qp_solver::solveSparseQp(lqProblem, x0);
+  const auto solveTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cerr << "[longHorizon] N: " << N << ", nx: " << nx << ", nu: " << nu << ", nc: " << nc << ", sparse solve: " << solveTime
+            << " [ms]\n";
+
+  // Check the KKT conditions stage by stage
+  const double tolerance = 1e-8;
+  int primalIndex = 0;
+  int dualIndex = 0;
+  ocs2::vector_t lambda_k = lambda.head(nx);
+  ASSERT_TRUE(w.head(nx).isApprox(x0, tolerance));
+  for (int k = 0; k <= N; ++k) {
+    const auto& stage = lqProblem[k];
+    const ocs2::vector_t x_k = w.segment(primalIndex, nx);
+    const ocs2::vector_t nu_k = lambda.segment(dualIndex + nx, nc);
+
+    // constraints and stationarity w.r.t. x_k
+    ocs2::vector_t dLdx = stage.cost.dfdxx * x_k + stage.cost.dfdx - lambda_k + stage.constraints.dfdx.transpose() * nu_k;
+    ocs2::vector_t constraint = stage.constraints.dfdx * x_k + stage.constraints.f;
+    if (k < N) {
+      const ocs2::vector_t u_k = w.segment(primalIndex + nx, nu);
+      const ocs2::vector_t x_next = w.segment(primalIndex + nx + nu, nx);
+      const ocs2::vector_t lambda_next = lambda.segment(dualIndex + nx + nc, nx);
+      constraint += stage.constraints.dfdu * u_k;
+      dLdx += stage.cost.dfdux.transpose() * u_k + stage.dynamics.dfdx.transpose() * lambda_next;
+      const ocs2::vector_t dLdu = stage.cost.dfduu * u_k + stage.cost.dfdux * x_k + stage.cost.dfdu +
+                                  stage.dynamics.dfdu.transpose() * lambda_next + stage.constraints.dfdu.transpose() * nu_k;
+      ASSERT_LT(dLdu.lpNorm<Eigen::Infinity>(), tolerance) << "k: " << k;
+      const ocs2::vector_t dynamicsDefect = stage.dynamics.dfdx * x_k + stage.dynamics.dfdu * u_k + stage.dynamics.f - x_next;
+      ASSERT_LT(dynamicsDefect.lpNorm<Eigen::Infinity>(), tolerance) << "k: " << k;
+      lambda_k = lambda_next;
+    }
+    ASSERT_LT(dLdx.lpNorm<Eigen::Infinity>(), tolerance) << "k: " << k;
+    ASSERT_LT(constraint.lpNorm<Eigen::Infinity>(), tolerance) << "k: " << k;
+    primalIndex += nx + nu;
+    dualIndex += nx + nc;
+  }
+}